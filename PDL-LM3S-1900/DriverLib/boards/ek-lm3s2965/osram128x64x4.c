@@ -318,8 +318,6 @@ static const unsigned char g_pucOSRAM128x64x4Init[] =
 static void
 OSRAMWriteCommand(const unsigned char *pucBuffer, unsigned long ulCount)
 {
-    unsigned long ulTemp;
-
     //
     // Return iff SSI port is not enabled for OSRAM.
     //
@@ -334,25 +332,11 @@ OSRAMWriteCommand(const unsigned char *pucBuffer, unsigned long ulCount)
     GPIOPinWrite(GPIO_PORTC_BASE, GPIO_PIN_7, 0);
 
     //
-    // Loop while there are more bytes left to be transferred.
+    // Write the bytes to the controller.  This returns once the data read
+    // back for the last byte has been drained from the receive FIFO, which
+    // times the GPIO signal.
     //
-    while(ulCount != 0)
-    {
-        //
-        // Write the next byte to the controller.
-        //
-        SSIDataPut(SSI0_BASE, *pucBuffer++);
-
-        //
-        // Dummy read to drain the fifo and time the GPIO signal.
-        //
-        SSIDataGet(SSI0_BASE, &ulTemp);
-
-        //
-        // Decrement the BYTE counter.
-        //
-        ulCount--;
-    }
+    SSIDataPutBlock(SSI0_BASE, pucBuffer, ulCount);
 }
 
 //*****************************************************************************
@@ -370,8 +354,6 @@ OSRAMWriteCommand(const unsigned char *pucBuffer, unsigned long ulCount)
 static void
 OSRAMWriteData(const unsigned char *pucBuffer, unsigned long ulCount)
 {
-    unsigned long ulTemp;
-
     //
     // Return iff SSI port is not enabled for OSRAM.
     //
@@ -386,25 +368,11 @@ OSRAMWriteData(const unsigned char *pucBuffer, unsigned long ulCount)
     GPIOPinWrite(GPIO_PORTC_BASE, GPIO_PIN_7, GPIO_PIN_7);
 
     //
-    // Loop while there are more bytes left to be transferred.
+    // Write the bytes to the controller.  This returns once the data read
+    // back for the last byte has been drained from the receive FIFO, which
+    // times the GPIO signal.
     //
-    while(ulCount != 0)
-    {
-        //
-        // Write the next byte to the controller.
-        //
-        SSIDataPut(SSI0_BASE, *pucBuffer++);
-
-        //
-        // Dummy read to drain the fifo and time the GPIO signal.
-        //
-        SSIDataGet(SSI0_BASE, &ulTemp);
-
-        //
-        // Decrement the BYTE counter.
-        //
-        ulCount--;
-    }
+    SSIDataPutBlock(SSI0_BASE, pucBuffer, ulCount);
 }
 
 //*****************************************************************************
@@ -105,66 +105,51 @@ fs_open(char *name)
     }
 
     //
-    // Initialize the file system tree pointer to the root of the linked list.
+    // Files are not compressed unless the file system image says so.
     //
-    ptTree = FS_ROOT;
+    ptFile->flags = 0;
 
     //
-    // Begin processing the linked list, looking for the requested file name.
+    // Look up the requested file name in the hash table of the file system
+    // image.
     //
-    while(ptTree != NULL)
+    ptTree = fsdata_find(name);
+    if(ptTree != NULL)
     {
         //
-        // Compare the requested file "name" to the file name in the
-        // current node.
+        // Fill in the data pointer, length and flags from the file system
+        // entry.
         //
-        if(strncmp(name, (char *)ptTree->name, ptTree->len) == 0)
-        {
-            //
-            // Fill in the data pointer and length values from the
-            // linked list node.
-            //
-            ptFile->data = (char *)ptTree->data;
-            ptFile->len = ptTree->len;
-
-            //
-            // For now, we setup the read index to the end of the file,
-            // indicating that all data has been read.
-            //
-            ptFile->index = ptTree->len;
+        ptFile->data = (char *)ptTree->data;
+        ptFile->len = ptTree->len;
+        ptFile->flags = ptTree->flags;
 
-            //
-            // See if the ptpclock shtml file has been selected.  If so,
-            // enable additional script processing.
-            //
-            ptr = strchr(name, '.');
-            if((ptr != NULL) && (strncmp(ptr, ".shtml", 6) == 0))
-            {
-                //
-                // Force the http server code to call the read function, and
-                // process the special script file there.
-                //
-                ptFile->data = NULL;
-                ptFile->len = 0;
-                ptFile->index = 0;
-                ptFile->pextension = (void *)ptTree;
-            }
-            else
-            {
-                ptFile->pextension = NULL;
-            }
+        //
+        // For now, we setup the read index to the end of the file,
+        // indicating that all data has been read.
+        //
+        ptFile->index = ptTree->len;
 
+        //
+        // See if the ptpclock shtml file has been selected.  If so,
+        // enable additional script processing.
+        //
+        ptr = strchr(name, '.');
+        if((ptr != NULL) && (strncmp(ptr, ".shtml", 6) == 0))
+        {
             //
-            // Exit the loop and return the file system pointer.
+            // Force the http server code to call the read function, and
+            // process the special script file there.
             //
-            break;
+            ptFile->data = NULL;
+            ptFile->len = 0;
+            ptFile->index = 0;
+            ptFile->pextension = (void *)ptTree;
+        }
+        else
+        {
+            ptFile->pextension = NULL;
         }
-
-        //
-        // If we get here, we did not find the file at this node of the linked
-        // list.  Get the next element in the list.
-        //
-        ptTree = ptTree->next;
     }
 
     //
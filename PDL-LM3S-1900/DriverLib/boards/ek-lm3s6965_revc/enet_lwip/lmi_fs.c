@@ -48,8 +48,11 @@
 // by the makefsdata script from lwIP, using the following command (all on one
 // line):
 //
-//     perl ../../../third_party/lwip-1.2.0/apps/httpd/makefsdata fs
-//          lmi-fsdata.c
+//     perl ../../../third_party/lwip-1.2.0/apps/httpd/makefsdata
+//          -z family.html -z lmi.html fs lmi-fsdata.c
+//
+// The two largest pages are also stored gzip compressed, and are sent
+// compressed to the browsers that accept it.
 //
 // If any changes are made to the static content of the web pages served by the
 // application, this script must be used to regenerate fsdata-qs.c in order for
@@ -199,6 +202,11 @@ fs_open(char *name)
         return(NULL);
     }
 
+    //
+    // Files are not compressed unless the file system image says so.
+    //
+    ptFile->flags = 0;
+
     //
     // Check to see if the Fat File System has been enabled.
     //
@@ -242,51 +250,31 @@ fs_open(char *name)
     }
 
     //
-    // Initialize the file system tree pointer to the root of the linked list.
-    //
-    ptTree = FS_ROOT;
-
-    //
-    // Begin processing the linked list, looking for the requested file name.
+    // Look up the requested file name in the hash table of the file system
+    // image.
     //
-    while(NULL != ptTree)
+    ptTree = fsdata_find(name);
+    if(ptTree != NULL)
     {
         //
-        // Compare the requested file "name" to the file name in the
-        // current node.
+        // Fill in the data pointer, length and flags from the file system
+        // entry.
         //
-        if(strncmp(name, (char *)ptTree->name, ptTree->len) == 0)
-        {
-            //
-            // Fill in the data pointer and length values from the
-            // linked list node.
-            //
-            ptFile->data = (char *)ptTree->data;
-            ptFile->len = ptTree->len;
-
-            //
-            // For now, we setup the read index to the end of the file,
-            // indicating that all data has been read.
-            //
-            ptFile->index = ptTree->len;
-
-            //
-            // We are not using any file system extensions in this
-            // application, so set the pointer to NULL.
-            //
-            ptFile->pextension = NULL;
-
-            //
-            // Exit the loop and return the file system pointer.
-            //
-            break;
-        }
+        ptFile->data = (char *)ptTree->data;
+        ptFile->len = ptTree->len;
+        ptFile->flags = ptTree->flags;
+
+        //
+        // For now, we setup the read index to the end of the file,
+        // indicating that all data has been read.
+        //
+        ptFile->index = ptTree->len;
 
         //
-        // If we get here, we did not find the file at this node of the linked
-        // list.  Get the next element in the list.
+        // We are not using any file system extensions in this
+        // application, so set the pointer to NULL.
         //
-        ptTree = ptTree->next;
+        ptFile->pextension = NULL;
     }
 
     //
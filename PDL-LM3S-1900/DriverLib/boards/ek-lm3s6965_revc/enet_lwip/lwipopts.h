@@ -53,6 +53,7 @@
 #define MEM_ALIGNMENT                   4       // default is 1
 #define MEM_SIZE                        (4*1024)
                                                 // default is 1600
+//#define MEM_USE_TLSF                    0
 //#define MEMP_SANITY_CHECK               0
 //#define MEMP_NUM_PBUF                   16
 //#define MEMP_NUM_RAW_PCB                4
@@ -202,6 +203,9 @@
 //#define CHECKSUM_CHECK_IP               1
 //#define CHECKSUM_CHECK_UDP              1
 //#define CHECKSUM_CHECK_TCP              1
+//#define LWIP_CHKSUM                     InetChksum
+                                                // default is the C version in
+                                                // inet.c
 
 //*****************************************************************************
 //
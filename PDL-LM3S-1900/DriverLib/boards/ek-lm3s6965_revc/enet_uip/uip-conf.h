@@ -90,6 +90,11 @@ typedef unsigned short uip_stats_t;
 //
 #define UIP_CONF_ARPTAB_SIZE        8
 
+//
+// Find ARP table entries with a hash table (for large ARP tables)
+//
+//#define UIP_CONF_ARP_HASH           1
+
 //
 // uIP buffer size.
 //
@@ -120,6 +125,12 @@ typedef unsigned short uip_stats_t;
 //
 #define UIP_CONF_BYTE_ORDER         LITTLE_ENDIAN
 
+//
+// Use the word at a time checksum routines in uip_arch.c, which require
+// utils/inetchksum.c
+//
+//#define UIP_ARCH_CHKSUM             1
+
 //
 // Here we include the header file for the application we are using in
 // this example
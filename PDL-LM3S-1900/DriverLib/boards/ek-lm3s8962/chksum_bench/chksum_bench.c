@@ -0,0 +1,363 @@
+//*****************************************************************************
+//
+// chksum_bench.c - Benchmark of the Internet checksum routine.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+#ifdef host
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <time.h>
+#endif
+#include "../../../hw_types.h"
+#include "../../../utils/inetchksum.h"
+#ifndef host
+#include "../../../hw_memmap.h"
+#include "../../../src/debug.h"
+#include "../../../src/gpio.h"
+#include "../../../src/sysctl.h"
+#include "../../../src/systick.h"
+#include "../../../utils/uartstdio.h"
+#endif
+
+//*****************************************************************************
+//
+//! \addtogroup ek_lm3s8962_list
+//! <h1>Internet Checksum Benchmark (chksum_bench)</h1>
+//!
+//! This example measures the Internet checksum routine in
+//! <tt>utils/inetchksum.c</tt> against a byte-pair loop like the ones in
+//! lwIP and uIP.  The two are first checked against each other for every
+//! length up to a full Ethernet frame at every alignment, and then each is
+//! timed on the header and frame sizes seen by the TCP/IP stacks.  The
+//! results are given in processor cycles per call, measured with SysTick, and
+//! are printed on UART0 (connected to the FTDI virtual serial port on the
+//! evaluation board) at 115,200 baud, 8-n-1.
+//!
+//! The same program can be built for the host from <tt>hwsim/bench</tt>, in
+//! which case the results are given in nanoseconds per call.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The longest buffer that is checked and timed, which is a full Ethernet
+// frame without its header.
+//
+//*****************************************************************************
+#define MAX_LEN                 1500
+
+//*****************************************************************************
+//
+// The number of times that each checksum is computed when it is timed.  On
+// the target, this is kept small enough that the slowest case fits in the
+// 24-bit SysTick counter.
+//
+//*****************************************************************************
+#ifdef host
+#define ITERATIONS              100000
+#else
+#define ITERATIONS              100
+#endif
+
+//*****************************************************************************
+//
+// The buffer lengths that are timed: an IP header, a TCP/IP header with
+// options, a minimum IP datagram, and a full frame.
+//
+//*****************************************************************************
+static const unsigned long g_pulLengths[] =
+{
+    20, 60, 576, MAX_LEN
+};
+
+//*****************************************************************************
+//
+// The data that is summed.  It is kept as words so that it is word aligned,
+// with room past the end for the largest starting offset.
+//
+//*****************************************************************************
+static unsigned long g_pulData[(MAX_LEN + 3 + 3) / 4];
+
+//*****************************************************************************
+//
+// The results of the timed checksums are added in here, so that the compiler
+// can not remove the calls.
+//
+//*****************************************************************************
+static volatile unsigned long g_ulSink;
+
+//*****************************************************************************
+//
+// The type of a checksum routine.
+//
+//*****************************************************************************
+typedef unsigned short (*tChksumFunc)(const void *pvData, unsigned long ulLen);
+
+//*****************************************************************************
+//
+// The error routine that is called if the driver library encounters an error.
+//
+//*****************************************************************************
+#ifdef DEBUG
+void
+__error__(char *pcFilename, unsigned long ulLine)
+{
+}
+#endif
+
+//*****************************************************************************
+//
+// Computes the one's complement sum of a buffer a pair of bytes at a time,
+// in the same way as uIP's chksum() and the first of lwIP's checksum
+// routines.  The sum is in network byte order, so it is the byte swap of the
+// sum returned by InetChksum().
+//
+//*****************************************************************************
+static unsigned short
+RefChksum(const void *pvData, unsigned long ulLen)
+{
+    const unsigned char *pucData;
+    unsigned long ulSum;
+
+    pucData = (const unsigned char *)pvData;
+    ulSum = 0;
+
+    //
+    // Sum the data a pair of bytes at a time, folding in any carry as it
+    // happens.
+    //
+    while(ulLen > 1)
+    {
+        ulSum += (pucData[0] << 8) | pucData[1];
+        ulSum = (ulSum & 0xffff) + (ulSum >> 16);
+        pucData += 2;
+        ulLen -= 2;
+    }
+
+    //
+    // Sum the trailing byte, if there is one, as the upper half of a pair.
+    //
+    if(ulLen)
+    {
+        ulSum += pucData[0] << 8;
+        ulSum = (ulSum & 0xffff) + (ulSum >> 16);
+    }
+
+    //
+    // Return the sum.
+    //
+    return((unsigned short)ulSum);
+}
+
+//*****************************************************************************
+//
+// Prints a line of the results.
+//
+//*****************************************************************************
+#ifdef host
+#define Print                   printf
+#else
+#define Print                   UARTprintf
+#endif
+
+//*****************************************************************************
+//
+// Returns the time taken by a number of calls to a checksum routine, in
+// nanoseconds on the host or processor cycles on the target.  The routine is
+// called through a volatile pointer, so that the compiler can not inline it
+// and move it out of the loop.
+//
+//*****************************************************************************
+#ifdef host
+static double
+TimeChksum(tChksumFunc volatile pfnChksum, const unsigned char *pucData,
+           unsigned long ulLen)
+{
+    struct timespec sStart, sEnd;
+    unsigned long ulSum, ulIdx;
+
+    clock_gettime(CLOCK_MONOTONIC, &sStart);
+    for(ulIdx = 0, ulSum = 0; ulIdx < ITERATIONS; ulIdx++)
+    {
+        ulSum += pfnChksum(pucData, ulLen);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &sEnd);
+    g_ulSink += ulSum;
+
+    return(((sEnd.tv_sec - sStart.tv_sec) * 1e9) +
+           (sEnd.tv_nsec - sStart.tv_nsec));
+}
+#else
+static unsigned long
+TimeChksum(tChksumFunc volatile pfnChksum, const unsigned char *pucData,
+           unsigned long ulLen)
+{
+    unsigned long ulSum, ulIdx, ulStart, ulEnd;
+
+    //
+    // SysTick counts down, and wraps from zero back to the top of its 24-bit
+    // range.
+    //
+    ulStart = SysTickValueGet();
+    for(ulIdx = 0, ulSum = 0; ulIdx < ITERATIONS; ulIdx++)
+    {
+        ulSum += pfnChksum(pucData, ulLen);
+    }
+    ulEnd = SysTickValueGet();
+    g_ulSink += ulSum;
+
+    return((ulStart - ulEnd) & 0xffffff);
+}
+#endif
+
+//*****************************************************************************
+//
+// Checks InetChksum() against RefChksum() for every length and alignment,
+// returning the number of mismatches.
+//
+//*****************************************************************************
+static unsigned long
+CheckChksum(void)
+{
+    const unsigned char *pucData;
+    unsigned long ulOffset, ulLen, ulErrors;
+    unsigned short usSum, usRef;
+
+    ulErrors = 0;
+    for(ulOffset = 0; ulOffset < 4; ulOffset++)
+    {
+        pucData = (const unsigned char *)g_pulData + ulOffset;
+        for(ulLen = 0; ulLen <= MAX_LEN; ulLen++)
+        {
+            usSum = InetChksum(pucData, ulLen);
+            usRef = RefChksum(pucData, ulLen);
+            if(usSum != (unsigned short)((usRef << 8) | (usRef >> 8)))
+            {
+                if(ulErrors++ < 8)
+                {
+                    Print("mismatch: offset %u, length %u\n",
+                          (unsigned int)ulOffset, (unsigned int)ulLen);
+                }
+            }
+        }
+    }
+
+    return(ulErrors);
+}
+
+//*****************************************************************************
+//
+// Checks and times the checksum routines, and prints the results.
+//
+//*****************************************************************************
+int
+main(void)
+{
+    const unsigned char *pucData;
+    unsigned long ulOffset, ulIdx, ulSeed, ulErrors;
+
+#ifndef host
+    //
+    // Set the clocking to run at 50MHz from the PLL.
+    //
+    SysCtlClockSet(SYSCTL_SYSDIV_4 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN |
+                   SYSCTL_XTAL_8MHZ);
+
+    //
+    // Set GPIO A0 and A1 as UART, and initialize the UART as a console for
+    // text output.
+    //
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
+    GPIOPinTypeUART(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
+    UARTStdioInit(0);
+
+    //
+    // Let SysTick count through its full range, without interrupts.
+    //
+    SysTickPeriodSet(0x1000000);
+    SysTickEnable();
+#endif
+
+    //
+    // Fill the buffer with pseudo-random data.
+    //
+    for(ulIdx = 0, ulSeed = 1;
+        ulIdx < (sizeof(g_pulData) / sizeof(g_pulData[0])); ulIdx++)
+    {
+        ulSeed = (ulSeed * 1664525) + 1013904223;
+        g_pulData[ulIdx] = ulSeed;
+    }
+
+    //
+    // Check that the two routines agree before timing them.
+    //
+    Print("\nInternet checksum benchmark\n");
+    ulErrors = CheckChksum();
+    Print("check: %u mismatches\n", (unsigned int)ulErrors);
+    if(ulErrors)
+    {
+        return(1);
+    }
+
+    //
+    // Time both routines at each length, from a word aligned buffer and from
+    // an odd address.
+    //
+#ifdef host
+    Print("ns per call  length  offset  byte pairs  InetChksum\n");
+#else
+    Print("cycles per call  length  offset  byte pairs  InetChksum\n");
+#endif
+    for(ulIdx = 0; ulIdx < sizeof(g_pulLengths) / sizeof(g_pulLengths[0]);
+        ulIdx++)
+    {
+        for(ulOffset = 0; ulOffset < 2; ulOffset++)
+        {
+            pucData = (const unsigned char *)g_pulData + ulOffset;
+#ifdef host
+            Print("             %6lu  %6lu  %10.1f  %10.1f\n",
+                  g_pulLengths[ulIdx], ulOffset,
+                  TimeChksum(RefChksum, pucData, g_pulLengths[ulIdx]) /
+                  ITERATIONS,
+                  TimeChksum(InetChksum, pucData, g_pulLengths[ulIdx]) /
+                  ITERATIONS);
+#else
+            Print("                 %6u  %6u  %10u  %10u\n",
+                  g_pulLengths[ulIdx], ulOffset,
+                  TimeChksum(RefChksum, pucData, g_pulLengths[ulIdx]) /
+                  ITERATIONS,
+                  TimeChksum(InetChksum, pucData, g_pulLengths[ulIdx]) /
+                  ITERATIONS);
+#endif
+        }
+    }
+
+    //
+    // Finished.
+    //
+    return(0);
+}
@@ -1,7 +1,7 @@
 static const unsigned char data_404_html[] = {
 	/* /404.html */
 	0x2f, 0x34, 0x30, 0x34, 0x2e, 0x68, 0x74, 0x6d, 0x6c, 0,
-	0x48, 0x54, 0x54, 0x50, 0x2f, 0x31, 0x2e, 0x30, 0x20, 0x34, 
+	0x48, 0x54, 0x54, 0x50, 0x2f, 0x31, 0x2e, 0x31, 0x20, 0x34, 
 	0x30, 0x34, 0x20, 0x46, 0x69, 0x6c, 0x65, 0x20, 0x6e, 0x6f, 
 	0x74, 0x20, 0x66, 0x6f, 0x75, 0x6e, 0x64, 0xd, 0xa, 0x53, 
 	0x65, 0x72, 0x76, 0x65, 0x72, 0x3a, 0x20, 0x6c, 0x77, 0x49, 
@@ -11,33 +11,38 @@ static const unsigned char data_404_html[] = {
 	0x64, 0x61, 0x6d, 0x2f, 0x6c, 0x77, 0x69, 0x70, 0x2f, 0x29, 
 	0xd, 0xa, 0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2d, 
 	0x74, 0x79, 0x70, 0x65, 0x3a, 0x20, 0x74, 0x65, 0x78, 0x74, 
-	0x2f, 0x68, 0x74, 0x6d, 0x6c, 0xd, 0xa, 0xd, 0xa, 0x3c, 
-	0x21, 0x2d, 0x2d, 0x20, 0x43, 0x6f, 0x70, 0x79, 0x72, 0x69, 
-	0x67, 0x68, 0x74, 0x20, 0x28, 0x63, 0x29, 0x20, 0x32, 0x30, 
-	0x30, 0x37, 0x20, 0x4c, 0x75, 0x6d, 0x69, 0x6e, 0x61, 0x72, 
-	0x79, 0x20, 0x4d, 0x69, 0x63, 0x72, 0x6f, 0x2c, 0x20, 0x49, 
-	0x6e, 0x63, 0x2e, 0x20, 0x20, 0x41, 0x6c, 0x6c, 0x20, 0x72, 
-	0x69, 0x67, 0x68, 0x74, 0x73, 0x20, 0x72, 0x65, 0x73, 0x65, 
-	0x72, 0x76, 0x65, 0x64, 0x2e, 0x20, 0x2d, 0x2d, 0x3e, 0xa, 
-	0x3c, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0xa, 0x3c, 0x62, 0x6f, 
-	0x64, 0x79, 0x20, 0x62, 0x67, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 
-	0x3d, 0x22, 0x77, 0x68, 0x69, 0x74, 0x65, 0x22, 0x3e, 0xa, 
-	0x3c, 0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x3e, 0xa, 0x3c, 
-	0x68, 0x31, 0x3e, 0x34, 0x30, 0x34, 0x20, 0x2d, 0x20, 0x66, 
-	0x69, 0x6c, 0x65, 0x20, 0x6e, 0x6f, 0x74, 0x20, 0x66, 0x6f, 
-	0x75, 0x6e, 0x64, 0x3c, 0x2f, 0x68, 0x31, 0x3e, 0xa, 0x3c, 
-	0x68, 0x33, 0x3e, 0x47, 0x6f, 0x20, 0x3c, 0x61, 0x20, 0x68, 
-	0x72, 0x65, 0x66, 0x3d, 0x22, 0x2f, 0x22, 0x3e, 0x68, 0x65, 
-	0x72, 0x65, 0x3c, 0x2f, 0x61, 0x3e, 0x20, 0x69, 0x6e, 0x73, 
-	0x74, 0x65, 0x61, 0x64, 0x2e, 0x3c, 0x2f, 0x68, 0x33, 0x3e, 
-	0xa, 0x3c, 0x2f, 0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x3e, 
-	0xa, 0x3c, 0x2f, 0x62, 0x6f, 0x64, 0x79, 0x3e, 0xa, 0x3c, 
-	0x2f, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0xa, };
+	0x2f, 0x68, 0x74, 0x6d, 0x6c, 0xd, 0xa, 0x43, 0x6f, 0x6e, 
+	0x74, 0x65, 0x6e, 0x74, 0x2d, 0x4c, 0x65, 0x6e, 0x67, 0x74, 
+	0x68, 0x3a, 0x20, 0x32, 0x30, 0x38, 0xd, 0xa, 0x43, 0x61, 
+	0x63, 0x68, 0x65, 0x2d, 0x43, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 
+	0x6c, 0x3a, 0x20, 0x6e, 0x6f, 0x2d, 0x63, 0x61, 0x63, 0x68, 
+	0x65, 0xd, 0xa, 0xd, 0xa, 0x3c, 0x21, 0x2d, 0x2d, 0x20, 
+	0x43, 0x6f, 0x70, 0x79, 0x72, 0x69, 0x67, 0x68, 0x74, 0x20, 
+	0x28, 0x63, 0x29, 0x20, 0x32, 0x30, 0x30, 0x37, 0x20, 0x4c, 
+	0x75, 0x6d, 0x69, 0x6e, 0x61, 0x72, 0x79, 0x20, 0x4d, 0x69, 
+	0x63, 0x72, 0x6f, 0x2c, 0x20, 0x49, 0x6e, 0x63, 0x2e, 0x20, 
+	0x20, 0x41, 0x6c, 0x6c, 0x20, 0x72, 0x69, 0x67, 0x68, 0x74, 
+	0x73, 0x20, 0x72, 0x65, 0x73, 0x65, 0x72, 0x76, 0x65, 0x64, 
+	0x2e, 0x20, 0x2d, 0x2d, 0x3e, 0xa, 0x3c, 0x68, 0x74, 0x6d, 
+	0x6c, 0x3e, 0xa, 0x3c, 0x62, 0x6f, 0x64, 0x79, 0x20, 0x62, 
+	0x67, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3d, 0x22, 0x77, 0x68, 
+	0x69, 0x74, 0x65, 0x22, 0x3e, 0xa, 0x3c, 0x63, 0x65, 0x6e, 
+	0x74, 0x65, 0x72, 0x3e, 0xa, 0x3c, 0x68, 0x31, 0x3e, 0x34, 
+	0x30, 0x34, 0x20, 0x2d, 0x20, 0x66, 0x69, 0x6c, 0x65, 0x20, 
+	0x6e, 0x6f, 0x74, 0x20, 0x66, 0x6f, 0x75, 0x6e, 0x64, 0x3c, 
+	0x2f, 0x68, 0x31, 0x3e, 0xa, 0x3c, 0x68, 0x33, 0x3e, 0x47, 
+	0x6f, 0x20, 0x3c, 0x61, 0x20, 0x68, 0x72, 0x65, 0x66, 0x3d, 
+	0x22, 0x2f, 0x22, 0x3e, 0x68, 0x65, 0x72, 0x65, 0x3c, 0x2f, 
+	0x61, 0x3e, 0x20, 0x69, 0x6e, 0x73, 0x74, 0x65, 0x61, 0x64, 
+	0x2e, 0x3c, 0x2f, 0x68, 0x33, 0x3e, 0xa, 0x3c, 0x2f, 0x63, 
+	0x65, 0x6e, 0x74, 0x65, 0x72, 0x3e, 0xa, 0x3c, 0x2f, 0x62, 
+	0x6f, 0x64, 0x79, 0x3e, 0xa, 0x3c, 0x2f, 0x68, 0x74, 0x6d, 
+	0x6c, 0x3e, 0xa, };
 
 static const unsigned char data_index_html[] = {
 	/* /index.html */
 	0x2f, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x2e, 0x68, 0x74, 0x6d, 0x6c, 0,
-	0x48, 0x54, 0x54, 0x50, 0x2f, 0x31, 0x2e, 0x30, 0x20, 0x32, 
+	0x48, 0x54, 0x54, 0x50, 0x2f, 0x31, 0x2e, 0x31, 0x20, 0x32, 
 	0x30, 0x30, 0x20, 0x4f, 0x4b, 0xd, 0xa, 0x53, 0x65, 0x72, 
 	0x76, 0x65, 0x72, 0x3a, 0x20, 0x6c, 0x77, 0x49, 0x50, 0x2f, 
 	0x31, 0x2e, 0x32, 0x2e, 0x30, 0x20, 0x28, 0x68, 0x74, 0x74, 
@@ -46,130 +51,135 @@ static const unsigned char data_index_html[] = {
 	0x6d, 0x2f, 0x6c, 0x77, 0x69, 0x70, 0x2f, 0x29, 0xd, 0xa, 
 	0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2d, 0x74, 0x79, 
 	0x70, 0x65, 0x3a, 0x20, 0x74, 0x65, 0x78, 0x74, 0x2f, 0x68, 
-	0x74, 0x6d, 0x6c, 0xd, 0xa, 0xd, 0xa, 0x3c, 0x21, 0x2d, 
-	0x2d, 0x20, 0x43, 0x6f, 0x70, 0x79, 0x72, 0x69, 0x67, 0x68, 
-	0x74, 0x20, 0x28, 0x63, 0x29, 0x20, 0x32, 0x30, 0x30, 0x37, 
-	0x20, 0x4c, 0x75, 0x6d, 0x69, 0x6e, 0x61, 0x72, 0x79, 0x20, 
-	0x4d, 0x69, 0x63, 0x72, 0x6f, 0x2c, 0x20, 0x49, 0x6e, 0x63, 
-	0x2e, 0x20, 0x20, 0x41, 0x6c, 0x6c, 0x20, 0x72, 0x69, 0x67, 
-	0x68, 0x74, 0x73, 0x20, 0x72, 0x65, 0x73, 0x65, 0x72, 0x76, 
-	0x65, 0x64, 0x2e, 0x20, 0x2d, 0x2d, 0x3e, 0xa, 0x3c, 0x68, 
-	0x74, 0x6d, 0x6c, 0x3e, 0xa, 0x3c, 0x68, 0x65, 0x61, 0x64, 
-	0x3e, 0xa, 0x3c, 0x6d, 0x65, 0x74, 0x61, 0x20, 0x68, 0x74, 
-	0x74, 0x70, 0x2d, 0x65, 0x71, 0x75, 0x69, 0x76, 0x3d, 0x22, 
-	0x63, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2d, 0x74, 0x79, 
-	0x70, 0x65, 0x22, 0x20, 0x63, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 
-	0x74, 0x3d, 0x22, 0x74, 0x65, 0x78, 0x74, 0x2f, 0x68, 0x74, 
-	0x6d, 0x6c, 0x3b, 0x63, 0x68, 0x61, 0x72, 0x73, 0x65, 0x74, 
-	0x3d, 0x49, 0x53, 0x4f, 0x2d, 0x38, 0x38, 0x36, 0x39, 0x2d, 
-	0x31, 0x22, 0x3e, 0xa, 0x3c, 0x6c, 0x69, 0x6e, 0x6b, 0x20, 
-	0x68, 0x72, 0x65, 0x66, 0x3d, 0x22, 0x2e, 0x2f, 0x73, 0x74, 
-	0x79, 0x6c, 0x65, 0x73, 0x2e, 0x63, 0x73, 0x73, 0x22, 0x20, 
-	0x72, 0x65, 0x6c, 0x3d, 0x22, 0x73, 0x74, 0x79, 0x6c, 0x65, 
-	0x73, 0x68, 0x65, 0x65, 0x74, 0x22, 0x20, 0x6d, 0x65, 0x64, 
-	0x69, 0x61, 0x3d, 0x22, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 
-	0x22, 0x3e, 0xa, 0x3c, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3e, 
-	0x41, 0x62, 0x6f, 0x75, 0x74, 0x20, 0x4c, 0x75, 0x6d, 0x69, 
-	0x6e, 0x61, 0x72, 0x79, 0x20, 0x4d, 0x69, 0x63, 0x72, 0x6f, 
-	0x3c, 0x2f, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3e, 0xa, 0x3c, 
-	0x2f, 0x68, 0x65, 0x61, 0x64, 0x3e, 0xa, 0x3c, 0x62, 0x6f, 
-	0x64, 0x79, 0x3e, 0xa, 0x3c, 0x68, 0x31, 0x3e, 0x41, 0x62, 
-	0x6f, 0x75, 0x74, 0x20, 0x4c, 0x75, 0x6d, 0x69, 0x6e, 0x61, 
-	0x72, 0x79, 0x20, 0x4d, 0x69, 0x63, 0x72, 0x6f, 0x3c, 0x2f, 
-	0x68, 0x31, 0x3e, 0xa, 0x3c, 0x70, 0x3e, 0xa, 0x4c, 0x75, 
-	0x6d, 0x69, 0x6e, 0x61, 0x72, 0x79, 0x20, 0x4d, 0x69, 0x63, 
-	0x72, 0x6f, 0x2c, 0x20, 0x49, 0x6e, 0x63, 0x2e, 0x20, 0x64, 
-	0x65, 0x73, 0x69, 0x67, 0x6e, 0x73, 0x2c, 0x20, 0x6d, 0x61, 
-	0x72, 0x6b, 0x65, 0x74, 0x73, 0x20, 0x61, 0x6e, 0x64, 0x20, 
-	0x73, 0x65, 0x6c, 0x6c, 0x73, 0x20, 0x61, 0x77, 0x61, 0x72, 
-	0x64, 0x2d, 0x77, 0x69, 0x6e, 0x6e, 0x69, 0x6e, 0x67, 0x20, 
-	0x41, 0x52, 0x4d, 0x26, 0x72, 0x65, 0x67, 0x3b, 0xa, 0x43, 
-	0x6f, 0x72, 0x74, 0x65, 0x78, 0x26, 0x74, 0x72, 0x61, 0x64, 
-	0x65, 0x3b, 0x2d, 0x4d, 0x33, 0x2d, 0x62, 0x61, 0x73, 0x65, 
-	0x64, 0x20, 0x6d, 0x69, 0x63, 0x72, 0x6f, 0x63, 0x6f, 0x6e, 
-	0x74, 0x72, 0x6f, 0x6c, 0x6c, 0x65, 0x72, 0x73, 0x20, 0x28, 
-	0x4d, 0x43, 0x55, 0x73, 0x29, 0x2e, 0x20, 0x20, 0x4c, 0x75, 
-	0x6d, 0x69, 0x6e, 0x61, 0x72, 0x79, 0x20, 0x4d, 0x69, 0x63, 
-	0x72, 0x6f, 0x20, 0x69, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 
-	0x6c, 0x65, 0x61, 0x64, 0xa, 0x70, 0x61, 0x72, 0x74, 0x6e, 
-	0x65, 0x72, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x74, 0x68, 0x65, 
-	0x20, 0x43, 0x6f, 0x72, 0x74, 0x65, 0x78, 0x2d, 0x4d, 0x33, 
-	0x20, 0x70, 0x72, 0x6f, 0x63, 0x65, 0x73, 0x73, 0x6f, 0x72, 
-	0x2c, 0x20, 0x64, 0x65, 0x6c, 0x69, 0x76, 0x65, 0x72, 0x69, 
-	0x6e, 0x67, 0x20, 0x74, 0x68, 0x65, 0x20, 0x77, 0x6f, 0x72, 
-	0x6c, 0x64, 0x27, 0x73, 0x20, 0x66, 0x69, 0x72, 0x73, 0x74, 
-	0x20, 0x73, 0x69, 0x6c, 0x69, 0x63, 0x6f, 0x6e, 0xa, 0x69, 
-	0x6d, 0x70, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x61, 0x74, 
-	0x69, 0x6f, 0x6e, 0x20, 0x6f, 0x66, 0x20, 0x74, 0x68, 0x65, 
-	0x20, 0x43, 0x6f, 0x72, 0x74, 0x65, 0x78, 0x2d, 0x4d, 0x33, 
-	0x20, 0x70, 0x72, 0x6f, 0x63, 0x65, 0x73, 0x73, 0x6f, 0x72, 
-	0x2e, 0xa, 0x3c, 0x2f, 0x70, 0x3e, 0xa, 0x3c, 0x70, 0x3e, 
-	0xa, 0x4c, 0x75, 0x6d, 0x69, 0x6e, 0x61, 0x72, 0x79, 0x20, 
-	0x4d, 0x69, 0x63, 0x72, 0x6f, 0x27, 0x73, 0x20, 0x69, 0x6e, 
-	0x74, 0x72, 0x6f, 0x64, 0x75, 0x63, 0x74, 0x69, 0x6f, 0x6e, 
-	0x20, 0x6f, 0x66, 0x20, 0x74, 0x68, 0x65, 0x20, 0x53, 0x74, 
-	0x65, 0x6c, 0x6c, 0x61, 0x72, 0x69, 0x73, 0x26, 0x72, 0x65, 
-	0x67, 0x3b, 0x20, 0x66, 0x61, 0x6d, 0x69, 0x6c, 0x79, 0x20, 
-	0x6f, 0x66, 0x20, 0x70, 0x72, 0x6f, 0x64, 0x75, 0x63, 0x74, 
-	0x73, 0x20, 0x70, 0x72, 0x6f, 0x76, 0x69, 0x64, 0x65, 0x73, 
-	0xa, 0x33, 0x32, 0x2d, 0x62, 0x69, 0x74, 0x20, 0x70, 0x65, 
-	0x72, 0x66, 0x6f, 0x72, 0x6d, 0x61, 0x6e, 0x63, 0x65, 0x20, 
-	0x66, 0x6f, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x61, 
-	0x6d, 0x65, 0x20, 0x70, 0x72, 0x69, 0x63, 0x65, 0x20, 0x61, 
-	0x73, 0x20, 0x63, 0x75, 0x72, 0x72, 0x65, 0x6e, 0x74, 0x20, 
-	0x38, 0x2d, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x31, 0x36, 0x2d, 
-	0x62, 0x69, 0x74, 0x20, 0x6d, 0x69, 0x63, 0x72, 0x6f, 0x63, 
-	0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x6c, 0x65, 0x72, 0xa, 
-	0x64, 0x65, 0x73, 0x69, 0x67, 0x6e, 0x73, 0x2e, 0x20, 0x20, 
-	0x57, 0x69, 0x74, 0x68, 0x20, 0x65, 0x6e, 0x74, 0x72, 0x79, 
-	0x2d, 0x6c, 0x65, 0x76, 0x65, 0x6c, 0x20, 0x70, 0x72, 0x69, 
-	0x63, 0x69, 0x6e, 0x67, 0x20, 0x61, 0x74, 0x20, 0x24, 0x31, 
-	0x2e, 0x30, 0x30, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x61, 0x6e, 
-	0x20, 0x41, 0x52, 0x4d, 0x20, 0x74, 0x65, 0x63, 0x68, 0x6e, 
-	0x6f, 0x6c, 0x6f, 0x67, 0x79, 0x2d, 0x62, 0x61, 0x73, 0x65, 
-	0x64, 0x20, 0x4d, 0x43, 0x55, 0x2c, 0xa, 0x4c, 0x75, 0x6d, 
+	0x74, 0x6d, 0x6c, 0xd, 0xa, 0x43, 0x6f, 0x6e, 0x74, 0x65, 
+	0x6e, 0x74, 0x2d, 0x4c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3a, 
+	0x20, 0x31, 0x31, 0x37, 0x35, 0xd, 0xa, 0x43, 0x61, 0x63, 
+	0x68, 0x65, 0x2d, 0x43, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 
+	0x3a, 0x20, 0x6d, 0x61, 0x78, 0x2d, 0x61, 0x67, 0x65, 0x3d, 
+	0x33, 0x36, 0x30, 0x30, 0xd, 0xa, 0xd, 0xa, 0x3c, 0x21, 
+	0x2d, 0x2d, 0x20, 0x43, 0x6f, 0x70, 0x79, 0x72, 0x69, 0x67, 
+	0x68, 0x74, 0x20, 0x28, 0x63, 0x29, 0x20, 0x32, 0x30, 0x30, 
+	0x37, 0x20, 0x4c, 0x75, 0x6d, 0x69, 0x6e, 0x61, 0x72, 0x79, 
+	0x20, 0x4d, 0x69, 0x63, 0x72, 0x6f, 0x2c, 0x20, 0x49, 0x6e, 
+	0x63, 0x2e, 0x20, 0x20, 0x41, 0x6c, 0x6c, 0x20, 0x72, 0x69, 
+	0x67, 0x68, 0x74, 0x73, 0x20, 0x72, 0x65, 0x73, 0x65, 0x72, 
+	0x76, 0x65, 0x64, 0x2e, 0x20, 0x2d, 0x2d, 0x3e, 0xa, 0x3c, 
+	0x68, 0x74, 0x6d, 0x6c, 0x3e, 0xa, 0x3c, 0x68, 0x65, 0x61, 
+	0x64, 0x3e, 0xa, 0x3c, 0x6d, 0x65, 0x74, 0x61, 0x20, 0x68, 
+	0x74, 0x74, 0x70, 0x2d, 0x65, 0x71, 0x75, 0x69, 0x76, 0x3d, 
+	0x22, 0x63, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2d, 0x74, 
+	0x79, 0x70, 0x65, 0x22, 0x20, 0x63, 0x6f, 0x6e, 0x74, 0x65, 
+	0x6e, 0x74, 0x3d, 0x22, 0x74, 0x65, 0x78, 0x74, 0x2f, 0x68, 
+	0x74, 0x6d, 0x6c, 0x3b, 0x63, 0x68, 0x61, 0x72, 0x73, 0x65, 
+	0x74, 0x3d, 0x49, 0x53, 0x4f, 0x2d, 0x38, 0x38, 0x36, 0x39, 
+	0x2d, 0x31, 0x22, 0x3e, 0xa, 0x3c, 0x6c, 0x69, 0x6e, 0x6b, 
+	0x20, 0x68, 0x72, 0x65, 0x66, 0x3d, 0x22, 0x2e, 0x2f, 0x73, 
+	0x74, 0x79, 0x6c, 0x65, 0x73, 0x2e, 0x63, 0x73, 0x73, 0x22, 
+	0x20, 0x72, 0x65, 0x6c, 0x3d, 0x22, 0x73, 0x74, 0x79, 0x6c, 
+	0x65, 0x73, 0x68, 0x65, 0x65, 0x74, 0x22, 0x20, 0x6d, 0x65, 
+	0x64, 0x69, 0x61, 0x3d, 0x22, 0x73, 0x63, 0x72, 0x65, 0x65, 
+	0x6e, 0x22, 0x3e, 0xa, 0x3c, 0x74, 0x69, 0x74, 0x6c, 0x65, 
+	0x3e, 0x41, 0x62, 0x6f, 0x75, 0x74, 0x20, 0x4c, 0x75, 0x6d, 
 	0x69, 0x6e, 0x61, 0x72, 0x79, 0x20, 0x4d, 0x69, 0x63, 0x72, 
-	0x6f, 0x27, 0x73, 0x20, 0x53, 0x74, 0x65, 0x6c, 0x6c, 0x61, 
-	0x72, 0x69, 0x73, 0x20, 0x70, 0x72, 0x6f, 0x64, 0x75, 0x63, 
-	0x74, 0x20, 0x6c, 0x69, 0x6e, 0x65, 0x20, 0x61, 0x6c, 0x6c, 
-	0x6f, 0x77, 0x73, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x73, 0x74, 
-	0x61, 0x6e, 0x64, 0x61, 0x72, 0x64, 0x69, 0x7a, 0x61, 0x74, 
-	0x69, 0x6f, 0x6e, 0x20, 0x74, 0x68, 0x61, 0x74, 0xa, 0x65, 
-	0x6c, 0x69, 0x6d, 0x69, 0x6e, 0x61, 0x74, 0x65, 0x73, 0x20, 
-	0x66, 0x75, 0x74, 0x75, 0x72, 0x65, 0x20, 0x61, 0x72, 0x63, 
-	0x68, 0x69, 0x74, 0x65, 0x63, 0x74, 0x75, 0x72, 0x61, 0x6c, 
-	0x20, 0x75, 0x70, 0x67, 0x72, 0x61, 0x64, 0x65, 0x73, 0x20, 
-	0x6f, 0x72, 0x20, 0x73, 0x6f, 0x66, 0x74, 0x77, 0x61, 0x72, 
-	0x65, 0x20, 0x74, 0x6f, 0x6f, 0x6c, 0x73, 0x20, 0x63, 0x68, 
-	0x61, 0x6e, 0x67, 0x65, 0x73, 0x2e, 0xa, 0x3c, 0x2f, 0x70, 
-	0x3e, 0xa, 0x3c, 0x70, 0x3e, 0xa, 0x52, 0x65, 0x61, 0x64, 
-	0x20, 0x6d, 0x6f, 0x72, 0x65, 0x20, 0x61, 0x62, 0x6f, 0x75, 
-	0x74, 0x20, 0x75, 0x73, 0x20, 0x6f, 0x6e, 0x20, 0x74, 0x68, 
-	0x65, 0x20, 0x77, 0x65, 0x62, 0x20, 0x61, 0x74, 0xa, 0x3c, 
-	0x61, 0x20, 0x68, 0x72, 0x65, 0x66, 0x3d, 0x22, 0x68, 0x74, 
-	0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x77, 0x77, 0x77, 0x2e, 0x6c, 
-	0x75, 0x6d, 0x69, 0x6e, 0x61, 0x72, 0x79, 0x6d, 0x69, 0x63, 
-	0x72, 0x6f, 0x2e, 0x63, 0x6f, 0x6d, 0x22, 0x3e, 0x77, 0x77, 
-	0x77, 0x2e, 0x6c, 0x75, 0x6d, 0x69, 0x6e, 0x61, 0x72, 0x79, 
-	0x6d, 0x69, 0x63, 0x72, 0x6f, 0x2e, 0x63, 0x6f, 0x6d, 0x3c, 
-	0x2f, 0x61, 0x3e, 0x2e, 0xa, 0x3c, 0x2f, 0x70, 0x3e, 0xa, 
-	0x3c, 0x70, 0x3e, 0xa, 0x46, 0x6f, 0x72, 0x20, 0x6d, 0x6f, 
-	0x72, 0x65, 0x20, 0x64, 0x65, 0x74, 0x61, 0x69, 0x6c, 0x73, 
-	0x20, 0x61, 0x62, 0x6f, 0x75, 0x74, 0x20, 0x74, 0x68, 0x65, 
-	0x20, 0x50, 0x54, 0x50, 0x64, 0x20, 0x69, 0x6d, 0x70, 0x6c, 
-	0x65, 0x6d, 0x65, 0x6e, 0x74, 0x61, 0x74, 0x69, 0x6f, 0x6e, 
-	0x2c, 0x20, 0x63, 0x6c, 0x69, 0x63, 0x6b, 0xa, 0x3c, 0x61, 
-	0x20, 0x68, 0x72, 0x65, 0x66, 0x3d, 0x22, 0x2e, 0x2f, 0x70, 
-	0x74, 0x70, 0x63, 0x6c, 0x6f, 0x63, 0x6b, 0x2e, 0x73, 0x68, 
-	0x74, 0x6d, 0x6c, 0x22, 0x3e, 0x68, 0x65, 0x72, 0x65, 0x3c, 
-	0x2f, 0x61, 0x3e, 0x2e, 0xa, 0x3c, 0x2f, 0x62, 0x6f, 0x64, 
-	0x79, 0x3e, 0xa, 0x3c, 0x2f, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 
-	0xa, 0xa, };
+	0x6f, 0x3c, 0x2f, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3e, 0xa, 
+	0x3c, 0x2f, 0x68, 0x65, 0x61, 0x64, 0x3e, 0xa, 0x3c, 0x62, 
+	0x6f, 0x64, 0x79, 0x3e, 0xa, 0x3c, 0x68, 0x31, 0x3e, 0x41, 
+	0x62, 0x6f, 0x75, 0x74, 0x20, 0x4c, 0x75, 0x6d, 0x69, 0x6e, 
+	0x61, 0x72, 0x79, 0x20, 0x4d, 0x69, 0x63, 0x72, 0x6f, 0x3c, 
+	0x2f, 0x68, 0x31, 0x3e, 0xa, 0x3c, 0x70, 0x3e, 0xa, 0x4c, 
+	0x75, 0x6d, 0x69, 0x6e, 0x61, 0x72, 0x79, 0x20, 0x4d, 0x69, 
+	0x63, 0x72, 0x6f, 0x2c, 0x20, 0x49, 0x6e, 0x63, 0x2e, 0x20, 
+	0x64, 0x65, 0x73, 0x69, 0x67, 0x6e, 0x73, 0x2c, 0x20, 0x6d, 
+	0x61, 0x72, 0x6b, 0x65, 0x74, 0x73, 0x20, 0x61, 0x6e, 0x64, 
+	0x20, 0x73, 0x65, 0x6c, 0x6c, 0x73, 0x20, 0x61, 0x77, 0x61, 
+	0x72, 0x64, 0x2d, 0x77, 0x69, 0x6e, 0x6e, 0x69, 0x6e, 0x67, 
+	0x20, 0x41, 0x52, 0x4d, 0x26, 0x72, 0x65, 0x67, 0x3b, 0xa, 
+	0x43, 0x6f, 0x72, 0x74, 0x65, 0x78, 0x26, 0x74, 0x72, 0x61, 
+	0x64, 0x65, 0x3b, 0x2d, 0x4d, 0x33, 0x2d, 0x62, 0x61, 0x73, 
+	0x65, 0x64, 0x20, 0x6d, 0x69, 0x63, 0x72, 0x6f, 0x63, 0x6f, 
+	0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x6c, 0x65, 0x72, 0x73, 0x20, 
+	0x28, 0x4d, 0x43, 0x55, 0x73, 0x29, 0x2e, 0x20, 0x20, 0x4c, 
+	0x75, 0x6d, 0x69, 0x6e, 0x61, 0x72, 0x79, 0x20, 0x4d, 0x69, 
+	0x63, 0x72, 0x6f, 0x20, 0x69, 0x73, 0x20, 0x74, 0x68, 0x65, 
+	0x20, 0x6c, 0x65, 0x61, 0x64, 0xa, 0x70, 0x61, 0x72, 0x74, 
+	0x6e, 0x65, 0x72, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x74, 0x68, 
+	0x65, 0x20, 0x43, 0x6f, 0x72, 0x74, 0x65, 0x78, 0x2d, 0x4d, 
+	0x33, 0x20, 0x70, 0x72, 0x6f, 0x63, 0x65, 0x73, 0x73, 0x6f, 
+	0x72, 0x2c, 0x20, 0x64, 0x65, 0x6c, 0x69, 0x76, 0x65, 0x72, 
+	0x69, 0x6e, 0x67, 0x20, 0x74, 0x68, 0x65, 0x20, 0x77, 0x6f, 
+	0x72, 0x6c, 0x64, 0x27, 0x73, 0x20, 0x66, 0x69, 0x72, 0x73, 
+	0x74, 0x20, 0x73, 0x69, 0x6c, 0x69, 0x63, 0x6f, 0x6e, 0xa, 
+	0x69, 0x6d, 0x70, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x61, 
+	0x74, 0x69, 0x6f, 0x6e, 0x20, 0x6f, 0x66, 0x20, 0x74, 0x68, 
+	0x65, 0x20, 0x43, 0x6f, 0x72, 0x74, 0x65, 0x78, 0x2d, 0x4d, 
+	0x33, 0x20, 0x70, 0x72, 0x6f, 0x63, 0x65, 0x73, 0x73, 0x6f, 
+	0x72, 0x2e, 0xa, 0x3c, 0x2f, 0x70, 0x3e, 0xa, 0x3c, 0x70, 
+	0x3e, 0xa, 0x4c, 0x75, 0x6d, 0x69, 0x6e, 0x61, 0x72, 0x79, 
+	0x20, 0x4d, 0x69, 0x63, 0x72, 0x6f, 0x27, 0x73, 0x20, 0x69, 
+	0x6e, 0x74, 0x72, 0x6f, 0x64, 0x75, 0x63, 0x74, 0x69, 0x6f, 
+	0x6e, 0x20, 0x6f, 0x66, 0x20, 0x74, 0x68, 0x65, 0x20, 0x53, 
+	0x74, 0x65, 0x6c, 0x6c, 0x61, 0x72, 0x69, 0x73, 0x26, 0x72, 
+	0x65, 0x67, 0x3b, 0x20, 0x66, 0x61, 0x6d, 0x69, 0x6c, 0x79, 
+	0x20, 0x6f, 0x66, 0x20, 0x70, 0x72, 0x6f, 0x64, 0x75, 0x63, 
+	0x74, 0x73, 0x20, 0x70, 0x72, 0x6f, 0x76, 0x69, 0x64, 0x65, 
+	0x73, 0xa, 0x33, 0x32, 0x2d, 0x62, 0x69, 0x74, 0x20, 0x70, 
+	0x65, 0x72, 0x66, 0x6f, 0x72, 0x6d, 0x61, 0x6e, 0x63, 0x65, 
+	0x20, 0x66, 0x6f, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 
+	0x61, 0x6d, 0x65, 0x20, 0x70, 0x72, 0x69, 0x63, 0x65, 0x20, 
+	0x61, 0x73, 0x20, 0x63, 0x75, 0x72, 0x72, 0x65, 0x6e, 0x74, 
+	0x20, 0x38, 0x2d, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x31, 0x36, 
+	0x2d, 0x62, 0x69, 0x74, 0x20, 0x6d, 0x69, 0x63, 0x72, 0x6f, 
+	0x63, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x6c, 0x65, 0x72, 
+	0xa, 0x64, 0x65, 0x73, 0x69, 0x67, 0x6e, 0x73, 0x2e, 0x20, 
+	0x20, 0x57, 0x69, 0x74, 0x68, 0x20, 0x65, 0x6e, 0x74, 0x72, 
+	0x79, 0x2d, 0x6c, 0x65, 0x76, 0x65, 0x6c, 0x20, 0x70, 0x72, 
+	0x69, 0x63, 0x69, 0x6e, 0x67, 0x20, 0x61, 0x74, 0x20, 0x24, 
+	0x31, 0x2e, 0x30, 0x30, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x61, 
+	0x6e, 0x20, 0x41, 0x52, 0x4d, 0x20, 0x74, 0x65, 0x63, 0x68, 
+	0x6e, 0x6f, 0x6c, 0x6f, 0x67, 0x79, 0x2d, 0x62, 0x61, 0x73, 
+	0x65, 0x64, 0x20, 0x4d, 0x43, 0x55, 0x2c, 0xa, 0x4c, 0x75, 
+	0x6d, 0x69, 0x6e, 0x61, 0x72, 0x79, 0x20, 0x4d, 0x69, 0x63, 
+	0x72, 0x6f, 0x27, 0x73, 0x20, 0x53, 0x74, 0x65, 0x6c, 0x6c, 
+	0x61, 0x72, 0x69, 0x73, 0x20, 0x70, 0x72, 0x6f, 0x64, 0x75, 
+	0x63, 0x74, 0x20, 0x6c, 0x69, 0x6e, 0x65, 0x20, 0x61, 0x6c, 
+	0x6c, 0x6f, 0x77, 0x73, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x73, 
+	0x74, 0x61, 0x6e, 0x64, 0x61, 0x72, 0x64, 0x69, 0x7a, 0x61, 
+	0x74, 0x69, 0x6f, 0x6e, 0x20, 0x74, 0x68, 0x61, 0x74, 0xa, 
+	0x65, 0x6c, 0x69, 0x6d, 0x69, 0x6e, 0x61, 0x74, 0x65, 0x73, 
+	0x20, 0x66, 0x75, 0x74, 0x75, 0x72, 0x65, 0x20, 0x61, 0x72, 
+	0x63, 0x68, 0x69, 0x74, 0x65, 0x63, 0x74, 0x75, 0x72, 0x61, 
+	0x6c, 0x20, 0x75, 0x70, 0x67, 0x72, 0x61, 0x64, 0x65, 0x73, 
+	0x20, 0x6f, 0x72, 0x20, 0x73, 0x6f, 0x66, 0x74, 0x77, 0x61, 
+	0x72, 0x65, 0x20, 0x74, 0x6f, 0x6f, 0x6c, 0x73, 0x20, 0x63, 
+	0x68, 0x61, 0x6e, 0x67, 0x65, 0x73, 0x2e, 0xa, 0x3c, 0x2f, 
+	0x70, 0x3e, 0xa, 0x3c, 0x70, 0x3e, 0xa, 0x52, 0x65, 0x61, 
+	0x64, 0x20, 0x6d, 0x6f, 0x72, 0x65, 0x20, 0x61, 0x62, 0x6f, 
+	0x75, 0x74, 0x20, 0x75, 0x73, 0x20, 0x6f, 0x6e, 0x20, 0x74, 
+	0x68, 0x65, 0x20, 0x77, 0x65, 0x62, 0x20, 0x61, 0x74, 0xa, 
+	0x3c, 0x61, 0x20, 0x68, 0x72, 0x65, 0x66, 0x3d, 0x22, 0x68, 
+	0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x77, 0x77, 0x77, 0x2e, 
+	0x6c, 0x75, 0x6d, 0x69, 0x6e, 0x61, 0x72, 0x79, 0x6d, 0x69, 
+	0x63, 0x72, 0x6f, 0x2e, 0x63, 0x6f, 0x6d, 0x22, 0x3e, 0x77, 
+	0x77, 0x77, 0x2e, 0x6c, 0x75, 0x6d, 0x69, 0x6e, 0x61, 0x72, 
+	0x79, 0x6d, 0x69, 0x63, 0x72, 0x6f, 0x2e, 0x63, 0x6f, 0x6d, 
+	0x3c, 0x2f, 0x61, 0x3e, 0x2e, 0xa, 0x3c, 0x2f, 0x70, 0x3e, 
+	0xa, 0x3c, 0x70, 0x3e, 0xa, 0x46, 0x6f, 0x72, 0x20, 0x6d, 
+	0x6f, 0x72, 0x65, 0x20, 0x64, 0x65, 0x74, 0x61, 0x69, 0x6c, 
+	0x73, 0x20, 0x61, 0x62, 0x6f, 0x75, 0x74, 0x20, 0x74, 0x68, 
+	0x65, 0x20, 0x50, 0x54, 0x50, 0x64, 0x20, 0x69, 0x6d, 0x70, 
+	0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x61, 0x74, 0x69, 0x6f, 
+	0x6e, 0x2c, 0x20, 0x63, 0x6c, 0x69, 0x63, 0x6b, 0xa, 0x3c, 
+	0x61, 0x20, 0x68, 0x72, 0x65, 0x66, 0x3d, 0x22, 0x2e, 0x2f, 
+	0x70, 0x74, 0x70, 0x63, 0x6c, 0x6f, 0x63, 0x6b, 0x2e, 0x73, 
+	0x68, 0x74, 0x6d, 0x6c, 0x22, 0x3e, 0x68, 0x65, 0x72, 0x65, 
+	0x3c, 0x2f, 0x61, 0x3e, 0x2e, 0xa, 0x3c, 0x2f, 0x62, 0x6f, 
+	0x64, 0x79, 0x3e, 0xa, 0x3c, 0x2f, 0x68, 0x74, 0x6d, 0x6c, 
+	0x3e, 0xa, 0xa, };
 
 static const unsigned char data_ptpclock_shtml[] = {
 	/* /ptpclock.shtml */
 	0x2f, 0x70, 0x74, 0x70, 0x63, 0x6c, 0x6f, 0x63, 0x6b, 0x2e, 0x73, 0x68, 0x74, 0x6d, 0x6c, 0,
-	0x48, 0x54, 0x54, 0x50, 0x2f, 0x31, 0x2e, 0x30, 0x20, 0x32, 
+	0x48, 0x54, 0x54, 0x50, 0x2f, 0x31, 0x2e, 0x31, 0x20, 0x32, 
 	0x30, 0x30, 0x20, 0x4f, 0x4b, 0xd, 0xa, 0x53, 0x65, 0x72, 
 	0x76, 0x65, 0x72, 0x3a, 0x20, 0x6c, 0x77, 0x49, 0x50, 0x2f, 
 	0x31, 0x2e, 0x32, 0x2e, 0x30, 0x20, 0x28, 0x68, 0x74, 0x74, 
@@ -178,111 +188,114 @@ static const unsigned char data_ptpclock_shtml[] = {
 	0x6d, 0x2f, 0x6c, 0x77, 0x69, 0x70, 0x2f, 0x29, 0xd, 0xa, 
 	0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2d, 0x74, 0x79, 
 	0x70, 0x65, 0x3a, 0x20, 0x74, 0x65, 0x78, 0x74, 0x2f, 0x68, 
-	0x74, 0x6d, 0x6c, 0xd, 0xa, 0xd, 0xa, 0x3c, 0x21, 0x2d, 
-	0x2d, 0x20, 0x43, 0x6f, 0x70, 0x79, 0x72, 0x69, 0x67, 0x68, 
-	0x74, 0x20, 0x28, 0x63, 0x29, 0x20, 0x32, 0x30, 0x30, 0x37, 
-	0x20, 0x4c, 0x75, 0x6d, 0x69, 0x6e, 0x61, 0x72, 0x79, 0x20, 
-	0x4d, 0x69, 0x63, 0x72, 0x6f, 0x2c, 0x20, 0x49, 0x6e, 0x63, 
-	0x2e, 0x20, 0x20, 0x41, 0x6c, 0x6c, 0x20, 0x72, 0x69, 0x67, 
-	0x68, 0x74, 0x73, 0x20, 0x72, 0x65, 0x73, 0x65, 0x72, 0x76, 
-	0x65, 0x64, 0x2e, 0x20, 0x2d, 0x2d, 0x3e, 0xa, 0x3c, 0x68, 
-	0x74, 0x6d, 0x6c, 0x3e, 0xa, 0x3c, 0x68, 0x65, 0x61, 0x64, 
-	0x3e, 0xa, 0x3c, 0x6d, 0x65, 0x74, 0x61, 0x20, 0x68, 0x74, 
-	0x74, 0x70, 0x2d, 0x65, 0x71, 0x75, 0x69, 0x76, 0x3d, 0x22, 
-	0x63, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2d, 0x74, 0x79, 
-	0x70, 0x65, 0x22, 0x20, 0x63, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 
-	0x74, 0x3d, 0x22, 0x74, 0x65, 0x78, 0x74, 0x2f, 0x68, 0x74, 
-	0x6d, 0x6c, 0x3b, 0x63, 0x68, 0x61, 0x72, 0x73, 0x65, 0x74, 
-	0x3d, 0x49, 0x53, 0x4f, 0x2d, 0x38, 0x38, 0x36, 0x39, 0x2d, 
-	0x31, 0x22, 0x3e, 0xa, 0x3c, 0x6c, 0x69, 0x6e, 0x6b, 0x20, 
-	0x68, 0x72, 0x65, 0x66, 0x3d, 0x22, 0x2e, 0x2f, 0x73, 0x74, 
-	0x79, 0x6c, 0x65, 0x73, 0x2e, 0x63, 0x73, 0x73, 0x22, 0x20, 
-	0x72, 0x65, 0x6c, 0x3d, 0x22, 0x73, 0x74, 0x79, 0x6c, 0x65, 
-	0x73, 0x68, 0x65, 0x65, 0x74, 0x22, 0x20, 0x6d, 0x65, 0x64, 
-	0x69, 0x61, 0x3d, 0x22, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 
-	0x22, 0x3e, 0xa, 0x3c, 0x6d, 0x65, 0x74, 0x61, 0x20, 0x68, 
-	0x74, 0x74, 0x70, 0x2d, 0x65, 0x71, 0x75, 0x69, 0x76, 0x3d, 
-	0x22, 0x72, 0x65, 0x66, 0x72, 0x65, 0x73, 0x68, 0x22, 0x20, 
-	0x63, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x3d, 0x22, 0x31, 
-	0x22, 0x3e, 0xa, 0x3c, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3e, 
-	0x41, 0x62, 0x6f, 0x75, 0x74, 0x20, 0x50, 0x54, 0x50, 0x20, 
-	0x28, 0x49, 0x45, 0x45, 0x45, 0x2d, 0x31, 0x35, 0x38, 0x38, 
-	0x29, 0x20, 0x6f, 0x6e, 0x20, 0x53, 0x74, 0x65, 0x6c, 0x6c, 
-	0x61, 0x72, 0x69, 0x73, 0x3c, 0x2f, 0x74, 0x69, 0x74, 0x6c, 
-	0x65, 0x3e, 0xa, 0x3c, 0x2f, 0x68, 0x65, 0x61, 0x64, 0x3e, 
-	0xa, 0x3c, 0x62, 0x6f, 0x64, 0x79, 0x3e, 0xa, 0x3c, 0x68, 
-	0x31, 0x3e, 0x41, 0x62, 0x6f, 0x75, 0x74, 0x20, 0x50, 0x54, 
-	0x50, 0x64, 0x20, 0x28, 0x49, 0x45, 0x45, 0x45, 0x2d, 0x31, 
-	0x35, 0x38, 0x38, 0x29, 0x20, 0x6f, 0x6e, 0x20, 0x53, 0x74, 
-	0x65, 0x6c, 0x6c, 0x61, 0x72, 0x69, 0x73, 0x3c, 0x2f, 0x68, 
-	0x31, 0x3e, 0xa, 0x3c, 0x70, 0x3e, 0xa, 0x4c, 0x75, 0x6d, 
-	0x69, 0x6e, 0x61, 0x72, 0x79, 0x20, 0x4d, 0x69, 0x63, 0x72, 
-	0x6f, 0x20, 0x68, 0x61, 0x73, 0x20, 0x69, 0x6d, 0x70, 0x6c, 
-	0x65, 0x6d, 0x65, 0x6e, 0x74, 0x65, 0x64, 0x20, 0x74, 0x68, 
-	0x65, 0x20, 0x4f, 0x70, 0x65, 0x6e, 0x20, 0x53, 0x6f, 0x75, 
-	0x72, 0x63, 0x65, 0x20, 0x50, 0x54, 0x50, 0x64, 0x20, 0x73, 
-	0x6f, 0x66, 0x74, 0x77, 0x61, 0x72, 0x65, 0x20, 0x6f, 0x6e, 
-	0x20, 0x69, 0x74, 0x73, 0x20, 0x53, 0x74, 0x65, 0x6c, 0x6c, 
-	0x61, 0x72, 0x69, 0x73, 0xa, 0x66, 0x61, 0x6d, 0x69, 0x6c, 
-	0x79, 0x20, 0x6f, 0x66, 0x20, 0x6d, 0x69, 0x63, 0x72, 0x6f, 
-	0x63, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x6c, 0x65, 0x72, 
-	0x73, 0x2e, 0x20, 0x20, 0x54, 0x68, 0x69, 0x73, 0x20, 0x69, 
-	0x6d, 0x70, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x61, 0x74, 
-	0x69, 0x6f, 0x6e, 0x20, 0x75, 0x73, 0x65, 0x73, 0x20, 0x74, 
-	0x68, 0x65, 0x20, 0x6c, 0x77, 0x49, 0x50, 0x20, 0x54, 0x43, 
-	0x50, 0x2f, 0x49, 0x50, 0x20, 0x73, 0x74, 0x61, 0x63, 0x6b, 
-	0x2c, 0xa, 0x61, 0x6e, 0x64, 0x20, 0x64, 0x6f, 0x65, 0x73, 
-	0x20, 0x6e, 0x6f, 0x74, 0x20, 0x72, 0x65, 0x71, 0x75, 0x69, 
-	0x72, 0x65, 0x20, 0x61, 0x6e, 0x20, 0x52, 0x54, 0x4f, 0x53, 
-	0x2e, 0xa, 0x3c, 0x2f, 0x70, 0x3e, 0xa, 0x3c, 0x70, 0x3e, 
-	0xa, 0x44, 0x65, 0x74, 0x61, 0x69, 0x6c, 0x73, 0x20, 0x6f, 
-	0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x4f, 0x70, 0x65, 0x6e, 
-	0x20, 0x53, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x20, 0x50, 0x54, 
-	0x50, 0x20, 0x50, 0x72, 0x6f, 0x74, 0x6f, 0x63, 0x6f, 0x6c, 
-	0x20, 0x53, 0x6f, 0x66, 0x74, 0x77, 0x61, 0x72, 0x65, 0x20, 
-	0x63, 0x61, 0x6e, 0x20, 0x62, 0x65, 0x20, 0x66, 0x6f, 0x75, 
-	0x6e, 0x64, 0x20, 0x61, 0x74, 0xa, 0x3c, 0x61, 0x20, 0x68, 
-	0x72, 0x65, 0x66, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 
-	0x2f, 0x2f, 0x70, 0x74, 0x70, 0x64, 0x2e, 0x73, 0x6f, 0x75, 
-	0x72, 0x63, 0x65, 0x66, 0x6f, 0x72, 0x67, 0x65, 0x2e, 0x6e, 
-	0x65, 0x74, 0x22, 0x3e, 0x70, 0x74, 0x70, 0x64, 0x2e, 0x73, 
-	0x6f, 0x75, 0x72, 0x63, 0x65, 0x66, 0x6f, 0x72, 0x67, 0x65, 
-	0x2e, 0x6e, 0x65, 0x74, 0x3c, 0x2f, 0x61, 0x3e, 0x2e, 0xa, 
-	0x3c, 0x2f, 0x70, 0x3e, 0xa, 0x3c, 0x70, 0x3e, 0xa, 0x44, 
-	0x65, 0x74, 0x61, 0x69, 0x6c, 0x73, 0x20, 0x6f, 0x6e, 0x20, 
-	0x74, 0x68, 0x65, 0x20, 0x4f, 0x70, 0x65, 0x6e, 0x20, 0x53, 
-	0x6f, 0x75, 0x72, 0x63, 0x65, 0x20, 0x6c, 0x77, 0x49, 0x50, 
-	0x20, 0x54, 0x43, 0x50, 0x2f, 0x49, 0x50, 0x20, 0x73, 0x74, 
-	0x61, 0x63, 0x6b, 0x20, 0x63, 0x61, 0x6e, 0x20, 0x62, 0x65, 
-	0x20, 0x66, 0x6f, 0x75, 0x6e, 0x64, 0x20, 0x61, 0x74, 0xa, 
-	0x3c, 0x61, 0x20, 0x68, 0x72, 0x65, 0x66, 0x3d, 0x22, 0x68, 
-	0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x77, 0x77, 0x77, 0x2e, 
-	0x73, 0x69, 0x63, 0x73, 0x2e, 0x73, 0x65, 0x2f, 0x7e, 0x61, 
-	0x64, 0x61, 0x6d, 0x2f, 0x6c, 0x77, 0x69, 0x70, 0x2f, 0x22, 
-	0x3e, 0x77, 0x77, 0x77, 0x2e, 0x73, 0x69, 0x63, 0x73, 0x2e, 
+	0x74, 0x6d, 0x6c, 0xd, 0xa, 0x43, 0x61, 0x63, 0x68, 0x65, 
+	0x2d, 0x43, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x3a, 0x20, 
+	0x6e, 0x6f, 0x2d, 0x63, 0x61, 0x63, 0x68, 0x65, 0xd, 0xa, 
+	0xd, 0xa, 0x3c, 0x21, 0x2d, 0x2d, 0x20, 0x43, 0x6f, 0x70, 
+	0x79, 0x72, 0x69, 0x67, 0x68, 0x74, 0x20, 0x28, 0x63, 0x29, 
+	0x20, 0x32, 0x30, 0x30, 0x37, 0x20, 0x4c, 0x75, 0x6d, 0x69, 
+	0x6e, 0x61, 0x72, 0x79, 0x20, 0x4d, 0x69, 0x63, 0x72, 0x6f, 
+	0x2c, 0x20, 0x49, 0x6e, 0x63, 0x2e, 0x20, 0x20, 0x41, 0x6c, 
+	0x6c, 0x20, 0x72, 0x69, 0x67, 0x68, 0x74, 0x73, 0x20, 0x72, 
+	0x65, 0x73, 0x65, 0x72, 0x76, 0x65, 0x64, 0x2e, 0x20, 0x2d, 
+	0x2d, 0x3e, 0xa, 0x3c, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0xa, 
+	0x3c, 0x68, 0x65, 0x61, 0x64, 0x3e, 0xa, 0x3c, 0x6d, 0x65, 
+	0x74, 0x61, 0x20, 0x68, 0x74, 0x74, 0x70, 0x2d, 0x65, 0x71, 
+	0x75, 0x69, 0x76, 0x3d, 0x22, 0x63, 0x6f, 0x6e, 0x74, 0x65, 
+	0x6e, 0x74, 0x2d, 0x74, 0x79, 0x70, 0x65, 0x22, 0x20, 0x63, 
+	0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x3d, 0x22, 0x74, 0x65, 
+	0x78, 0x74, 0x2f, 0x68, 0x74, 0x6d, 0x6c, 0x3b, 0x63, 0x68, 
+	0x61, 0x72, 0x73, 0x65, 0x74, 0x3d, 0x49, 0x53, 0x4f, 0x2d, 
+	0x38, 0x38, 0x36, 0x39, 0x2d, 0x31, 0x22, 0x3e, 0xa, 0x3c, 
+	0x6c, 0x69, 0x6e, 0x6b, 0x20, 0x68, 0x72, 0x65, 0x66, 0x3d, 
+	0x22, 0x2e, 0x2f, 0x73, 0x74, 0x79, 0x6c, 0x65, 0x73, 0x2e, 
+	0x63, 0x73, 0x73, 0x22, 0x20, 0x72, 0x65, 0x6c, 0x3d, 0x22, 
+	0x73, 0x74, 0x79, 0x6c, 0x65, 0x73, 0x68, 0x65, 0x65, 0x74, 
+	0x22, 0x20, 0x6d, 0x65, 0x64, 0x69, 0x61, 0x3d, 0x22, 0x73, 
+	0x63, 0x72, 0x65, 0x65, 0x6e, 0x22, 0x3e, 0xa, 0x3c, 0x6d, 
+	0x65, 0x74, 0x61, 0x20, 0x68, 0x74, 0x74, 0x70, 0x2d, 0x65, 
+	0x71, 0x75, 0x69, 0x76, 0x3d, 0x22, 0x72, 0x65, 0x66, 0x72, 
+	0x65, 0x73, 0x68, 0x22, 0x20, 0x63, 0x6f, 0x6e, 0x74, 0x65, 
+	0x6e, 0x74, 0x3d, 0x22, 0x31, 0x22, 0x3e, 0xa, 0x3c, 0x74, 
+	0x69, 0x74, 0x6c, 0x65, 0x3e, 0x41, 0x62, 0x6f, 0x75, 0x74, 
+	0x20, 0x50, 0x54, 0x50, 0x20, 0x28, 0x49, 0x45, 0x45, 0x45, 
+	0x2d, 0x31, 0x35, 0x38, 0x38, 0x29, 0x20, 0x6f, 0x6e, 0x20, 
+	0x53, 0x74, 0x65, 0x6c, 0x6c, 0x61, 0x72, 0x69, 0x73, 0x3c, 
+	0x2f, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3e, 0xa, 0x3c, 0x2f, 
+	0x68, 0x65, 0x61, 0x64, 0x3e, 0xa, 0x3c, 0x62, 0x6f, 0x64, 
+	0x79, 0x3e, 0xa, 0x3c, 0x68, 0x31, 0x3e, 0x41, 0x62, 0x6f, 
+	0x75, 0x74, 0x20, 0x50, 0x54, 0x50, 0x64, 0x20, 0x28, 0x49, 
+	0x45, 0x45, 0x45, 0x2d, 0x31, 0x35, 0x38, 0x38, 0x29, 0x20, 
+	0x6f, 0x6e, 0x20, 0x53, 0x74, 0x65, 0x6c, 0x6c, 0x61, 0x72, 
+	0x69, 0x73, 0x3c, 0x2f, 0x68, 0x31, 0x3e, 0xa, 0x3c, 0x70, 
+	0x3e, 0xa, 0x4c, 0x75, 0x6d, 0x69, 0x6e, 0x61, 0x72, 0x79, 
+	0x20, 0x4d, 0x69, 0x63, 0x72, 0x6f, 0x20, 0x68, 0x61, 0x73, 
+	0x20, 0x69, 0x6d, 0x70, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 
+	0x65, 0x64, 0x20, 0x74, 0x68, 0x65, 0x20, 0x4f, 0x70, 0x65, 
+	0x6e, 0x20, 0x53, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x20, 0x50, 
+	0x54, 0x50, 0x64, 0x20, 0x73, 0x6f, 0x66, 0x74, 0x77, 0x61, 
+	0x72, 0x65, 0x20, 0x6f, 0x6e, 0x20, 0x69, 0x74, 0x73, 0x20, 
+	0x53, 0x74, 0x65, 0x6c, 0x6c, 0x61, 0x72, 0x69, 0x73, 0xa, 
+	0x66, 0x61, 0x6d, 0x69, 0x6c, 0x79, 0x20, 0x6f, 0x66, 0x20, 
+	0x6d, 0x69, 0x63, 0x72, 0x6f, 0x63, 0x6f, 0x6e, 0x74, 0x72, 
+	0x6f, 0x6c, 0x6c, 0x65, 0x72, 0x73, 0x2e, 0x20, 0x20, 0x54, 
+	0x68, 0x69, 0x73, 0x20, 0x69, 0x6d, 0x70, 0x6c, 0x65, 0x6d, 
+	0x65, 0x6e, 0x74, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x75, 
+	0x73, 0x65, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6c, 0x77, 
+	0x49, 0x50, 0x20, 0x54, 0x43, 0x50, 0x2f, 0x49, 0x50, 0x20, 
+	0x73, 0x74, 0x61, 0x63, 0x6b, 0x2c, 0xa, 0x61, 0x6e, 0x64, 
+	0x20, 0x64, 0x6f, 0x65, 0x73, 0x20, 0x6e, 0x6f, 0x74, 0x20, 
+	0x72, 0x65, 0x71, 0x75, 0x69, 0x72, 0x65, 0x20, 0x61, 0x6e, 
+	0x20, 0x52, 0x54, 0x4f, 0x53, 0x2e, 0xa, 0x3c, 0x2f, 0x70, 
+	0x3e, 0xa, 0x3c, 0x70, 0x3e, 0xa, 0x44, 0x65, 0x74, 0x61, 
+	0x69, 0x6c, 0x73, 0x20, 0x6f, 0x6e, 0x20, 0x74, 0x68, 0x65, 
+	0x20, 0x4f, 0x70, 0x65, 0x6e, 0x20, 0x53, 0x6f, 0x75, 0x72, 
+	0x63, 0x65, 0x20, 0x50, 0x54, 0x50, 0x20, 0x50, 0x72, 0x6f, 
+	0x74, 0x6f, 0x63, 0x6f, 0x6c, 0x20, 0x53, 0x6f, 0x66, 0x74, 
+	0x77, 0x61, 0x72, 0x65, 0x20, 0x63, 0x61, 0x6e, 0x20, 0x62, 
+	0x65, 0x20, 0x66, 0x6f, 0x75, 0x6e, 0x64, 0x20, 0x61, 0x74, 
+	0xa, 0x3c, 0x61, 0x20, 0x68, 0x72, 0x65, 0x66, 0x3d, 0x22, 
+	0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x70, 0x74, 0x70, 
+	0x64, 0x2e, 0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x66, 0x6f, 
+	0x72, 0x67, 0x65, 0x2e, 0x6e, 0x65, 0x74, 0x22, 0x3e, 0x70, 
+	0x74, 0x70, 0x64, 0x2e, 0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 
+	0x66, 0x6f, 0x72, 0x67, 0x65, 0x2e, 0x6e, 0x65, 0x74, 0x3c, 
+	0x2f, 0x61, 0x3e, 0x2e, 0xa, 0x3c, 0x2f, 0x70, 0x3e, 0xa, 
+	0x3c, 0x70, 0x3e, 0xa, 0x44, 0x65, 0x74, 0x61, 0x69, 0x6c, 
+	0x73, 0x20, 0x6f, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x4f, 
+	0x70, 0x65, 0x6e, 0x20, 0x53, 0x6f, 0x75, 0x72, 0x63, 0x65, 
+	0x20, 0x6c, 0x77, 0x49, 0x50, 0x20, 0x54, 0x43, 0x50, 0x2f, 
+	0x49, 0x50, 0x20, 0x73, 0x74, 0x61, 0x63, 0x6b, 0x20, 0x63, 
+	0x61, 0x6e, 0x20, 0x62, 0x65, 0x20, 0x66, 0x6f, 0x75, 0x6e, 
+	0x64, 0x20, 0x61, 0x74, 0xa, 0x3c, 0x61, 0x20, 0x68, 0x72, 
+	0x65, 0x66, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 
+	0x2f, 0x77, 0x77, 0x77, 0x2e, 0x73, 0x69, 0x63, 0x73, 0x2e, 
 	0x73, 0x65, 0x2f, 0x7e, 0x61, 0x64, 0x61, 0x6d, 0x2f, 0x6c, 
-	0x77, 0x69, 0x70, 0x2f, 0x3c, 0x2f, 0x61, 0x3e, 0x2e, 0xa, 
-	0x3c, 0x70, 0x3e, 0xa, 0x54, 0x68, 0x65, 0x20, 0x63, 0x75, 
-	0x72, 0x72, 0x65, 0x6e, 0x74, 0x20, 0x49, 0x45, 0x45, 0x45, 
-	0x20, 0x31, 0x35, 0x38, 0x38, 0x20, 0x54, 0x69, 0x6d, 0x65, 
-	0x20, 0x28, 0x47, 0x4d, 0x54, 0x29, 0x20, 0x69, 0x73, 0x3a, 
-	0x20, 0x20, 0x57, 0x77, 0x77, 0x20, 0x4d, 0x6d, 0x6d, 0x20, 
-	0x44, 0x64, 0x2c, 0x20, 0x59, 0x79, 0x79, 0x79, 0x20, 0x20, 
-	0x48, 0x68, 0x3a, 0x4d, 0x6d, 0x3a, 0x53, 0x73, 0xa, 0x3c, 
-	0x70, 0x3e, 0xa, 0x54, 0x6f, 0x20, 0x72, 0x65, 0x74, 0x75, 
-	0x72, 0x6e, 0x20, 0x74, 0x6f, 0x20, 0x74, 0x68, 0x65, 0x20, 
-	0x6d, 0x61, 0x69, 0x6e, 0x20, 0x70, 0x61, 0x67, 0x65, 0x2c, 
-	0x20, 0x63, 0x6c, 0x69, 0x63, 0x6b, 0x20, 0x3c, 0x61, 0x20, 
-	0x68, 0x72, 0x65, 0x66, 0x3d, 0x22, 0x2e, 0x2f, 0x69, 0x6e, 
-	0x64, 0x65, 0x78, 0x2e, 0x68, 0x74, 0x6d, 0x6c, 0x22, 0x3e, 
-	0x68, 0x65, 0x72, 0x65, 0x3c, 0x2f, 0x61, 0x3e, 0x2e, 0xa, 
-	0x3c, 0x2f, 0x62, 0x6f, 0x64, 0x79, 0x3e, 0xa, 0x3c, 0x2f, 
-	0x68, 0x74, 0x6d, 0x6c, 0x3e, 0xa, 0xa, };
+	0x77, 0x69, 0x70, 0x2f, 0x22, 0x3e, 0x77, 0x77, 0x77, 0x2e, 
+	0x73, 0x69, 0x63, 0x73, 0x2e, 0x73, 0x65, 0x2f, 0x7e, 0x61, 
+	0x64, 0x61, 0x6d, 0x2f, 0x6c, 0x77, 0x69, 0x70, 0x2f, 0x3c, 
+	0x2f, 0x61, 0x3e, 0x2e, 0xa, 0x3c, 0x70, 0x3e, 0xa, 0x54, 
+	0x68, 0x65, 0x20, 0x63, 0x75, 0x72, 0x72, 0x65, 0x6e, 0x74, 
+	0x20, 0x49, 0x45, 0x45, 0x45, 0x20, 0x31, 0x35, 0x38, 0x38, 
+	0x20, 0x54, 0x69, 0x6d, 0x65, 0x20, 0x28, 0x47, 0x4d, 0x54, 
+	0x29, 0x20, 0x69, 0x73, 0x3a, 0x20, 0x20, 0x57, 0x77, 0x77, 
+	0x20, 0x4d, 0x6d, 0x6d, 0x20, 0x44, 0x64, 0x2c, 0x20, 0x59, 
+	0x79, 0x79, 0x79, 0x20, 0x20, 0x48, 0x68, 0x3a, 0x4d, 0x6d, 
+	0x3a, 0x53, 0x73, 0xa, 0x3c, 0x70, 0x3e, 0xa, 0x54, 0x6f, 
+	0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x74, 0x6f, 
+	0x20, 0x74, 0x68, 0x65, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x20, 
+	0x70, 0x61, 0x67, 0x65, 0x2c, 0x20, 0x63, 0x6c, 0x69, 0x63, 
+	0x6b, 0x20, 0x3c, 0x61, 0x20, 0x68, 0x72, 0x65, 0x66, 0x3d, 
+	0x22, 0x2e, 0x2f, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x2e, 0x68, 
+	0x74, 0x6d, 0x6c, 0x22, 0x3e, 0x68, 0x65, 0x72, 0x65, 0x3c, 
+	0x2f, 0x61, 0x3e, 0x2e, 0xa, 0x3c, 0x2f, 0x62, 0x6f, 0x64, 
+	0x79, 0x3e, 0xa, 0x3c, 0x2f, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 
+	0xa, 0xa, };
 
 static const unsigned char data_styles_css[] = {
 	/* /styles.css */
 	0x2f, 0x73, 0x74, 0x79, 0x6c, 0x65, 0x73, 0x2e, 0x63, 0x73, 0x73, 0,
-	0x48, 0x54, 0x54, 0x50, 0x2f, 0x31, 0x2e, 0x30, 0x20, 0x32, 
+	0x48, 0x54, 0x54, 0x50, 0x2f, 0x31, 0x2e, 0x31, 0x20, 0x32, 
 	0x30, 0x30, 0x20, 0x4f, 0x4b, 0xd, 0xa, 0x53, 0x65, 0x72, 
 	0x76, 0x65, 0x72, 0x3a, 0x20, 0x6c, 0x77, 0x49, 0x50, 0x2f, 
 	0x31, 0x2e, 0x32, 0x2e, 0x30, 0x20, 0x28, 0x68, 0x74, 0x74, 
@@ -291,7 +304,12 @@ static const unsigned char data_styles_css[] = {
 	0x6d, 0x2f, 0x6c, 0x77, 0x69, 0x70, 0x2f, 0x29, 0xd, 0xa, 
 	0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2d, 0x74, 0x79, 
 	0x70, 0x65, 0x3a, 0x20, 0x74, 0x65, 0x78, 0x74, 0x2f, 0x70, 
-	0x6c, 0x61, 0x69, 0x6e, 0xd, 0xa, 0xd, 0xa, 0x2f, 0x2a, 
+	0x6c, 0x61, 0x69, 0x6e, 0xd, 0xa, 0x43, 0x6f, 0x6e, 0x74, 
+	0x65, 0x6e, 0x74, 0x2d, 0x4c, 0x65, 0x6e, 0x67, 0x74, 0x68, 
+	0x3a, 0x20, 0x34, 0x33, 0x34, 0xd, 0xa, 0x43, 0x61, 0x63, 
+	0x68, 0x65, 0x2d, 0x43, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 
+	0x3a, 0x20, 0x6d, 0x61, 0x78, 0x2d, 0x61, 0x67, 0x65, 0x3d, 
+	0x33, 0x36, 0x30, 0x30, 0xd, 0xa, 0xd, 0xa, 0x2f, 0x2a, 
 	0xa, 0x20, 0x2a, 0x20, 0x43, 0x6f, 0x70, 0x79, 0x72, 0x69, 
 	0x67, 0x68, 0x74, 0x20, 0x28, 0x63, 0x29, 0x20, 0x32, 0x30, 
 	0x30, 0x37, 0x20, 0x4c, 0x75, 0x6d, 0x69, 0x6e, 0x61, 0x72, 
@@ -337,14 +355,48 @@ static const unsigned char data_styles_css[] = {
 	0x3a, 0x20, 0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x3b, 0xa, 
 	0x7d, 0xa, };
 
-const struct fsdata_file file_404_html[] = {{NULL, data_404_html, data_404_html + 10, sizeof(data_404_html) - 10}};
+const struct fsdata_file file_404_html[] = {{NULL, data_404_html, data_404_html + 10, sizeof(data_404_html) - 10, FS_FILE_FLAGS_LENGTH}};
 
-const struct fsdata_file file_index_html[] = {{file_404_html, data_index_html, data_index_html + 12, sizeof(data_index_html) - 12}};
+const struct fsdata_file file_index_html[] = {{file_404_html, data_index_html, data_index_html + 12, sizeof(data_index_html) - 12, FS_FILE_FLAGS_LENGTH}};
 
-const struct fsdata_file file_ptpclock_shtml[] = {{file_index_html, data_ptpclock_shtml, data_ptpclock_shtml + 16, sizeof(data_ptpclock_shtml) - 16}};
+const struct fsdata_file file_ptpclock_shtml[] = {{file_index_html, data_ptpclock_shtml, data_ptpclock_shtml + 16, sizeof(data_ptpclock_shtml) - 16, 0}};
 
-const struct fsdata_file file_styles_css[] = {{file_ptpclock_shtml, data_styles_css, data_styles_css + 12, sizeof(data_styles_css) - 12}};
+const struct fsdata_file file_styles_css[] = {{file_ptpclock_shtml, data_styles_css, data_styles_css + 12, sizeof(data_styles_css) - 12, FS_FILE_FLAGS_LENGTH}};
 
 #define FS_ROOT file_styles_css
 
 #define FS_NUMFILES 4
+
+#define FS_HASH_SEED 2
+
+#define FS_HASH_SIZE 8
+
+static const struct fsdata_file *const fs_hash[FS_HASH_SIZE] = {
+	file_ptpclock_shtml,
+	file_404_html,
+	file_styles_css,
+	file_index_html,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+};
+
+static const struct fsdata_file *
+fsdata_find(const char *name)
+{
+  const struct fsdata_file *f;
+  const char *p;
+  u32_t h;
+
+  h = FS_HASH_SEED;
+  for(p = name; *p != 0; p++) {
+    h = ((h << 5) + h) ^ (unsigned char)*p;
+  }
+  h ^= h >> 16;
+  f = fs_hash[h & (FS_HASH_SIZE - 1)];
+  if(f != NULL && strcmp(name, (const char *)f->name) == 0) {
+    return f;
+  }
+  return NULL;
+}
@@ -330,8 +330,6 @@ static const unsigned char g_pucRIT128x96x4Init[] =
 static void
 RITWriteCommand(const unsigned char *pucBuffer, unsigned long ulCount)
 {
-    unsigned long ulTemp;
-
     //
     // Return if SSI port is not enabled for RIT display.
     //
@@ -346,25 +344,11 @@ RITWriteCommand(const unsigned char *pucBuffer, unsigned long ulCount)
     GPIOPinWrite(GPIO_OLEDDC_BASE, GPIO_OLEDDC_PIN, 0);
 
     //
-    // Loop while there are more bytes left to be transferred.
+    // Write the bytes to the controller.  This returns once the data read
+    // back for the last byte has been drained from the receive FIFO, which
+    // times the GPIO signal.
     //
-    while(ulCount != 0)
-    {
-        //
-        // Write the next byte to the controller.
-        //
-        SSIDataPut(SSI0_BASE, *pucBuffer++);
-
-        //
-        // Dummy read to drain the fifo and time the GPIO signal.
-        //
-        SSIDataGet(SSI0_BASE, &ulTemp);
-
-        //
-        // Decrement the BYTE counter.
-        //
-        ulCount--;
-    }
+    SSIDataPutBlock(SSI0_BASE, pucBuffer, ulCount);
 }
 
 //*****************************************************************************
@@ -382,8 +366,6 @@ RITWriteCommand(const unsigned char *pucBuffer, unsigned long ulCount)
 static void
 RITWriteData(const unsigned char *pucBuffer, unsigned long ulCount)
 {
-    unsigned long ulTemp;
-
     //
     // Return if SSI port is not enabled for RIT display.
     //
@@ -398,25 +380,11 @@ RITWriteData(const unsigned char *pucBuffer, unsigned long ulCount)
     GPIOPinWrite(GPIO_OLEDDC_BASE, GPIO_OLEDDC_PIN, GPIO_OLEDDC_PIN);
 
     //
-    // Loop while there are more bytes left to be transferred.
+    // Write the bytes to the controller.  This returns once the data read
+    // back for the last byte has been drained from the receive FIFO, which
+    // times the GPIO signal.
     //
-    while(ulCount != 0)
-    {
-        //
-        // Write the next byte to the controller.
-        //
-        SSIDataPut(SSI0_BASE, *pucBuffer++);
-
-        //
-        // Dummy read to drain the fifo and time the GPIO signal.
-        //
-        SSIDataGet(SSI0_BASE, &ulTemp);
-
-        //
-        // Decrement the BYTE counter.
-        //
-        ulCount--;
-    }
+    SSIDataPutBlock(SSI0_BASE, pucBuffer, ulCount);
 }
 
 //*****************************************************************************
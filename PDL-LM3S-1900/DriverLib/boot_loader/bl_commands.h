@@ -177,6 +177,197 @@
 //*****************************************************************************
 #define COMMAND_RESET           0x25
 
+//*****************************************************************************
+//
+// This command should only follow a COMMAND_DOWNLOAD command, and switches the
+// boot loader into a streaming mode that transfers the remainder of the
+// download without a packet and a COMMAND_GET_STATUS for each block of data.
+// The command carries the block size (the number of data bytes in each frame,
+// transferred MSB first) and the window (the number of frames that the host
+// would like to send before waiting for an acknowledgement).  The boot loader
+// ACKs the command and then sends a packet containing the block size and
+// window that it accepted, which may be smaller than those requested (the
+// block size is limited by the STREAM_BUFFER_SIZE parameter and is always a
+// multiple of four, and the window is always one when using I2C).  An accepted
+// block size of zero indicates that no download is pending or that the stream
+// mode is not available, in which case the host should fall back to
+// COMMAND_SEND_DATA.
+//
+// The format of the command is as follows:
+//
+//     unsigned char ucCommand[4];
+//
+//     ucCommand[0] = COMMAND_SEND_DATA_STREAM;
+//     ucCommand[1] = Block Size [15:8];
+//     ucCommand[2] = Block Size [7:0];
+//     ucCommand[3] = Window;
+//
+// The format of the response packet is as follows:
+//
+//     unsigned char ucResponse[3];
+//
+//     ucResponse[0] = Accepted Block Size [15:8];
+//     ucResponse[1] = Accepted Block Size [7:0];
+//     ucResponse[2] = Accepted Window;
+//
+// The data is then sent as a sequence of frames, with the first frame having a
+// sequence number of one and the sequence number wrapping from 255 back to
+// one (zero is never used, and zero bytes between frames are ignored).  Each
+// frame holds a full block of data, except the last one which holds whatever
+// remains of the download, so the length of a frame is not sent.  The
+// checksum is the 8-bit sum of the data bytes and the sequence number.
+//
+//     unsigned char ucFrame[Block Size + 2];
+//
+//     ucFrame[0] = Sequence Number;
+//     ucFrame[1] = Checksum;
+//     ucFrame[2] = Data[0];
+//     ...
+//
+// The host may have up to the accepted window of frames outstanding.  The
+// boot loader answers each frame with two bytes; COMMAND_ACK followed by the
+// sequence number of the frame once it has been received intact and in order,
+// or COMMAND_NAK followed by the sequence number of the frame that it expects
+// next.  Only one NAK is sent for each lost frame, and frames are discarded
+// until the expected frame arrives, so the host must then send Block Size + 2
+// zero bytes (to complete any frame that the boot loader has misread) before
+// resending that frame and all of those that followed it.  The boot loader
+// programs each frame while receiving the next one, so the download is
+// complete once every frame has been acknowledged; the host should then send
+// a COMMAND_GET_STATUS command to ensure that all of the data was successfully
+// programmed into the flash.
+//
+//*****************************************************************************
+#define COMMAND_SEND_DATA_STREAM 0x26
+
+//*****************************************************************************
+//
+// This command computes the CRC-32 of a range of the flash, allowing the host
+// to check that an image was programmed correctly without reading it back.
+// The CRC is the same one used by Ethernet and zlib (polynomial 0x04c11db7,
+// bit reversed, with an initial value and final exclusive-or of 0xffffffff).
+// The boot loader ACKs the command and then sends a packet containing the
+// CRC; if the command or the range is invalid, a CRC of zero is sent and the
+// status is set accordingly.  This command is only available if the boot
+// loader was built with ENABLE_VERIFY.
+//
+// The format of the command is as follows:
+//
+//     unsigned char ucCommand[9];
+//
+//     ucCommand[0] = COMMAND_VERIFY;
+//     ucCommand[1] = Address [31:24];
+//     ucCommand[2] = Address [23:16];
+//     ucCommand[3] = Address [15:8];
+//     ucCommand[4] = Address [7:0];
+//     ucCommand[5] = Size [31:24];
+//     ucCommand[6] = Size [23:16];
+//     ucCommand[7] = Size [15:8];
+//     ucCommand[8] = Size [7:0];
+//
+// The format of the response packet is as follows:
+//
+//     unsigned char ucResponse[4];
+//
+//     ucResponse[0] = CRC [31:24];
+//     ucResponse[1] = CRC [23:16];
+//     ucResponse[2] = CRC [15:8];
+//     ucResponse[3] = CRC [7:0];
+//
+//*****************************************************************************
+#define COMMAND_VERIFY          0x27
+
+//*****************************************************************************
+//
+// This command gives the CRC-32 (as computed by COMMAND_VERIFY) of each 1 KB
+// page of the new image, starting at a page-aligned address within the
+// application area.  The boot loader compares each CRC with that of the page
+// that is already in the flash, and marks the pages that match as unchanged.
+// It ACKs the command and then sends a packet with one bit per page given (bit
+// 0 of the first byte for the first page), where a set bit indicates that the
+// page is unchanged.  This command is only available if the boot loader was
+// built with ENABLE_DELTA_UPDATE.
+//
+// The following COMMAND_DOWNLOAD to APP_START_ADDRESS neither erases nor
+// programs the pages that are marked as unchanged.  The host must send only
+// the data for the pages that have changed, in order (in other words, the
+// image with the unchanged pages removed), using either COMMAND_SEND_DATA or
+// COMMAND_SEND_DATA_STREAM.  The marks are forgotten once all of the data has
+// been received, if the COMMAND_DOWNLOAD fails, or if a COMMAND_DOWNLOAD is
+// sent for another address.
+//
+// The format of the command is as follows:
+//
+//     unsigned char ucCommand[5 + (4 * Pages)];
+//
+//     ucCommand[0] = COMMAND_PAGE_CRC;
+//     ucCommand[1] = Address [31:24];
+//     ucCommand[2] = Address [23:16];
+//     ucCommand[3] = Address [15:8];
+//     ucCommand[4] = Address [7:0];
+//     ucCommand[5] = Page 0 CRC [31:24];
+//     ucCommand[6] = Page 0 CRC [23:16];
+//     ucCommand[7] = Page 0 CRC [15:8];
+//     ucCommand[8] = Page 0 CRC [7:0];
+//     ...
+//
+// The number of pages in each command is limited by the size of the receive
+// buffer in the boot loader (as configured by the BUFFER_SIZE parameter).  The
+// format of the response packet is as follows:
+//
+//     unsigned char ucResponse[(Pages + 7) / 8];
+//
+//     ucResponse[0] = Unchanged flags for pages 7 through 0;
+//     ...
+//
+//*****************************************************************************
+#define COMMAND_PAGE_CRC        0x28
+
+//*****************************************************************************
+//
+// This command starts a download in the same way as COMMAND_DOWNLOAD, except
+// that the data that follows (sent with COMMAND_SEND_DATA or
+// COMMAND_SEND_DATA_STREAM) is compressed.  The size is that of the image
+// once it has been decompressed, and the compressed size is the number of
+// bytes of compressed data that the host will send.  If the image does not
+// decompress to exactly the given size, the status is set to
+// COMMAND_RET_FLASH_FAIL once all of the compressed data has been received.
+// This command is only available if the boot loader was built with
+// LZ_WINDOW_SIZE.
+//
+// The compressed data is a sequence of groups, each consisting of a flag byte
+// followed by eight items (the final group may have fewer).  Bit 0 of the flag
+// byte describes the first item, and so on.  If the bit is one, the item is a
+// single byte that is copied to the image.  If the bit is zero, the item is a
+// two byte match which copies Length bytes from Offset bytes back in the image
+// (where Length is from 3 to 18 and Offset is from 1 to LZ_WINDOW_SIZE):
+//
+//     unsigned char ucMatch[2];
+//
+//     ucMatch[0] = (Offset - 1) [11:4];
+//     ucMatch[1] = ((Offset - 1) [3:0] << 4) | (Length - 3);
+//
+// The format of the command is as follows:
+//
+//     unsigned char ucCommand[13];
+//
+//     ucCommand[0] = COMMAND_DOWNLOAD_COMPRESSED;
+//     ucCommand[1] = Program Address [31:24];
+//     ucCommand[2] = Program Address [23:16];
+//     ucCommand[3] = Program Address [15:8];
+//     ucCommand[4] = Program Address [7:0];
+//     ucCommand[5] = Program Size [31:24];
+//     ucCommand[6] = Program Size [23:16];
+//     ucCommand[7] = Program Size [15:8];
+//     ucCommand[8] = Program Size [7:0];
+//     ucCommand[9] = Compressed Size [31:24];
+//     ucCommand[10] = Compressed Size [23:16];
+//     ucCommand[11] = Compressed Size [15:8];
+//     ucCommand[12] = Compressed Size [7:0];
+//
+//*****************************************************************************
+#define COMMAND_DOWNLOAD_COMPRESSED 0x29
+
 //*****************************************************************************
 //
 // This is returned in response to a COMMAND_GET_STATUS command and indicates
@@ -0,0 +1,1012 @@
+//*****************************************************************************
+//
+// bl_enet.c - Functions to update via Ethernet, using BOOTP and TFTP.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+#include "../hw_ethernet.h"
+#include "../hw_flash.h"
+#include "../hw_memmap.h"
+#include "../hw_nvic.h"
+#include "../hw_sysctl.h"
+#include "../hw_types.h"
+#include "bl_config.h"
+#include "bl_enet.h"
+#include "bl_flash.h"
+
+//*****************************************************************************
+//
+//! \addtogroup boot_loader_api
+//! @{
+//
+//*****************************************************************************
+#if defined(ENET_ENABLE_UPDATE) || defined(DOXYGEN)
+
+//*****************************************************************************
+//
+// Make sure that the crystal frequency is known, since it is needed to time
+// out requests and to clock the PHY management interface.
+//
+//*****************************************************************************
+#ifndef CRYSTAL_FREQ
+#error ERROR: CRYSTAL_FREQ must be defined for Ethernet update!
+#endif
+
+//*****************************************************************************
+//
+// The offsets of the fields of a frame within the packet buffers.  The frame
+// is preceded by the two byte length that is read from (or written to) the
+// MAC FIFO along with it, so that the IP header and the data of BOOTP and
+// TFTP packets are word aligned.
+//
+//*****************************************************************************
+#define ENET_ETH_DEST           2
+#define ENET_ETH_SRC            8
+#define ENET_ETH_TYPE           14
+#define ENET_IP                 16
+#define ENET_UDP                36
+#define ENET_DATA               44
+
+//*****************************************************************************
+//
+// The offsets of the fields of an ARP packet, within the packet buffers.
+//
+//*****************************************************************************
+#define ENET_ARP_OP             (ENET_IP + 6)
+#define ENET_ARP_SHA            (ENET_IP + 8)
+#define ENET_ARP_SPA            (ENET_IP + 14)
+#define ENET_ARP_THA            (ENET_IP + 18)
+#define ENET_ARP_TPA            (ENET_IP + 24)
+
+//*****************************************************************************
+//
+// The offsets of the fields of a BOOTP packet, from the start of the UDP
+// data, and the size of a BOOTP packet.
+//
+//*****************************************************************************
+#define BOOTP_OP                0
+#define BOOTP_XID               4
+#define BOOTP_FLAGS             10
+#define BOOTP_YIADDR            16
+#define BOOTP_SIADDR            20
+#define BOOTP_CHADDR            28
+#define BOOTP_FILE              108
+#define BOOTP_VEND              236
+#define BOOTP_SIZE              300
+
+//*****************************************************************************
+//
+// The TFTP opcodes.
+//
+//*****************************************************************************
+#define TFTP_RRQ                1
+#define TFTP_DATA               3
+#define TFTP_ACK                4
+#define TFTP_ERROR              5
+
+//*****************************************************************************
+//
+// The size of the packet buffers.  The receive buffer holds the largest
+// Ethernet frame, along with its length and FCS, and the transmit buffer holds
+// the largest packet that is sent (a BOOTP request).
+//
+//*****************************************************************************
+#define ENET_RX_SIZE            1520
+#define ENET_TX_SIZE            (ENET_DATA + BOOTP_SIZE)
+
+//*****************************************************************************
+//
+// The number of timer ticks per second, the number of ticks to wait for a
+// response before resending a request, and the number of times that a TFTP
+// request is resent before starting again with BOOTP.
+//
+//*****************************************************************************
+#define ENET_TICKS_PER_SECOND   10
+#define ENET_TIMEOUT            10
+#define ENET_RETRIES            8
+
+//*****************************************************************************
+//
+// Reads and writes 16-bit values in network byte order.
+//
+//*****************************************************************************
+#define ENET_GET16(pucData)                                                   \
+        (((unsigned long)(pucData)[0] << 8) | (pucData)[1])
+#define ENET_PUT16(pucData, ulValue)                                          \
+        do                                                                    \
+        {                                                                     \
+            (pucData)[0] = (unsigned char)((ulValue) >> 8);                   \
+            (pucData)[1] = (unsigned char)(ulValue);                          \
+        }                                                                     \
+        while(0)
+
+//*****************************************************************************
+//
+// The packet buffers, and byte pointers to them.
+//
+//*****************************************************************************
+static unsigned long g_pulEnetRx[ENET_RX_SIZE / 4];
+static unsigned long g_pulEnetTx[(ENET_TX_SIZE + 3) / 4];
+#define g_pucEnetRx             ((unsigned char *)g_pulEnetRx)
+#define g_pucEnetTx             ((unsigned char *)g_pulEnetTx)
+
+//*****************************************************************************
+//
+// The MAC address of this device and of the TFTP server, the IP addresses of
+// this device and of the TFTP server, and a flag that is set once the MAC
+// address of the TFTP server is known.
+//
+//*****************************************************************************
+static unsigned char g_pucEnetMAC[6];
+static unsigned char g_pucEnetServerMAC[6];
+static unsigned char g_pucEnetIP[4];
+static unsigned char g_pucEnetServerIP[4];
+static tBoolean g_bEnetServerMAC;
+
+//*****************************************************************************
+//
+// The transaction ID of the BOOTP request, the name of the file to be read by
+// TFTP, the UDP port from which the TFTP server is sending the file, and the
+// number of the last TFTP block that was received.
+//
+//*****************************************************************************
+static unsigned long g_ulBOOTPXid;
+static unsigned char g_pucTFTPFile[128];
+static unsigned long g_ulTFTPPort;
+static unsigned long g_ulTFTPBlock;
+
+//*****************************************************************************
+//
+// The number of timer ticks that have occurred, and the IP identification of
+// the next packet to be sent.
+//
+//*****************************************************************************
+static unsigned long g_ulEnetTicks;
+static unsigned long g_ulEnetIPID;
+
+//*****************************************************************************
+//
+// The flash address at which the next data is programmed, the address up to
+// which the flash has been erased, and the first two words of the image (the
+// initial stack pointer and reset vector), which are programmed only once the
+// rest of the image has been received so that a partial image is never
+// mistaken for a valid application.
+//
+//*****************************************************************************
+static unsigned long g_ulEnetAddress;
+static unsigned long g_ulEnetErased;
+static unsigned long g_pulEnetVectors[2];
+
+//*****************************************************************************
+//
+// The broadcast Ethernet (and IP) address, and an all zero address.
+//
+//*****************************************************************************
+static const unsigned char g_pucEnetBroadcast[6] =
+{
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+};
+static const unsigned char g_pucEnetZero[6] =
+{
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+//*****************************************************************************
+//
+// Copies bytes from one buffer to another.
+//
+//*****************************************************************************
+static void
+EnetCopy(unsigned char *pucDest, const unsigned char *pucSrc,
+         unsigned long ulCount)
+{
+    while(ulCount--)
+    {
+        *pucDest++ = *pucSrc++;
+    }
+}
+
+//*****************************************************************************
+//
+// Compares two buffers, returning zero if they are the same.
+//
+//*****************************************************************************
+static unsigned long
+EnetCompare(const unsigned char *pucA, const unsigned char *pucB,
+            unsigned long ulCount)
+{
+    while(ulCount--)
+    {
+        if(*pucA++ != *pucB++)
+        {
+            return(1);
+        }
+    }
+    return(0);
+}
+
+//*****************************************************************************
+//
+// Counts the ticks of the SysTick timer, returning the number of ticks that
+// have occurred.
+//
+//*****************************************************************************
+static unsigned long
+EnetTicks(void)
+{
+    //
+    // The count flag is set (and cleared by the read) each time that the timer
+    // wraps.
+    //
+    if(HWREG(NVIC_ST_CTRL) & NVIC_ST_CTRL_COUNT)
+    {
+        g_ulEnetTicks++;
+    }
+    return(g_ulEnetTicks);
+}
+
+//*****************************************************************************
+//
+// Writes the frame in the transmit buffer to the MAC.  The length is the
+// number of bytes in the frame, starting with the destination address.
+//
+//*****************************************************************************
+static void
+EnetSend(unsigned long ulLength)
+{
+    unsigned long ulIdx;
+
+    //
+    // The FIFO starts with the length of the frame, not counting the header.
+    //
+    g_pucEnetTx[0] = (ulLength - 14) & 0xff;
+    g_pucEnetTx[1] = (ulLength - 14) >> 8;
+
+    //
+    // Wait until the previous frame has been transmitted.
+    //
+    while(HWREG(ETH_BASE + MAC_O_TR) & MAC_TR_NEWTX)
+    {
+    }
+
+    //
+    // Write the frame to the FIFO and start the transmission.
+    //
+    for(ulIdx = 0; ulIdx < (ulLength + 2); ulIdx += 4)
+    {
+        HWREG(ETH_BASE + MAC_O_DATA) = g_pulEnetTx[ulIdx / 4];
+    }
+    HWREG(ETH_BASE + MAC_O_TR) = MAC_TR_NEWTX;
+}
+
+//*****************************************************************************
+//
+// Sends a UDP packet whose data has been placed in the transmit buffer.
+//
+//*****************************************************************************
+static void
+EnetUDPSend(const unsigned char *pucMAC, const unsigned char *pucIP,
+            unsigned long ulSrcPort, unsigned long ulDestPort,
+            unsigned long ulLength)
+{
+    unsigned char *pucTx = g_pucEnetTx;
+    unsigned long ulIdx, ulSum;
+
+    //
+    // Fill in the Ethernet header.
+    //
+    EnetCopy(pucTx + ENET_ETH_DEST, pucMAC, 6);
+    EnetCopy(pucTx + ENET_ETH_SRC, g_pucEnetMAC, 6);
+    ENET_PUT16(pucTx + ENET_ETH_TYPE, 0x0800);
+
+    //
+    // Fill in the IP header.  The packet is never fragmented, and the UDP
+    // checksum is not used.
+    //
+    pucTx[ENET_IP] = 0x45;
+    pucTx[ENET_IP + 1] = 0;
+    ENET_PUT16(pucTx + ENET_IP + 2, ulLength + 28);
+    ENET_PUT16(pucTx + ENET_IP + 4, g_ulEnetIPID++);
+    ENET_PUT16(pucTx + ENET_IP + 6, 0);
+    pucTx[ENET_IP + 8] = 64;
+    pucTx[ENET_IP + 9] = 17;
+    ENET_PUT16(pucTx + ENET_IP + 10, 0);
+    EnetCopy(pucTx + ENET_IP + 12, g_pucEnetIP, 4);
+    EnetCopy(pucTx + ENET_IP + 16, pucIP, 4);
+    ENET_PUT16(pucTx + ENET_UDP, ulSrcPort);
+    ENET_PUT16(pucTx + ENET_UDP + 2, ulDestPort);
+    ENET_PUT16(pucTx + ENET_UDP + 4, ulLength + 8);
+    ENET_PUT16(pucTx + ENET_UDP + 6, 0);
+
+    //
+    // Compute the IP header checksum.
+    //
+    for(ulIdx = 0, ulSum = 0; ulIdx < 20; ulIdx += 2)
+    {
+        ulSum += ENET_GET16(pucTx + ENET_IP + ulIdx);
+    }
+    ulSum = (ulSum & 0xffff) + (ulSum >> 16);
+    ulSum += ulSum >> 16;
+    ENET_PUT16(pucTx + ENET_IP + 10, ~ulSum);
+
+    //
+    // Send the packet.
+    //
+    EnetSend(ENET_DATA - 2 + ulLength);
+}
+
+//*****************************************************************************
+//
+// Sends an ARP packet.  A request is broadcast, while a reply is sent to the
+// target hardware address.
+//
+//*****************************************************************************
+static void
+EnetARPSend(unsigned long ulOp, const unsigned char *pucTHA,
+            const unsigned char *pucTPA)
+{
+    unsigned char *pucTx = g_pucEnetTx;
+
+    //
+    // Fill in the Ethernet header.
+    //
+    EnetCopy(pucTx + ENET_ETH_DEST,
+             (ulOp == 1) ? g_pucEnetBroadcast : pucTHA, 6);
+    EnetCopy(pucTx + ENET_ETH_SRC, g_pucEnetMAC, 6);
+    ENET_PUT16(pucTx + ENET_ETH_TYPE, 0x0806);
+
+    //
+    // Fill in the ARP packet for an IP address on Ethernet.
+    //
+    ENET_PUT16(pucTx + ENET_IP, 1);
+    ENET_PUT16(pucTx + ENET_IP + 2, 0x0800);
+    pucTx[ENET_IP + 4] = 6;
+    pucTx[ENET_IP + 5] = 4;
+    ENET_PUT16(pucTx + ENET_ARP_OP, ulOp);
+    EnetCopy(pucTx + ENET_ARP_SHA, g_pucEnetMAC, 6);
+    EnetCopy(pucTx + ENET_ARP_SPA, g_pucEnetIP, 4);
+    EnetCopy(pucTx + ENET_ARP_THA, pucTHA, 6);
+    EnetCopy(pucTx + ENET_ARP_TPA, pucTPA, 4);
+
+    //
+    // Send the packet.
+    //
+    EnetSend(42);
+}
+
+//*****************************************************************************
+//
+// Handles a received ARP packet, answering requests for this device's IP
+// address and noting the MAC address of the TFTP server.
+//
+//*****************************************************************************
+static void
+EnetARPReceive(void)
+{
+    unsigned char *pucRx = g_pucEnetRx;
+
+    //
+    // Ignore the packet unless it is for an IP address on Ethernet and this
+    // device has an IP address.
+    //
+    if((ENET_GET16(pucRx + ENET_IP) != 1) ||
+       (ENET_GET16(pucRx + ENET_IP + 2) != 0x0800) ||
+       !EnetCompare(g_pucEnetIP, g_pucEnetZero, 4))
+    {
+        return;
+    }
+
+    //
+    // Answer a request for this device's IP address.
+    //
+    if((ENET_GET16(pucRx + ENET_ARP_OP) == 1) &&
+       !EnetCompare(pucRx + ENET_ARP_TPA, g_pucEnetIP, 4))
+    {
+        EnetARPSend(2, pucRx + ENET_ARP_SHA, pucRx + ENET_ARP_SPA);
+    }
+
+    //
+    // Note the MAC address of the TFTP server when it is seen.
+    //
+    if(!EnetCompare(pucRx + ENET_ARP_SPA, g_pucEnetServerIP, 4))
+    {
+        EnetCopy(g_pucEnetServerMAC, pucRx + ENET_ARP_SHA, 6);
+        g_bEnetServerMAC = true;
+    }
+}
+
+//*****************************************************************************
+//
+// Receives a UDP packet sent to the given port, handling any ARP packets that
+// are received along the way.  Returns the length of the UDP data, which is
+// at ENET_DATA in the receive buffer, or -1 if no such packet was received.
+//
+//*****************************************************************************
+static long
+EnetUDPReceive(unsigned long ulPort)
+{
+    unsigned char *pucRx = g_pucEnetRx;
+    unsigned long ulLength, ulData, ulIdx;
+
+    //
+    // Do nothing if there is no frame in the receive FIFO.
+    //
+    if(!(HWREG(ETH_BASE + MAC_O_NP) & MAC_NP_NPR_M))
+    {
+        return(-1);
+    }
+
+    //
+    // Read the frame from the FIFO.  The first word holds the length of the
+    // frame (including the length itself and the FCS).  The excess of a frame
+    // that is too large for the buffer is discarded.
+    //
+    g_pulEnetRx[0] = HWREG(ETH_BASE + MAC_O_DATA);
+    ulLength = g_pulEnetRx[0] & 0xffff;
+    for(ulIdx = 4; ulIdx < ulLength; ulIdx += 4)
+    {
+        ulData = HWREG(ETH_BASE + MAC_O_DATA);
+        if(ulIdx < ENET_RX_SIZE)
+        {
+            g_pulEnetRx[ulIdx / 4] = ulData;
+        }
+    }
+    if((ulLength > ENET_RX_SIZE) || (ulLength < (ENET_DATA + 4)))
+    {
+        return(-1);
+    }
+
+    //
+    // Handle ARP packets.
+    //
+    if(ENET_GET16(pucRx + ENET_ETH_TYPE) == 0x0806)
+    {
+        EnetARPReceive();
+        return(-1);
+    }
+
+    //
+    // Ignore anything but an unfragmented UDP packet (without IP options) to
+    // the requested port.
+    //
+    if((ENET_GET16(pucRx + ENET_ETH_TYPE) != 0x0800) ||
+       (pucRx[ENET_IP] != 0x45) || (pucRx[ENET_IP + 9] != 17) ||
+       (ENET_GET16(pucRx + ENET_IP + 6) & 0x3fff) ||
+       (ENET_GET16(pucRx + ENET_UDP + 2) != ulPort))
+    {
+        return(-1);
+    }
+
+    //
+    // Return the length of the UDP data, provided that it fits in the frame.
+    //
+    ulData = ENET_GET16(pucRx + ENET_UDP + 4);
+    if((ulData < 8) || (ulData > (ulLength - ENET_UDP - 4)))
+    {
+        return(-1);
+    }
+    return(ulData - 8);
+}
+
+//*****************************************************************************
+//
+// Sends a BOOTP request.
+//
+//*****************************************************************************
+static void
+BOOTPRequest(void)
+{
+    unsigned char *pucData = g_pucEnetTx + ENET_DATA;
+    unsigned long ulIdx;
+
+    //
+    // Clear the request.
+    //
+    for(ulIdx = 0; ulIdx < BOOTP_SIZE; ulIdx++)
+    {
+        pucData[ulIdx] = 0;
+    }
+
+    //
+    // Fill in a request for an Ethernet address, asking for the reply to be
+    // broadcast since this device can not answer an ARP request yet.
+    //
+    pucData[BOOTP_OP] = 1;
+    pucData[BOOTP_OP + 1] = 1;
+    pucData[BOOTP_OP + 2] = 6;
+    EnetCopy(pucData + BOOTP_XID, (unsigned char *)&g_ulBOOTPXid, 4);
+    pucData[BOOTP_FLAGS] = 0x80;
+    EnetCopy(pucData + BOOTP_CHADDR, g_pucEnetMAC, 6);
+
+    //
+    // Add the magic cookie that starts the vendor area, followed by the end
+    // option.
+    //
+    pucData[BOOTP_VEND] = 99;
+    pucData[BOOTP_VEND + 1] = 130;
+    pucData[BOOTP_VEND + 2] = 83;
+    pucData[BOOTP_VEND + 3] = 99;
+    pucData[BOOTP_VEND + 4] = 255;
+
+    //
+    // Broadcast the request.
+    //
+    EnetUDPSend(g_pucEnetBroadcast, g_pucEnetBroadcast, BOOTP_CLIENT_PORT,
+                BOOTP_SERVER_PORT, BOOTP_SIZE);
+}
+
+//*****************************************************************************
+//
+// Checks a received BOOTP packet to see if it is the reply to the request,
+// saving the assigned IP address, the address of the TFTP server, and the
+// name of the file to be loaded.  Returns true if it was the reply.
+//
+//*****************************************************************************
+static tBoolean
+BOOTPReply(long lLength)
+{
+    unsigned char *pucData = g_pucEnetRx + ENET_DATA;
+
+    //
+    // Ignore anything but a reply to this device's request.
+    //
+    if((lLength < BOOTP_VEND) || (pucData[BOOTP_OP] != 2) ||
+       EnetCompare(pucData + BOOTP_XID, (unsigned char *)&g_ulBOOTPXid, 4) ||
+       EnetCompare(pucData + BOOTP_CHADDR, g_pucEnetMAC, 6))
+    {
+        return(false);
+    }
+
+    //
+    // Save the assigned IP address, the address of the TFTP server (which
+    // is the BOOTP server if no other server was given), and the file name.
+    //
+    EnetCopy(g_pucEnetIP, pucData + BOOTP_YIADDR, 4);
+    EnetCopy(g_pucEnetServerIP, pucData + BOOTP_SIADDR, 4);
+    if(!EnetCompare(g_pucEnetServerIP, g_pucEnetZero, 4))
+    {
+        EnetCopy(g_pucEnetServerIP, g_pucEnetRx + ENET_IP + 12, 4);
+    }
+    EnetCopy(g_pucTFTPFile, pucData + BOOTP_FILE, sizeof(g_pucTFTPFile));
+    g_pucTFTPFile[sizeof(g_pucTFTPFile) - 1] = 0;
+
+    //
+    // This was the reply.
+    //
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Sends the TFTP read request for the file, or the acknowledgement of the
+// last block of the file that was received.
+//
+//*****************************************************************************
+static void
+TFTPSend(void)
+{
+    unsigned char *pucData = g_pucEnetTx + ENET_DATA;
+    unsigned long ulLength;
+
+    //
+    // Send an acknowledgement once the first block has been received.
+    //
+    if(g_ulTFTPBlock)
+    {
+        ENET_PUT16(pucData, TFTP_ACK);
+        ENET_PUT16(pucData + 2, g_ulTFTPBlock);
+        EnetUDPSend(g_pucEnetServerMAC, g_pucEnetServerIP, TFTP_CLIENT_PORT,
+                    g_ulTFTPPort, 4);
+        return;
+    }
+
+    //
+    // Otherwise, send a request to read the file in binary mode.
+    //
+    ENET_PUT16(pucData, TFTP_RRQ);
+    for(ulLength = 2; g_pucTFTPFile[ulLength - 2]; ulLength++)
+    {
+        pucData[ulLength] = g_pucTFTPFile[ulLength - 2];
+    }
+    EnetCopy(pucData + ulLength, (const unsigned char *)"\0octet", 7);
+    EnetUDPSend(g_pucEnetServerMAC, g_pucEnetServerIP, TFTP_CLIENT_PORT,
+                TFTP_SERVER_PORT, ulLength + 7);
+}
+
+//*****************************************************************************
+//
+// Programs a block of the image into the flash, erasing each flash block as
+// it is reached.  Returns zero on success and non-zero if the image is too
+// large or the flash could not be erased or programmed.
+//
+//*****************************************************************************
+static unsigned long
+TFTPProgram(unsigned long *pulData, unsigned long ulLength)
+{
+    unsigned long ulFlashSize;
+
+    //
+    // Determine the end of the space available for the application.
+    //
+    ulFlashSize = (((HWREG(SYSCTL_DC0) & SYSCTL_DC0_FLASHSZ_M) + 1) << 11);
+#ifdef FLASH_RSVD_SPACE
+    ulFlashSize -= FLASH_RSVD_SPACE;
+#endif
+
+    //
+    // Fail if the image does not fit.
+    //
+    if((g_ulEnetAddress + ulLength) > ulFlashSize)
+    {
+        return(1);
+    }
+
+    //
+    // This function is a stub to show where to insert a function to decrypt
+    // the data as it is received.
+    //
+#ifdef ENABLE_DECRYPTION
+    DecryptData((unsigned char *)pulData, ulLength);
+#endif
+
+    //
+    // Erase the flash blocks that the data reaches.
+    //
+    while(g_ulEnetErased < (g_ulEnetAddress + ulLength))
+    {
+        if(EraseBlocks(g_ulEnetErased, g_ulEnetErased + 0x400))
+        {
+            return(1);
+        }
+        g_ulEnetErased += 0x400;
+    }
+
+    //
+    // Hold back the initial stack pointer and reset vector until the rest of
+    // the image has been programmed.
+    //
+    if(g_ulEnetAddress == APP_START_ADDRESS)
+    {
+        g_pulEnetVectors[0] = pulData[0];
+        g_pulEnetVectors[1] = pulData[1];
+        pulData[0] = 0xffffffff;
+        pulData[1] = 0xffffffff;
+    }
+
+    //
+    // Program the data.
+    //
+    if(ProgramFlash(pulData, g_ulEnetAddress, ulLength))
+    {
+        return(1);
+    }
+    g_ulEnetAddress += ulLength;
+
+    //
+    // Success.
+    //
+    return(0);
+}
+
+//*****************************************************************************
+//
+// Reads the image from the TFTP server and programs it into the flash.
+// Returns only if the transfer fails.
+//
+//*****************************************************************************
+static void
+TFTPRead(void)
+{
+    unsigned char *pucData = g_pucEnetRx + ENET_DATA;
+    unsigned long ulStart, ulRetries, ulBlock;
+    long lLength;
+
+    //
+    // Start at the beginning of the application area.  If protecting the
+    // code, erase the entire application area now rather than as each block
+    // is reached.
+    //
+    g_ulEnetAddress = APP_START_ADDRESS;
+    g_ulEnetErased = APP_START_ADDRESS;
+    g_ulTFTPBlock = 0;
+    g_ulTFTPPort = TFTP_SERVER_PORT;
+#ifdef FLASH_CODE_PROTECTION
+    g_ulEnetErased = (((HWREG(SYSCTL_DC0) & SYSCTL_DC0_FLASHSZ_M) + 1) << 11);
+#ifdef FLASH_RSVD_SPACE
+    g_ulEnetErased -= FLASH_RSVD_SPACE;
+#endif
+    if(EraseBlocks(APP_START_ADDRESS, g_ulEnetErased))
+    {
+        return;
+    }
+#endif
+
+    //
+    // Send the read request, and then resend the last request or
+    // acknowledgement each time that the server fails to answer.
+    //
+    for(ulRetries = 0; ulRetries < ENET_RETRIES; ulRetries++)
+    {
+        TFTPSend();
+        ulStart = EnetTicks();
+        while((EnetTicks() - ulStart) < ENET_TIMEOUT)
+        {
+            //
+            // Wait for a packet from the server.
+            //
+            lLength = EnetUDPReceive(TFTP_CLIENT_PORT);
+            if((lLength < 4) ||
+               EnetCompare(g_pucEnetRx + ENET_IP + 12, g_pucEnetServerIP, 4))
+            {
+                continue;
+            }
+
+            //
+            // Give up if the server reports an error.
+            //
+            if(ENET_GET16(pucData) == TFTP_ERROR)
+            {
+                return;
+            }
+
+            //
+            // Ignore anything else but data.  The first data block gives the
+            // port from which the server sends the file, and later blocks
+            // must come from the same port.
+            //
+            ulBlock = ENET_GET16(pucData + 2);
+            if((ENET_GET16(pucData) != TFTP_DATA) ||
+               (g_ulTFTPBlock &&
+                (ENET_GET16(g_pucEnetRx + ENET_UDP) != g_ulTFTPPort)))
+            {
+                continue;
+            }
+
+            //
+            // Acknowledge a repeat of the last block again, since the
+            // acknowledgement must have been lost.
+            //
+            if(g_ulTFTPBlock && (ulBlock == g_ulTFTPBlock))
+            {
+                TFTPSend();
+                continue;
+            }
+
+            //
+            // Ignore anything but the next block.
+            //
+            if(ulBlock != ((g_ulTFTPBlock + 1) & 0xffff))
+            {
+                continue;
+            }
+
+            //
+            // Acknowledge the block straight away so that the server sends
+            // the next block while this one is being programmed.
+            //
+            g_ulTFTPPort = ENET_GET16(g_pucEnetRx + ENET_UDP);
+            g_ulTFTPBlock = ulBlock;
+            TFTPSend();
+            ulRetries = 0;
+            ulStart = EnetTicks();
+
+            //
+            // Program the block.
+            //
+            if(TFTPProgram((unsigned long *)(pucData + 4), lLength - 4))
+            {
+                return;
+            }
+
+            //
+            // A short block is the end of the file.  Program the vectors
+            // that were held back and wait for the acknowledgement to be
+            // sent.
+            //
+            if((lLength - 4) < TFTP_BLOCK_SIZE)
+            {
+                if((g_ulEnetAddress == APP_START_ADDRESS) ||
+                   ProgramFlash(g_pulEnetVectors, APP_START_ADDRESS, 8))
+                {
+                    return;
+                }
+                while(HWREG(ETH_BASE + MAC_O_TR) & MAC_TR_NEWTX)
+                {
+                }
+
+                //
+                // Reset the device to start the new application.
+                //
+                HWREG(NVIC_APINT) = (NVIC_APINT_VECTKEY |
+                                     NVIC_APINT_SYSRESETREQ);
+
+                //
+                // The microcontroller should have reset, so this should
+                // never be reached.  Just in case, loop forever.
+                //
+                while(1)
+                {
+                }
+            }
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! Configures the Ethernet controller.
+//!
+//! This function enables the Ethernet controller, programs it with the MAC
+//! address (taken from the \b ENET_MAC_ADDR0 through \b ENET_MAC_ADDR5
+//! defines if they are present, or from the USER0 and USER1 registers
+//! otherwise), and starts the SysTick timer that is used to time out requests.
+//!
+//! This function is contained in <tt>bl_enet.c</tt>.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ConfigureEnet(void)
+{
+    //
+    // Enable the clocks to the Ethernet MAC and PHY.
+    //
+    HWREG(SYSCTL_RCGC2) |= SYSCTL_RCGC2_EMAC0 | SYSCTL_RCGC2_EPHY0;
+
+    //
+    // Get the MAC address.
+    //
+#ifdef ENET_MAC_ADDR0
+    g_pucEnetMAC[0] = ENET_MAC_ADDR0;
+    g_pucEnetMAC[1] = ENET_MAC_ADDR1;
+    g_pucEnetMAC[2] = ENET_MAC_ADDR2;
+    g_pucEnetMAC[3] = ENET_MAC_ADDR3;
+    g_pucEnetMAC[4] = ENET_MAC_ADDR4;
+    g_pucEnetMAC[5] = ENET_MAC_ADDR5;
+#else
+    g_pucEnetMAC[0] = HWREG(FLASH_USERREG0);
+    g_pucEnetMAC[1] = HWREG(FLASH_USERREG0) >> 8;
+    g_pucEnetMAC[2] = HWREG(FLASH_USERREG0) >> 16;
+    g_pucEnetMAC[3] = HWREG(FLASH_USERREG1);
+    g_pucEnetMAC[4] = HWREG(FLASH_USERREG1) >> 8;
+    g_pucEnetMAC[5] = HWREG(FLASH_USERREG1) >> 16;
+#endif
+
+    //
+    // Program the MAC address for the receive filter.
+    //
+    HWREG(ETH_BASE + MAC_O_IA0) = (g_pucEnetMAC[0] |
+                                   (g_pucEnetMAC[1] << 8) |
+                                   (g_pucEnetMAC[2] << 16) |
+                                   (g_pucEnetMAC[3] << 24));
+    HWREG(ETH_BASE + MAC_O_IA1) = g_pucEnetMAC[4] | (g_pucEnetMAC[5] << 8);
+
+    //
+    // Set the management clock divider for an MDC of no more than 2.5 MHz.
+    //
+    HWREG(ETH_BASE + MAC_O_MDV) = (CRYSTAL_FREQ / 2) / 2500000;
+
+    //
+    // Enable the transmitter with full duplex, CRC generation and padding,
+    // and enable the receiver after clearing the receive FIFO.
+    //
+    HWREG(ETH_BASE + MAC_O_TCTL) = (MAC_TCTL_DUPLEX | MAC_TCTL_CRC |
+                                    MAC_TCTL_PADEN | MAC_TCTL_TXEN);
+    HWREG(ETH_BASE + MAC_O_RCTL) = MAC_RCTL_BADCRC | MAC_RCTL_RSTFIFO;
+    HWREG(ETH_BASE + MAC_O_RCTL) = MAC_RCTL_BADCRC | MAC_RCTL_RXEN;
+
+    //
+    // Start the SysTick timer, running from the processor clock.
+    //
+    HWREG(NVIC_ST_RELOAD) = (CRYSTAL_FREQ / ENET_TICKS_PER_SECOND) - 1;
+    HWREG(NVIC_ST_CTRL) = NVIC_ST_CTRL_CLK_SRC | NVIC_ST_CTRL_ENABLE;
+}
+
+//*****************************************************************************
+//
+//! Performs an update via Ethernet.
+//!
+//! This function obtains an IP address, the address of a TFTP server, and the
+//! name of the image file from a BOOTP server, and then reads the image from
+//! the TFTP server and programs it into the flash at \b APP_START_ADDRESS.
+//! Each block is acknowledged before it is programmed, so the server sends
+//! the following block while the flash is busy.  Once the image has been
+//! programmed, the device is reset to start the new application.  If any step
+//! fails, the update starts again with a new BOOTP request.
+//!
+//! This function is contained in <tt>bl_enet.c</tt>.
+//!
+//! \return Never returns.
+//
+//*****************************************************************************
+void
+UpdateBOOTP(void)
+{
+    unsigned long ulStart;
+    long lLength;
+
+    while(1)
+    {
+        //
+        // Forget any previous IP address and server, and pick a transaction
+        // ID for the BOOTP request.
+        //
+        EnetCopy(g_pucEnetIP, g_pucEnetZero, 4);
+        g_bEnetServerMAC = false;
+        g_ulBOOTPXid = ((g_pucEnetMAC[2] << 24) | (g_pucEnetMAC[3] << 16) |
+                        (g_pucEnetMAC[4] << 8) | g_pucEnetMAC[5]) +
+                       EnetTicks();
+
+        //
+        // Send BOOTP requests until a reply is received.
+        //
+        do
+        {
+            BOOTPRequest();
+            ulStart = EnetTicks();
+            do
+            {
+                lLength = EnetUDPReceive(BOOTP_CLIENT_PORT);
+            }
+            while(((lLength < 0) || !BOOTPReply(lLength)) &&
+                  ((EnetTicks() - ulStart) < ENET_TIMEOUT));
+        }
+        while(!EnetCompare(g_pucEnetIP, g_pucEnetZero, 4));
+
+        //
+        // Find the MAC address of the TFTP server.
+        //
+        for(ulStart = 0; !g_bEnetServerMAC && (ulStart < ENET_RETRIES);
+            ulStart++)
+        {
+            EnetARPSend(1, g_pucEnetZero, g_pucEnetServerIP);
+            lLength = EnetTicks();
+            while(!g_bEnetServerMAC &&
+                  ((EnetTicks() - (unsigned long)lLength) < ENET_TIMEOUT))
+            {
+                EnetUDPReceive(0);
+            }
+        }
+
+        //
+        // Read the image from the server.  This only returns if the transfer
+        // fails.
+        //
+        if(g_bEnetServerMAC)
+        {
+            TFTPRead();
+        }
+    }
+}
+
+#endif
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
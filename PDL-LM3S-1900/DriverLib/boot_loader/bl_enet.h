@@ -0,0 +1,64 @@
+//*****************************************************************************
+//
+// bl_enet.h - Definitions for the Ethernet transport functions.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+#ifndef __BL_ENET_H__
+#define __BL_ENET_H__
+
+//*****************************************************************************
+//
+// The UDP ports used by BOOTP and TFTP.
+//
+//*****************************************************************************
+#define BOOTP_SERVER_PORT       67
+#define BOOTP_CLIENT_PORT       68
+#define TFTP_SERVER_PORT        69
+
+//*****************************************************************************
+//
+// The local UDP port from which TFTP requests are sent.
+//
+//*****************************************************************************
+#define TFTP_CLIENT_PORT        49152
+
+//*****************************************************************************
+//
+// The size of the data in each TFTP data packet; a shorter packet marks the
+// end of the file.
+//
+//*****************************************************************************
+#define TFTP_BLOCK_SIZE         512
+
+//*****************************************************************************
+//
+// Ethernet Transport APIs
+//
+//*****************************************************************************
+extern void ConfigureEnet(void);
+extern void UpdateBOOTP(void);
+
+#endif // __BL_ENET_H__
@@ -0,0 +1,44 @@
+//*****************************************************************************
+//
+// bl_flash.h - Prototypes for the flash update functions in bl_main.c.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+#ifndef __BL_FLASH_H__
+#define __BL_FLASH_H__
+
+//*****************************************************************************
+//
+// Flash update APIs, used by the transports that write the flash themselves
+// instead of going through the packet handler in bl_main.c.
+//
+//*****************************************************************************
+extern unsigned long EraseBlocks(unsigned long ulStart, unsigned long ulEnd);
+extern unsigned long ProgramFlash(unsigned long *pulData,
+                                  unsigned long ulAddress,
+                                  unsigned long ulSize);
+extern void DecryptData(unsigned char *pucBuffer, unsigned long ulSize);
+
+#endif // __BL_FLASH_H__
@@ -148,6 +148,54 @@ I2CReceive(unsigned char *pucData, unsigned long ulSize)
     }
 }
 
+//*****************************************************************************
+//
+//! Receives any data that is available from the I2C port.
+//!
+//! \param pucData is the buffer to read data into from the I2C port.
+//! \param ulSize is the maximum number of bytes to be written to the
+//! \e pucData buffer.
+//!
+//! This function reads up to \e ulSize bytes of data from the I2C port into
+//! the buffer that is pointed to by \e pucData.  Only the bytes that the
+//! master has already written are read; this function does not wait for more
+//! data to arrive.
+//!
+//! This function is contained in <tt>bl_i2c.c</tt>.
+//!
+//! \return Returns the number of bytes read into \e pucData.
+//
+//*****************************************************************************
+unsigned long
+I2CReceiveNonBlocking(unsigned char *pucData, unsigned long ulSize)
+{
+    unsigned long ulCount;
+
+    //
+    // Read bytes until there are no more or the buffer is full.
+    //
+    for(ulCount = 0; ulCount < ulSize; ulCount++)
+    {
+        //
+        // Stop if the slave has not received another character.
+        //
+        if(!(HWREG(I2C0_SLAVE_BASE + I2C_O_SCSR) & I2C_SCSR_RREQ))
+        {
+            break;
+        }
+
+        //
+        // Receive a byte from the I2C.
+        //
+        *pucData++ = HWREG(I2C0_SLAVE_BASE + I2C_O_SDR);
+    }
+
+    //
+    // Return the number of bytes received.
+    //
+    return(ulCount);
+}
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
@@ -58,6 +58,8 @@
 //*****************************************************************************
 extern void I2CSend(unsigned char const *pucData, unsigned long ulSize);
 extern void I2CReceive(unsigned char *pucData, unsigned long ulSize);
+extern unsigned long I2CReceiveNonBlocking(unsigned char *pucData,
+                                           unsigned long ulSize);
 extern void I2CFlush(void);
 
 //*****************************************************************************
@@ -69,6 +71,8 @@ extern void I2CFlush(void);
 #define SendData                I2CSend
 #define FlushData               I2CFlush
 #define ReceiveData             I2CReceive
+#define SendDataNoWait          I2CSend
+#define ReceiveDataNonBlocking  I2CReceiveNonBlocking
 #endif
 
 #endif // __BL_I2C_H__
@@ -37,6 +37,8 @@
 #include "../hw_uart.h"
 #include "bl_commands.h"
 #include "bl_config.h"
+#include "bl_enet.h"
+#include "bl_flash.h"
 #include "bl_i2c.h"
 #include "bl_packet.h"
 #include "bl_ssi.h"
@@ -121,6 +123,173 @@ unsigned long g_pulDataBuffer[BUFFER_SIZE];
 //*****************************************************************************
 unsigned char *g_pucDataBuffer;
 
+#ifdef STREAM_BUFFER_SIZE
+//*****************************************************************************
+//
+// The largest window that can be used by COMMAND_SEND_DATA_STREAM.  This is
+// limited by the sequence numbers, since a frame must be distinguished from
+// the frames that were sent before the one that is expected.  When using I2C,
+// the host has to read each acknowledgement before it sends the next frame.
+//
+//*****************************************************************************
+#ifdef I2C_ENABLE_UPDATE
+#define STREAM_MAX_WINDOW       1
+#else
+#define STREAM_MAX_WINDOW       127
+#endif
+
+//*****************************************************************************
+//
+// Computes the number of frames by which the given sequence number is ahead of
+// the sequence number of the next expected frame.  Sequence numbers run from
+// 1 to 255, so values larger than STREAM_MAX_WINDOW correspond to frames that
+// were sent before the expected frame.
+//
+//*****************************************************************************
+#define STREAM_DISTANCE(ulSeq)  (((ulSeq) + 255 - g_ucStreamSeq) % 255)
+
+//*****************************************************************************
+//
+// The pair of buffers used to receive one frame of streamed data while the
+// previous frame is programmed into the flash.
+//
+//*****************************************************************************
+unsigned long g_pulStreamBuffer[2][STREAM_BUFFER_SIZE];
+
+//*****************************************************************************
+//
+// The sequence number and checksum of the frame being received, the buffer
+// into which its data is being received (or NULL if a frame is not being
+// received), the number of bytes of the frame received so far, and the total
+// number of bytes in the frame (including the sequence number and checksum).
+//
+//*****************************************************************************
+unsigned char g_pucStreamHeader[2];
+unsigned char *g_pucStreamData;
+unsigned long g_ulStreamCount;
+unsigned long g_ulStreamLength;
+
+//*****************************************************************************
+//
+// The block size negotiated for the stream and the sequence number of the next
+// frame that is expected.
+//
+//*****************************************************************************
+unsigned long g_ulStreamBlock;
+unsigned char g_ucStreamSeq;
+#endif
+
+#ifdef ENABLE_VERIFY
+//*****************************************************************************
+//
+// The table used to compute the CRC-32 four bits at a time.
+//
+//*****************************************************************************
+static const unsigned long g_pulCRC32Table[16] =
+{
+    0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
+    0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+    0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
+    0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
+};
+#endif
+
+#ifdef ENABLE_DELTA_UPDATE
+//*****************************************************************************
+//
+// The largest number of 1 KB pages of flash on any device.
+//
+//*****************************************************************************
+#define DELTA_MAX_PAGES         256
+
+//*****************************************************************************
+//
+// A bit for each page of flash, which is set if the page has been marked as
+// unchanged by COMMAND_PAGE_CRC.
+//
+//*****************************************************************************
+unsigned long g_pulDeltaSame[DELTA_MAX_PAGES / 32];
+
+//*****************************************************************************
+//
+// Determines if the page containing the given address is marked unchanged.
+//
+//*****************************************************************************
+#define DeltaSame(ulAddress)                                                  \
+        ((((ulAddress) >> 10) < DELTA_MAX_PAGES) &&                           \
+         (g_pulDeltaSame[(ulAddress) >> 15] &                                 \
+          (1 << (((ulAddress) >> 10) & 31))))
+#else
+
+//*****************************************************************************
+//
+// Without delta updates, the data is programmed directly into the flash.
+//
+//*****************************************************************************
+#define ProgramDelta            ProgramFlash
+#define DeltaAdvance(ulAddress, ulCount)                                      \
+                                ((ulAddress) + (ulCount))
+#endif
+
+#ifdef LZ_WINDOW_SIZE
+//*****************************************************************************
+//
+// Make sure that the decompression window is a power of two that is no larger
+// than the largest offset of a match.
+//
+//*****************************************************************************
+#if ((LZ_WINDOW_SIZE & (LZ_WINDOW_SIZE - 1)) != 0) || \
+    (LZ_WINDOW_SIZE < 4) || (LZ_WINDOW_SIZE > 4096)
+#error ERROR: LZ_WINDOW_SIZE must be a power of two from 4 to 4096!
+#endif
+
+//*****************************************************************************
+//
+// The window that holds the most recently decompressed bytes of the image.
+// Each word of the window is programmed into the flash as soon as it has been
+// filled.
+//
+//*****************************************************************************
+unsigned long g_pulLZWindow[LZ_WINDOW_SIZE / 4];
+
+//*****************************************************************************
+//
+// This is true if the download in progress is compressed.
+//
+//*****************************************************************************
+tBoolean g_bLZActive;
+
+//*****************************************************************************
+//
+// The number of bytes that have been decompressed (which also gives the
+// position of the next byte in the window), the address at which the next word
+// of the image is programmed, and the number of bytes of the image that remain
+// to be decompressed.
+//
+//*****************************************************************************
+unsigned long g_ulLZCount;
+unsigned long g_ulLZAddress;
+unsigned long g_ulLZSize;
+
+//*****************************************************************************
+//
+// The flags for the rest of the current group of items (above a marker bit, so
+// that a value of one indicates that a new flag byte is needed), and the first
+// byte of a match (ORed with 0x100) or zero if a match is not in progress.
+//
+//*****************************************************************************
+unsigned long g_ulLZFlags;
+unsigned long g_ulLZMatch;
+#else
+
+//*****************************************************************************
+//
+// Without decompression, the received data is programmed directly.
+//
+//*****************************************************************************
+#define DownloadData            ProgramDelta
+#endif
+
 //*****************************************************************************
 //
 // Converts a word from big endian to little endian.  This macro uses compiler-
@@ -128,147 +297,987 @@ unsigned char *g_pucDataBuffer;
 // which performs the byte swap directly.
 //
 //*****************************************************************************
-#if defined(ewarm)
-#include <intrinsics.h>
-#define SwapWord(x)             __REV(x)
-#endif
-#if defined(gcc) || defined(sourcerygxx)
-#define SwapWord(x) __extension__                                \
-        ({                                                       \
-             register unsigned long __ret, __inp = x;            \
-             __asm__("rev %0, %1" : "=r" (__ret) : "r" (__inp)); \
-             __ret;                                              \
-        })
-#endif
-#if defined(rvmdk) || defined(__ARMCC_VERSION)
-#define SwapWord(x)             __rev(x)
+#if defined(ewarm)
+#include <intrinsics.h>
+#define SwapWord(x)             __REV(x)
+#endif
+#if defined(gcc) || defined(sourcerygxx)
+#define SwapWord(x) __extension__                                \
+        ({                                                       \
+             register unsigned long __ret, __inp = x;            \
+             __asm__("rev %0, %1" : "=r" (__ret) : "r" (__inp)); \
+             __ret;                                              \
+        })
+#endif
+#if defined(rvmdk) || defined(__ARMCC_VERSION)
+#define SwapWord(x)             __rev(x)
+#endif
+
+//*****************************************************************************
+//
+//! Checks if an update is needed or is being requested.
+//!
+//! This function detects if an update is being requested or if there is no
+//! valid code presently located on the microcontroller.  This is used to tell
+//! whether or not to enter update mode.
+//!
+//! This function is contained in <tt>bl_main.c</tt>.
+//!
+//! \return Returns a non-zero value if an update is needed or is being
+//! requested and zero otherwise.
+//
+//*****************************************************************************
+unsigned long
+CheckForceUpdate(void)
+{
+    unsigned long *pulApp;
+
+#ifdef ENABLE_UPDATE_CHECK
+    //
+    // Enable the required GPIO module.
+    //
+    HWREG(SYSCTL_RCGC2) = FORCED_UPDATE_PERIPH;
+#endif
+
+    //
+    // See if the first location is 0xfffffffff or something that does not
+    // look like a stack pointer, or if the second location is 0xffffffff or
+    // something that does not look like a reset vector.
+    //
+    pulApp = (unsigned long *)APP_START_ADDRESS;
+    if((pulApp[0] == 0xffffffff) || ((pulApp[0] & 0xfff00000) != 0x20000000) ||
+       (pulApp[1] == 0xffffffff) || ((pulApp[1] & 0xfff00001) != 0x00000001))
+    {
+        return(1);
+    }
+
+#ifdef ENABLE_UPDATE_CHECK
+    //
+    // Check the pin to see if an update is being requested.
+    //
+    HWREG(FORCED_UPDATE_PORT + GPIO_O_DEN) |= 1 << FORCED_UPDATE_PIN;
+    if(HWREG(FORCED_UPDATE_PORT + (1 << (FORCED_UPDATE_PIN + 2))) ==
+       (FORCED_UPDATE_POLARITY << FORCED_UPDATE_PIN))
+    {
+        return(1);
+    }
+#endif
+
+    //
+    // No update was needed or requested.
+    //
+    return(0);
+}
+
+//*****************************************************************************
+//
+//! Performs an in-place decryption of downloaded data.
+//!
+//! \param pucBuffer is the buffer that holds the data to decrypt.
+//! \param ulSize is the size, in bytes, of the buffer that was passed in via
+//! the pucBuffer parameter.
+//!
+//! This function is a stub that could provide in-place decryption of the data
+//! that is being downloaded to the device.
+//!
+//! This function is contained in <tt>bl_main.c</tt>.
+//!
+//! \return None.
+//
+//*****************************************************************************
+#if defined(ENABLE_DECRYPTION) || defined(DOXYGEN)
+void
+DecryptData(unsigned char *pucBuffer, unsigned long ulSize)
+{
+}
+#endif
+
+//*****************************************************************************
+//
+//! \internal
+//! Provides a small delay.
+//!
+//! \param ulCount is the number of delay loop iterations to perform.
+//!
+//! This function provides a means of generating a constant length delay.  It
+//! is written in assembly to keep the delay consistent across tool chains,
+//! avoiding the need to tune the delay based on the tool chain in use.
+//!
+//! The loop below takes 3 cycles/loop.
+//!
+//! This function is contained in <tt>bl_main.c</tt>.
+//!
+//! \return None.
+//
+//*****************************************************************************
+#ifdef CRYSTAL_FREQ
+#if defined(ewarm)
+static void
+Delay(unsigned long ulCount)
+{
+    __asm("    subs    r0, #1\n"
+          "    bne     Delay\n"
+          "    bx      lr");
+}
+#endif
+#if defined(gcc) || defined(sourcerygxx)
+static void __attribute__((naked))
+Delay(unsigned long ulCount)
+{
+    __asm("    subs    r0, #1\n"
+          "    bne     Delay\n"
+          "    bx      lr");
+}
+#endif
+#if defined(rvmdk) || defined(__ARMCC_VERSION)
+__asm void
+Delay(unsigned long ulCount)
+{
+    subs    r0, #1;
+    bne     Delay;
+    bx      lr;
+}
+#endif
+#endif
+
+//*****************************************************************************
+//
+//! \internal
+//! Receives the part of a streamed frame that has already arrived.
+//!
+//! This function reads whatever bytes of the frame being received are
+//! available from the port in use, without waiting for more to arrive.  It
+//! is called while waiting for the flash, so that the next frame is received
+//! while the previous one is being programmed, and does nothing if a frame is
+//! not being received.
+//!
+//! This function is contained in <tt>bl_main.c</tt>.
+//!
+//! \return None.
+//
+//*****************************************************************************
+#ifdef STREAM_BUFFER_SIZE
+static void
+StreamReceive(void)
+{
+    unsigned long ulOffset;
+
+    //
+    // Do nothing if a frame is not being received.
+    //
+    if(!g_pucStreamData)
+    {
+        return;
+    }
+
+    //
+    // Receive the sequence number and checksum one byte at a time, since the
+    // sequence number determines the length of the frame.
+    //
+    while(g_ulStreamCount < 2)
+    {
+        if(!ReceiveDataNonBlocking(g_pucStreamHeader + g_ulStreamCount, 1))
+        {
+            return;
+        }
+
+        //
+        // Zero bytes between frames are ignored.
+        //
+        if(g_ulStreamCount == 0)
+        {
+            if(g_pucStreamHeader[0] == 0)
+            {
+                continue;
+            }
+
+            //
+            // Every frame holds a full block, except for the one that holds
+            // the end of the download.  Frames sent before the expected frame
+            // were full blocks since the download had not ended, and frames
+            // that lie beyond the end of the download have no data.
+            //
+            ulOffset = STREAM_DISTANCE(g_pucStreamHeader[0]);
+            g_ulStreamLength = g_ulStreamBlock + 2;
+            if(ulOffset <= STREAM_MAX_WINDOW)
+            {
+                ulOffset *= g_ulStreamBlock;
+                if(ulOffset >= g_ulTransferSize)
+                {
+                    g_ulStreamLength = 2;
+                }
+                else if((g_ulTransferSize - ulOffset) < g_ulStreamBlock)
+                {
+                    g_ulStreamLength = g_ulTransferSize - ulOffset + 2;
+                }
+            }
+        }
+        g_ulStreamCount++;
+    }
+
+    //
+    // Receive as much of the data as is available.
+    //
+    if(g_ulStreamCount < g_ulStreamLength)
+    {
+        g_ulStreamCount +=
+            ReceiveDataNonBlocking(g_pucStreamData + g_ulStreamCount - 2,
+                                   g_ulStreamLength - g_ulStreamCount);
+    }
+}
+#endif
+
+//*****************************************************************************
+//
+//! \internal
+//! Erases a range of flash blocks.
+//!
+//! \param ulStart is the address of the first block to erase.
+//! \param ulEnd is the address at which to stop erasing.
+//!
+//! This function erases the 1 KB flash blocks from \e ulStart up to, but not
+//! including, \e ulEnd.  Blocks that have been marked as unchanged by
+//! COMMAND_PAGE_CRC are skipped.
+//!
+//! This function is contained in <tt>bl_main.c</tt>.
+//!
+//! \return Returns a non-zero value if an access violation occurred and zero
+//! otherwise.
+//
+//*****************************************************************************
+unsigned long
+EraseBlocks(unsigned long ulStart, unsigned long ulEnd)
+{
+    //
+    // Clear the flash access interrupt.
+    //
+    HWREG(FLASH_FCMISC) = FLASH_FCMISC_AMISC;
+
+    //
+    // Loop over the blocks to erase.
+    //
+    for(; ulStart < ulEnd; ulStart += 0x400)
+    {
+#ifdef ENABLE_DELTA_UPDATE
+        //
+        // Skip this block if it is not being updated.
+        //
+        if(DeltaSame(ulStart))
+        {
+            continue;
+        }
+#endif
+
+        //
+        // Erase this block.
+        //
+        HWREG(FLASH_FMA) = ulStart;
+        HWREG(FLASH_FMC) = FLASH_FMC_WRKEY | FLASH_FMC_ERASE;
+
+        //
+        // Wait until this block has been erased.
+        //
+        while(HWREG(FLASH_FMC) & FLASH_FMC_ERASE)
+        {
+        }
+    }
+
+    //
+    // Return an indication of whether an access violation occurred.
+    //
+    return(HWREG(FLASH_FCRIS) & FLASH_FCRIS_ARIS);
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! Programs data into the flash.
+//!
+//! \param pulData is a pointer to the data to be programmed.
+//! \param ulAddress is the flash address at which to program the data.
+//! \param ulSize is the number of bytes to program, which is rounded up to a
+//! multiple of four.
+//!
+//! This function programs the flash one word at a time.  When a streamed
+//! frame is being received, the time spent waiting for each word to be
+//! programmed is used to receive more of the frame.
+//!
+//! This function is contained in <tt>bl_main.c</tt>.
+//!
+//! \return Returns a non-zero value if an access violation occurred and zero
+//! otherwise.
+//
+//*****************************************************************************
+unsigned long
+ProgramFlash(unsigned long *pulData, unsigned long ulAddress,
+             unsigned long ulSize)
+{
+    unsigned long ulTemp;
+
+    //
+    // Clear the flash access interrupt.
+    //
+    HWREG(FLASH_FCMISC) = FLASH_FCMISC_AMISC;
+
+    //
+    // Loop over the words to program.
+    //
+    for(ulTemp = 0; ulTemp < ((ulSize + 3) & ~3); ulTemp += 4)
+    {
+        //
+        // Program the next word.
+        //
+        HWREG(FLASH_FMA) = ulAddress + ulTemp;
+        HWREG(FLASH_FMD) = *pulData++;
+        HWREG(FLASH_FMC) = FLASH_FMC_WRKEY | FLASH_FMC_WRITE;
+
+        //
+        // Wait until the word has been programmed.
+        //
+        while(HWREG(FLASH_FMC) & FLASH_FMC_WRITE)
+        {
+#ifdef STREAM_BUFFER_SIZE
+            StreamReceive();
+#endif
+        }
+    }
+
+    //
+    // Return an indication of whether an access violation occurred.
+    //
+    return(HWREG(FLASH_FCRIS) & FLASH_FCRIS_ARIS);
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! Computes the CRC-32 of a range of the flash.
+//!
+//! \param ulAddress is the address of the first byte of the range.
+//! \param ulSize is the number of bytes in the range.
+//!
+//! This function computes the CRC-32 used by Ethernet and zlib.  The flash is
+//! read a word at a time (apart from any unaligned bytes at the start and end
+//! of the range), and the CRC is updated four bits at a time from a 16 entry
+//! table, which keeps the table small enough for the boot loader.
+//!
+//! This function is contained in <tt>bl_main.c</tt>.
+//!
+//! \return Returns the CRC-32 of the range.
+//
+//*****************************************************************************
+#ifdef ENABLE_VERIFY
+static unsigned long
+CRC32(unsigned long ulAddress, unsigned long ulSize)
+{
+    unsigned long ulCRC, ulBits;
+
+    //
+    // Loop through the range.
+    //
+    ulCRC = 0xffffffff;
+    while(ulSize)
+    {
+        //
+        // Add the next word if it is aligned and entirely within the range, or
+        // the next byte otherwise.
+        //
+        if(((ulAddress & 3) == 0) && (ulSize >= 4))
+        {
+            ulCRC ^= HWREG(ulAddress);
+            ulBits = 32;
+        }
+        else
+        {
+            ulCRC ^= HWREGB(ulAddress);
+            ulBits = 8;
+        }
+        ulAddress += ulBits / 8;
+        ulSize -= ulBits / 8;
+
+        //
+        // Shift the new bits through the CRC.
+        //
+        for(; ulBits; ulBits -= 4)
+        {
+            ulCRC = (ulCRC >> 4) ^ g_pulCRC32Table[ulCRC & 15];
+        }
+    }
+
+    //
+    // Return the CRC.
+    //
+    return(ulCRC ^ 0xffffffff);
+}
+#endif
+
+//*****************************************************************************
+//
+//! \internal
+//! Advances a download address past data and any unchanged pages.
+//!
+//! \param ulAddress is the address of the data.
+//! \param ulCount is the number of bytes of data.
+//!
+//! This function determines the address at which the data following a block
+//! of data is programmed, skipping the pages that have been marked as
+//! unchanged by COMMAND_PAGE_CRC (since their data is not sent by the host).
+//!
+//! This function is contained in <tt>bl_main.c</tt>.
+//!
+//! \return Returns the address at which the following data is programmed.
+//
+//*****************************************************************************
+#ifdef ENABLE_DELTA_UPDATE
+static unsigned long
+DeltaAdvance(unsigned long ulAddress, unsigned long ulCount)
+{
+    //
+    // Move past the data.
+    //
+    ulAddress += ulCount;
+
+    //
+    // Move past any unchanged pages that follow it.
+    //
+    while(((ulAddress & 0x3ff) == 0) && DeltaSame(ulAddress))
+    {
+        ulAddress += 0x400;
+    }
+
+    //
+    // Return the new address.
+    //
+    return(ulAddress);
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! Programs data into the changed pages of the flash.
+//!
+//! \param pulData is a pointer to the data to be programmed.
+//! \param ulAddress is the flash address at which to program the data.
+//! \param ulSize is the number of bytes to program.
+//!
+//! This function programs data into the flash in the same way as
+//! ProgramFlash(), except that the pages that have been marked as unchanged by
+//! COMMAND_PAGE_CRC are skipped; the data that reaches the end of a page is
+//! continued in the next page that has changed.
+//!
+//! This function is contained in <tt>bl_main.c</tt>.
+//!
+//! \return Returns a non-zero value if an access violation occurred and zero
+//! otherwise.
+//
+//*****************************************************************************
+static unsigned long
+ProgramDelta(unsigned long *pulData, unsigned long ulAddress,
+             unsigned long ulSize)
+{
+    unsigned long ulCount;
+
+    //
+    // Loop while there is data to program.
+    //
+    while(ulSize)
+    {
+        //
+        // Program as much of the data as fits in this page.
+        //
+        ulCount = 0x400 - (ulAddress & 0x3ff);
+        if(ulCount > ulSize)
+        {
+            ulCount = ulSize;
+        }
+        if(ProgramFlash(pulData, ulAddress, ulCount))
+        {
+            return(1);
+        }
+
+        //
+        // Move on to the next changed page.
+        //
+        pulData += ulCount / 4;
+        ulSize -= ulCount;
+        ulAddress = DeltaAdvance(ulAddress, ulCount);
+    }
+
+    //
+    // Success.
+    //
+    return(0);
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! Determines the amount of data that must be sent for a download.
+//!
+//! \param ulAddress is the address of the download.
+//! \param ulSize is the size of the image being downloaded.
+//!
+//! This function determines the number of bytes of the image that are in the
+//! pages that have not been marked as unchanged by COMMAND_PAGE_CRC.
+//!
+//! This function is contained in <tt>bl_main.c</tt>.
+//!
+//! \return Returns the number of bytes that must be sent by the host.
+//
+//*****************************************************************************
+static unsigned long
+DeltaSize(unsigned long ulAddress, unsigned long ulSize)
+{
+    unsigned long ulEnd, ulNext;
+
+    //
+    // Loop over the pages of the image.
+    //
+    for(ulEnd = ulAddress + ulSize; ulAddress < ulEnd; ulAddress = ulNext)
+    {
+        //
+        // Find the start of the next page, or the end of the image.
+        //
+        ulNext = (ulAddress | 0x3ff) + 1;
+        if(ulNext > ulEnd)
+        {
+            ulNext = ulEnd;
+        }
+
+        //
+        // Remove the part of the image in this page if it is unchanged.
+        //
+        if(DeltaSame(ulAddress))
+        {
+            ulSize -= ulNext - ulAddress;
+        }
+    }
+
+    //
+    // Return the amount of data remaining.
+    //
+    return(ulSize);
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! Forgets the pages that have been marked as unchanged.
+//!
+//! This function is contained in <tt>bl_main.c</tt>.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+DeltaClear(void)
+{
+    unsigned long ulIdx;
+
+    //
+    // Clear all the marks.
+    //
+    for(ulIdx = 0; ulIdx < (DELTA_MAX_PAGES / 32); ulIdx++)
+    {
+        g_pulDeltaSame[ulIdx] = 0;
+    }
+}
 #endif
 
 //*****************************************************************************
 //
-//! Checks if an update is needed or is being requested.
+//! \internal
+//! Adds a byte to a compressed image.
 //!
-//! This function detects if an update is being requested or if there is no
-//! valid code presently located on the microcontroller.  This is used to tell
-//! whether or not to enter update mode.
+//! \param ulByte is the byte to add to the image.
+//!
+//! This function places the next decompressed byte of the image into the
+//! window, and programs the word of the window that it completes into the
+//! flash.
 //!
 //! This function is contained in <tt>bl_main.c</tt>.
 //!
-//! \return Returns a non-zero value if an update is needed or is being
-//! requested and zero otherwise.
+//! \return Returns a non-zero value if the image has overflowed or an access
+//! violation occurred, and zero otherwise.
 //
 //*****************************************************************************
-unsigned long
-CheckForceUpdate(void)
+#ifdef LZ_WINDOW_SIZE
+static unsigned long
+LZOutput(unsigned long ulByte)
 {
-    unsigned long *pulApp;
+    unsigned long ulWord;
 
-#ifdef ENABLE_UPDATE_CHECK
     //
-    // Enable the required GPIO module.
+    // Fail if the image has already been completed.
     //
-    HWREG(SYSCTL_RCGC2) = FORCED_UPDATE_PERIPH;
-#endif
+    if(g_ulLZSize == 0)
+    {
+        return(1);
+    }
+    g_ulLZSize--;
 
     //
-    // See if the first location is 0xfffffffff or something that does not
-    // look like a stack pointer, or if the second location is 0xffffffff or
-    // something that does not look like a reset vector.
+    // Add the byte to the window.
     //
-    pulApp = (unsigned long *)APP_START_ADDRESS;
-    if((pulApp[0] == 0xffffffff) || ((pulApp[0] & 0xfff00000) != 0x20000000) ||
-       (pulApp[1] == 0xffffffff) || ((pulApp[1] & 0xfff00001) != 0x00000001))
+    ((unsigned char *)g_pulLZWindow)[g_ulLZCount & (LZ_WINDOW_SIZE - 1)] =
+        ulByte;
+    g_ulLZCount++;
+
+    //
+    // Program the word if it has been completed.
+    //
+    if((g_ulLZCount & 3) == 0)
     {
-        return(1);
+        ulWord = ((g_ulLZCount - 4) & (LZ_WINDOW_SIZE - 1)) / 4;
+        if(ProgramDelta(g_pulLZWindow + ulWord, g_ulLZAddress, 4))
+        {
+            return(1);
+        }
+        g_ulLZAddress = DeltaAdvance(g_ulLZAddress, 4);
     }
 
-#ifdef ENABLE_UPDATE_CHECK
     //
-    // Check the pin to see if an update is being requested.
+    // Success.
     //
-    HWREG(FORCED_UPDATE_PORT + GPIO_O_DEN) |= 1 << FORCED_UPDATE_PIN;
-    if(HWREG(FORCED_UPDATE_PORT + (1 << (FORCED_UPDATE_PIN + 2))) ==
-       (FORCED_UPDATE_POLARITY << FORCED_UPDATE_PIN))
+    return(0);
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! Decompresses data into the flash.
+//!
+//! \param pucData is a pointer to the compressed data.
+//! \param ulSize is the number of bytes of compressed data.
+//!
+//! This function decompresses the next part of a compressed image, which may
+//! end part way through a group of items or a match (the remainder of which is
+//! decompressed by the next call).  The format of the compressed data is
+//! described with COMMAND_DOWNLOAD_COMPRESSED.
+//!
+//! This function is contained in <tt>bl_main.c</tt>.
+//!
+//! \return Returns a non-zero value if the image has overflowed or an access
+//! violation occurred, and zero otherwise.
+//
+//*****************************************************************************
+static unsigned long
+LZDecode(const unsigned char *pucData, unsigned long ulSize)
+{
+    unsigned long ulByte, ulOffset, ulLength;
+
+    //
+    // Loop through the compressed data.
+    //
+    for(; ulSize; ulSize--)
     {
-        return(1);
+        ulByte = *pucData++;
+
+        //
+        // Start a new group of items when the flags have been used up.
+        //
+        if(g_ulLZFlags == 1)
+        {
+            g_ulLZFlags = ulByte | 0x100;
+        }
+
+        //
+        // Copy a literal byte to the image.
+        //
+        else if(g_ulLZFlags & 1)
+        {
+            if(LZOutput(ulByte))
+            {
+                return(1);
+            }
+            g_ulLZFlags >>= 1;
+        }
+
+        //
+        // Save the first byte of a match.
+        //
+        else if(g_ulLZMatch == 0)
+        {
+            g_ulLZMatch = ulByte | 0x100;
+        }
+
+        //
+        // Copy the bytes of a match from the window to the image.
+        //
+        else
+        {
+            ulOffset = (((g_ulLZMatch & 0xff) << 4) | (ulByte >> 4)) + 1;
+            for(ulLength = (ulByte & 15) + 3; ulLength; ulLength--)
+            {
+                ulByte = ((unsigned char *)g_pulLZWindow)
+                    [(g_ulLZCount - ulOffset) & (LZ_WINDOW_SIZE - 1)];
+                if(LZOutput(ulByte))
+                {
+                    return(1);
+                }
+            }
+            g_ulLZMatch = 0;
+            g_ulLZFlags >>= 1;
+        }
     }
-#endif
 
     //
-    // No update was needed or requested.
+    // Success.
     //
     return(0);
 }
 
 //*****************************************************************************
 //
-//! Performs an in-place decryption of downloaded data.
+//! \internal
+//! Programs received data into the flash.
 //!
-//! \param pucBuffer is the buffer that holds the data to decrypt.
-//! \param ulSize is the size, in bytes, of the buffer that was passed in via
-//! the pucBuffer parameter.
+//! \param pulData is a pointer to the received data.
+//! \param ulAddress is the flash address at which to program the data if it
+//! is not compressed.
+//! \param ulSize is the number of bytes of received data.
 //!
-//! This function is a stub that could provide in-place decryption of the data
-//! that is being downloaded to the device.
+//! This function decompresses the data into the flash if the download is
+//! compressed, and programs it directly otherwise.
 //!
 //! This function is contained in <tt>bl_main.c</tt>.
 //!
-//! \return None.
+//! \return Returns a non-zero value if an error occurred and zero otherwise.
 //
 //*****************************************************************************
-#if defined(ENABLE_DECRYPTION) || defined(DOXYGEN)
-void
-DecryptData(unsigned char *pucBuffer, unsigned long ulSize)
+static unsigned long
+DownloadData(unsigned long *pulData, unsigned long ulAddress,
+             unsigned long ulSize)
 {
+    if(g_bLZActive)
+    {
+        return(LZDecode((unsigned char *)pulData, ulSize));
+    }
+    return(ProgramDelta(pulData, ulAddress, ulSize));
 }
 #endif
 
 //*****************************************************************************
 //
 //! \internal
-//! Provides a small delay.
-//!
-//! \param ulCount is the number of delay loop iterations to perform.
-//!
-//! This function provides a means of generating a constant length delay.  It
-//! is written in assembly to keep the delay consistent across tool chains,
-//! avoiding the need to tune the delay based on the tool chain in use.
+//! Completes a download.
 //!
-//! The loop below takes 3 cycles/loop.
+//! This function is called once all of the data for a download has been
+//! received.  The last partial word of a compressed image is programmed (and
+//! the download fails if the image is incomplete), and the pages marked as
+//! unchanged for a delta update are forgotten.
 //!
 //! This function is contained in <tt>bl_main.c</tt>.
 //!
 //! \return None.
 //
 //*****************************************************************************
-#ifdef CRYSTAL_FREQ
-#if defined(ewarm)
 static void
-Delay(unsigned long ulCount)
+DownloadDone(void)
 {
-    __asm("    subs    r0, #1\n"
-          "    bne     Delay\n"
-          "    bx      lr");
-}
+#ifdef LZ_WINDOW_SIZE
+    //
+    // See if a compressed download has finished.
+    //
+    if(g_bLZActive)
+    {
+        //
+        // Program the last partial word, filling the rest of it with erased
+        // bytes.
+        //
+        if(g_ulLZCount & 3)
+        {
+            while(g_ulLZCount & 3)
+            {
+                ((unsigned char *)g_pulLZWindow)
+                    [g_ulLZCount & (LZ_WINDOW_SIZE - 1)] = 0xff;
+                g_ulLZCount++;
+            }
+            if(ProgramDelta(g_pulLZWindow +
+                            (((g_ulLZCount - 4) & (LZ_WINDOW_SIZE - 1)) / 4),
+                            g_ulLZAddress, 4))
+            {
+                g_ucStatus = COMMAND_RET_FLASH_FAIL;
+            }
+        }
+
+        //
+        // The download fails if the compressed data did not produce the
+        // entire image.
+        //
+        if(g_ulLZSize || g_ulLZMatch)
+        {
+            g_ucStatus = COMMAND_RET_FLASH_FAIL;
+        }
+        g_bLZActive = false;
+    }
 #endif
-#if defined(gcc) || defined(sourcerygxx)
-static void __attribute__((naked))
-Delay(unsigned long ulCount)
-{
-    __asm("    subs    r0, #1\n"
-          "    bne     Delay\n"
-          "    bx      lr");
-}
+
+#ifdef ENABLE_DELTA_UPDATE
+    //
+    // Forget the unchanged pages.
+    //
+    DeltaClear();
 #endif
-#if defined(rvmdk) || defined(__ARMCC_VERSION)
-__asm void
-Delay(unsigned long ulCount)
-{
-    subs    r0, #1;
-    bne     Delay;
-    bx      lr;
 }
+
+//*****************************************************************************
+//
+//! \internal
+//! Receives the remainder of a download as a stream of frames.
+//!
+//! This function receives the frames sent following a
+//! COMMAND_SEND_DATA_STREAM command, until all of the data indicated by the
+//! COMMAND_DOWNLOAD command has been received.  Each frame is acknowledged as
+//! soon as it has been received, and is then programmed into the flash while
+//! the following frame is being received into the other buffer.  A frame that
+//! is lost or corrupted is answered with a single NAK, after which frames are
+//! discarded until the expected frame is sent again.
+//!
+//! This function is contained in <tt>bl_main.c</tt>.
+//!
+//! \return None.
+//
+//*****************************************************************************
+#ifdef STREAM_BUFFER_SIZE
+static void
+StreamData(void)
+{
+    unsigned long ulBuffer, ulAddress, ulPending, ulLength, ulSeq;
+    unsigned char pucReply[2];
+    tBoolean bNaked;
+
+    //
+    // The first frame has a sequence number of one, and the first buffer is
+    // not holding a frame to be programmed.
+    //
+    g_ucStreamSeq = 1;
+    ulBuffer = 0;
+    ulAddress = 0;
+    ulPending = 0;
+    bNaked = false;
+
+    //
+    // Loop until all of the data has been received.
+    //
+    while(g_ulTransferSize)
+    {
+        //
+        // Start receiving the next frame into the free buffer.
+        //
+        g_pucStreamData = (unsigned char *)g_pulStreamBuffer[ulBuffer];
+        g_ulStreamCount = 0;
+        g_ulStreamLength = 2;
+
+        //
+        // Program the previous frame, receiving this frame while the flash is
+        // busy.
+        //
+        if(ulPending)
+        {
+            if(DownloadData(g_pulStreamBuffer[ulBuffer ^ 1], ulAddress,
+                            ulPending))
+            {
+                g_ucStatus = COMMAND_RET_FLASH_FAIL;
+            }
+            ulPending = 0;
+        }
+
+        //
+        // Wait for the rest of this frame to arrive.
+        //
+        while(g_ulStreamCount < g_ulStreamLength)
+        {
+            StreamReceive();
+        }
+        g_pucStreamData = 0;
+
+        //
+        // Determine whether the frame was received intact.
+        //
+        ulSeq = g_pucStreamHeader[0];
+        ulLength = g_ulStreamLength - 2;
+        pucReply[1] = ulSeq;
+        if(((CheckSum((unsigned char *)g_pulStreamBuffer[ulBuffer],
+                      ulLength) + ulSeq) & 0xff) != g_pucStreamHeader[1])
+        {
+            ulSeq = 0;
+        }
+
+        //
+        // See if this is the expected frame.
+        //
+        if(ulSeq == g_ucStreamSeq)
+        {
+            //
+            // Acknowledge the frame.
+            //
+            pucReply[0] = COMMAND_ACK;
+            SendDataNoWait(pucReply, 2);
+
+            //
+            // This function is a stub to show where to insert a function to
+            // decrypt the data as it is received.
+            //
+#ifdef ENABLE_DECRYPTION
+            DecryptData((unsigned char *)g_pulStreamBuffer[ulBuffer],
+                        ulLength);
 #endif
+
+            //
+            // Program this frame while the next one is received into the
+            // other buffer.
+            //
+            ulPending = ulLength;
+            ulAddress = g_ulTransferAddress;
+            ulBuffer ^= 1;
+
+            //
+            // Move on to the next frame.
+            //
+            g_ulTransferSize -= ulLength;
+            g_ulTransferAddress = DeltaAdvance(g_ulTransferAddress, ulLength);
+            g_ucStreamSeq = (g_ucStreamSeq == 255) ? 1 : (g_ucStreamSeq + 1);
+            bNaked = false;
+        }
+
+        //
+        // An intact frame that was sent before the expected frame has already
+        // been received, so its acknowledgement must have been lost.
+        //
+        else if(ulSeq && (STREAM_DISTANCE(ulSeq) > STREAM_MAX_WINDOW))
+        {
+            pucReply[0] = COMMAND_ACK;
+            SendDataNoWait(pucReply, 2);
+        }
+
+        //
+        // Otherwise, a frame has been lost or corrupted, so ask for the
+        // expected frame to be resent (unless this has already been done).
+        //
+        else if(!bNaked)
+        {
+            pucReply[0] = COMMAND_NAK;
+            pucReply[1] = g_ucStreamSeq;
+            SendDataNoWait(pucReply, 2);
+            bNaked = true;
+        }
+    }
+
+    //
+    // Program the last frame.
+    //
+    if(ulPending &&
+       DownloadData(g_pulStreamBuffer[ulBuffer ^ 1], ulAddress, ulPending))
+    {
+        g_ucStatus = COMMAND_RET_FLASH_FAIL;
+    }
+
+    //
+    // The download is done.
+    //
+    DownloadDone();
+}
 #endif
 
 //*****************************************************************************
@@ -418,10 +1427,17 @@ ConfigureDevice(void)
 
 #ifdef UART_AUTOBAUD
     //
-    // Need to ack in the UART case to hold it up while we get things set up.
+    // Need to ack in the UART case to hold it up while we get things set up.
+    //
+    AckPacket();
+#endif
+#endif
+
+#ifdef ENET_ENABLE_UPDATE
+    //
+    // Configure the Ethernet controller.
     //
-    AckPacket();
-#endif
+    ConfigureEnet();
 #endif
 }
 
@@ -440,7 +1456,16 @@ ConfigureDevice(void)
 void
 Updater(void)
 {
-    unsigned long ulSize, ulTemp, ulFlashSize;
+#ifdef ENET_ENABLE_UPDATE
+    //
+    // Perform the update via BOOTP and TFTP.  This never returns.
+    //
+    UpdateBOOTP();
+#else
+    unsigned long ulSize, ulFlashSize;
+#ifdef ENABLE_VERIFY
+    unsigned long ulAddress, ulIdx;
+#endif
 
     //
     // This ensures proper alignment of the global buffer so that the one byte
@@ -499,6 +1524,9 @@ Updater(void)
             //
             // This command indicates the start of a download sequence.
             //
+#ifdef LZ_WINDOW_SIZE
+            case COMMAND_DOWNLOAD_COMPRESSED:
+#endif
             case COMMAND_DOWNLOAD:
             {
                 //
@@ -506,6 +1534,23 @@ Updater(void)
                 //
                 g_ucStatus = COMMAND_RET_SUCCESS;
 
+#ifdef LZ_WINDOW_SIZE
+                //
+                // The download is not compressed until it has been started.
+                //
+                g_bLZActive = false;
+
+                //
+                // A compressed download also gives the size of the compressed
+                // data, which is checked as if it were a fourth word of a
+                // normal download command.
+                //
+                if(g_pucDataBuffer[0] == COMMAND_DOWNLOAD_COMPRESSED)
+                {
+                    ulSize -= 4;
+                }
+#endif
+
                 //
                 // A simple do/while(0) control loop to make error exits
                 // easier.
@@ -534,6 +1579,17 @@ Updater(void)
                     g_ulTransferAddress = SwapWord(g_pulDataBuffer[1]);
                     g_ulTransferSize = SwapWord(g_pulDataBuffer[2]);
 
+#ifdef ENABLE_DELTA_UPDATE
+                    //
+                    // Pages can only be skipped when the application is being
+                    // downloaded.
+                    //
+                    if(g_ulTransferAddress != APP_START_ADDRESS)
+                    {
+                        DeltaClear();
+                    }
+#endif
+
                     //
                     // This determines the size of the flash available on the
                     // part in use.
@@ -590,39 +1646,43 @@ Updater(void)
                     ulFlashSize = g_ulTransferAddress + g_ulTransferSize;
 #endif
 
-                    //
-                    // Clear the flash access interrupt.
-                    //
-                    HWREG(FLASH_FCMISC) = FLASH_FCMISC_AMISC;
-
                     //
                     // Leave the boot loader present until we start getting an
-                    // image.
+                    // image, returning an error if an access violation
+                    // occurred.
                     //
-                    for(ulTemp = g_ulTransferAddress; ulTemp < ulFlashSize;
-                        ulTemp += 0x400)
+                    if(EraseBlocks(g_ulTransferAddress, ulFlashSize))
                     {
-                        //
-                        // Erase this block.
-                        //
-                        HWREG(FLASH_FMA) = ulTemp;
-                        HWREG(FLASH_FMC) = FLASH_FMC_WRKEY | FLASH_FMC_ERASE;
-
-                        //
-                        // Wait until this block has been erased.
-                        //
-                        while(HWREG(FLASH_FMC) & FLASH_FMC_ERASE)
-                        {
-                        }
+                        g_ucStatus = COMMAND_RET_FLASH_FAIL;
                     }
 
+#ifdef ENABLE_DELTA_UPDATE
                     //
-                    // Return an error if an access violation occurred.
+                    // The host only sends the data for the pages that have
+                    // changed.
                     //
-                    if(HWREG(FLASH_FCRIS) & FLASH_FCRIS_ARIS)
+                    g_ulTransferSize = DeltaSize(g_ulTransferAddress,
+                                                 g_ulTransferSize);
+                    g_ulTransferAddress = DeltaAdvance(g_ulTransferAddress, 0);
+#endif
+
+#ifdef LZ_WINDOW_SIZE
+                    //
+                    // For a compressed download, the image is decompressed
+                    // starting at the transfer address, and the host sends the
+                    // given number of bytes of compressed data.
+                    //
+                    if(g_pucDataBuffer[0] == COMMAND_DOWNLOAD_COMPRESSED)
                     {
-                        g_ucStatus = COMMAND_RET_FLASH_FAIL;
+                        g_bLZActive = true;
+                        g_ulLZCount = 0;
+                        g_ulLZAddress = g_ulTransferAddress;
+                        g_ulLZSize = g_ulTransferSize;
+                        g_ulLZFlags = 1;
+                        g_ulLZMatch = 0;
+                        g_ulTransferSize = SwapWord(g_pulDataBuffer[3]);
                     }
+#endif
                 }
                 while(0);
 
@@ -638,6 +1698,14 @@ Updater(void)
                     g_ulTransferSize = 0;
                 }
 
+                //
+                // Complete the download now if there is no data to be sent.
+                //
+                if(g_ulTransferSize == 0)
+                {
+                    DownloadDone();
+                }
+
                 //
                 // Acknowledge that this command was received correctly.  This
                 // does not indicate success, just that the command was
@@ -790,34 +1858,10 @@ Updater(void)
                 if(g_ulTransferAddress == 0)
                 {
                     //
-                    // Clear the flash access interrupt.
-                    //
-                    HWREG(FLASH_FCMISC) = FLASH_FCMISC_AMISC;
-
-                    //
-                    // Erase the application before the boot loader.
-                    //
-                    for(ulTemp = 0; ulTemp < APP_START_ADDRESS;
-                        ulTemp += 0x400)
-                    {
-                        //
-                        // Erase this block.
-                        //
-                        HWREG(FLASH_FMA) = ulTemp;
-                        HWREG(FLASH_FMC) = FLASH_FMC_WRKEY | FLASH_FMC_ERASE;
-
-                        //
-                        // Wait until this block has been erased.
-                        //
-                        while(HWREG(FLASH_FMC) & FLASH_FMC_ERASE)
-                        {
-                        }
-                    }
-
-                    //
-                    // Return an error if an access violation occurred.
+                    // Erase the application before the boot loader, returning
+                    // an error if an access violation occurred.
                     //
-                    if(HWREG(FLASH_FCRIS) & FLASH_FCRIS_ARIS)
+                    if(EraseBlocks(0, APP_START_ADDRESS))
                     {
                         //
                         // Setting g_ulTransferSize to zero makes
@@ -851,34 +1895,11 @@ Updater(void)
 #endif
 
                     //
-                    // Clear the flash access interrupt.
-                    //
-                    HWREG(FLASH_FCMISC) = FLASH_FCMISC_AMISC;
-
-                    //
-                    // Loop over the words to program.
-                    //
-                    for(ulTemp = 0; ulTemp < ((ulSize + 3) & ~3); ulTemp += 4)
-                    {
-                        //
-                        // Program the next word.
-                        //
-                        HWREG(FLASH_FMA) = g_ulTransferAddress + ulTemp;
-                        HWREG(FLASH_FMD) = g_pulDataBuffer[(ulTemp >> 2) + 1];
-                        HWREG(FLASH_FMC) = FLASH_FMC_WRKEY | FLASH_FMC_WRITE;
-
-                        //
-                        // Wait until the word has been programmed.
-                        //
-                        while(HWREG(FLASH_FMC) & FLASH_FMC_WRITE)
-                        {
-                        }
-                    }
-
-                    //
-                    // Return an error if an access violation occurred.
+                    // Program the data, returning an error if an access
+                    // violation occurred.
                     //
-                    if(HWREG(FLASH_FCRIS) & FLASH_FCRIS_ARIS)
+                    if(DownloadData(g_pulDataBuffer + 1, g_ulTransferAddress,
+                                    ulSize))
                     {
                         //
                         // Indicate that the flash programming failed.
@@ -891,7 +1912,17 @@ Updater(void)
                         // Now update the address to program.
                         //
                         g_ulTransferSize -= ulSize;
-                        g_ulTransferAddress += ulSize;
+                        g_ulTransferAddress = DeltaAdvance(g_ulTransferAddress,
+                                                           ulSize);
+                    }
+
+                    //
+                    // Complete the download once all the data has been
+                    // received.
+                    //
+                    if(g_ulTransferSize == 0)
+                    {
+                        DownloadDone();
                     }
                 }
                 else
@@ -916,6 +1947,284 @@ Updater(void)
                 break;
             }
 
+#ifdef STREAM_BUFFER_SIZE
+            //
+            // This command is sent to stream the rest of the data to the
+            // device following a download command.
+            //
+            case COMMAND_SEND_DATA_STREAM:
+            {
+                //
+                // Acknowledge that this command was received correctly.  This
+                // does not indicate success, just that the command was
+                // received.
+                //
+                AckPacket();
+
+                //
+                // Until determined otherwise, the command status is success.
+                //
+                g_ucStatus = COMMAND_RET_SUCCESS;
+
+                //
+                // Limit the block size to the size of the stream buffers and
+                // the window to the largest that can be supported.
+                //
+                g_ulStreamBlock = (((g_pucDataBuffer[1] << 8) |
+                                    g_pucDataBuffer[2]) & ~3);
+                if(g_ulStreamBlock > sizeof(g_pulStreamBuffer[0]))
+                {
+                    g_ulStreamBlock = sizeof(g_pulStreamBuffer[0]);
+                }
+                if(g_pucDataBuffer[3] > STREAM_MAX_WINDOW)
+                {
+                    g_pucDataBuffer[3] = STREAM_MAX_WINDOW;
+                }
+
+                //
+                // See if a full packet was received and if there is any data
+                // left to be received.
+                //
+                if((ulSize != 4) || (g_ulTransferSize == 0) ||
+                   (g_ulStreamBlock == 0) || (g_pucDataBuffer[3] == 0))
+                {
+                    //
+                    // Indicate that an invalid command was received, and
+                    // refuse to stream any data.
+                    //
+                    g_ucStatus = COMMAND_RET_INVALID_CMD;
+                    g_ulStreamBlock = 0;
+                    g_pucDataBuffer[3] = 0;
+                }
+
+                //
+                // If this is overwriting the boot loader then the application
+                // has already been erased so now erase the boot loader.
+                //
+                else if((g_ulTransferAddress == 0) &&
+                        EraseBlocks(0, APP_START_ADDRESS))
+                {
+                    //
+                    // Indicate that the flash erase failed, and refuse to
+                    // stream any data.
+                    //
+                    g_ucStatus = COMMAND_RET_FLASH_FAIL;
+                    g_ulTransferSize = 0;
+                    g_ulStreamBlock = 0;
+                    g_pucDataBuffer[3] = 0;
+                }
+
+                //
+                // Tell the host the block size and window that were accepted.
+                //
+                g_pucDataBuffer[1] = g_ulStreamBlock >> 8;
+                g_pucDataBuffer[2] = g_ulStreamBlock;
+                if(SendPacket(g_pucDataBuffer + 1, 3) != 0)
+                {
+                    //
+                    // The host did not receive the reply, so it will not be
+                    // streaming any data.
+                    //
+                    break;
+                }
+
+                //
+                // Receive the stream of data.
+                //
+                if(g_ulStreamBlock)
+                {
+                    StreamData();
+                }
+
+                //
+                // Go back and wait for a new command.
+                //
+                break;
+            }
+#endif
+
+#ifdef ENABLE_VERIFY
+            //
+            // This command returns the CRC of a range of the flash.
+            //
+            case COMMAND_VERIFY:
+            {
+                //
+                // Acknowledge that this command was received correctly.  This
+                // does not indicate success, just that the command was
+                // received.
+                //
+                AckPacket();
+
+                //
+                // Until determined otherwise, the command status is success.
+                //
+                g_ucStatus = COMMAND_RET_SUCCESS;
+
+                //
+                // Get the address and size of the range.
+                //
+                ulAddress = SwapWord(g_pulDataBuffer[1]);
+                ulIdx = SwapWord(g_pulDataBuffer[2]);
+
+                //
+                // This determines the size of the flash available on the
+                // device in use.
+                //
+                ulFlashSize = (((HWREG(SYSCTL_DC0) &
+                                 SYSCTL_DC0_FLASHSZ_M) + 1) << 11);
+
+                //
+                // See if a full packet was received and if the range is
+                // within the flash.
+                //
+                if(ulSize != 9)
+                {
+                    g_ucStatus = COMMAND_RET_INVALID_CMD;
+                    ulIdx = 0;
+                }
+                else if((ulAddress > ulFlashSize) ||
+                        (ulIdx > (ulFlashSize - ulAddress)))
+                {
+                    g_ucStatus = COMMAND_RET_INVALID_ADR;
+                    ulIdx = 0;
+                }
+
+                //
+                // Compute the CRC of the range, or return zero if the range is
+                // not valid.
+                //
+                if(g_ucStatus == COMMAND_RET_SUCCESS)
+                {
+                    g_pulDataBuffer[1] = SwapWord(CRC32(ulAddress, ulIdx));
+                }
+                else
+                {
+                    g_pulDataBuffer[1] = 0;
+                }
+
+                //
+                // Return the CRC to the updater.
+                //
+                SendPacket(g_pucDataBuffer + 1, 4);
+
+                //
+                // Go back and wait for a new command.
+                //
+                break;
+            }
+#endif
+
+#ifdef ENABLE_DELTA_UPDATE
+            //
+            // This command marks the pages of the application that are
+            // unchanged by the next download.
+            //
+            case COMMAND_PAGE_CRC:
+            {
+                //
+                // Acknowledge that this command was received correctly.  This
+                // does not indicate success, just that the command was
+                // received.
+                //
+                AckPacket();
+
+                //
+                // Until determined otherwise, the command status is success.
+                //
+                g_ucStatus = COMMAND_RET_SUCCESS;
+
+                //
+                // Get the address of the first page.
+                //
+                ulAddress = SwapWord(g_pulDataBuffer[1]);
+
+                //
+                // Determine the end of the application area.
+                //
+                ulFlashSize = (((HWREG(SYSCTL_DC0) &
+                                 SYSCTL_DC0_FLASHSZ_M) + 1) << 11);
+#ifdef FLASH_RSVD_SPACE
+                ulFlashSize -= FLASH_RSVD_SPACE;
+#endif
+
+                //
+                // See if a full packet was received.  The number of pages is
+                // determined by the size of the packet.
+                //
+                if((ulSize < 5) || ((ulSize - 5) & 3))
+                {
+                    g_ucStatus = COMMAND_RET_INVALID_CMD;
+                    ulSize = 5;
+                }
+                ulSize = (ulSize - 5) / 4;
+
+                //
+                // See if the address is the start of a page in the application
+                // area.  If not, none of the pages are marked as unchanged.
+                //
+                if((g_ucStatus == COMMAND_RET_SUCCESS) &&
+                   ((ulAddress < APP_START_ADDRESS) ||
+                    (ulAddress >= ulFlashSize) || (ulAddress & 0x3ff)))
+                {
+                    g_ucStatus = COMMAND_RET_INVALID_ADR;
+                    ulFlashSize = 0;
+                }
+
+                //
+                // Compare the CRC of each page with the CRC given for it.
+                // The response bits are built up over the start of the buffer
+                // (which has already been read) since each response byte is
+                // written after the CRCs that it covers have been read.
+                //
+                for(ulIdx = 0; ulIdx < ulSize; ulIdx++, ulAddress += 0x400)
+                {
+                    //
+                    // Start a new byte of the response every eight pages.
+                    //
+                    if((ulIdx & 7) == 0)
+                    {
+                        g_pucDataBuffer[1 + (ulIdx / 8)] = 0;
+                    }
+
+                    //
+                    // Pages beyond the application area are always changed.
+                    //
+                    if(ulAddress >= ulFlashSize)
+                    {
+                        continue;
+                    }
+
+                    //
+                    // Mark the page as unchanged if the CRC matches, or as
+                    // changed otherwise.
+                    //
+                    if(CRC32(ulAddress, 0x400) ==
+                       SwapWord(g_pulDataBuffer[2 + ulIdx]))
+                    {
+                        g_pulDeltaSame[ulAddress >> 15] |=
+                            1 << ((ulAddress >> 10) & 31);
+                        g_pucDataBuffer[1 + (ulIdx / 8)] |= 1 << (ulIdx & 7);
+                    }
+                    else
+                    {
+                        g_pulDeltaSame[ulAddress >> 15] &=
+                            ~(1 << ((ulAddress >> 10) & 31));
+                    }
+                }
+
+                //
+                // Return the unchanged page flags to the updater.
+                //
+                SendPacket(g_pucDataBuffer + 1, (ulSize + 7) / 8);
+
+                //
+                // Go back and wait for a new command.
+                //
+                break;
+            }
+#endif
+
             //
             // This command is used to reset the device.
             //
@@ -973,6 +2282,7 @@ Updater(void)
             }
         }
     }
+#endif
 }
 
 //*****************************************************************************
@@ -39,7 +39,7 @@
 //! @{
 //
 //*****************************************************************************
-
+#ifndef ENET_ENABLE_UPDATE
 //*****************************************************************************
 //
 // The packet that is sent to acknowledge a received packet.
@@ -296,6 +296,7 @@ SendPacket(unsigned char *pucData, unsigned long ulSize)
     //
     return(0);
 }
+#endif
 
 //*****************************************************************************
 //
@@ -37,5 +37,7 @@
 extern int ReceivePacket(unsigned char *pucData, unsigned long *pulSize);
 extern int SendPacket(unsigned char *pucData, unsigned long ulSize);
 extern void AckPacket(void);
+extern unsigned long CheckSum(const unsigned char *pucData,
+                              unsigned long ulSize);
 
 #endif // __BL_PACKET_H__
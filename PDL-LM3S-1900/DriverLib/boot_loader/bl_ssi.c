@@ -86,6 +86,45 @@ SSISend(const unsigned char *pucData, unsigned long ulSize)
     }
 }
 
+//*****************************************************************************
+//
+//! Sends data via the SSI port in slave mode without waiting for it to be
+//! transmitted.
+//!
+//! \param pucData is the location of the data to send through the SSI port.
+//! \param ulSize is the number of bytes of data to send.
+//!
+//! This function places data into the SSI transmit FIFO, to be clocked out by
+//! the master along with the data that it is sending.  Unlike SSISend(), the
+//! receive FIFO is not emptied, so no received data is lost.
+//!
+//! This function is contained in <tt>bl_ssi.c</tt>.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SSISendNoWait(const unsigned char *pucData, unsigned long ulSize)
+{
+    //
+    // Send the requested number of bytes over the SSI port.
+    //
+    while(ulSize--)
+    {
+        //
+        // Wait until there is space in the SSI FIFO.
+        //
+        while(!(HWREG(SSI0_BASE + SSI_O_SR) & SSI_SR_TNF))
+        {
+        }
+
+        //
+        // Write the next byte to the SSI port.
+        //
+        HWREG(SSI0_BASE + SSI_O_DR) = *pucData++;
+    }
+}
+
 //*****************************************************************************
 //
 //! Waits until all data has been transmitted by the SSI port.
@@ -160,6 +199,64 @@ SSIReceive(unsigned char *pucData, unsigned long ulSize)
     }
 }
 
+//*****************************************************************************
+//
+//! Receives any data that is available from the SSI port in slave mode.
+//!
+//! \param pucData is the location to store the data received from the SSI
+//! port.
+//! \param ulSize is the maximum number of bytes of data to receive.
+//!
+//! This function reads up to \e ulSize bytes of data from the SSI port.  Only
+//! the data that is already in the receive FIFO is read; this function does
+//! not wait for more data to arrive.  A zero is placed into the transmit FIFO
+//! whenever it is empty, so that the master always clocks out zeros (which
+//! the host ignores) when the boot loader has nothing to send.
+//!
+//! This function is contained in <tt>bl_ssi.c</tt>.
+//!
+//! \return Returns the number of bytes read into \e pucData.
+//
+//*****************************************************************************
+unsigned long
+SSIReceiveNonBlocking(unsigned char *pucData, unsigned long ulSize)
+{
+    unsigned long ulCount;
+
+    //
+    // Read bytes until the FIFO is empty or the buffer is full.
+    //
+    for(ulCount = 0; ulCount < ulSize; ulCount++)
+    {
+        //
+        // Keep something in the transmit FIFO so that we don't confuse the
+        // host.
+        //
+        if(HWREG(SSI0_BASE + SSI_O_SR) & SSI_SR_TFE)
+        {
+            HWREG(SSI0_BASE + SSI_O_DR) = 0;
+        }
+
+        //
+        // Stop if the receive FIFO is empty.
+        //
+        if(!(HWREG(SSI0_BASE + SSI_O_SR) & SSI_SR_RNE))
+        {
+            break;
+        }
+
+        //
+        // Read the next byte from the FIFO.
+        //
+        *pucData++ = HWREG(SSI0_BASE + SSI_O_DR);
+    }
+
+    //
+    // Return the number of bytes received.
+    //
+    return(ulCount);
+}
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
@@ -79,7 +79,10 @@
 //
 //*****************************************************************************
 extern void SSISend(unsigned char const *pucData, unsigned long ulSize);
+extern void SSISendNoWait(unsigned char const *pucData, unsigned long ulSize);
 extern void SSIReceive(unsigned char *pucData, unsigned long ulSize);
+extern unsigned long SSIReceiveNonBlocking(unsigned char *pucData,
+                                           unsigned long ulSize);
 extern void SSIFlush(void);
 
 //*****************************************************************************
@@ -91,6 +94,8 @@ extern void SSIFlush(void);
 #define SendData                SSISend
 #define FlushData               SSIFlush
 #define ReceiveData             SSIReceive
+#define SendDataNoWait          SSISendNoWait
+#define ReceiveDataNonBlocking  SSIReceiveNonBlocking
 #endif
 
 #endif // __BL_SSI_H__
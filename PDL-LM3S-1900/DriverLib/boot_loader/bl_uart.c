@@ -85,6 +85,48 @@ UARTSend(const unsigned char *pucData, unsigned long ulSize)
     UARTFlush();
 }
 
+//*****************************************************************************
+//
+//! Sends data over the UART port without waiting for it to be transmitted.
+//!
+//! \param pucData is the buffer containing the data to write out to the UART
+//! port.
+//! \param ulSize is the number of bytes provided in \e pucData buffer that
+//! will be written out to the UART port.
+//!
+//! This function places \e ulSize bytes of data from the buffer pointed to by
+//! \e pucData into the UART transmit FIFO, returning as soon as the last byte
+//! has been placed into the FIFO instead of waiting for the data to be
+//! transmitted.  This allows data to be received while the data is being
+//! transmitted.
+//!
+//! This function is contained in <tt>bl_uart.c</tt>.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTSendNoWait(const unsigned char *pucData, unsigned long ulSize)
+{
+    //
+    // Transmit the number of bytes requested on the UART port.
+    //
+    while(ulSize--)
+    {
+        //
+        // Make sure that the transmit FIFO is not full.
+        //
+        while((HWREG(UART0_BASE + UART_O_FR) & UART_FR_TXFF))
+        {
+        }
+
+        //
+        // Send out the next byte.
+        //
+        HWREG(UART0_BASE + UART_O_DR) = *pucData++;
+    }
+}
+
 //*****************************************************************************
 //
 //! Waits until all data has been transmitted by the UART port.
@@ -155,6 +197,54 @@ UARTReceive(unsigned char *pucData, unsigned long ulSize)
     }
 }
 
+//*****************************************************************************
+//
+//! Receives any data that is available from the UART port.
+//!
+//! \param pucData is the buffer to read data into from the UART port.
+//! \param ulSize is the maximum number of bytes to be written to the
+//! \e pucData buffer.
+//!
+//! This function reads up to \e ulSize bytes of data from the UART port into
+//! the buffer that is pointed to by \e pucData.  Only the data that is already
+//! in the receive FIFO is read; this function does not wait for more data to
+//! arrive.
+//!
+//! This function is contained in <tt>bl_uart.c</tt>.
+//!
+//! \return Returns the number of bytes read into \e pucData.
+//
+//*****************************************************************************
+unsigned long
+UARTReceiveNonBlocking(unsigned char *pucData, unsigned long ulSize)
+{
+    unsigned long ulCount;
+
+    //
+    // Read bytes until the FIFO is empty or the buffer is full.
+    //
+    for(ulCount = 0; ulCount < ulSize; ulCount++)
+    {
+        //
+        // Stop if the FIFO is empty.
+        //
+        if(HWREG(UART0_BASE + UART_O_FR) & UART_FR_RXFE)
+        {
+            break;
+        }
+
+        //
+        // Receive a byte from the UART.
+        //
+        *pucData++ = HWREG(UART0_BASE + UART_O_DR);
+    }
+
+    //
+    // Return the number of bytes received.
+    //
+    return(ulCount);
+}
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
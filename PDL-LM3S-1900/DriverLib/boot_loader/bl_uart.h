@@ -66,7 +66,10 @@
 //
 //*****************************************************************************
 extern void UARTSend(const unsigned char *pucData, unsigned long ulSize);
+extern void UARTSendNoWait(const unsigned char *pucData, unsigned long ulSize);
 extern void UARTReceive(unsigned char *pucData, unsigned long ulSize);
+extern unsigned long UARTReceiveNonBlocking(unsigned char *pucData,
+                                            unsigned long ulSize);
 extern void UARTFlush(void);
 extern int UARTAutoBaud(unsigned long *pulRatio);
 
@@ -79,6 +82,8 @@ extern int UARTAutoBaud(unsigned long *pulRatio);
 #define SendData                UARTSend
 #define FlushData               UARTFlush
 #define ReceiveData             UARTReceive
+#define SendDataNoWait          UARTSendNoWait
+#define ReceiveDataNonBlocking  UARTReceiveNonBlocking
 #endif
 
 #endif // __BL_UART_H__
@@ -0,0 +1,66 @@
+//*****************************************************************************
+//
+// lwipopts.h - Configuration file for lwIP, used by the heap benchmark.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+//
+// NOTE:  Only the options that affect the heap are set here; they match the
+// enet_lwip example, so that its traffic can be replayed against the same
+// heap.  For additional details, refer to the original "opt.h" file, and
+// lwIP documentation.
+//
+//*****************************************************************************
+
+#ifndef __LWIPOPTS_H__
+#define __LWIPOPTS_H__
+
+//*****************************************************************************
+//
+// ---------- System options ----------
+//
+//*****************************************************************************
+#define NO_SYS                          1       // default is 0
+
+//*****************************************************************************
+//
+// ---------- Memory options ----------
+//
+//*****************************************************************************
+#define MEM_ALIGNMENT                   4       // default is 1
+#define MEM_SIZE                        (4*1024)
+                                                // default is 1600
+#ifndef MEM_USE_TLSF
+#define MEM_USE_TLSF                    1       // default is 0
+#endif
+
+//*****************************************************************************
+//
+// ---------- Statistics options ----------
+//
+//*****************************************************************************
+#define LWIP_STATS                      1
+#define MEM_STATS                       1
+
+#endif // __LWIPOPTS_H__
@@ -0,0 +1,575 @@
+//*****************************************************************************
+//
+// mem_bench.c - Trace replay benchmark for the lwIP heap.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//*****************************************************************************
+//
+// The heap is built into the benchmark, rather than linked with it, so that
+// its internal structures can be checked after each operation.  The heap that
+// is built (TLSF or first fit) is chosen by MEM_USE_TLSF.
+//
+//*****************************************************************************
+#include "mem.c"
+
+//*****************************************************************************
+//
+// The heap statistics, which are normally supplied by stats.c.
+//
+//*****************************************************************************
+struct stats_ lwip_stats;
+
+//*****************************************************************************
+//
+// The largest block identifier that a trace may use, and the number of times
+// that the trace is replayed when it is timed.
+//
+//*****************************************************************************
+#define MAX_IDS                 65536
+#define TIMED_PASSES            20
+
+//*****************************************************************************
+//
+// An operation of a trace, which either allocates a block of the given size
+// and names it with the identifier, or frees the block with the identifier.
+//
+//*****************************************************************************
+typedef struct
+{
+    unsigned long ulID;
+    unsigned short usSize;
+    unsigned char ucAlloc;
+}
+tTraceOp;
+
+//*****************************************************************************
+//
+// The trace being replayed, along with the block allocated for (and the size
+// requested by) each identifier.
+//
+//*****************************************************************************
+static tTraceOp *g_psOps;
+static unsigned long g_ulNumOps;
+static unsigned long g_ulMaxOps;
+static unsigned char *g_ppucBlocks[MAX_IDS];
+static unsigned short g_pusSizes[MAX_IDS];
+
+//*****************************************************************************
+//
+// Appends an operation to the trace.
+//
+//*****************************************************************************
+static void
+TraceAdd(int bAlloc, unsigned long ulID, unsigned long ulSize)
+{
+    //
+    // Grow the trace if it is full.
+    //
+    if(g_ulNumOps == g_ulMaxOps)
+    {
+        g_ulMaxOps = g_ulMaxOps ? (g_ulMaxOps * 2) : 65536;
+        g_psOps = realloc(g_psOps, g_ulMaxOps * sizeof(tTraceOp));
+        if(!g_psOps)
+        {
+            fprintf(stderr, "mem_bench: out of memory\n");
+            exit(1);
+        }
+    }
+
+    //
+    // Add the operation.
+    //
+    g_psOps[g_ulNumOps].ulID = ulID;
+    g_psOps[g_ulNumOps].usSize = (unsigned short)ulSize;
+    g_psOps[g_ulNumOps].ucAlloc = bAlloc ? 1 : 0;
+    g_ulNumOps++;
+}
+
+//*****************************************************************************
+//
+// Reads a recorded trace.  Each line is either "a <id> <size>" for a call to
+// mem_malloc() or "f <id>" for the matching call to mem_free().
+//
+//*****************************************************************************
+static void
+TraceRead(const char *pcFile)
+{
+    unsigned long ulID, ulSize, ulLine;
+    char pcBuf[64], cOp;
+    FILE *pFile;
+
+    pFile = fopen(pcFile, "r");
+    if(!pFile)
+    {
+        fprintf(stderr, "mem_bench: can not open %s\n", pcFile);
+        exit(1);
+    }
+    for(ulLine = 1; fgets(pcBuf, sizeof(pcBuf), pFile); ulLine++)
+    {
+        ulSize = 0;
+        if((sscanf(pcBuf, " %c %lu %lu", &cOp, &ulID, &ulSize) < 2) ||
+           ((cOp != 'a') && (cOp != 'f')) || (ulID >= MAX_IDS) ||
+           (ulSize > MEM_SIZE))
+        {
+            fprintf(stderr, "mem_bench: %s:%lu: bad trace line\n", pcFile,
+                    ulLine);
+            exit(1);
+        }
+        TraceAdd(cOp == 'a', ulID, ulSize);
+    }
+    fclose(pFile);
+}
+
+//*****************************************************************************
+//
+// A simple pseudo-random number generator, so that the synthetic trace is the
+// same on every host.
+//
+//*****************************************************************************
+static unsigned long g_ulSeed = 1;
+
+static unsigned long
+Random(unsigned long ulRange)
+{
+    g_ulSeed = (g_ulSeed * 1103515245) + 12345;
+    return(((g_ulSeed & 0xffffffff) >> 8) % ulRange);
+}
+
+//*****************************************************************************
+//
+// Generates a trace shaped like the heap traffic of the enet_lwip web server
+// when no recorded trace is given.  Each request from one of four clients
+// allocates the connection state and the open file, then a PBUF_RAM header
+// for each segment of a file sent from flash, or a copy of each segment of a
+// generated page.  Up to two windows of segments are outstanding, and are
+// freed as they are acknowledged.  Short lived ARP and ICMP replies are mixed
+// in, and the state of a client's previous request is freed when it makes
+// the next one.
+//
+//*****************************************************************************
+#define WINDOW_SEGS             8
+
+static void
+TraceGenerate(unsigned long ulRequests)
+{
+    unsigned long ulReq, ulSeg, ulNumSegs, ulClient, ulID, ulSize;
+    unsigned long pulQueue[2 * WINDOW_SEGS], ulQueued, pulConn[4][2];
+    int bCopied;
+
+    ulID = 0;
+    ulQueued = 0;
+    for(ulClient = 0; ulClient < 4; ulClient++)
+    {
+        pulConn[ulClient][0] = 0xffffffff;
+    }
+    for(ulReq = 0; ulReq < ulRequests; ulReq++)
+    {
+        //
+        // Free the state of the client's previous request, and allocate the
+        // connection state and open file for this one.
+        //
+        ulClient = Random(4);
+        if(pulConn[ulClient][0] != 0xffffffff)
+        {
+            TraceAdd(0, pulConn[ulClient][0], 0);
+            TraceAdd(0, pulConn[ulClient][1], 0);
+        }
+        pulConn[ulClient][0] = ulID;
+        TraceAdd(1, ulID++, 28);
+        pulConn[ulClient][1] = ulID;
+        TraceAdd(1, ulID++, 20);
+
+        //
+        // Send the response, one segment at a time.
+        //
+        ulNumSegs = 1 + Random(12);
+        bCopied = Random(3) == 0;
+        for(ulSeg = 0; ulSeg < ulNumSegs; ulSeg++)
+        {
+            //
+            // Free the oldest outstanding segment if both windows are full,
+            // or at random when it has been acknowledged.
+            //
+            if((ulQueued == (2 * WINDOW_SEGS)) || (ulQueued && Random(2)))
+            {
+                TraceAdd(0, pulQueue[0], 0);
+                memmove(pulQueue, pulQueue + 1,
+                        --ulQueued * sizeof(pulQueue[0]));
+            }
+
+            //
+            // Allocate the segment, which is either just the headers or a
+            // copy of part of a generated page.
+            //
+            ulSize = bCopied ? (156 + Random(1360)) : 70;
+            pulQueue[ulQueued++] = ulID;
+            TraceAdd(1, ulID++, ulSize);
+
+            //
+            // Now and then, reply to an ARP request or a ping.
+            //
+            if(Random(8) == 0)
+            {
+                TraceAdd(1, ulID, 114);
+                TraceAdd(0, ulID++, 0);
+            }
+        }
+
+        //
+        // Reuse the identifiers once they are all taken; the blocks that
+        // they named were freed long ago.
+        //
+        if(ulID > (MAX_IDS - 100))
+        {
+            ulID = 0;
+        }
+    }
+
+    //
+    // Free everything that is still allocated.
+    //
+    while(ulQueued)
+    {
+        TraceAdd(0, pulQueue[--ulQueued], 0);
+    }
+    for(ulClient = 0; ulClient < 4; ulClient++)
+    {
+        if(pulConn[ulClient][0] != 0xffffffff)
+        {
+            TraceAdd(0, pulConn[ulClient][0], 0);
+            TraceAdd(0, pulConn[ulClient][1], 0);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Reports a broken heap invariant and stops.
+//
+//*****************************************************************************
+static void
+CheckFail(unsigned long ulOp, const char *pcWhat)
+{
+    printf("mem_bench: after operation %lu: %s\n", ulOp, pcWhat);
+    exit(1);
+}
+
+//*****************************************************************************
+//
+// Walks the heap, checking that the blocks link up from the start of the heap
+// to the end and (for the TLSF heap) that the free lists and bitmaps match
+// the free blocks.  The number of free blocks and the size of the largest are
+// returned.
+//
+//*****************************************************************************
+static void
+HeapCheck(unsigned long ulOp, unsigned long *pulFree, unsigned long *pulLargest)
+{
+    unsigned long ulFree, ulLargest, ulSize;
+    unsigned long ulPtr, ulPrev;
+    struct mem *psMem;
+#if MEM_USE_TLSF
+    unsigned long ulListed;
+    int bLastFree;
+    u8_t ucFL, ucSL, ucClassFL, ucClassSL;
+#endif
+
+    //
+    // Walk the blocks in address order.
+    //
+    ulFree = 0;
+    ulLargest = 0;
+#if MEM_USE_TLSF
+    bLastFree = 0;
+#endif
+    for(ulPtr = 0, ulPrev = 0; ulPtr < MEM_SIZE; ulPrev = ulPtr,
+        ulPtr = psMem->next)
+    {
+        psMem = (struct mem *)&ram[ulPtr];
+        if(psMem->prev != ulPrev)
+        {
+            CheckFail(ulOp, "block does not link back to the previous one");
+        }
+        if(psMem->next <= ulPtr)
+        {
+            CheckFail(ulOp, "block does not link forward");
+        }
+        if(!psMem->used)
+        {
+            ulSize = psMem->next - ulPtr - SIZEOF_STRUCT_MEM;
+            ulFree++;
+            if(ulSize > ulLargest)
+            {
+                ulLargest = ulSize;
+            }
+#if MEM_USE_TLSF
+            if(bLastFree)
+            {
+                CheckFail(ulOp, "adjacent free blocks were not merged");
+            }
+#endif
+        }
+#if MEM_USE_TLSF
+        bLastFree = !psMem->used;
+#endif
+    }
+    if(ulPtr != MEM_SIZE)
+    {
+        CheckFail(ulOp, "blocks run past the end of the heap");
+    }
+
+#if MEM_USE_TLSF
+    //
+    // Check that each list holds only free blocks of its size class, that its
+    // bits are set exactly when it is not empty, and that every free block is
+    // on a list.
+    //
+    ulListed = 0;
+    for(ucFL = 0; ucFL < MEM_TLSF_FL_COUNT; ucFL++)
+    {
+        if(((mem_fl_bitmap >> ucFL) & 1) != (mem_sl_bitmap[ucFL] != 0))
+        {
+            CheckFail(ulOp, "first level bitmap does not match its lists");
+        }
+        for(ucSL = 0; ucSL < MEM_TLSF_SL_COUNT; ucSL++)
+        {
+            if(((mem_sl_bitmap[ucFL] >> ucSL) & 1) !=
+               (mem_lists[ucFL][ucSL] != MEM_SIZE))
+            {
+                CheckFail(ulOp, "second level bitmap does not match a list");
+            }
+            for(ulPtr = mem_lists[ucFL][ucSL], ulPrev = MEM_SIZE;
+                ulPtr != MEM_SIZE; ulPrev = ulPtr,
+                ulPtr = MEM_LINK(psMem)->next)
+            {
+                psMem = (struct mem *)&ram[ulPtr];
+                if(psMem->used || (MEM_LINK(psMem)->prev != ulPrev))
+                {
+                    CheckFail(ulOp, "free list is broken");
+                }
+                mem_mapping(psMem->next - ulPtr - SIZEOF_STRUCT_MEM,
+                            &ucClassFL, &ucClassSL);
+                if((ucClassFL != ucFL) || (ucClassSL != ucSL))
+                {
+                    CheckFail(ulOp, "free block is on the wrong list");
+                }
+                ulListed++;
+            }
+        }
+    }
+    if((ulListed != ulFree) || (lwip_stats.mem.free_blocks != ulFree))
+    {
+        CheckFail(ulOp, "free block count does not match the heap");
+    }
+
+    //
+    // The largest free block reported is the first on the highest list, which
+    // may be smaller than the largest block by up to the width of the list.
+    //
+    if((lwip_stats.mem.largest_free > ulLargest) ||
+       ((((lwip_stats.mem.largest_free * 9) / 8) + 8) < ulLargest))
+    {
+        CheckFail(ulOp, "largest free block is wrongly reported");
+    }
+#endif
+
+    //
+    // Return the free block count and the largest free block.
+    //
+    *pulFree = ulFree;
+    *pulLargest = ulLargest;
+}
+
+//*****************************************************************************
+//
+// Replays the trace once with every check enabled.  The contents of each
+// block are filled in when it is allocated and checked when it is freed, and
+// the heap is checked after every operation.  The mean fragmentation (one
+// minus the largest free block over the free space) is returned.
+//
+//*****************************************************************************
+static double
+ReplayChecked(unsigned long *pulFailed)
+{
+    unsigned long ulOp, ulIdx, ulFree, ulLargest, ulSamples;
+    unsigned char *pucBlock;
+    tTraceOp *psOp;
+    double dFrag;
+    long lSpace;
+
+    mem_init();
+    memset(g_ppucBlocks, 0, sizeof(g_ppucBlocks));
+    *pulFailed = 0;
+    dFrag = 0;
+    ulSamples = 0;
+    for(ulOp = 0; ulOp < g_ulNumOps; ulOp++)
+    {
+        psOp = &g_psOps[ulOp];
+        if(psOp->ucAlloc)
+        {
+            if(g_ppucBlocks[psOp->ulID])
+            {
+                CheckFail(ulOp, "trace allocates a block that is in use");
+            }
+            pucBlock = mem_malloc(psOp->usSize);
+            if(pucBlock)
+            {
+                memset(pucBlock, psOp->ulID & 0xff, psOp->usSize);
+            }
+            else
+            {
+                (*pulFailed)++;
+            }
+            g_ppucBlocks[psOp->ulID] = pucBlock;
+            g_pusSizes[psOp->ulID] = psOp->usSize;
+        }
+        else
+        {
+            pucBlock = g_ppucBlocks[psOp->ulID];
+            for(ulIdx = 0; pucBlock && (ulIdx < g_pusSizes[psOp->ulID]);
+                ulIdx++)
+            {
+                if(pucBlock[ulIdx] != (psOp->ulID & 0xff))
+                {
+                    CheckFail(ulOp, "block was overwritten");
+                }
+            }
+            mem_free(pucBlock);
+            g_ppucBlocks[psOp->ulID] = 0;
+        }
+
+        //
+        // Check the heap, and measure its fragmentation whenever there is
+        // some free space.
+        //
+        HeapCheck(ulOp, &ulFree, &ulLargest);
+        lSpace = MEM_SIZE - lwip_stats.mem.used;
+        if((lSpace > 0) && ulFree)
+        {
+            dFrag += 1.0 - ((double)ulLargest / lSpace);
+            ulSamples++;
+        }
+    }
+
+    return(ulSamples ? (dFrag / ulSamples) : 0);
+}
+
+//*****************************************************************************
+//
+// Replays the trace without any checks, returning the time taken in
+// nanoseconds.
+//
+//*****************************************************************************
+static double
+ReplayTimed(void)
+{
+    struct timespec sStart, sEnd;
+    unsigned long ulOp;
+    tTraceOp *psOp;
+
+    mem_init();
+    memset(g_ppucBlocks, 0, sizeof(g_ppucBlocks));
+    clock_gettime(CLOCK_MONOTONIC, &sStart);
+    for(ulOp = 0, psOp = g_psOps; ulOp < g_ulNumOps; ulOp++, psOp++)
+    {
+        if(psOp->ucAlloc)
+        {
+            g_ppucBlocks[psOp->ulID] = mem_malloc(psOp->usSize);
+        }
+        else
+        {
+            mem_free(g_ppucBlocks[psOp->ulID]);
+            g_ppucBlocks[psOp->ulID] = 0;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &sEnd);
+
+    return(((sEnd.tv_sec - sStart.tv_sec) * 1e9) +
+           (sEnd.tv_nsec - sStart.tv_nsec));
+}
+
+//*****************************************************************************
+//
+// Replays a recorded trace (or a synthetic one if none is named), first with
+// the heap checked after every operation and then timed.
+//
+//*****************************************************************************
+int
+main(int argc, char *argv[])
+{
+    unsigned long ulPass, ulFailed;
+    double dFrag, dTime, dBest;
+
+    //
+    // Get the trace.
+    //
+    if(argc > 1)
+    {
+        TraceRead(argv[1]);
+    }
+    else
+    {
+        TraceGenerate(20000);
+    }
+
+    //
+    // Replay it with the checks, which stops the program if the heap is
+    // found to be broken.
+    //
+    dFrag = ReplayChecked(&ulFailed);
+
+    //
+    // Replay it for timing, keeping the fastest pass.
+    //
+    dBest = 0;
+    for(ulPass = 0; ulPass < TIMED_PASSES; ulPass++)
+    {
+        dTime = ReplayTimed();
+        if(!ulPass || (dTime < dBest))
+        {
+            dBest = dTime;
+        }
+    }
+
+    //
+    // Report the results.
+    //
+    printf("heap:          %s, %d bytes\n",
+           MEM_USE_TLSF ? "TLSF" : "first fit", MEM_SIZE);
+    printf("operations:    %lu\n", g_ulNumOps);
+    printf("failed allocs: %lu\n", ulFailed);
+    printf("peak used:     %lu bytes\n", (unsigned long)lwip_stats.mem.max);
+    printf("fragmentation: %.3f\n", dFrag);
+    printf("time:          %.1f ns per operation\n", dBest / g_ulNumOps);
+
+    return(0);
+}
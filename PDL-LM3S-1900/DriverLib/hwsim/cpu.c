@@ -0,0 +1,73 @@
+//*****************************************************************************
+//
+// cpu.c - Host replacements for the CPU instruction wrapper functions.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+#include "../hw_types.h"
+#include "../src/cpu.h"
+#include "hwsim.h"
+
+//*****************************************************************************
+//
+// Wrapper function for the CPSID instruction.  Returns the state of PRIMASK
+// on entry.
+//
+//*****************************************************************************
+unsigned long
+CPUcpsid(void)
+{
+    return(HWSimPrimaskSet(1));
+}
+
+//*****************************************************************************
+//
+// Wrapper function for the CPSIE instruction.  Returns the state of PRIMASK
+// on entry.  Since the simulator only delivers interrupts at well defined
+// points, any interrupts that became pending while interrupts were disabled
+// are taken here.
+//
+//*****************************************************************************
+unsigned long
+CPUcpsie(void)
+{
+    unsigned long ulRet;
+
+    ulRet = HWSimPrimaskSet(0);
+    HWSimIntService();
+    return(ulRet);
+}
+
+//*****************************************************************************
+//
+// Wrapper function for the WFI instruction.  Pending interrupts are taken
+// immediately rather than waiting for one to occur.
+//
+//*****************************************************************************
+void
+CPUwfi(void)
+{
+    HWSimIntService();
+}
@@ -0,0 +1,887 @@
+//*****************************************************************************
+//
+// hwsim.c - Host-side peripheral register simulator.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The simulator works by reserving the Stellaris peripheral address windows
+// in the host process and leaving them inaccessible.  Every HWREG(),
+// HWREGH(), HWREGB() and HWREGBITW() access from the driver library therefore
+// faults; the fault handler routes the access to the peripheral model that
+// claims the address, briefly exposes the accessed page, single-steps the
+// faulting instruction, and then hides the page again.  The driver library
+// itself is compiled unmodified, so the register access sequence seen by the
+// models is exactly the one that the target would see.
+//
+// This relies on the x86 page fault error code and trap flag, so it is only
+// supported on Linux hosts running 32-bit (ILP32) x86 code.
+//
+//*****************************************************************************
+
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include "../hw_ints.h"
+#include "../hw_memmap.h"
+#include "../hw_nvic.h"
+#include "../hw_sysctl.h"
+#include "../hw_types.h"
+#include "hwsim.h"
+
+#if !defined(__i386__) && !defined(__x86_64__)
+#error The peripheral simulator requires an x86 host.
+#endif
+
+//*****************************************************************************
+//
+// The address windows that are reserved in the host process.
+//
+//*****************************************************************************
+#define HWSIM_PERIPH_BASE       0x40000000
+#define HWSIM_PERIPH_SIZE       0x00100000
+#define HWSIM_BITBAND_BASE      0x42000000
+#define HWSIM_BITBAND_SIZE      0x02000000
+#define HWSIM_SCS_BASE          0xE000E000
+#define HWSIM_SCS_SIZE          0x00001000
+
+//*****************************************************************************
+//
+// The x86 page fault error code bit that indicates a write access, and the
+// x86 EFLAGS trap flag.
+//
+//*****************************************************************************
+#define HWSIM_PF_WRITE          0x00000002
+#define HWSIM_EFLAGS_TF         0x00000100
+
+//*****************************************************************************
+//
+// The maximum number of interrupt handlers that HWSimIntService() will run
+// before returning, which prevents a handler that fails to clear its
+// interrupt source from hanging the host.
+//
+//*****************************************************************************
+#define HWSIM_MAX_INT_LOOPS     64
+
+//*****************************************************************************
+//
+// The register contents of the peripheral and system control space windows.
+// The reserved windows themselves are only used as staging cells for the
+// instruction being stepped; the models always work on these copies.
+//
+//*****************************************************************************
+static unsigned long g_pulHWSimPeriphRegs[HWSIM_PERIPH_SIZE / 4];
+static unsigned long g_pulHWSimSCSRegs[HWSIM_SCS_SIZE / 4];
+
+//*****************************************************************************
+//
+// The list of registered peripheral models.
+//
+//*****************************************************************************
+static tHWSimPeriph *g_psHWSimPeriphs;
+
+//*****************************************************************************
+//
+// The global access statistics.
+//
+//*****************************************************************************
+static tHWSimStats g_sHWSimStats;
+
+//*****************************************************************************
+//
+// The current simulated time, in processor cycles.
+//
+//*****************************************************************************
+static unsigned long g_ulHWSimCycles;
+
+//*****************************************************************************
+//
+// The host page size.
+//
+//*****************************************************************************
+static unsigned long g_ulHWSimPageSize;
+
+//*****************************************************************************
+//
+// The state of the access currently being single-stepped.
+//
+//*****************************************************************************
+static struct
+{
+    unsigned long ulAddr;
+    unsigned long ulPage;
+    tBoolean bWrite;
+    tBoolean bActive;
+}
+g_sHWSimStep;
+
+//*****************************************************************************
+//
+// The simulated PRIMASK register, the pending interrupts (indexed by
+// interrupt number - 16), and a flag that prevents nested interrupt service.
+//
+//*****************************************************************************
+static unsigned long g_ulHWSimPrimask;
+static unsigned long g_pulHWSimIntPending[2];
+static tBoolean g_bHWSimInService;
+
+//*****************************************************************************
+//
+// Returns a pointer to the register copy for an address, or 0 if the address
+// is not in a simulated window.
+//
+//*****************************************************************************
+static unsigned long *
+HWSimRegPtr(unsigned long ulAddr)
+{
+    if((ulAddr - HWSIM_PERIPH_BASE) < HWSIM_PERIPH_SIZE)
+    {
+        return(&g_pulHWSimPeriphRegs[(ulAddr - HWSIM_PERIPH_BASE) / 4]);
+    }
+    if((ulAddr - HWSIM_SCS_BASE) < HWSIM_SCS_SIZE)
+    {
+        return(&g_pulHWSimSCSRegs[(ulAddr - HWSIM_SCS_BASE) / 4]);
+    }
+    return(0);
+}
+
+//*****************************************************************************
+//
+//! Gets the current contents of a simulated register.
+//!
+//! \param ulAddr is the address of the register.
+//!
+//! This returns the stored contents of a register without invoking the
+//! peripheral model or counting an access, and is intended for use by the
+//! peripheral models and by test code inspecting peripheral state.
+//!
+//! \return Returns the register contents, or 0 if the address is not within
+//! a simulated window.
+//
+//*****************************************************************************
+unsigned long
+HWSimRegGet(unsigned long ulAddr)
+{
+    unsigned long *pulReg;
+
+    pulReg = HWSimRegPtr(ulAddr & ~3);
+    return(pulReg ? *pulReg : 0);
+}
+
+//*****************************************************************************
+//
+//! Sets the contents of a simulated register.
+//!
+//! \param ulAddr is the address of the register.
+//! \param ulValue is the new register contents.
+//!
+//! This stores a register value without invoking the peripheral model or
+//! counting an access.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+HWSimRegSet(unsigned long ulAddr, unsigned long ulValue)
+{
+    unsigned long *pulReg;
+
+    pulReg = HWSimRegPtr(ulAddr & ~3);
+    if(pulReg)
+    {
+        *pulReg = ulValue;
+    }
+}
+
+//*****************************************************************************
+//
+//! Registers a peripheral model with the simulator.
+//!
+//! \param psPeriph is the peripheral model to register.
+//!
+//! Register accesses within the address range of \e psPeriph are routed to
+//! its read and write functions.  Peripherals registered later take
+//! precedence over those registered earlier.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+HWSimPeriphRegister(tHWSimPeriph *psPeriph)
+{
+    psPeriph->ulReads = 0;
+    psPeriph->ulWrites = 0;
+    psPeriph->psNext = g_psHWSimPeriphs;
+    g_psHWSimPeriphs = psPeriph;
+}
+
+//*****************************************************************************
+//
+//! Finds the peripheral model that claims an address.
+//!
+//! \param ulAddr is the address to look up.
+//!
+//! \return Returns the peripheral model, or 0 if no model claims the address.
+//
+//*****************************************************************************
+tHWSimPeriph *
+HWSimPeriphFind(unsigned long ulAddr)
+{
+    tHWSimPeriph *psPeriph;
+
+    for(psPeriph = g_psHWSimPeriphs; psPeriph; psPeriph = psPeriph->psNext)
+    {
+        if((ulAddr - psPeriph->ulBase) < psPeriph->ulSize)
+        {
+            return(psPeriph);
+        }
+    }
+    return(0);
+}
+
+//*****************************************************************************
+//
+// Performs a simulated register read, including the model's side effects.
+//
+//*****************************************************************************
+static unsigned long
+HWSimRead(unsigned long ulAddr)
+{
+    tHWSimPeriph *psPeriph;
+
+    g_sHWSimStats.ulReads++;
+    g_ulHWSimCycles += HWSIM_ACCESS_CYCLES;
+
+    psPeriph = HWSimPeriphFind(ulAddr);
+    if(psPeriph)
+    {
+        psPeriph->ulReads++;
+        if(psPeriph->pfnRead)
+        {
+            return(psPeriph->pfnRead(psPeriph, ulAddr - psPeriph->ulBase));
+        }
+    }
+    return(HWSimRegGet(ulAddr));
+}
+
+//*****************************************************************************
+//
+// Performs a simulated register write, including the model's side effects.
+//
+//*****************************************************************************
+static void
+HWSimWrite(unsigned long ulAddr, unsigned long ulValue)
+{
+    tHWSimPeriph *psPeriph;
+
+    g_sHWSimStats.ulWrites++;
+    g_ulHWSimCycles += HWSIM_ACCESS_CYCLES;
+
+    psPeriph = HWSimPeriphFind(ulAddr);
+    if(psPeriph)
+    {
+        psPeriph->ulWrites++;
+        if(psPeriph->pfnWrite)
+        {
+            psPeriph->pfnWrite(psPeriph, ulAddr - psPeriph->ulBase, ulValue);
+            return;
+        }
+    }
+    HWSimRegSet(ulAddr, ulValue);
+}
+
+//*****************************************************************************
+//
+// Converts a peripheral bit-band alias address into the address of the
+// aliased register and the bit number within it.
+//
+//*****************************************************************************
+static unsigned long
+HWSimBitBandTarget(unsigned long ulAddr, unsigned long *pulBit)
+{
+    *pulBit = ((ulAddr - HWSIM_BITBAND_BASE) >> 2) & 31;
+    return(HWSIM_PERIPH_BASE + (((ulAddr - HWSIM_BITBAND_BASE) >> 5) & ~3));
+}
+
+//*****************************************************************************
+//
+// Restores the default action for a signal that was not caused by a
+// simulated access, so that the fault is reported normally when the faulting
+// instruction is restarted.
+//
+//*****************************************************************************
+static void
+HWSimSignalDefault(int iSignal)
+{
+    struct sigaction sAction;
+
+    memset(&sAction, 0, sizeof(sAction));
+    sAction.sa_handler = SIG_DFL;
+    sigaction(iSignal, &sAction, 0);
+}
+
+//*****************************************************************************
+//
+// The SIGSEGV handler, which is invoked at the start of every simulated
+// register access.  The value to be read (or, for a write, the current value
+// to be partially overwritten) is placed in the staging cell, the page is
+// exposed, and the trap flag is set so that the faulting instruction is
+// executed by itself.
+//
+//*****************************************************************************
+static void
+HWSimFaultHandler(int iSignal, siginfo_t *psInfo, void *pvContext)
+{
+    ucontext_t *psContext = pvContext;
+    unsigned long ulAddr, ulTarget, ulBit, ulValue;
+    tBoolean bWrite;
+
+    ulAddr = (unsigned long)psInfo->si_addr;
+
+    //
+    // Let faults outside the simulated windows (or nested faults) crash the
+    // program as they normally would.
+    //
+    if(g_sHWSimStep.bActive ||
+       (((ulAddr - HWSIM_PERIPH_BASE) >= HWSIM_PERIPH_SIZE) &&
+        ((ulAddr - HWSIM_BITBAND_BASE) >= HWSIM_BITBAND_SIZE) &&
+        ((ulAddr - HWSIM_SCS_BASE) >= HWSIM_SCS_SIZE)))
+    {
+        HWSimSignalDefault(SIGSEGV);
+        return;
+    }
+
+    bWrite = ((psContext->uc_mcontext.gregs[REG_ERR] & HWSIM_PF_WRITE) ?
+              true : false);
+
+    //
+    // Determine the value that the instruction should see.  A write only
+    // needs the current contents (so that byte and halfword writes merge
+    // correctly); a read performs the model's read side effects.
+    //
+    if((ulAddr - HWSIM_BITBAND_BASE) < HWSIM_BITBAND_SIZE)
+    {
+        ulTarget = HWSimBitBandTarget(ulAddr, &ulBit);
+        ulValue = bWrite ? HWSimRegGet(ulTarget) : HWSimRead(ulTarget);
+        ulValue = (ulValue >> ulBit) & 1;
+    }
+    else
+    {
+        ulValue = bWrite ? HWSimRegGet(ulAddr & ~3) : HWSimRead(ulAddr & ~3);
+    }
+
+    //
+    // Expose the page, stage the value, and single-step the instruction.
+    //
+    g_sHWSimStep.ulAddr = ulAddr;
+    g_sHWSimStep.ulPage = ulAddr & ~(g_ulHWSimPageSize - 1);
+    g_sHWSimStep.bWrite = bWrite;
+    g_sHWSimStep.bActive = true;
+    mprotect((void *)g_sHWSimStep.ulPage, g_ulHWSimPageSize,
+             PROT_READ | PROT_WRITE);
+    *(volatile unsigned long *)(ulAddr & ~3) = ulValue;
+    psContext->uc_mcontext.gregs[REG_EFL] |= HWSIM_EFLAGS_TF;
+}
+
+//*****************************************************************************
+//
+// The SIGTRAP handler, which is invoked after the faulting instruction has
+// been stepped.  A written value is passed to the peripheral model and the
+// page is hidden again.
+//
+//*****************************************************************************
+static void
+HWSimStepHandler(int iSignal, siginfo_t *psInfo, void *pvContext)
+{
+    ucontext_t *psContext = pvContext;
+    unsigned long ulAddr, ulTarget, ulBit, ulValue;
+
+    if(!g_sHWSimStep.bActive)
+    {
+        HWSimSignalDefault(SIGTRAP);
+        raise(SIGTRAP);
+        return;
+    }
+
+    psContext->uc_mcontext.gregs[REG_EFL] &= ~HWSIM_EFLAGS_TF;
+    ulAddr = g_sHWSimStep.ulAddr;
+
+    if(g_sHWSimStep.bWrite)
+    {
+        ulValue = *(volatile unsigned long *)(ulAddr & ~3);
+        if((ulAddr - HWSIM_BITBAND_BASE) < HWSIM_BITBAND_SIZE)
+        {
+            ulTarget = HWSimBitBandTarget(ulAddr, &ulBit);
+            HWSimWrite(ulTarget, ((HWSimRegGet(ulTarget) & ~(1 << ulBit)) |
+                                  ((ulValue & 1) << ulBit)));
+        }
+        else
+        {
+            HWSimWrite(ulAddr & ~3, ulValue);
+        }
+    }
+
+    mprotect((void *)g_sHWSimStep.ulPage, g_ulHWSimPageSize, PROT_NONE);
+    g_sHWSimStep.bActive = false;
+}
+
+//*****************************************************************************
+//
+// Reserves one of the simulated address windows.
+//
+//*****************************************************************************
+static void
+HWSimWindowMap(unsigned long ulBase, unsigned long ulSize)
+{
+    void *pvMap;
+
+    pvMap = mmap((void *)ulBase, ulSize, PROT_NONE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if(pvMap != (void *)ulBase)
+    {
+        fprintf(stderr, "hwsim: unable to reserve 0x%08lx-0x%08lx\n", ulBase,
+                ulBase + ulSize - 1);
+        exit(1);
+    }
+}
+
+//*****************************************************************************
+//
+// The NVIC model.  The set/clear enable and pending registers are folded
+// onto the enable and pending state; everything else behaves as memory.
+//
+//*****************************************************************************
+static unsigned long
+HWSimNVICRead(tHWSimPeriph *psPeriph, unsigned long ulOffset)
+{
+    unsigned long ulAddr = psPeriph->ulBase + ulOffset;
+
+    switch(ulAddr)
+    {
+        case NVIC_EN0:
+        case NVIC_DIS0:
+        {
+            return(HWSimRegGet(NVIC_EN0));
+        }
+        case NVIC_EN1:
+        case NVIC_DIS1:
+        {
+            return(HWSimRegGet(NVIC_EN1));
+        }
+        case NVIC_PEND0:
+        case NVIC_UNPEND0:
+        {
+            return(g_pulHWSimIntPending[0]);
+        }
+        case NVIC_PEND1:
+        case NVIC_UNPEND1:
+        {
+            return(g_pulHWSimIntPending[1]);
+        }
+        default:
+        {
+            return(HWSimRegGet(ulAddr));
+        }
+    }
+}
+
+static void
+HWSimNVICWrite(tHWSimPeriph *psPeriph, unsigned long ulOffset,
+               unsigned long ulValue)
+{
+    unsigned long ulAddr = psPeriph->ulBase + ulOffset;
+
+    switch(ulAddr)
+    {
+        case NVIC_EN0:
+        case NVIC_EN1:
+        {
+            HWSimRegSet(ulAddr, HWSimRegGet(ulAddr) | ulValue);
+            break;
+        }
+        case NVIC_DIS0:
+        case NVIC_DIS1:
+        {
+            ulAddr -= NVIC_DIS0 - NVIC_EN0;
+            HWSimRegSet(ulAddr, HWSimRegGet(ulAddr) & ~ulValue);
+            break;
+        }
+        case NVIC_PEND0:
+        case NVIC_PEND1:
+        {
+            g_pulHWSimIntPending[(ulAddr - NVIC_PEND0) / 4] |= ulValue;
+            break;
+        }
+        case NVIC_UNPEND0:
+        case NVIC_UNPEND1:
+        {
+            g_pulHWSimIntPending[(ulAddr - NVIC_UNPEND0) / 4] &= ~ulValue;
+            break;
+        }
+        default:
+        {
+            HWSimRegSet(ulAddr, ulValue);
+            break;
+        }
+    }
+}
+
+static tHWSimPeriph g_sHWSimNVIC =
+{
+    "NVIC", NVIC_BASE, HWSIM_SCS_SIZE, 0, HWSimNVICRead, HWSimNVICWrite
+};
+
+//*****************************************************************************
+//
+// The system control model.  The identification and capability registers
+// describe an LM3S8962 with every peripheral present, and the PLL always
+// reports that it is locked.  The PLL configuration reflects the crystal
+// selected in RCC, so that the PLL output is (close to) 400 MHz, which is
+// divided by two before reaching the system clock divider.
+//
+//*****************************************************************************
+static const unsigned long g_pulHWSimXtals[] =
+{
+    1000000, 1843200, 2000000, 2457600, 3579545, 3686400, 4000000, 4096000,
+    4915200, 5000000, 5120000, 6000000, 6144000, 7372800, 8000000, 8192000
+};
+
+static unsigned long
+HWSimSysCtlRead(tHWSimPeriph *psPeriph, unsigned long ulOffset)
+{
+    unsigned long ulAddr = psPeriph->ulBase + ulOffset;
+    unsigned long ulF;
+
+    if(ulAddr == SYSCTL_RIS)
+    {
+        return(HWSimRegGet(ulAddr) | SYSCTL_RIS_PLLLRIS);
+    }
+    if(ulAddr == SYSCTL_PLLCFG)
+    {
+        ulF = (400000000 /
+               g_pulHWSimXtals[(HWSimRegGet(SYSCTL_RCC) & SYSCTL_RCC_XTAL_M) >>
+                               SYSCTL_RCC_XTAL_S]);
+        if(ulF > (SYSCTL_PLLCFG_F_M >> SYSCTL_PLLCFG_F_S))
+        {
+            ulF = SYSCTL_PLLCFG_F_M >> SYSCTL_PLLCFG_F_S;
+        }
+        return(ulF << SYSCTL_PLLCFG_F_S);
+    }
+    return(HWSimRegGet(ulAddr));
+}
+
+static void
+HWSimSysCtlWrite(tHWSimPeriph *psPeriph, unsigned long ulOffset,
+                 unsigned long ulValue)
+{
+    unsigned long ulAddr = psPeriph->ulBase + ulOffset;
+
+    //
+    // The identification and capability registers are read-only.
+    //
+    if((ulAddr >= SYSCTL_DID0) && (ulAddr <= SYSCTL_DC4))
+    {
+        return;
+    }
+    HWSimRegSet(ulAddr, ulValue);
+}
+
+static tHWSimPeriph g_sHWSimSysCtl =
+{
+    "SYSCTL", SYSCTL_BASE, 0x1000, 0, HWSimSysCtlRead, HWSimSysCtlWrite
+};
+
+//*****************************************************************************
+//
+//! Initializes the peripheral simulator.
+//!
+//! This reserves the simulated address windows, installs the fault handlers,
+//! and registers the default set of peripheral models.  It must be called
+//! before any driver library function is used.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+HWSimInit(void)
+{
+    struct sigaction sAction;
+
+    g_ulHWSimPageSize = (unsigned long)sysconf(_SC_PAGESIZE);
+
+    HWSimWindowMap(HWSIM_PERIPH_BASE, HWSIM_PERIPH_SIZE);
+    HWSimWindowMap(HWSIM_BITBAND_BASE, HWSIM_BITBAND_SIZE);
+    HWSimWindowMap(HWSIM_SCS_BASE, HWSIM_SCS_SIZE);
+
+    memset(&sAction, 0, sizeof(sAction));
+    sAction.sa_flags = SA_SIGINFO;
+    sigemptyset(&sAction.sa_mask);
+    sAction.sa_sigaction = HWSimFaultHandler;
+    sigaction(SIGSEGV, &sAction, 0);
+    sAction.sa_sigaction = HWSimStepHandler;
+    sigaction(SIGTRAP, &sAction, 0);
+
+    //
+    // Set the reset values of the registers that the driver library relies
+    // upon.
+    //
+    HWSimRegSet(SYSCTL_DID0, (SYSCTL_DID0_VER_1 | SYSCTL_DID0_CLASS_FURY |
+                              SYSCTL_DID0_MAJ_REVA | SYSCTL_DID0_MIN_2));
+    HWSimRegSet(SYSCTL_DID1, (SYSCTL_DID1_VER_1 | SYSCTL_DID1_FAM_STELLARIS |
+                              SYSCTL_DID1_PRTNO_8962 | SYSCTL_DID1_TEMP_I |
+                              SYSCTL_DID1_ROHS));
+    HWSimRegSet(SYSCTL_DC0, 0x00FF007F);
+    HWSimRegSet(SYSCTL_DC1, 0xFFFFFFFF);
+    HWSimRegSet(SYSCTL_DC2, 0xFFFFFFFF);
+    HWSimRegSet(SYSCTL_DC3, 0xFFFFFFFF);
+    HWSimRegSet(SYSCTL_DC4, 0xFFFFFFFF);
+    HWSimRegSet(SYSCTL_RCC, 0x078E3AD1);
+    HWSimRegSet(SYSCTL_RCC2, 0x07802810);
+
+    //
+    // Register the peripheral models.
+    //
+    HWSimPeriphRegister(&g_sHWSimNVIC);
+    HWSimPeriphRegister(&g_sHWSimSysCtl);
+    HWSimFlashInit();
+    HWSimUARTInit();
+    HWSimSSIInit();
+    HWSimEthInit();
+    HWSimCANInit();
+}
+
+//*****************************************************************************
+//
+//! Gets the current simulated time.
+//!
+//! \return Returns the number of processor cycles that have elapsed.
+//
+//*****************************************************************************
+unsigned long
+HWSimCyclesGet(void)
+{
+    return(g_ulHWSimCycles);
+}
+
+//*****************************************************************************
+//
+//! Advances the simulated time.
+//!
+//! \param ulCycles is the number of processor cycles to add.
+//!
+//! This is used by the peripheral models to account for time spent waiting
+//! on the hardware, and by host replacements of delay loops.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+HWSimCyclesAdd(unsigned long ulCycles)
+{
+    g_ulHWSimCycles += ulCycles;
+}
+
+//*****************************************************************************
+//
+//! Gets the access statistics.
+//!
+//! \param psStats is a pointer to the structure to be filled in.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+HWSimStatsGet(tHWSimStats *psStats)
+{
+    *psStats = g_sHWSimStats;
+    psStats->ulCycles = g_ulHWSimCycles - g_sHWSimStats.ulCycles;
+}
+
+//*****************************************************************************
+//
+//! Resets the access statistics.
+//!
+//! This clears the global and per-peripheral access counts and restarts the
+//! cycle count from the current simulated time.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+HWSimStatsReset(void)
+{
+    tHWSimPeriph *psPeriph;
+
+    g_sHWSimStats.ulReads = 0;
+    g_sHWSimStats.ulWrites = 0;
+    g_sHWSimStats.ulCycles = g_ulHWSimCycles;
+
+    for(psPeriph = g_psHWSimPeriphs; psPeriph; psPeriph = psPeriph->psNext)
+    {
+        psPeriph->ulReads = 0;
+        psPeriph->ulWrites = 0;
+    }
+}
+
+//*****************************************************************************
+//
+//! Prints the access statistics to the standard output.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+HWSimStatsPrint(void)
+{
+    tHWSimPeriph *psPeriph;
+    tHWSimStats sStats;
+
+    HWSimStatsGet(&sStats);
+    printf("%-8s %10s %10s\n", "periph", "reads", "writes");
+    for(psPeriph = g_psHWSimPeriphs; psPeriph; psPeriph = psPeriph->psNext)
+    {
+        if(psPeriph->ulReads || psPeriph->ulWrites)
+        {
+            printf("%-8s %10lu %10lu\n", psPeriph->pcName, psPeriph->ulReads,
+                   psPeriph->ulWrites);
+        }
+    }
+    printf("%-8s %10lu %10lu  (%lu cycles)\n", "total", sStats.ulReads,
+           sStats.ulWrites, sStats.ulCycles);
+}
+
+//*****************************************************************************
+//
+//! Pends a simulated interrupt.
+//!
+//! \param ulInterrupt is the interrupt number to pend.
+//!
+//! The interrupt handler is run by the next call to HWSimIntService() if the
+//! interrupt is enabled in the NVIC and processor interrupts are enabled.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+HWSimIntPend(unsigned long ulInterrupt)
+{
+    if(ulInterrupt >= 16)
+    {
+        g_pulHWSimIntPending[(ulInterrupt - 16) / 32] |=
+            1 << ((ulInterrupt - 16) & 31);
+    }
+}
+
+//*****************************************************************************
+//
+//! Runs the handlers for any pending simulated interrupts.
+//!
+//! Each peripheral model is first advanced to the current simulated time and
+//! has its interrupt pended if asserted.  The handler for each interrupt that
+//! is both pending and enabled is then called from the vector table
+//! registered with IntRegister(), lowest interrupt number first.
+//!
+//! Since the host cannot preempt the application, interrupts are only taken
+//! when this function is called, either directly or from CPUcpsie() or
+//! CPUwfi().
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+HWSimIntService(void)
+{
+    void (**ppfnVectors)(void);
+    tHWSimPeriph *psPeriph;
+    unsigned long ulLoop, ulIdx, ulActive;
+
+    if(g_bHWSimInService)
+    {
+        return;
+    }
+    g_bHWSimInService = true;
+
+    for(ulLoop = 0; ulLoop < HWSIM_MAX_INT_LOOPS; ulLoop++)
+    {
+        for(psPeriph = g_psHWSimPeriphs; psPeriph; psPeriph = psPeriph->psNext)
+        {
+            if(psPeriph->pfnUpdate && psPeriph->pfnUpdate(psPeriph) &&
+               psPeriph->ulInt)
+            {
+                HWSimIntPend(psPeriph->ulInt);
+            }
+        }
+
+        ppfnVectors = (void (**)(void))HWSimRegGet(NVIC_VTABLE);
+        if(g_ulHWSimPrimask || !ppfnVectors)
+        {
+            break;
+        }
+
+        for(ulIdx = 0; ulIdx < (NUM_INTERRUPTS - 16); ulIdx++)
+        {
+            ulActive = (g_pulHWSimIntPending[ulIdx / 32] &
+                        HWSimRegGet(NVIC_EN0 + ((ulIdx / 32) * 4)));
+            if(ulActive & (1 << (ulIdx & 31)))
+            {
+                break;
+            }
+        }
+        if(ulIdx == (NUM_INTERRUPTS - 16))
+        {
+            break;
+        }
+
+        g_pulHWSimIntPending[ulIdx / 32] &= ~(1 << (ulIdx & 31));
+        ppfnVectors[ulIdx + 16]();
+    }
+
+    g_bHWSimInService = false;
+}
+
+//*****************************************************************************
+//
+//! Sets the simulated PRIMASK register.
+//!
+//! \param ulPrimask is the new PRIMASK value.
+//!
+//! \return Returns the previous PRIMASK value.
+//
+//*****************************************************************************
+unsigned long
+HWSimPrimaskSet(unsigned long ulPrimask)
+{
+    unsigned long ulOld;
+
+    ulOld = g_ulHWSimPrimask;
+    g_ulHWSimPrimask = ulPrimask;
+    return(ulOld);
+}
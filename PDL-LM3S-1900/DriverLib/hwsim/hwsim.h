@@ -0,0 +1,222 @@
+//*****************************************************************************
+//
+// hwsim.h - Prototypes for the host-side peripheral register simulator.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+#ifndef __HWSIM_H__
+#define __HWSIM_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The number of processor clock cycles charged for each simulated peripheral
+// register access.
+//
+//*****************************************************************************
+#ifndef HWSIM_ACCESS_CYCLES
+#define HWSIM_ACCESS_CYCLES     2
+#endif
+
+//*****************************************************************************
+//
+// The processor clock frequency assumed when converting peripheral timings
+// (baud rates, flash program and erase times) into processor cycles.
+//
+//*****************************************************************************
+#ifndef HWSIM_CLOCK
+#define HWSIM_CLOCK             50000000
+#endif
+
+//*****************************************************************************
+//
+// The size of the simulated flash memory, in bytes.
+//
+//*****************************************************************************
+#ifndef HWSIM_FLASH_SIZE
+#define HWSIM_FLASH_SIZE        0x00040000
+#endif
+
+//*****************************************************************************
+//
+// A simulated peripheral.  The simulator routes every register access within
+// [ulBase, ulBase + ulSize) to the read and write functions of the peripheral
+// that claims the address; accesses to addresses not claimed by any
+// peripheral behave as plain memory.
+//
+//*****************************************************************************
+typedef struct _tHWSimPeriph
+{
+    //
+    // The name of the peripheral, used when reporting statistics.
+    //
+    const char *pcName;
+
+    //
+    // The base address of the peripheral's register block.
+    //
+    unsigned long ulBase;
+
+    //
+    // The size of the peripheral's register block, in bytes.
+    //
+    unsigned long ulSize;
+
+    //
+    // The interrupt number asserted by this peripheral, or zero if it does
+    // not generate interrupts.
+    //
+    unsigned long ulInt;
+
+    //
+    // The function called when a register is read.  It is passed the offset
+    // of the (word aligned) register and returns the value read, applying any
+    // read side effects (such as popping a FIFO).  If NULL, the last value
+    // written to the register is returned.
+    //
+    unsigned long (*pfnRead)(struct _tHWSimPeriph *psPeriph,
+                             unsigned long ulOffset);
+
+    //
+    // The function called when a register is written.  It is passed the
+    // offset of the (word aligned) register and the new value of the entire
+    // word.  If NULL, the value is simply stored.
+    //
+    void (*pfnWrite)(struct _tHWSimPeriph *psPeriph, unsigned long ulOffset,
+                     unsigned long ulValue);
+
+    //
+    // The function called to advance the peripheral to the current simulated
+    // time.  It returns true if the peripheral's interrupt is asserted.  May
+    // be NULL.
+    //
+    tBoolean (*pfnUpdate)(struct _tHWSimPeriph *psPeriph);
+
+    //
+    // Model specific state.
+    //
+    void *pvData;
+
+    //
+    // The number of register reads performed on this peripheral.
+    //
+    unsigned long ulReads;
+
+    //
+    // The number of register writes performed on this peripheral.
+    //
+    unsigned long ulWrites;
+
+    //
+    // The next peripheral in the list of registered peripherals.
+    //
+    struct _tHWSimPeriph *psNext;
+}
+tHWSimPeriph;
+
+//*****************************************************************************
+//
+// The access statistics gathered by the simulator.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The number of peripheral register reads.
+    //
+    unsigned long ulReads;
+
+    //
+    // The number of peripheral register writes.
+    //
+    unsigned long ulWrites;
+
+    //
+    // The estimated number of processor cycles spent in register accesses
+    // and waiting on peripherals.
+    //
+    unsigned long ulCycles;
+}
+tHWSimStats;
+
+//*****************************************************************************
+//
+// Prototypes for the simulator core.
+//
+//*****************************************************************************
+extern void HWSimInit(void);
+extern void HWSimPeriphRegister(tHWSimPeriph *psPeriph);
+extern tHWSimPeriph *HWSimPeriphFind(unsigned long ulAddr);
+extern unsigned long HWSimRegGet(unsigned long ulAddr);
+extern void HWSimRegSet(unsigned long ulAddr, unsigned long ulValue);
+extern unsigned long HWSimCyclesGet(void);
+extern void HWSimCyclesAdd(unsigned long ulCycles);
+extern void HWSimStatsGet(tHWSimStats *psStats);
+extern void HWSimStatsReset(void);
+extern void HWSimStatsPrint(void);
+extern void HWSimIntPend(unsigned long ulInterrupt);
+extern void HWSimIntService(void);
+extern unsigned long HWSimPrimaskSet(unsigned long ulPrimask);
+
+//*****************************************************************************
+//
+// Prototypes for the peripheral models.
+//
+//*****************************************************************************
+extern void HWSimUARTInit(void);
+extern void HWSimUARTRxInject(unsigned long ulBase,
+                              const unsigned char *pucData,
+                              unsigned long ulLen);
+extern unsigned long HWSimUARTTxRead(unsigned long ulBase,
+                                     unsigned char *pucData,
+                                     unsigned long ulLen);
+extern void HWSimSSIInit(void);
+extern void HWSimSSIDeviceSet(unsigned long ulBase,
+                              unsigned long (*pfnXfer)(unsigned long ulTx));
+extern void HWSimEthInit(void);
+extern tBoolean HWSimEthRxInject(const unsigned char *pucFrame,
+                                 unsigned long ulLen);
+extern void HWSimEthTxCallbackSet(void (*pfnTx)(const unsigned char *pucFrame,
+                                                unsigned long ulLen));
+extern void HWSimFlashInit(void);
+extern unsigned char *HWSimFlashGet(void);
+extern unsigned long HWSimFlashEraseCount(void);
+extern void HWSimCANInit(void);
+extern tBoolean HWSimCANRxInject(unsigned long ulBase, unsigned long ulID,
+                                 tBoolean bExtended,
+                                 const unsigned char *pucData,
+                                 unsigned long ulLen);
+extern tBoolean HWSimCANTxGet(unsigned long ulBase, unsigned long *pulID,
+                              unsigned char *pucData, unsigned long *pulLen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __HWSIM_H__
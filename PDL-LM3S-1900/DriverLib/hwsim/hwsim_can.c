@@ -0,0 +1,631 @@
+//*****************************************************************************
+//
+// hwsim_can.c - CAN controller model for the host-side peripheral simulator.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+#include "../hw_can.h"
+#include "../hw_ints.h"
+#include "../hw_memmap.h"
+#include "../hw_types.h"
+#include "hwsim.h"
+
+//*****************************************************************************
+//
+// The number of message objects in each controller, and the number of
+// transmitted frames buffered for collection by the host.
+//
+//*****************************************************************************
+#define CAN_NUM_OBJECTS         32
+#define CAN_TX_QUEUE_SIZE       64
+
+//*****************************************************************************
+//
+// The offset between the IF1 and IF2 register sets.
+//
+//*****************************************************************************
+#define CAN_IF_SPACING          (CAN_O_IF2CRQ - CAN_O_IF1CRQ)
+
+//*****************************************************************************
+//
+// A message object in the controller's message RAM.
+//
+//*****************************************************************************
+typedef struct
+{
+    unsigned long ulMsk1;
+    unsigned long ulMsk2;
+    unsigned long ulArb1;
+    unsigned long ulArb2;
+    unsigned long ulMctl;
+    unsigned long pulData[4];
+}
+tCANObject;
+
+//*****************************************************************************
+//
+// A frame transmitted by the controller.
+//
+//*****************************************************************************
+typedef struct
+{
+    unsigned long ulID;
+    unsigned long ulLen;
+    unsigned char pucData[8];
+}
+tCANFrame;
+
+//*****************************************************************************
+//
+// The state of a simulated CAN controller.
+//
+//*****************************************************************************
+typedef struct
+{
+    tCANObject psObjects[CAN_NUM_OBJECTS];
+    tCANFrame psTxQueue[CAN_TX_QUEUE_SIZE];
+    unsigned long ulTxRead;
+    unsigned long ulTxCount;
+}
+tCANState;
+
+static tCANState g_psCANState[3];
+
+//*****************************************************************************
+//
+// Returns the identifier programmed into a message object.
+//
+//*****************************************************************************
+static unsigned long
+CANObjectID(tCANObject *psObj)
+{
+    if(psObj->ulArb2 & CAN_IF1ARB2_XTD)
+    {
+        return(((psObj->ulArb2 & CAN_IF1ARB2_ID_M) << 16) |
+               (psObj->ulArb1 & CAN_IF1ARB1_ID_M));
+    }
+    return((psObj->ulArb2 & CAN_IF1ARB2_ID_M) >> 2);
+}
+
+//*****************************************************************************
+//
+// Returns the acceptance mask programmed into a message object.
+//
+//*****************************************************************************
+static unsigned long
+CANObjectMask(tCANObject *psObj)
+{
+    if(!(psObj->ulMctl & CAN_IF1MCTL_UMASK))
+    {
+        return(0xFFFFFFFF);
+    }
+    if(psObj->ulArb2 & CAN_IF1ARB2_XTD)
+    {
+        return(((psObj->ulMsk2 & CAN_IF1MSK2_IDMSK_M) << 16) |
+               (psObj->ulMsk1 & CAN_IF1MSK1_IDMSK_M));
+    }
+    return((psObj->ulMsk2 & CAN_IF1MSK2_IDMSK_M) >> 2);
+}
+
+//*****************************************************************************
+//
+// Transmits the frame held in a message object.  The frame is placed on the
+// host transmit queue immediately.
+//
+//*****************************************************************************
+static void
+CANObjectTransmit(tHWSimPeriph *psPeriph, tCANObject *psObj)
+{
+    tCANState *psState = psPeriph->pvData;
+    tCANFrame *psFrame;
+    unsigned long ulIdx;
+
+    psObj->ulMctl &= ~CAN_IF1MCTL_TXRQST;
+    if(psObj->ulMctl & CAN_IF1MCTL_TXIE)
+    {
+        psObj->ulMctl |= CAN_IF1MCTL_INTPND;
+    }
+    HWSimRegSet(psPeriph->ulBase + CAN_O_STS,
+                HWSimRegGet(psPeriph->ulBase + CAN_O_STS) | CAN_STS_TXOK);
+
+    if(psState->ulTxCount == CAN_TX_QUEUE_SIZE)
+    {
+        return;
+    }
+    psFrame = &psState->psTxQueue[(psState->ulTxRead + psState->ulTxCount) %
+                                  CAN_TX_QUEUE_SIZE];
+    psState->ulTxCount++;
+
+    psFrame->ulID = CANObjectID(psObj);
+    psFrame->ulLen = psObj->ulMctl & CAN_IF1MCTL_DLC_M;
+    if(psFrame->ulLen > 8)
+    {
+        psFrame->ulLen = 8;
+    }
+    for(ulIdx = 0; ulIdx < 8; ulIdx++)
+    {
+        psFrame->pucData[ulIdx] = ((psObj->pulData[ulIdx / 2] >>
+                                    ((ulIdx & 1) * 8)) & 0xFF);
+    }
+}
+
+//*****************************************************************************
+//
+// Transfers a message object between the message RAM and one of the IF
+// register sets, as requested by a write to an IFn command request register.
+//
+//*****************************************************************************
+static void
+CANTransfer(tHWSimPeriph *psPeriph, unsigned long ulIF, unsigned long ulCRQ)
+{
+    tCANState *psState = psPeriph->pvData;
+    tCANObject *psObj;
+    unsigned long ulRegs, ulCMSK, ulIdx;
+
+    ulIdx = ulCRQ & CAN_IF1CRQ_MNUM_M;
+    if((ulIdx == 0) || (ulIdx > CAN_NUM_OBJECTS))
+    {
+        return;
+    }
+    psObj = &psState->psObjects[ulIdx - 1];
+    ulRegs = psPeriph->ulBase + (ulIF * CAN_IF_SPACING);
+    ulCMSK = HWSimRegGet(ulRegs + CAN_O_IF1CMSK);
+
+    if(ulCMSK & CAN_IF1CMSK_WRNRD)
+    {
+        if(ulCMSK & CAN_IF1CMSK_MASK)
+        {
+            psObj->ulMsk1 = HWSimRegGet(ulRegs + CAN_O_IF1MSK1);
+            psObj->ulMsk2 = HWSimRegGet(ulRegs + CAN_O_IF1MSK2);
+        }
+        if(ulCMSK & CAN_IF1CMSK_ARB)
+        {
+            psObj->ulArb1 = HWSimRegGet(ulRegs + CAN_O_IF1ARB1);
+            psObj->ulArb2 = HWSimRegGet(ulRegs + CAN_O_IF1ARB2);
+        }
+        if(ulCMSK & CAN_IF1CMSK_CONTROL)
+        {
+            psObj->ulMctl = HWSimRegGet(ulRegs + CAN_O_IF1MCTL);
+        }
+        if(ulCMSK & CAN_IF1CMSK_DATAA)
+        {
+            psObj->pulData[0] = HWSimRegGet(ulRegs + CAN_O_IF1DA1);
+            psObj->pulData[1] = HWSimRegGet(ulRegs + CAN_O_IF1DA2);
+        }
+        if(ulCMSK & CAN_IF1CMSK_DATAB)
+        {
+            psObj->pulData[2] = HWSimRegGet(ulRegs + CAN_O_IF1DB1);
+            psObj->pulData[3] = HWSimRegGet(ulRegs + CAN_O_IF1DB2);
+        }
+        if(ulCMSK & CAN_IF1CMSK_TXRQST)
+        {
+            psObj->ulMctl |= CAN_IF1MCTL_TXRQST;
+        }
+
+        //
+        // A valid transmit object with a pending request goes out at once.
+        //
+        if((psObj->ulArb2 & CAN_IF1ARB2_MSGVAL) &&
+           (psObj->ulArb2 & CAN_IF1ARB2_DIR) &&
+           (psObj->ulMctl & CAN_IF1MCTL_TXRQST))
+        {
+            CANObjectTransmit(psPeriph, psObj);
+        }
+    }
+    else
+    {
+        if(ulCMSK & CAN_IF1CMSK_MASK)
+        {
+            HWSimRegSet(ulRegs + CAN_O_IF1MSK1, psObj->ulMsk1);
+            HWSimRegSet(ulRegs + CAN_O_IF1MSK2, psObj->ulMsk2);
+        }
+        if(ulCMSK & CAN_IF1CMSK_ARB)
+        {
+            HWSimRegSet(ulRegs + CAN_O_IF1ARB1, psObj->ulArb1);
+            HWSimRegSet(ulRegs + CAN_O_IF1ARB2, psObj->ulArb2);
+        }
+        if(ulCMSK & CAN_IF1CMSK_CONTROL)
+        {
+            HWSimRegSet(ulRegs + CAN_O_IF1MCTL, psObj->ulMctl);
+        }
+        if(ulCMSK & CAN_IF1CMSK_DATAA)
+        {
+            HWSimRegSet(ulRegs + CAN_O_IF1DA1, psObj->pulData[0]);
+            HWSimRegSet(ulRegs + CAN_O_IF1DA2, psObj->pulData[1]);
+        }
+        if(ulCMSK & CAN_IF1CMSK_DATAB)
+        {
+            HWSimRegSet(ulRegs + CAN_O_IF1DB1, psObj->pulData[2]);
+            HWSimRegSet(ulRegs + CAN_O_IF1DB2, psObj->pulData[3]);
+        }
+        if(ulCMSK & CAN_IF1CMSK_CLRINTPND)
+        {
+            psObj->ulMctl &= ~CAN_IF1MCTL_INTPND;
+        }
+        if(ulCMSK & CAN_IF1CMSK_NEWDAT)
+        {
+            psObj->ulMctl &= ~CAN_IF1MCTL_NEWDAT;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Builds one of the message object summary registers (TXRQn, NWDAn, MSGnINT
+// and MSGnVAL) from the message RAM.
+//
+//*****************************************************************************
+static unsigned long
+CANSummary(tCANState *psState, unsigned long ulFirst, tBoolean bArb2,
+           unsigned long ulFlag)
+{
+    unsigned long ulIdx, ulValue, ulReg;
+
+    ulValue = 0;
+    for(ulIdx = 0; ulIdx < 16; ulIdx++)
+    {
+        ulReg = (bArb2 ? psState->psObjects[ulFirst + ulIdx].ulArb2 :
+                 psState->psObjects[ulFirst + ulIdx].ulMctl);
+        if(ulReg & ulFlag)
+        {
+            ulValue |= 1 << ulIdx;
+        }
+    }
+    return(ulValue);
+}
+
+//*****************************************************************************
+//
+// Returns the number of the lowest numbered message object with an interrupt
+// pending, or zero if there is none.
+//
+//*****************************************************************************
+static unsigned long
+CANIntID(tCANState *psState)
+{
+    unsigned long ulIdx;
+
+    for(ulIdx = 0; ulIdx < CAN_NUM_OBJECTS; ulIdx++)
+    {
+        if(psState->psObjects[ulIdx].ulMctl & CAN_IF1MCTL_INTPND)
+        {
+            return(ulIdx + 1);
+        }
+    }
+    return(CAN_INT_INTID_NONE);
+}
+
+//*****************************************************************************
+//
+// Handles a read of a CAN register.
+//
+//*****************************************************************************
+static unsigned long
+CANRead(tHWSimPeriph *psPeriph, unsigned long ulOffset)
+{
+    tCANState *psState = psPeriph->pvData;
+
+    switch(ulOffset)
+    {
+        case CAN_O_INT:
+        {
+            return(CANIntID(psState));
+        }
+        case CAN_O_TXRQ1:
+        case CAN_O_TXRQ2:
+        {
+            return(CANSummary(psState, (ulOffset - CAN_O_TXRQ1) * 4, false,
+                              CAN_IF1MCTL_TXRQST));
+        }
+        case CAN_O_NWDA1:
+        case CAN_O_NWDA2:
+        {
+            return(CANSummary(psState, (ulOffset - CAN_O_NWDA1) * 4, false,
+                              CAN_IF1MCTL_NEWDAT));
+        }
+        case CAN_O_MSG1INT:
+        case CAN_O_MSG2INT:
+        {
+            return(CANSummary(psState, (ulOffset - CAN_O_MSG1INT) * 4, false,
+                              CAN_IF1MCTL_INTPND));
+        }
+        case CAN_O_MSG1VAL:
+        case CAN_O_MSG2VAL:
+        {
+            return(CANSummary(psState, (ulOffset - CAN_O_MSG1VAL) * 4, true,
+                              CAN_IF1ARB2_MSGVAL));
+        }
+        default:
+        {
+            return(HWSimRegGet(psPeriph->ulBase + ulOffset));
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Handles a write to a CAN register.
+//
+//*****************************************************************************
+static void
+CANWrite(tHWSimPeriph *psPeriph, unsigned long ulOffset,
+         unsigned long ulValue)
+{
+    switch(ulOffset)
+    {
+        case CAN_O_IF1CRQ:
+        case CAN_O_IF2CRQ:
+        {
+            //
+            // Transfers complete immediately, so the busy flag never reads
+            // back as set.
+            //
+            HWSimRegSet(psPeriph->ulBase + ulOffset,
+                        ulValue & ~CAN_IF1CRQ_BUSY);
+            CANTransfer(psPeriph, (ulOffset - CAN_O_IF1CRQ) / CAN_IF_SPACING,
+                        ulValue);
+            break;
+        }
+        case CAN_O_INT:
+        case CAN_O_TXRQ1:
+        case CAN_O_TXRQ2:
+        case CAN_O_NWDA1:
+        case CAN_O_NWDA2:
+        case CAN_O_MSG1INT:
+        case CAN_O_MSG2INT:
+        case CAN_O_MSG1VAL:
+        case CAN_O_MSG2VAL:
+        {
+            break;
+        }
+        default:
+        {
+            HWSimRegSet(psPeriph->ulBase + ulOffset, ulValue);
+            break;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Reports whether the CAN controller interrupt is asserted.
+//
+//*****************************************************************************
+static tBoolean
+CANUpdate(tHWSimPeriph *psPeriph)
+{
+    return(((HWSimRegGet(psPeriph->ulBase + CAN_O_CTL) & CAN_CTL_IE) &&
+            CANIntID(psPeriph->pvData)) ? true : false);
+}
+
+//*****************************************************************************
+//
+// The simulated CAN controllers.
+//
+//*****************************************************************************
+static tHWSimPeriph g_psCANPeriphs[3] =
+{
+    { "CAN0", CAN0_BASE, 0x1000, INT_CAN0, CANRead, CANWrite, CANUpdate,
+      &g_psCANState[0] },
+    { "CAN1", CAN1_BASE, 0x1000, INT_CAN1, CANRead, CANWrite, CANUpdate,
+      &g_psCANState[1] },
+    { "CAN2", CAN2_BASE, 0x1000, INT_CAN2, CANRead, CANWrite, CANUpdate,
+      &g_psCANState[2] }
+};
+
+//*****************************************************************************
+//
+// Finds the simulated CAN controller at a base address.
+//
+//*****************************************************************************
+static tHWSimPeriph *
+CANFind(unsigned long ulBase)
+{
+    unsigned long ulIdx;
+
+    for(ulIdx = 0; ulIdx < 3; ulIdx++)
+    {
+        if(g_psCANPeriphs[ulIdx].ulBase == ulBase)
+        {
+            return(&g_psCANPeriphs[ulIdx]);
+        }
+    }
+    return(0);
+}
+
+//*****************************************************************************
+//
+//! Registers the CAN controller models with the simulator.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+HWSimCANInit(void)
+{
+    unsigned long ulIdx;
+
+    for(ulIdx = 0; ulIdx < 3; ulIdx++)
+    {
+        HWSimRegSet(g_psCANPeriphs[ulIdx].ulBase + CAN_O_CTL, CAN_CTL_INIT);
+        HWSimPeriphRegister(&g_psCANPeriphs[ulIdx]);
+    }
+}
+
+//*****************************************************************************
+//
+//! Delivers a frame to a simulated CAN controller.
+//!
+//! \param ulBase is the base address of the CAN controller.
+//! \param ulID is the identifier of the frame.
+//! \param bExtended is \b true if \e ulID is a 29-bit identifier.
+//! \param pucData is a pointer to the frame data.
+//! \param ulLen is the number of data bytes (0 to 8).
+//!
+//! The frame is stored in the lowest numbered valid receive object whose
+//! identifier matches under its acceptance mask.  As in hardware, objects
+//! that are part of a FIFO buffer (those without the end-of-buffer flag) are
+//! skipped if they already hold new data, while the final object of a buffer
+//! (or a single object) is overwritten and flagged as having lost a message.
+//!
+//! \return Returns \b true if the frame was accepted by a message object.
+//
+//*****************************************************************************
+tBoolean
+HWSimCANRxInject(unsigned long ulBase, unsigned long ulID, tBoolean bExtended,
+                 const unsigned char *pucData, unsigned long ulLen)
+{
+    tHWSimPeriph *psPeriph;
+    tCANState *psState;
+    tCANObject *psObj;
+    unsigned long ulIdx, ulByte, ulMask;
+
+    psPeriph = CANFind(ulBase);
+    if(!psPeriph ||
+       (HWSimRegGet(ulBase + CAN_O_CTL) & CAN_CTL_INIT) || (ulLen > 8))
+    {
+        return(false);
+    }
+    psState = psPeriph->pvData;
+
+    for(ulIdx = 0; ulIdx < CAN_NUM_OBJECTS; ulIdx++)
+    {
+        psObj = &psState->psObjects[ulIdx];
+        if(!(psObj->ulArb2 & CAN_IF1ARB2_MSGVAL) ||
+           (psObj->ulArb2 & CAN_IF1ARB2_DIR))
+        {
+            continue;
+        }
+        if((!bExtended != !(psObj->ulArb2 & CAN_IF1ARB2_XTD)) &&
+           (!(psObj->ulMctl & CAN_IF1MCTL_UMASK) ||
+            (psObj->ulMsk2 & CAN_IF1MSK2_MXTD)))
+        {
+            continue;
+        }
+        ulMask = CANObjectMask(psObj);
+        if((ulID & ulMask) != (CANObjectID(psObj) & ulMask))
+        {
+            continue;
+        }
+        if((psObj->ulMctl & CAN_IF1MCTL_NEWDAT) &&
+           !(psObj->ulMctl & CAN_IF1MCTL_EOB))
+        {
+            continue;
+        }
+        break;
+    }
+    if(ulIdx == CAN_NUM_OBJECTS)
+    {
+        return(false);
+    }
+
+    if(psObj->ulMctl & CAN_IF1MCTL_NEWDAT)
+    {
+        psObj->ulMctl |= CAN_IF1MCTL_MSGLST;
+    }
+    psObj->ulMctl = ((psObj->ulMctl & ~CAN_IF1MCTL_DLC_M) | ulLen |
+                     CAN_IF1MCTL_NEWDAT);
+    if(psObj->ulMctl & CAN_IF1MCTL_RXIE)
+    {
+        psObj->ulMctl |= CAN_IF1MCTL_INTPND;
+    }
+
+    //
+    // Store the received identifier and identifier type, which may differ
+    // from the programmed ones in the bits that are masked off.
+    //
+    if(bExtended)
+    {
+        psObj->ulArb1 = ulID & CAN_IF1ARB1_ID_M;
+        psObj->ulArb2 = ((psObj->ulArb2 & ~CAN_IF1ARB2_ID_M) |
+                         ((ulID >> 16) & CAN_IF1ARB2_ID_M) | CAN_IF1ARB2_XTD);
+    }
+    else
+    {
+        psObj->ulArb1 = 0;
+        psObj->ulArb2 = ((psObj->ulArb2 &
+                          ~(CAN_IF1ARB2_ID_M | CAN_IF1ARB2_XTD)) |
+                         ((ulID << 2) & CAN_IF1ARB2_ID_M));
+    }
+
+    for(ulByte = 0; ulByte < 4; ulByte++)
+    {
+        psObj->pulData[ulByte] = 0;
+    }
+    for(ulByte = 0; ulByte < ulLen; ulByte++)
+    {
+        psObj->pulData[ulByte / 2] |= pucData[ulByte] << ((ulByte & 1) * 8);
+    }
+
+    HWSimRegSet(ulBase + CAN_O_STS,
+                HWSimRegGet(ulBase + CAN_O_STS) | CAN_STS_RXOK);
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Collects a frame transmitted by a simulated CAN controller.
+//!
+//! \param ulBase is the base address of the CAN controller.
+//! \param pulID is a pointer to storage for the frame identifier.
+//! \param pucData is a pointer to storage for up to eight data bytes.
+//! \param pulLen is a pointer to storage for the number of data bytes.
+//!
+//! \return Returns \b true if a frame was returned, or \b false if no frames
+//! have been transmitted since the last call.
+//
+//*****************************************************************************
+tBoolean
+HWSimCANTxGet(unsigned long ulBase, unsigned long *pulID,
+              unsigned char *pucData, unsigned long *pulLen)
+{
+    tHWSimPeriph *psPeriph;
+    tCANState *psState;
+    tCANFrame *psFrame;
+    unsigned long ulIdx;
+
+    psPeriph = CANFind(ulBase);
+    if(!psPeriph)
+    {
+        return(false);
+    }
+    psState = psPeriph->pvData;
+    if(!psState->ulTxCount)
+    {
+        return(false);
+    }
+
+    psFrame = &psState->psTxQueue[psState->ulTxRead];
+    psState->ulTxRead = (psState->ulTxRead + 1) % CAN_TX_QUEUE_SIZE;
+    psState->ulTxCount--;
+
+    *pulID = psFrame->ulID;
+    *pulLen = psFrame->ulLen;
+    for(ulIdx = 0; ulIdx < psFrame->ulLen; ulIdx++)
+    {
+        pucData[ulIdx] = psFrame->pucData[ulIdx];
+    }
+    return(true);
+}
@@ -0,0 +1,480 @@
+//*****************************************************************************
+//
+// hwsim_enet.c - Ethernet MAC model for the host-side peripheral simulator.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+#include "../hw_ethernet.h"
+#include "../hw_ints.h"
+#include "../hw_memmap.h"
+#include "../hw_types.h"
+#include "hwsim.h"
+
+//*****************************************************************************
+//
+// The size of the MAC FIFOs, in bytes, and the maximum number of frames that
+// the model will hold in the receive FIFO.
+//
+//*****************************************************************************
+#define ENET_FIFO_SIZE          2048
+#define ENET_MAX_RX_FRAMES      32
+
+//*****************************************************************************
+//
+// The number of processor cycles taken to transmit one byte at 10 Mbps, and
+// the per-frame overhead (preamble, FCS and inter-frame gap) in bytes.
+//
+//*****************************************************************************
+#define ENET_BYTE_TIME          ((HWSIM_CLOCK / 10000000) * 8)
+#define ENET_FRAME_OVERHEAD     24
+
+//*****************************************************************************
+//
+// Returns true if time ulA is at or after time ulB.
+//
+//*****************************************************************************
+#define TIME_REACHED(ulA, ulB)  ((long)((ulA) - (ulB)) >= 0)
+
+//*****************************************************************************
+//
+// The state of the simulated MAC.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The receive FIFO contents, as the words that the driver reads from
+    // MAC_O_DATA, along with the number of words in each frame.
+    //
+    unsigned long pulRxFifo[ENET_FIFO_SIZE / 4];
+    unsigned long ulRxRead;
+    unsigned long ulRxWords;
+    unsigned long pulRxFrameWords[ENET_MAX_RX_FRAMES];
+    unsigned long ulRxFrameRead;
+    unsigned long ulRxFrames;
+    unsigned long ulRxFrameLeft;
+
+    //
+    // The transmit FIFO contents and write position, in words.
+    //
+    unsigned long pulTxFifo[ENET_FIFO_SIZE / 4];
+    unsigned long ulTxWords;
+
+    //
+    // The time at which the frame being transmitted completes.
+    //
+    unsigned long ulTxDone;
+    tBoolean bTxBusy;
+
+    //
+    // The latched interrupt status.
+    //
+    unsigned long ulRIS;
+
+    //
+    // The PHY registers.
+    //
+    unsigned short pusPHY[32];
+
+    //
+    // The function called with each transmitted frame.
+    //
+    void (*pfnTx)(const unsigned char *pucFrame, unsigned long ulLen);
+}
+tEnetState;
+
+static tEnetState g_sEnetState;
+
+//*****************************************************************************
+//
+// Advances the transmitter to the current simulated time.
+//
+//*****************************************************************************
+static void
+EnetAdvance(tEnetState *psState)
+{
+    if(psState->bTxBusy && TIME_REACHED(HWSimCyclesGet(), psState->ulTxDone))
+    {
+        psState->bTxBusy = false;
+        psState->ulRIS |= MAC_RIS_TXEMP;
+    }
+}
+
+//*****************************************************************************
+//
+// Computes the raw interrupt status of the MAC.
+//
+//*****************************************************************************
+static unsigned long
+EnetRawIntStatus(tEnetState *psState)
+{
+    return(psState->ulRIS | (psState->ulRxFrames ? MAC_RIS_RXINT : 0));
+}
+
+//*****************************************************************************
+//
+// Sends the frame in the transmit FIFO.
+//
+//*****************************************************************************
+static void
+EnetTransmit(tEnetState *psState)
+{
+    unsigned long ulLen;
+
+    //
+    // The first halfword of the FIFO holds the frame length less the 14 byte
+    // header, and the frame itself follows.
+    //
+    ulLen = (psState->pulTxFifo[0] & 0xFFFF) + 14;
+    if(ulLen > ((psState->ulTxWords * 4) - 2))
+    {
+        psState->ulRIS |= MAC_RIS_TXER;
+        psState->ulTxWords = 0;
+        return;
+    }
+
+    if(psState->pfnTx)
+    {
+        psState->pfnTx((unsigned char *)psState->pulTxFifo + 2, ulLen);
+    }
+
+    psState->ulTxWords = 0;
+    psState->bTxBusy = true;
+    psState->ulTxDone = (HWSimCyclesGet() +
+                         ((ulLen + ENET_FRAME_OVERHEAD) * ENET_BYTE_TIME));
+}
+
+//*****************************************************************************
+//
+// Removes all frames from the receive FIFO.
+//
+//*****************************************************************************
+static void
+EnetRxReset(tEnetState *psState)
+{
+    psState->ulRxRead = 0;
+    psState->ulRxWords = 0;
+    psState->ulRxFrameRead = 0;
+    psState->ulRxFrames = 0;
+    psState->ulRxFrameLeft = 0;
+}
+
+//*****************************************************************************
+//
+// Handles a read of a MAC register.
+//
+//*****************************************************************************
+static unsigned long
+EnetRead(tHWSimPeriph *psPeriph, unsigned long ulOffset)
+{
+    tEnetState *psState = psPeriph->pvData;
+    unsigned long ulValue;
+
+    EnetAdvance(psState);
+
+    switch(ulOffset)
+    {
+        case MAC_O_RIS:
+        {
+            return(EnetRawIntStatus(psState));
+        }
+
+        case MAC_O_DATA:
+        {
+            if(!psState->ulRxWords)
+            {
+                return(0);
+            }
+            ulValue = psState->pulRxFifo[psState->ulRxRead];
+            psState->ulRxRead = (psState->ulRxRead + 1) % (ENET_FIFO_SIZE / 4);
+            psState->ulRxWords--;
+
+            //
+            // The frame leaves the FIFO (and the packet count) once its last
+            // word has been read.
+            //
+            if(psState->ulRxFrameLeft == 0)
+            {
+                psState->ulRxFrameLeft =
+                    psState->pulRxFrameWords[psState->ulRxFrameRead];
+            }
+            if(--psState->ulRxFrameLeft == 0)
+            {
+                psState->ulRxFrameRead = ((psState->ulRxFrameRead + 1) %
+                                          ENET_MAX_RX_FRAMES);
+                psState->ulRxFrames--;
+            }
+            return(ulValue);
+        }
+
+        case MAC_O_NP:
+        {
+            return(psState->ulRxFrames);
+        }
+
+        case MAC_O_TR:
+        {
+            //
+            // The transmit request is only polled while waiting for the
+            // transmitter, so charge the time until it completes.
+            //
+            if(psState->bTxBusy)
+            {
+                HWSimCyclesAdd(psState->ulTxDone - HWSimCyclesGet());
+                return(MAC_TR_NEWTX);
+            }
+            return(0);
+        }
+
+        default:
+        {
+            return(HWSimRegGet(psPeriph->ulBase + ulOffset));
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Handles a write to a MAC register.
+//
+//*****************************************************************************
+static void
+EnetWrite(tHWSimPeriph *psPeriph, unsigned long ulOffset,
+          unsigned long ulValue)
+{
+    tEnetState *psState = psPeriph->pvData;
+    unsigned long ulReg;
+
+    EnetAdvance(psState);
+
+    switch(ulOffset)
+    {
+        case MAC_O_IACK:
+        {
+            psState->ulRIS &= ~ulValue;
+            break;
+        }
+
+        case MAC_O_RCTL:
+        {
+            if(ulValue & MAC_RCTL_RSTFIFO)
+            {
+                EnetRxReset(psState);
+            }
+            HWSimRegSet(psPeriph->ulBase + ulOffset,
+                        ulValue & ~MAC_RCTL_RSTFIFO);
+            break;
+        }
+
+        case MAC_O_DATA:
+        {
+            if(psState->ulTxWords < (ENET_FIFO_SIZE / 4))
+            {
+                psState->pulTxFifo[psState->ulTxWords++] = ulValue;
+            }
+            break;
+        }
+
+        case MAC_O_TR:
+        {
+            if(ulValue & MAC_TR_NEWTX)
+            {
+                EnetTransmit(psState);
+            }
+            break;
+        }
+
+        case MAC_O_MCTL:
+        {
+            //
+            // MII transactions complete immediately.
+            //
+            if(ulValue & MAC_MCTL_START)
+            {
+                ulReg = (ulValue & MAC_MCTL_REGADR_M) >> MAC_MCTL_REGADR_S;
+                if(ulValue & MAC_MCTL_WRITE)
+                {
+                    psState->pusPHY[ulReg] =
+                        (unsigned short)HWSimRegGet(psPeriph->ulBase +
+                                                    MAC_O_MTXD);
+                }
+                else
+                {
+                    HWSimRegSet(psPeriph->ulBase + MAC_O_MRXD,
+                                psState->pusPHY[ulReg]);
+                }
+                psState->ulRIS |= MAC_RIS_MDINT;
+            }
+            HWSimRegSet(psPeriph->ulBase + ulOffset,
+                        ulValue & ~MAC_MCTL_START);
+            break;
+        }
+
+        case MAC_O_NP:
+        {
+            break;
+        }
+
+        default:
+        {
+            HWSimRegSet(psPeriph->ulBase + ulOffset, ulValue);
+            break;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Advances the MAC and reports whether its interrupt is asserted.
+//
+//*****************************************************************************
+static tBoolean
+EnetUpdate(tHWSimPeriph *psPeriph)
+{
+    tEnetState *psState = psPeriph->pvData;
+
+    EnetAdvance(psState);
+    return((EnetRawIntStatus(psState) &
+            HWSimRegGet(psPeriph->ulBase + MAC_O_IM)) ? true : false);
+}
+
+//*****************************************************************************
+//
+// The simulated MAC.
+//
+//*****************************************************************************
+static tHWSimPeriph g_sEnetPeriph =
+{
+    "ETH", ETH_BASE, 0x1000, INT_ETH, EnetRead, EnetWrite, EnetUpdate,
+    &g_sEnetState
+};
+
+//*****************************************************************************
+//
+//! Registers the Ethernet MAC model with the simulator.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+HWSimEthInit(void)
+{
+    //
+    // Report a PHY with the link up and auto-negotiation complete.
+    //
+    g_sEnetState.pusPHY[0] = 0x3100;
+    g_sEnetState.pusPHY[1] = 0x786D;
+    g_sEnetState.pusPHY[2] = 0x0161;
+    g_sEnetState.pusPHY[3] = 0xB401;
+
+    HWSimPeriphRegister(&g_sEnetPeriph);
+}
+
+//*****************************************************************************
+//
+//! Places a frame in the simulated MAC receive FIFO.
+//!
+//! \param pucFrame is a pointer to the frame, starting with the destination
+//! address and excluding the FCS.
+//! \param ulLen is the length of the frame in bytes.
+//!
+//! The frame is stored in the FIFO in the same format as the hardware uses:
+//! a two byte length field (which counts itself and the four byte FCS),
+//! followed by the frame and the FCS, packed into words.
+//!
+//! \return Returns \b true if the frame was placed in the FIFO, or \b false
+//! if the receiver is disabled or there is not enough room in the FIFO.
+//
+//*****************************************************************************
+tBoolean
+HWSimEthRxInject(const unsigned char *pucFrame, unsigned long ulLen)
+{
+    tEnetState *psState = &g_sEnetState;
+    unsigned long ulWords, ulIdx, ulByte, ulWord;
+
+    if(!(HWSimRegGet(ETH_BASE + MAC_O_RCTL) & MAC_RCTL_RXEN))
+    {
+        return(false);
+    }
+
+    ulWords = (ulLen + 6 + 3) / 4;
+    if(((psState->ulRxWords + ulWords) > (ENET_FIFO_SIZE / 4)) ||
+       (psState->ulRxFrames == ENET_MAX_RX_FRAMES))
+    {
+        psState->ulRIS |= MAC_RIS_FOV;
+        return(false);
+    }
+
+    for(ulIdx = 0; ulIdx < ulWords; ulIdx++)
+    {
+        ulWord = 0;
+        for(ulByte = 0; ulByte < 4; ulByte++)
+        {
+            //
+            // Bytes 0 and 1 are the length field, and the bytes following
+            // the frame are the (zero) FCS.
+            //
+            if(((ulIdx * 4) + ulByte) == 0)
+            {
+                ulWord |= (ulLen + 6) & 0xFF;
+            }
+            else if(((ulIdx * 4) + ulByte) == 1)
+            {
+                ulWord |= ((ulLen + 6) >> 8) << 8;
+            }
+            else if(((ulIdx * 4) + ulByte - 2) < ulLen)
+            {
+                ulWord |= pucFrame[(ulIdx * 4) + ulByte - 2] << (ulByte * 8);
+            }
+        }
+        psState->pulRxFifo[(psState->ulRxRead + psState->ulRxWords) %
+                           (ENET_FIFO_SIZE / 4)] = ulWord;
+        psState->ulRxWords++;
+    }
+
+    psState->pulRxFrameWords[(psState->ulRxFrameRead + psState->ulRxFrames) %
+                             ENET_MAX_RX_FRAMES] = ulWords;
+    psState->ulRxFrames++;
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Sets the function called with each frame transmitted by the MAC.
+//!
+//! \param pfnTx is the function to be called; it is passed a pointer to the
+//! frame (starting with the destination address and excluding the FCS) and
+//! its length.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+HWSimEthTxCallbackSet(void (*pfnTx)(const unsigned char *pucFrame,
+                                    unsigned long ulLen))
+{
+    g_sEnetState.pfnTx = pfnTx;
+}
@@ -0,0 +1,325 @@
+//*****************************************************************************
+//
+// hwsim_flash.c - Flash controller model for the host-side peripheral
+//                 simulator.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+#include <string.h>
+#include "../hw_flash.h"
+#include "../hw_ints.h"
+#include "../hw_memmap.h"
+#include "../hw_types.h"
+#include "hwsim.h"
+
+//*****************************************************************************
+//
+// The size of a flash page, and the time taken by each flash operation in
+// processor cycles (20 us per word program, 20 ms per page erase and 200 ms
+// per mass erase).
+//
+//*****************************************************************************
+#define FLASH_PAGE_SIZE         1024
+#define FLASH_PROGRAM_TIME      (HWSIM_CLOCK / 50000)
+#define FLASH_ERASE_TIME        (HWSIM_CLOCK / 50)
+#define FLASH_MERASE_TIME       (HWSIM_CLOCK / 5)
+
+//*****************************************************************************
+//
+// The time charged for each poll of the FMC register while an operation is in
+// progress.  Charging a slice of the operation per poll (rather than all of
+// it) lets code that does other work while waiting for the flash see the
+// operation overlap that work, as it would on the hardware.
+//
+//*****************************************************************************
+#define FLASH_POLL_TIME         100
+
+//*****************************************************************************
+//
+// Returns true if time ulA is at or after time ulB.
+//
+//*****************************************************************************
+#define TIME_REACHED(ulA, ulB)  ((long)((ulA) - (ulB)) >= 0)
+
+//*****************************************************************************
+//
+// The contents of the simulated flash, and the number of page erases that
+// have been performed.
+//
+//*****************************************************************************
+static unsigned char g_pucHWSimFlash[HWSIM_FLASH_SIZE];
+static unsigned long g_ulHWSimFlashErases;
+
+//*****************************************************************************
+//
+// The time at which the operation in progress completes.
+//
+//*****************************************************************************
+static unsigned long g_ulHWSimFlashDone;
+
+//*****************************************************************************
+//
+// Performs a flash operation requested through the FMC register.  The
+// contents of the flash change immediately, but the operation is reported as
+// in progress (by the FMC register) until the time that the hardware would
+// take has passed.  Returns that time, or zero if the operation failed.
+//
+//*****************************************************************************
+static unsigned long
+FlashOperation(unsigned long ulFMC)
+{
+    unsigned long ulAddr, ulData, ulIdx;
+
+    ulAddr = HWSimRegGet(FLASH_FMA);
+
+    if(ulFMC & FLASH_FMC_MERASE)
+    {
+        memset(g_pucHWSimFlash, 0xFF, sizeof(g_pucHWSimFlash));
+        g_ulHWSimFlashErases += HWSIM_FLASH_SIZE / FLASH_PAGE_SIZE;
+        return(FLASH_MERASE_TIME);
+    }
+    else if(ulAddr >= HWSIM_FLASH_SIZE)
+    {
+        //
+        // An access outside the flash is flagged as an access violation.
+        //
+        HWSimRegSet(FLASH_FCRIS, HWSimRegGet(FLASH_FCRIS) | FLASH_FCRIS_ARIS);
+        return(0);
+    }
+    else if(ulFMC & FLASH_FMC_ERASE)
+    {
+        memset(g_pucHWSimFlash + (ulAddr & ~(FLASH_PAGE_SIZE - 1)), 0xFF,
+               FLASH_PAGE_SIZE);
+        g_ulHWSimFlashErases++;
+        return(FLASH_ERASE_TIME);
+    }
+    else if(ulFMC & FLASH_FMC_WRITE)
+    {
+        //
+        // Programming can only clear bits.
+        //
+        ulData = HWSimRegGet(FLASH_FMD);
+        for(ulIdx = 0; ulIdx < 4; ulIdx++)
+        {
+            g_pucHWSimFlash[(ulAddr & ~3) + ulIdx] &= ulData >> (ulIdx * 8);
+        }
+        return(FLASH_PROGRAM_TIME);
+    }
+
+    return(0);
+}
+
+//*****************************************************************************
+//
+// Completes the operation in progress once its time has passed.
+//
+//*****************************************************************************
+static void
+FlashAdvance(void)
+{
+    if(HWSimRegGet(FLASH_FMC) &&
+       TIME_REACHED(HWSimCyclesGet(), g_ulHWSimFlashDone))
+    {
+        HWSimRegSet(FLASH_FMC, 0);
+        HWSimRegSet(FLASH_FCRIS, HWSimRegGet(FLASH_FCRIS) | FLASH_FCRIS_PRIS);
+    }
+}
+
+//*****************************************************************************
+//
+// Handles a read of a flash controller register.
+//
+//*****************************************************************************
+static unsigned long
+FlashRead(tHWSimPeriph *psPeriph, unsigned long ulOffset)
+{
+    unsigned long ulAddr = psPeriph->ulBase + ulOffset;
+    unsigned long ulValue;
+
+    FlashAdvance();
+
+    if(ulAddr == FLASH_FCMISC)
+    {
+        return(HWSimRegGet(FLASH_FCRIS) & HWSimRegGet(FLASH_FCIM));
+    }
+
+    //
+    // Polling the FMC register while an operation is in progress lets a slice
+    // of the operation's time pass.
+    //
+    ulValue = HWSimRegGet(ulAddr);
+    if((ulAddr == FLASH_FMC) && ulValue)
+    {
+        if(TIME_REACHED(HWSimCyclesGet() + FLASH_POLL_TIME,
+                        g_ulHWSimFlashDone))
+        {
+            HWSimCyclesAdd(g_ulHWSimFlashDone - HWSimCyclesGet());
+        }
+        else
+        {
+            HWSimCyclesAdd(FLASH_POLL_TIME);
+        }
+    }
+    return(ulValue);
+}
+
+//*****************************************************************************
+//
+// Handles a write to a flash controller register.
+//
+//*****************************************************************************
+static void
+FlashWrite(tHWSimPeriph *psPeriph, unsigned long ulOffset,
+           unsigned long ulValue)
+{
+    unsigned long ulAddr = psPeriph->ulBase + ulOffset;
+    unsigned long ulTime;
+
+    FlashAdvance();
+
+    switch(ulAddr)
+    {
+        case FLASH_FMC:
+        {
+            //
+            // Requests without the write key, or made while another operation
+            // is in progress, are ignored.
+            //
+            if(((ulValue & FLASH_FMC_WRKEY_M) != FLASH_FMC_WRKEY) ||
+               HWSimRegGet(ulAddr))
+            {
+                break;
+            }
+
+            //
+            // Perform the operation, leaving its bit set in the FMC register
+            // until it completes.
+            //
+            ulTime = FlashOperation(ulValue);
+            if(ulTime)
+            {
+                g_ulHWSimFlashDone = HWSimCyclesGet() + ulTime;
+                HWSimRegSet(ulAddr, ulValue & (FLASH_FMC_MERASE |
+                                               FLASH_FMC_ERASE |
+                                               FLASH_FMC_WRITE));
+            }
+            break;
+        }
+
+        case FLASH_FCMISC:
+        {
+            HWSimRegSet(FLASH_FCRIS, HWSimRegGet(FLASH_FCRIS) & ~ulValue);
+            break;
+        }
+
+        case FLASH_FCRIS:
+        {
+            break;
+        }
+
+        default:
+        {
+            HWSimRegSet(ulAddr, ulValue);
+            break;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Reports whether the flash controller interrupt is asserted.
+//
+//*****************************************************************************
+static tBoolean
+FlashUpdate(tHWSimPeriph *psPeriph)
+{
+    FlashAdvance();
+    return((HWSimRegGet(FLASH_FCRIS) & HWSimRegGet(FLASH_FCIM)) ?
+           true : false);
+}
+
+//*****************************************************************************
+//
+// The simulated flash controller.
+//
+//*****************************************************************************
+static tHWSimPeriph g_sFlashPeriph =
+{
+    "FLASH", FLASH_CTRL_BASE, 0x1000, INT_FLASH, FlashRead, FlashWrite,
+    FlashUpdate
+};
+
+//*****************************************************************************
+//
+//! Registers the flash controller model with the simulator.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+HWSimFlashInit(void)
+{
+    memset(g_pucHWSimFlash, 0xFF, sizeof(g_pucHWSimFlash));
+
+    //
+    // Leave all of the flash readable and programmable, with the microsecond
+    // reload value for a 50 MHz clock.
+    //
+    HWSimRegSet(FLASH_FMPRE, 0xFFFFFFFF);
+    HWSimRegSet(FLASH_FMPPE, 0xFFFFFFFF);
+    HWSimRegSet(FLASH_USECRL, 49);
+
+    HWSimPeriphRegister(&g_sFlashPeriph);
+}
+
+//*****************************************************************************
+//
+//! Gets the contents of the simulated flash.
+//!
+//! Since the host cannot map the flash at address zero, code that needs to
+//! inspect or pre-load the flash contents must do so through this pointer.
+//!
+//! \return Returns a pointer to the \b HWSIM_FLASH_SIZE bytes of flash.
+//
+//*****************************************************************************
+unsigned char *
+HWSimFlashGet(void)
+{
+    return(g_pucHWSimFlash);
+}
+
+//*****************************************************************************
+//
+//! Gets the number of flash pages erased.
+//!
+//! \return Returns the number of page erases performed (a mass erase counts
+//! as an erase of every page).
+//
+//*****************************************************************************
+unsigned long
+HWSimFlashEraseCount(void)
+{
+    return(g_ulHWSimFlashErases);
+}
@@ -0,0 +1,400 @@
+//*****************************************************************************
+//
+// hwsim_ssi.c - SSI model for the host-side peripheral simulator.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+#include "../hw_ints.h"
+#include "../hw_memmap.h"
+#include "../hw_ssi.h"
+#include "../hw_types.h"
+#include "hwsim.h"
+
+//*****************************************************************************
+//
+// The depth of the hardware FIFOs.
+//
+//*****************************************************************************
+#define SSI_FIFO_SIZE           8
+
+//*****************************************************************************
+//
+// Returns true if time ulA is at or after time ulB.
+//
+//*****************************************************************************
+#define TIME_REACHED(ulA, ulB)  ((long)((ulA) - (ulB)) >= 0)
+
+//*****************************************************************************
+//
+// The state of a simulated SSI port.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The frames in the transmit FIFO and the time at which each one
+    // finishes shifting out.
+    //
+    unsigned short pusTxFifo[SSI_FIFO_SIZE];
+    unsigned long pulTxDone[SSI_FIFO_SIZE];
+    unsigned long ulTxRead;
+    unsigned long ulTxCount;
+
+    //
+    // The receive FIFO.
+    //
+    unsigned short pusRxFifo[SSI_FIFO_SIZE];
+    unsigned long ulRxRead;
+    unsigned long ulRxCount;
+
+    //
+    // The latched receive overrun and timeout interrupt status.
+    //
+    unsigned long ulRIS;
+
+    //
+    // The device attached to the port, which is given each transmitted frame
+    // and returns the frame clocked back in.  If NULL, all ones are received.
+    //
+    unsigned long (*pfnXfer)(unsigned long ulTx);
+}
+tSSIState;
+
+static tSSIState g_psSSIState[2];
+
+//*****************************************************************************
+//
+// Computes the number of processor cycles taken to transfer one frame at the
+// currently programmed bit rate.
+//
+//*****************************************************************************
+static unsigned long
+SSIFrameTime(tHWSimPeriph *psPeriph)
+{
+    unsigned long ulCR0, ulCPSR;
+
+    ulCR0 = HWSimRegGet(psPeriph->ulBase + SSI_O_CR0);
+    ulCPSR = HWSimRegGet(psPeriph->ulBase + SSI_O_CPSR) & SSI_CPSR_CPSDVSR_M;
+    return(ulCPSR * (((ulCR0 & SSI_CR0_SCR_M) >> SSI_CR0_SCR_S) + 1) *
+           ((ulCR0 & SSI_CR0_DSS_M) + 1));
+}
+
+//*****************************************************************************
+//
+// Advances the SSI port to the current simulated time.  Each frame that has
+// finished shifting out produces a frame in the receive FIFO.
+//
+//*****************************************************************************
+static void
+SSIAdvance(tHWSimPeriph *psPeriph)
+{
+    tSSIState *psState = psPeriph->pvData;
+    unsigned long ulTx, ulRx, ulMask;
+
+    ulMask = (2 << (HWSimRegGet(psPeriph->ulBase + SSI_O_CR0) &
+                    SSI_CR0_DSS_M)) - 1;
+
+    while(psState->ulTxCount &&
+          TIME_REACHED(HWSimCyclesGet(),
+                       psState->pulTxDone[psState->ulTxRead]))
+    {
+        ulTx = psState->pusTxFifo[psState->ulTxRead];
+        psState->ulTxRead = (psState->ulTxRead + 1) % SSI_FIFO_SIZE;
+        psState->ulTxCount--;
+
+        if(HWSimRegGet(psPeriph->ulBase + SSI_O_CR1) & SSI_CR1_LBM)
+        {
+            ulRx = ulTx;
+        }
+        else if(psState->pfnXfer)
+        {
+            ulRx = psState->pfnXfer(ulTx);
+        }
+        else
+        {
+            ulRx = 0xFFFFFFFF;
+        }
+
+        if(psState->ulRxCount == SSI_FIFO_SIZE)
+        {
+            psState->ulRIS |= SSI_RIS_RORRIS;
+            continue;
+        }
+        psState->pusRxFifo[(psState->ulRxRead + psState->ulRxCount) %
+                           SSI_FIFO_SIZE] = (unsigned short)(ulRx & ulMask);
+        psState->ulRxCount++;
+    }
+}
+
+//*****************************************************************************
+//
+// Advances the simulated time to the completion of the frame currently being
+// shifted out.
+//
+//*****************************************************************************
+static void
+SSIWaitFrame(tHWSimPeriph *psPeriph)
+{
+    tSSIState *psState = psPeriph->pvData;
+    unsigned long ulDone;
+
+    ulDone = psState->pulTxDone[psState->ulTxRead];
+    if(!TIME_REACHED(HWSimCyclesGet(), ulDone))
+    {
+        HWSimCyclesAdd(ulDone - HWSimCyclesGet());
+    }
+}
+
+//*****************************************************************************
+//
+// Computes the raw interrupt status of the SSI port.
+//
+//*****************************************************************************
+static unsigned long
+SSIRawIntStatus(tHWSimPeriph *psPeriph)
+{
+    tSSIState *psState = psPeriph->pvData;
+    unsigned long ulRIS;
+
+    ulRIS = psState->ulRIS;
+    if(psState->ulTxCount <= (SSI_FIFO_SIZE / 2))
+    {
+        ulRIS |= SSI_RIS_TXRIS;
+    }
+    if(psState->ulRxCount >= (SSI_FIFO_SIZE / 2))
+    {
+        ulRIS |= SSI_RIS_RXRIS;
+    }
+    else if(psState->ulRxCount && !psState->ulTxCount)
+    {
+        ulRIS |= SSI_RIS_RTRIS;
+    }
+    return(ulRIS);
+}
+
+//*****************************************************************************
+//
+// Handles a read of an SSI register.
+//
+//*****************************************************************************
+static unsigned long
+SSIRead(tHWSimPeriph *psPeriph, unsigned long ulOffset)
+{
+    tSSIState *psState = psPeriph->pvData;
+    unsigned long ulValue;
+
+    SSIAdvance(psPeriph);
+
+    switch(ulOffset)
+    {
+        case SSI_O_DR:
+        {
+            if(!psState->ulRxCount)
+            {
+                return(0);
+            }
+            ulValue = psState->pusRxFifo[psState->ulRxRead];
+            psState->ulRxRead = (psState->ulRxRead + 1) % SSI_FIFO_SIZE;
+            psState->ulRxCount--;
+            return(ulValue);
+        }
+
+        case SSI_O_SR:
+        {
+            ulValue = 0;
+            if(psState->ulTxCount == 0)
+            {
+                ulValue |= SSI_SR_TFE;
+            }
+            else
+            {
+                ulValue |= SSI_SR_BSY;
+            }
+            if(psState->ulTxCount != SSI_FIFO_SIZE)
+            {
+                ulValue |= SSI_SR_TNF;
+            }
+            if(psState->ulRxCount)
+            {
+                ulValue |= SSI_SR_RNE;
+            }
+            if(psState->ulRxCount == SSI_FIFO_SIZE)
+            {
+                ulValue |= SSI_SR_RFF;
+            }
+
+            //
+            // The status register is only polled for a full transmit FIFO or
+            // an empty receive FIFO while a frame is in flight, so charge the
+            // time until that frame completes rather than polling it out one
+            // access at a time.
+            //
+            if((psState->ulTxCount == SSI_FIFO_SIZE) ||
+               (psState->ulTxCount && !psState->ulRxCount))
+            {
+                SSIWaitFrame(psPeriph);
+            }
+            return(ulValue);
+        }
+
+        case SSI_O_RIS:
+        {
+            return(SSIRawIntStatus(psPeriph));
+        }
+
+        case SSI_O_MIS:
+        {
+            return(SSIRawIntStatus(psPeriph) &
+                   HWSimRegGet(psPeriph->ulBase + SSI_O_IM));
+        }
+
+        default:
+        {
+            return(HWSimRegGet(psPeriph->ulBase + ulOffset));
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Handles a write to an SSI register.
+//
+//*****************************************************************************
+static void
+SSIWrite(tHWSimPeriph *psPeriph, unsigned long ulOffset,
+         unsigned long ulValue)
+{
+    tSSIState *psState = psPeriph->pvData;
+    unsigned long ulStart, ulIdx;
+
+    SSIAdvance(psPeriph);
+
+    switch(ulOffset)
+    {
+        case SSI_O_DR:
+        {
+            if(psState->ulTxCount == SSI_FIFO_SIZE)
+            {
+                break;
+            }
+            ulStart = HWSimCyclesGet();
+            if(psState->ulTxCount)
+            {
+                ulIdx = ((psState->ulTxRead + psState->ulTxCount - 1) %
+                         SSI_FIFO_SIZE);
+                ulStart = psState->pulTxDone[ulIdx];
+            }
+            ulIdx = (psState->ulTxRead + psState->ulTxCount) % SSI_FIFO_SIZE;
+            psState->pusTxFifo[ulIdx] = (unsigned short)ulValue;
+            psState->pulTxDone[ulIdx] = ulStart + SSIFrameTime(psPeriph);
+            psState->ulTxCount++;
+            break;
+        }
+
+        case SSI_O_ICR:
+        {
+            psState->ulRIS &= ~ulValue;
+            break;
+        }
+
+        case SSI_O_SR:
+        case SSI_O_RIS:
+        case SSI_O_MIS:
+        {
+            break;
+        }
+
+        default:
+        {
+            HWSimRegSet(psPeriph->ulBase + ulOffset, ulValue);
+            break;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Advances the SSI port and reports whether its interrupt is asserted.
+//
+//*****************************************************************************
+static tBoolean
+SSIUpdate(tHWSimPeriph *psPeriph)
+{
+    SSIAdvance(psPeriph);
+    return((SSIRawIntStatus(psPeriph) &
+            HWSimRegGet(psPeriph->ulBase + SSI_O_IM)) ? true : false);
+}
+
+//*****************************************************************************
+//
+// The simulated SSI ports.
+//
+//*****************************************************************************
+static tHWSimPeriph g_psSSIPeriphs[2] =
+{
+    { "SSI0", SSI0_BASE, 0x1000, INT_SSI0, SSIRead, SSIWrite, SSIUpdate,
+      &g_psSSIState[0] },
+    { "SSI1", SSI1_BASE, 0x1000, INT_SSI1, SSIRead, SSIWrite, SSIUpdate,
+      &g_psSSIState[1] }
+};
+
+//*****************************************************************************
+//
+//! Registers the SSI models with the simulator.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+HWSimSSIInit(void)
+{
+    HWSimPeriphRegister(&g_psSSIPeriphs[0]);
+    HWSimPeriphRegister(&g_psSSIPeriphs[1]);
+}
+
+//*****************************************************************************
+//
+//! Attaches a simulated device to an SSI port.
+//!
+//! \param ulBase is the base address of the SSI port.
+//! \param pfnXfer is the function called for each frame; it is passed the
+//! frame transmitted by the port and returns the frame received by the port.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+HWSimSSIDeviceSet(unsigned long ulBase,
+                  unsigned long (*pfnXfer)(unsigned long ulTx))
+{
+    if(ulBase == SSI0_BASE)
+    {
+        g_psSSIState[0].pfnXfer = pfnXfer;
+    }
+    else if(ulBase == SSI1_BASE)
+    {
+        g_psSSIState[1].pfnXfer = pfnXfer;
+    }
+}
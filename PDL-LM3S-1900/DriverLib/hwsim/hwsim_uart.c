@@ -0,0 +1,540 @@
+//*****************************************************************************
+//
+// hwsim_uart.c - UART model for the host-side peripheral simulator.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+#include "../hw_ints.h"
+#include "../hw_memmap.h"
+#include "../hw_types.h"
+#include "../hw_uart.h"
+#include "hwsim.h"
+
+//*****************************************************************************
+//
+// The depth of the hardware FIFOs, and the size of the host side buffers
+// that hold characters waiting to be received and characters that have been
+// transmitted.
+//
+//*****************************************************************************
+#define UART_FIFO_SIZE          16
+#define UART_LINE_SIZE          4096
+
+//*****************************************************************************
+//
+// The state of a simulated UART.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The characters in the transmit FIFO and the time at which each one
+    // finishes shifting out.
+    //
+    unsigned char pucTxFifo[UART_FIFO_SIZE];
+    unsigned long pulTxDone[UART_FIFO_SIZE];
+    unsigned long ulTxRead;
+    unsigned long ulTxCount;
+
+    //
+    // The receive FIFO.
+    //
+    unsigned char pucRxFifo[UART_FIFO_SIZE];
+    unsigned long ulRxRead;
+    unsigned long ulRxCount;
+
+    //
+    // Characters injected by the host that have not yet arrived in the
+    // receive FIFO, and the time at which the next one arrives.
+    //
+    unsigned char pucRxLine[UART_LINE_SIZE];
+    unsigned long ulRxLineRead;
+    unsigned long ulRxLineCount;
+    unsigned long ulRxNext;
+
+    //
+    // Characters that have been transmitted, waiting to be collected by the
+    // host.
+    //
+    unsigned char pucTxLine[UART_LINE_SIZE];
+    unsigned long ulTxLineRead;
+    unsigned long ulTxLineCount;
+
+    //
+    // The latched transmit interrupt status.
+    //
+    unsigned long ulRIS;
+}
+tUARTState;
+
+static tUARTState g_psUARTState[3];
+
+//*****************************************************************************
+//
+// Returns true if time ulA is at or after time ulB.
+//
+//*****************************************************************************
+#define TIME_REACHED(ulA, ulB)  ((long)((ulA) - (ulB)) >= 0)
+
+//*****************************************************************************
+//
+// Computes the number of processor cycles taken to transfer one character at
+// the currently programmed baud rate, assuming ten bits per character.
+//
+//*****************************************************************************
+static unsigned long
+UARTCharTime(tHWSimPeriph *psPeriph)
+{
+    unsigned long ulIBRD, ulFBRD;
+
+    ulIBRD = HWSimRegGet(psPeriph->ulBase + UART_O_IBRD);
+    ulFBRD = HWSimRegGet(psPeriph->ulBase + UART_O_FBRD);
+    return((160 * ulIBRD) + ((160 * ulFBRD) / 64));
+}
+
+//*****************************************************************************
+//
+// Returns the FIFO level corresponding to an interrupt FIFO level selection.
+//
+//*****************************************************************************
+static unsigned long
+UARTFifoLevel(unsigned long ulSel)
+{
+    static const unsigned char pucLevels[] = { 2, 4, 8, 12, 14, 14, 14, 14 };
+
+    return(pucLevels[ulSel & 7]);
+}
+
+//*****************************************************************************
+//
+// Adds a character to the receive FIFO, flagging an overrun if it is full.
+//
+//*****************************************************************************
+static void
+UARTRxPush(tHWSimPeriph *psPeriph, unsigned char ucChar)
+{
+    tUARTState *psState = psPeriph->pvData;
+
+    if(psState->ulRxCount == UART_FIFO_SIZE)
+    {
+        psState->ulRIS |= UART_RIS_OERIS;
+        return;
+    }
+    psState->pucRxFifo[(psState->ulRxRead + psState->ulRxCount) %
+                       UART_FIFO_SIZE] = ucChar;
+    psState->ulRxCount++;
+}
+
+//*****************************************************************************
+//
+// Advances the UART to the current simulated time, retiring transmitted
+// characters and delivering received ones.
+//
+//*****************************************************************************
+static void
+UARTAdvance(tHWSimPeriph *psPeriph)
+{
+    tUARTState *psState = psPeriph->pvData;
+    unsigned long ulNow, ulLevel;
+    unsigned char ucChar;
+
+    ulNow = HWSimCyclesGet();
+    ulLevel = UARTFifoLevel(HWSimRegGet(psPeriph->ulBase + UART_O_IFLS));
+
+    while(psState->ulTxCount &&
+          TIME_REACHED(ulNow, psState->pulTxDone[psState->ulTxRead]))
+    {
+        ucChar = psState->pucTxFifo[psState->ulTxRead];
+        psState->ulTxRead = (psState->ulTxRead + 1) % UART_FIFO_SIZE;
+        psState->ulTxCount--;
+
+        //
+        // The transmit interrupt is asserted as the FIFO level passes
+        // through the trigger level.
+        //
+        if(psState->ulTxCount == ulLevel)
+        {
+            psState->ulRIS |= UART_RIS_TXRIS;
+        }
+
+        if(HWSimRegGet(psPeriph->ulBase + UART_O_CTL) & UART_CTL_LBE)
+        {
+            UARTRxPush(psPeriph, ucChar);
+        }
+        else if(psState->ulTxLineCount < UART_LINE_SIZE)
+        {
+            psState->pucTxLine[(psState->ulTxLineRead +
+                                psState->ulTxLineCount) % UART_LINE_SIZE] =
+                ucChar;
+            psState->ulTxLineCount++;
+        }
+    }
+
+    while(psState->ulRxLineCount && TIME_REACHED(ulNow, psState->ulRxNext))
+    {
+        UARTRxPush(psPeriph, psState->pucRxLine[psState->ulRxLineRead]);
+        psState->ulRxLineRead = (psState->ulRxLineRead + 1) % UART_LINE_SIZE;
+        psState->ulRxLineCount--;
+        psState->ulRxNext += UARTCharTime(psPeriph);
+    }
+}
+
+//*****************************************************************************
+//
+// Computes the raw interrupt status of the UART.
+//
+//*****************************************************************************
+static unsigned long
+UARTRawIntStatus(tHWSimPeriph *psPeriph)
+{
+    tUARTState *psState = psPeriph->pvData;
+    unsigned long ulRIS, ulLevel;
+
+    ulRIS = psState->ulRIS;
+    ulLevel = UARTFifoLevel(HWSimRegGet(psPeriph->ulBase + UART_O_IFLS) >> 3);
+    if(psState->ulRxCount >= ulLevel)
+    {
+        ulRIS |= UART_RIS_RXRIS;
+    }
+    else if(psState->ulRxCount)
+    {
+        ulRIS |= UART_RIS_RTRIS;
+    }
+    return(ulRIS);
+}
+
+//*****************************************************************************
+//
+// Handles a read of a UART register.
+//
+//*****************************************************************************
+static unsigned long
+UARTRead(tHWSimPeriph *psPeriph, unsigned long ulOffset)
+{
+    tUARTState *psState = psPeriph->pvData;
+    unsigned long ulValue;
+
+    UARTAdvance(psPeriph);
+
+    switch(ulOffset)
+    {
+        case UART_O_DR:
+        {
+            if(!psState->ulRxCount)
+            {
+                return(0);
+            }
+            ulValue = psState->pucRxFifo[psState->ulRxRead];
+            psState->ulRxRead = (psState->ulRxRead + 1) % UART_FIFO_SIZE;
+            psState->ulRxCount--;
+            return(ulValue);
+        }
+
+        case UART_O_FR:
+        {
+            ulValue = 0;
+            if(psState->ulTxCount == 0)
+            {
+                ulValue |= UART_FR_TXFE;
+            }
+            if(psState->ulTxCount == UART_FIFO_SIZE)
+            {
+                ulValue |= UART_FR_TXFF;
+
+                //
+                // A full transmit FIFO is only ever polled until space
+                // becomes available, so charge the time until the oldest
+                // character finishes instead of polling it out one access
+                // at a time.
+                //
+                ulValue |= UART_FR_BUSY;
+                if(!TIME_REACHED(HWSimCyclesGet(),
+                                 psState->pulTxDone[psState->ulTxRead]))
+                {
+                    HWSimCyclesAdd(psState->pulTxDone[psState->ulTxRead] -
+                                   HWSimCyclesGet());
+                }
+            }
+            else if(psState->ulTxCount)
+            {
+                ulValue |= UART_FR_BUSY;
+            }
+            if(psState->ulRxCount == 0)
+            {
+                ulValue |= UART_FR_RXFE;
+
+                //
+                // Likewise, an empty receive FIFO is polled until a character
+                // arrives, so skip ahead to the arrival of the next one.
+                //
+                if(psState->ulRxLineCount &&
+                   !TIME_REACHED(HWSimCyclesGet(), psState->ulRxNext))
+                {
+                    HWSimCyclesAdd(psState->ulRxNext - HWSimCyclesGet());
+                }
+            }
+            if(psState->ulRxCount == UART_FIFO_SIZE)
+            {
+                ulValue |= UART_FR_RXFF;
+            }
+            return(ulValue);
+        }
+
+        case UART_O_RIS:
+        {
+            return(UARTRawIntStatus(psPeriph));
+        }
+
+        case UART_O_MIS:
+        {
+            return(UARTRawIntStatus(psPeriph) &
+                   HWSimRegGet(psPeriph->ulBase + UART_O_IM));
+        }
+
+        default:
+        {
+            return(HWSimRegGet(psPeriph->ulBase + ulOffset));
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Handles a write to a UART register.
+//
+//*****************************************************************************
+static void
+UARTWrite(tHWSimPeriph *psPeriph, unsigned long ulOffset,
+          unsigned long ulValue)
+{
+    tUARTState *psState = psPeriph->pvData;
+    unsigned long ulStart, ulIdx;
+
+    UARTAdvance(psPeriph);
+
+    switch(ulOffset)
+    {
+        case UART_O_DR:
+        {
+            //
+            // Characters written to a full FIFO are lost, as in hardware.
+            //
+            if(psState->ulTxCount == UART_FIFO_SIZE)
+            {
+                break;
+            }
+
+            //
+            // The character starts shifting out once the one ahead of it has
+            // finished.
+            //
+            ulStart = HWSimCyclesGet();
+            if(psState->ulTxCount)
+            {
+                ulIdx = ((psState->ulTxRead + psState->ulTxCount - 1) %
+                         UART_FIFO_SIZE);
+                ulStart = psState->pulTxDone[ulIdx];
+            }
+            ulIdx = (psState->ulTxRead + psState->ulTxCount) % UART_FIFO_SIZE;
+            psState->pucTxFifo[ulIdx] = (unsigned char)ulValue;
+            psState->pulTxDone[ulIdx] = ulStart + UARTCharTime(psPeriph);
+            psState->ulTxCount++;
+            if(psState->ulTxCount >
+               UARTFifoLevel(HWSimRegGet(psPeriph->ulBase + UART_O_IFLS)))
+            {
+                psState->ulRIS &= ~UART_RIS_TXRIS;
+            }
+            break;
+        }
+
+        case UART_O_ICR:
+        {
+            psState->ulRIS &= ~ulValue;
+            break;
+        }
+
+        case UART_O_FR:
+        case UART_O_RIS:
+        case UART_O_MIS:
+        {
+            break;
+        }
+
+        default:
+        {
+            HWSimRegSet(psPeriph->ulBase + ulOffset, ulValue);
+            break;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Advances the UART and reports whether its interrupt is asserted.
+//
+//*****************************************************************************
+static tBoolean
+UARTUpdate(tHWSimPeriph *psPeriph)
+{
+    UARTAdvance(psPeriph);
+    return((UARTRawIntStatus(psPeriph) &
+            HWSimRegGet(psPeriph->ulBase + UART_O_IM)) ? true : false);
+}
+
+//*****************************************************************************
+//
+// The simulated UARTs.
+//
+//*****************************************************************************
+static tHWSimPeriph g_psUARTPeriphs[3] =
+{
+    { "UART0", UART0_BASE, 0x1000, INT_UART0, UARTRead, UARTWrite,
+      UARTUpdate, &g_psUARTState[0] },
+    { "UART1", UART1_BASE, 0x1000, INT_UART1, UARTRead, UARTWrite,
+      UARTUpdate, &g_psUARTState[1] },
+    { "UART2", UART2_BASE, 0x1000, INT_UART2, UARTRead, UARTWrite,
+      UARTUpdate, &g_psUARTState[2] }
+};
+
+//*****************************************************************************
+//
+// Finds the simulated UART at a base address.
+//
+//*****************************************************************************
+static tHWSimPeriph *
+UARTFind(unsigned long ulBase)
+{
+    unsigned long ulIdx;
+
+    for(ulIdx = 0; ulIdx < 3; ulIdx++)
+    {
+        if(g_psUARTPeriphs[ulIdx].ulBase == ulBase)
+        {
+            return(&g_psUARTPeriphs[ulIdx]);
+        }
+    }
+    return(0);
+}
+
+//*****************************************************************************
+//
+//! Registers the UART models with the simulator.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+HWSimUARTInit(void)
+{
+    unsigned long ulIdx;
+
+    for(ulIdx = 0; ulIdx < 3; ulIdx++)
+    {
+        HWSimRegSet(g_psUARTPeriphs[ulIdx].ulBase + UART_O_CTL,
+                    UART_CTL_RXE | UART_CTL_TXE);
+        HWSimRegSet(g_psUARTPeriphs[ulIdx].ulBase + UART_O_IFLS, 0x12);
+        HWSimPeriphRegister(&g_psUARTPeriphs[ulIdx]);
+    }
+}
+
+//*****************************************************************************
+//
+//! Supplies characters to be received by a simulated UART.
+//!
+//! \param ulBase is the base address of the UART.
+//! \param pucData is a pointer to the characters.
+//! \param ulLen is the number of characters.
+//!
+//! The characters arrive in the receive FIFO one at a time at the programmed
+//! baud rate, starting from the current simulated time.  Characters that do
+//! not fit in the host side line buffer are discarded.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+HWSimUARTRxInject(unsigned long ulBase, const unsigned char *pucData,
+                  unsigned long ulLen)
+{
+    tHWSimPeriph *psPeriph;
+    tUARTState *psState;
+
+    psPeriph = UARTFind(ulBase);
+    if(!psPeriph)
+    {
+        return;
+    }
+    psState = psPeriph->pvData;
+
+    if(!psState->ulRxLineCount)
+    {
+        psState->ulRxNext = HWSimCyclesGet() + UARTCharTime(psPeriph);
+    }
+    while(ulLen-- && (psState->ulRxLineCount < UART_LINE_SIZE))
+    {
+        psState->pucRxLine[(psState->ulRxLineRead + psState->ulRxLineCount) %
+                           UART_LINE_SIZE] = *pucData++;
+        psState->ulRxLineCount++;
+    }
+}
+
+//*****************************************************************************
+//
+//! Collects the characters transmitted by a simulated UART.
+//!
+//! \param ulBase is the base address of the UART.
+//! \param pucData is a pointer to the buffer to receive the characters.
+//! \param ulLen is the size of the buffer.
+//!
+//! Only characters that have finished shifting out by the current simulated
+//! time are returned.
+//!
+//! \return Returns the number of characters copied into \e pucData.
+//
+//*****************************************************************************
+unsigned long
+HWSimUARTTxRead(unsigned long ulBase, unsigned char *pucData,
+                unsigned long ulLen)
+{
+    tHWSimPeriph *psPeriph;
+    tUARTState *psState;
+    unsigned long ulCount;
+
+    psPeriph = UARTFind(ulBase);
+    if(!psPeriph)
+    {
+        return(0);
+    }
+    psState = psPeriph->pvData;
+
+    UARTAdvance(psPeriph);
+    for(ulCount = 0; (ulCount < ulLen) && psState->ulTxLineCount; ulCount++)
+    {
+        pucData[ulCount] = psState->pucTxLine[psState->ulTxLineRead];
+        psState->ulTxLineRead = (psState->ulTxLineRead + 1) % UART_LINE_SIZE;
+        psState->ulTxLineCount--;
+    }
+    return(ulCount);
+}
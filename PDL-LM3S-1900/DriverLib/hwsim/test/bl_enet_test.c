@@ -0,0 +1,494 @@
+//*****************************************************************************
+//
+// bl_enet_test.c - Test of the boot loader's Ethernet update.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+#define _GNU_SOURCE
+
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include "../../hw_nvic.h"
+#include "../../hw_types.h"
+#include "../../boot_loader/bl_enet.h"
+#include "../hwsim.h"
+#include "bl_config.h"
+
+//*****************************************************************************
+//
+// The size of the image that is served, which is chosen to end part way
+// through both a TFTP block and a flash block.
+//
+//*****************************************************************************
+#define IMAGE_SIZE              3000
+
+//*****************************************************************************
+//
+// The number of TFTP blocks in the image.
+//
+//*****************************************************************************
+#define IMAGE_BLOCKS            ((IMAGE_SIZE / TFTP_BLOCK_SIZE) + 1)
+
+//*****************************************************************************
+//
+// The TFTP block that the server sends twice, as if the acknowledgement of
+// it had been lost.
+//
+//*****************************************************************************
+#define DUP_BLOCK               2
+
+//*****************************************************************************
+//
+// The UDP port from which the server sends the file.
+//
+//*****************************************************************************
+#define SERVER_PORT             1234
+
+//*****************************************************************************
+//
+// The number of 10 ms timer ticks to wait for the update to finish.
+//
+//*****************************************************************************
+#define TIMEOUT_TICKS           500
+
+//*****************************************************************************
+//
+// The TFTP opcodes.
+//
+//*****************************************************************************
+#define TFTP_RRQ                1
+#define TFTP_DATA               3
+#define TFTP_ACK                4
+
+//*****************************************************************************
+//
+// The MAC and IP addresses of the server and of the device, and the name of
+// the image file.
+//
+//*****************************************************************************
+static const unsigned char g_pucServerMAC[6] =
+{
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x01
+};
+static const unsigned char g_pucServerIP[4] = { 10, 0, 0, 1 };
+static const unsigned char g_pucDeviceIP[4] = { 10, 0, 0, 2 };
+static const unsigned char g_pucBroadcast[6] =
+{
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+};
+static const char g_pcFile[] = "image.bin";
+
+//*****************************************************************************
+//
+// The image that is served, and the frame that is being sent to the device.
+//
+//*****************************************************************************
+static unsigned char g_pucImage[IMAGE_SIZE];
+static unsigned char g_pucFrame[1514];
+
+//*****************************************************************************
+//
+// The MAC address of the device, taken from the frames that it sends.
+//
+//*****************************************************************************
+static unsigned char g_pucDeviceMAC[6];
+
+//*****************************************************************************
+//
+// The number of BOOTP requests, TFTP read requests, and acknowledgements
+// received by the server, and the number of timer ticks that have passed.
+//
+//*****************************************************************************
+static unsigned long g_ulBOOTPRequests;
+static unsigned long g_ulReadRequests;
+static unsigned long g_ulAcks;
+static unsigned long g_ulTicks;
+
+//*****************************************************************************
+//
+// The number of failed checks.
+//
+//*****************************************************************************
+static unsigned long g_ulFailures;
+
+//*****************************************************************************
+//
+// The boot loader's startup code is not linked, so the functions that it
+// provides are supplied here.
+//
+//*****************************************************************************
+void
+Delay(unsigned long ulCount)
+{
+}
+
+void
+CallApplication(unsigned long ulBase)
+{
+}
+
+//*****************************************************************************
+//
+// Checks a condition, reporting it if it has failed.
+//
+//*****************************************************************************
+static void
+Check(tBoolean bPass, const char *pcWhat)
+{
+    if(!bPass)
+    {
+        printf("bl_enet_test: FAIL: %s\n", pcWhat);
+        g_ulFailures++;
+    }
+}
+
+//*****************************************************************************
+//
+// Fills in the Ethernet header of the frame to the device.
+//
+//*****************************************************************************
+static void
+FrameHeader(const unsigned char *pucDest, unsigned long ulType)
+{
+    memcpy(g_pucFrame, pucDest, 6);
+    memcpy(g_pucFrame + 6, g_pucServerMAC, 6);
+    g_pucFrame[12] = ulType >> 8;
+    g_pucFrame[13] = ulType;
+}
+
+//*****************************************************************************
+//
+// Sends the UDP data that has been placed in the frame (at offset 42) to the
+// device.  The UDP checksum is not used, and the boot loader does not check
+// the IP header checksum.
+//
+//*****************************************************************************
+static void
+SendUDP(const unsigned char *pucDest, unsigned long ulSrcPort,
+        unsigned long ulDestPort, unsigned long ulLen)
+{
+    unsigned char *pucIP = g_pucFrame + 14;
+
+    FrameHeader(pucDest, 0x0800);
+    memset(pucIP, 0, 28);
+    pucIP[0] = 0x45;
+    pucIP[2] = (ulLen + 28) >> 8;
+    pucIP[3] = ulLen + 28;
+    pucIP[8] = 64;
+    pucIP[9] = 17;
+    memcpy(pucIP + 12, g_pucServerIP, 4);
+    memcpy(pucIP + 16, (pucDest == g_pucBroadcast) ? g_pucBroadcast :
+           g_pucDeviceIP, 4);
+    pucIP[20] = ulSrcPort >> 8;
+    pucIP[21] = ulSrcPort;
+    pucIP[22] = ulDestPort >> 8;
+    pucIP[23] = ulDestPort;
+    pucIP[24] = (ulLen + 8) >> 8;
+    pucIP[25] = ulLen + 8;
+    Check(HWSimEthRxInject(g_pucFrame, 42 + ulLen), "frame received");
+}
+
+//*****************************************************************************
+//
+// Sends a block of the image to the device.
+//
+//*****************************************************************************
+static void
+SendBlock(unsigned long ulBlock)
+{
+    unsigned long ulOffset, ulLen;
+
+    ulOffset = (ulBlock - 1) * TFTP_BLOCK_SIZE;
+    ulLen = IMAGE_SIZE - ulOffset;
+    if(ulLen > TFTP_BLOCK_SIZE)
+    {
+        ulLen = TFTP_BLOCK_SIZE;
+    }
+    g_pucFrame[42] = 0;
+    g_pucFrame[43] = TFTP_DATA;
+    g_pucFrame[44] = ulBlock >> 8;
+    g_pucFrame[45] = ulBlock;
+    memcpy(g_pucFrame + 46, g_pucImage + ulOffset, ulLen);
+    SendUDP(g_pucDeviceMAC, SERVER_PORT, TFTP_CLIENT_PORT, ulLen + 4);
+}
+
+//*****************************************************************************
+//
+// Answers a BOOTP request with the device's address and the image file.
+//
+//*****************************************************************************
+static void
+ServeBOOTP(const unsigned char *pucData)
+{
+    unsigned char *pucReply = g_pucFrame + 42;
+
+    g_ulBOOTPRequests++;
+    Check(g_ulBOOTPRequests == 1, "update restarted with a new BOOTP request");
+    Check((pucData[0] == 1) && (pucData[10] & 0x80),
+          "BOOTP request asks for a broadcast reply");
+
+    memset(pucReply, 0, 300);
+    pucReply[0] = 2;
+    pucReply[1] = 1;
+    pucReply[2] = 6;
+    memcpy(pucReply + 4, pucData + 4, 4);
+    memcpy(pucReply + 16, g_pucDeviceIP, 4);
+    memcpy(pucReply + 20, g_pucServerIP, 4);
+    memcpy(pucReply + 28, pucData + 28, 16);
+    strcpy((char *)pucReply + 108, g_pcFile);
+    memcpy(pucReply + 236, pucData + 236, 5);
+    SendUDP(g_pucBroadcast, BOOTP_SERVER_PORT, BOOTP_CLIENT_PORT, 300);
+}
+
+//*****************************************************************************
+//
+// Answers an ARP request for the server's IP address.
+//
+//*****************************************************************************
+static void
+ServeARP(const unsigned char *pucFrame)
+{
+    if((pucFrame[21] != 1) || memcmp(pucFrame + 38, g_pucServerIP, 4))
+    {
+        return;
+    }
+    FrameHeader(g_pucDeviceMAC, 0x0806);
+    memcpy(g_pucFrame + 14, pucFrame + 14, 6);
+    g_pucFrame[20] = 0;
+    g_pucFrame[21] = 2;
+    memcpy(g_pucFrame + 22, g_pucServerMAC, 6);
+    memcpy(g_pucFrame + 28, g_pucServerIP, 4);
+    memcpy(g_pucFrame + 32, pucFrame + 22, 10);
+    Check(HWSimEthRxInject(g_pucFrame, 42), "ARP reply received");
+}
+
+//*****************************************************************************
+//
+// Handles a TFTP packet sent by the device to the server.
+//
+//*****************************************************************************
+static void
+ServeTFTP(const unsigned char *pucData, unsigned long ulDestPort)
+{
+    unsigned char *pucFlash = HWSimFlashGet() + APP_START_ADDRESS;
+    unsigned long ulBlock, ulOffset, ulLen;
+
+    //
+    // A read request for the image starts the transfer.
+    //
+    if(ulDestPort == TFTP_SERVER_PORT)
+    {
+        g_ulReadRequests++;
+        Check((pucData[1] == TFTP_RRQ) &&
+              !strcmp((const char *)pucData + 2, g_pcFile) &&
+              !strcmp((const char *)pucData + 3 + sizeof(g_pcFile) - 1,
+                      "octet"),
+              "TFTP read request for the image in binary mode");
+        SendBlock(1);
+        return;
+    }
+    if((ulDestPort != SERVER_PORT) || (pucData[1] != TFTP_ACK))
+    {
+        return;
+    }
+    g_ulAcks++;
+    ulBlock = (pucData[2] << 8) | pucData[3];
+
+    //
+    // Each block must be acknowledged before it is programmed, so that the
+    // server can send the next block while the flash is busy.  The initial
+    // stack pointer and reset vector must be held back until the end.
+    //
+    ulOffset = (ulBlock - 1) * TFTP_BLOCK_SIZE;
+    ulLen = IMAGE_SIZE - ulOffset;
+    if(ulLen > TFTP_BLOCK_SIZE)
+    {
+        ulLen = TFTP_BLOCK_SIZE;
+    }
+    if(!((ulBlock == DUP_BLOCK) && (g_ulAcks == (DUP_BLOCK + 1))))
+    {
+        Check(memcmp(pucFlash + ulOffset + 8, g_pucImage + ulOffset + 8,
+                     ulLen - 8) != 0,
+              "block acknowledged before it is programmed");
+    }
+    Check((ulBlock == 1) ||
+          ((((unsigned long *)pucFlash)[0] == 0xffffffff) &&
+           (((unsigned long *)pucFlash)[1] == 0xffffffff)),
+          "vectors held back until the image is complete");
+
+    //
+    // Send the next block, sending the duplicated block a second time first.
+    // The repeated acknowledgement of the duplicated block is not answered.
+    //
+    if(ulBlock == DUP_BLOCK)
+    {
+        if(g_ulAcks == DUP_BLOCK)
+        {
+            SendBlock(DUP_BLOCK);
+            SendBlock(DUP_BLOCK + 1);
+        }
+        return;
+    }
+    if(ulBlock < IMAGE_BLOCKS)
+    {
+        SendBlock(ulBlock + 1);
+    }
+}
+
+//*****************************************************************************
+//
+// Handles a frame sent by the device, playing the part of a BOOTP, ARP and
+// TFTP server.
+//
+//*****************************************************************************
+static void
+EthTx(const unsigned char *pucFrame, unsigned long ulLen)
+{
+    unsigned long ulType, ulDestPort;
+
+    memcpy(g_pucDeviceMAC, pucFrame + 6, 6);
+    ulType = (pucFrame[12] << 8) | pucFrame[13];
+    if(ulType == 0x0806)
+    {
+        ServeARP(pucFrame);
+        return;
+    }
+    if((ulType != 0x0800) || (pucFrame[23] != 17) || (ulLen < 46))
+    {
+        return;
+    }
+    ulDestPort = (pucFrame[36] << 8) | pucFrame[37];
+    if(ulDestPort == BOOTP_SERVER_PORT)
+    {
+        ServeBOOTP(pucFrame + 42);
+    }
+    else
+    {
+        ServeTFTP(pucFrame + 42, ulDestPort);
+    }
+}
+
+//*****************************************************************************
+//
+// Checks the result of the update and exits with a non-zero status if any
+// check has failed.
+//
+//*****************************************************************************
+static void
+Finish(tBoolean bReset)
+{
+    const unsigned char *pucFlash = HWSimFlashGet() + APP_START_ADDRESS;
+    unsigned long ulIdx;
+    char pcBuf[96];
+
+    Check(bReset, "device reset at the end of the update");
+    Check(g_ulReadRequests == 1, "one TFTP read request");
+    sprintf(pcBuf, "%lu acknowledgements, expected %lu", g_ulAcks,
+            (unsigned long)IMAGE_BLOCKS + 1);
+    Check(g_ulAcks == (IMAGE_BLOCKS + 1), pcBuf);
+    Check(!memcmp(pucFlash, g_pucImage, IMAGE_SIZE), "image programmed");
+    for(ulIdx = IMAGE_SIZE; ulIdx < ((IMAGE_SIZE + 0x3ff) & ~0x3ff); ulIdx++)
+    {
+        if(pucFlash[ulIdx] != 0xff)
+        {
+            break;
+        }
+    }
+    Check(ulIdx == ((IMAGE_SIZE + 0x3ff) & ~0x3ff),
+          "rest of the last flash block erased");
+    Check(pucFlash[ulIdx] == 0x5a, "flash past the image left alone");
+
+    printf("bl_enet_test: %s\n", g_ulFailures ? "FAILED" : "passed");
+    fflush(stdout);
+    _exit(g_ulFailures ? 1 : 0);
+}
+
+//*****************************************************************************
+//
+// The timer signal handler.  Once the image has been programmed the boot
+// loader requests a reset and then spins forever, so the result is checked
+// from here.
+//
+//*****************************************************************************
+static void
+TimerHandler(int iSignal)
+{
+    if(HWSimRegGet(NVIC_APINT) & NVIC_APINT_SYSRESETREQ)
+    {
+        Finish(true);
+    }
+    if(++g_ulTicks == TIMEOUT_TICKS)
+    {
+        Finish(false);
+    }
+}
+
+//*****************************************************************************
+//
+// Runs the test, exiting with a zero status if it passes.
+//
+//*****************************************************************************
+int
+main(void)
+{
+    struct itimerval sTimer;
+    unsigned long ulIdx;
+
+    //
+    // Start the simulator and attach the server to the Ethernet controller.
+    //
+    HWSimInit();
+    HWSimEthTxCallbackSet(EthTx);
+
+    //
+    // Fill the image with a pattern, and fill the application area with an
+    // old image that must be erased.
+    //
+    for(ulIdx = 0; ulIdx < IMAGE_SIZE; ulIdx++)
+    {
+        g_pucImage[ulIdx] = (ulIdx * 13) + (ulIdx >> 8) + 5;
+    }
+    memset(HWSimFlashGet() + APP_START_ADDRESS, 0x5a, 0x2000);
+
+    //
+    // Check on the boot loader every 10 ms.
+    //
+    signal(SIGALRM, TimerHandler);
+    sTimer.it_interval.tv_sec = 0;
+    sTimer.it_interval.tv_usec = 10000;
+    sTimer.it_value = sTimer.it_interval;
+    setitimer(ITIMER_REAL, &sTimer, 0);
+
+    //
+    // Run the update, which never returns.
+    //
+    ConfigureEnet();
+    UpdateBOOTP();
+
+    return(1);
+}
@@ -0,0 +1,481 @@
+//*****************************************************************************
+//
+// mmc_test.c - Test of the command sequences issued by the MMC/SD port.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+#include <stdio.h>
+#include <string.h>
+#include "../../hw_types.h"
+#include "../../hw_memmap.h"
+#include "../../src/sysctl.h"
+#include "../../third_party/fatfs/src/diskio.h"
+#include "../hwsim.h"
+
+//*****************************************************************************
+//
+// The number of sectors on the simulated card, and the number of busy bytes
+// that the card returns after each block that is written.
+//
+//*****************************************************************************
+#define CARD_SECTORS            64
+#define CARD_BUSY_BYTES         8
+
+//*****************************************************************************
+//
+// The states of the simulated card.
+//
+//*****************************************************************************
+#define CARD_IDLE               0   // Waiting for a command
+#define CARD_READ_MULTI         1   // Sending blocks until CMD12
+#define CARD_WRITE_MULTI        2   // Waiting for a data or stop token
+#define CARD_WRITE_MULTI_DATA   3   // Receiving a block of a CMD25
+#define CARD_WRITE_SINGLE       4   // Waiting for the data token of a CMD24
+#define CARD_WRITE_SINGLE_DATA  5   // Receiving the block of a CMD24
+
+//*****************************************************************************
+//
+// The simulated SDHC card: its contents, the bytes queued to be returned to
+// the host, the command being received, and the block being written.
+//
+//*****************************************************************************
+static unsigned char g_pucCard[CARD_SECTORS * 512];
+static unsigned char g_pucOut[1024];
+static unsigned long g_ulOutRead, g_ulOutWrite;
+static unsigned char g_pucCmd[6];
+static unsigned long g_ulCmdLen;
+static unsigned char g_pucBlock[514];
+static unsigned long g_ulBlockLen;
+static unsigned long g_ulState;
+static unsigned long g_ulSector;
+
+//*****************************************************************************
+//
+// The number of commands received by the card (with an ACMD counting as two),
+// and the index of the last one.
+//
+//*****************************************************************************
+static unsigned long g_ulCmds;
+static unsigned long g_ulLastCmd;
+
+//*****************************************************************************
+//
+// The number of failed checks.
+//
+//*****************************************************************************
+static unsigned long g_ulFailures;
+
+//*****************************************************************************
+//
+// Queues bytes to be returned by the card.
+//
+//*****************************************************************************
+static void
+CardPut(unsigned char ucByte, unsigned long ulCount)
+{
+    while(ulCount--)
+    {
+        g_pucOut[g_ulOutWrite++ % sizeof(g_pucOut)] = ucByte;
+    }
+}
+
+//*****************************************************************************
+//
+// Queues a data block from the card, preceded by the data token.
+//
+//*****************************************************************************
+static void
+CardPutBlock(unsigned long ulSector)
+{
+    unsigned long ulIdx;
+
+    CardPut(0xff, 2);
+    CardPut(0xfe, 1);
+    for(ulIdx = 0; ulIdx < 512; ulIdx++)
+    {
+        CardPut(g_pucCard[((ulSector % CARD_SECTORS) * 512) + ulIdx], 1);
+    }
+    CardPut(0, 2);
+}
+
+//*****************************************************************************
+//
+// Handles a command received by the card.
+//
+//*****************************************************************************
+static void
+CardCommand(void)
+{
+    unsigned long ulArg;
+
+    ulArg = ((g_pucCmd[1] << 24) | (g_pucCmd[2] << 16) | (g_pucCmd[3] << 8) |
+             g_pucCmd[4]);
+    g_ulLastCmd = g_pucCmd[0] & 0x3f;
+    g_ulCmds++;
+
+    //
+    // A STOP_TRANSMISSION ends a read; the blocks already queued are lost, and
+    // a stuff byte precedes the response.
+    //
+    if(g_ulLastCmd == 12)
+    {
+        g_ulOutRead = g_ulOutWrite = 0;
+        g_ulState = CARD_IDLE;
+        CardPut(0xff, 2);
+        CardPut(0, 1);
+        CardPut(0, CARD_BUSY_BYTES);
+        CardPut(0xff, 1);
+        return;
+    }
+
+    CardPut(0xff, 1);
+    switch(g_ulLastCmd)
+    {
+        //
+        // GO_IDLE_STATE.
+        //
+        case 0:
+        {
+            CardPut(0x01, 1);
+            break;
+        }
+
+        //
+        // SEND_IF_COND, with the voltage range accepted.
+        //
+        case 8:
+        {
+            CardPut(0x01, 1);
+            CardPut(0x00, 2);
+            CardPut(0x01, 1);
+            CardPut(0xaa, 1);
+            break;
+        }
+
+        //
+        // READ_OCR, with the card powered up and high capacity.
+        //
+        case 58:
+        {
+            CardPut(0x00, 1);
+            CardPut(0xc0, 1);
+            CardPut(0xff, 1);
+            CardPut(0x80, 1);
+            CardPut(0x00, 1);
+            break;
+        }
+
+        //
+        // READ_SINGLE_BLOCK.
+        //
+        case 17:
+        {
+            CardPut(0x00, 1);
+            CardPutBlock(ulArg);
+            break;
+        }
+
+        //
+        // READ_MULTIPLE_BLOCK; the blocks are queued as the host reads them.
+        //
+        case 18:
+        {
+            CardPut(0x00, 1);
+            g_ulState = CARD_READ_MULTI;
+            g_ulSector = ulArg;
+            break;
+        }
+
+        //
+        // WRITE_BLOCK.
+        //
+        case 24:
+        {
+            CardPut(0x00, 1);
+            g_ulState = CARD_WRITE_SINGLE;
+            g_ulSector = ulArg;
+            break;
+        }
+
+        //
+        // WRITE_MULTIPLE_BLOCK.
+        //
+        case 25:
+        {
+            CardPut(0x00, 1);
+            g_ulState = CARD_WRITE_MULTI;
+            g_ulSector = ulArg;
+            break;
+        }
+
+        //
+        // APP_CMD, SD_SEND_OP_COND, SET_BLOCKLEN and SET_WR_BLK_ERASE_COUNT
+        // all succeed with no data.
+        //
+        case 16:
+        case 23:
+        case 41:
+        case 55:
+        {
+            CardPut(0x00, 1);
+            break;
+        }
+
+        //
+        // Any other command is illegal.
+        //
+        default:
+        {
+            CardPut(0x04, 1);
+            break;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Exchanges a byte with the simulated card.  This is called by the SSI model
+// for each frame sent by the port.
+//
+//*****************************************************************************
+static unsigned long
+CardXfer(unsigned long ulTx)
+{
+    unsigned char ucRx;
+
+    //
+    // Return the next queued byte, or an idle bus.
+    //
+    ucRx = 0xff;
+    if(g_ulOutRead != g_ulOutWrite)
+    {
+        ucRx = g_pucOut[g_ulOutRead++ % sizeof(g_pucOut)];
+    }
+
+    switch(g_ulState)
+    {
+        //
+        // Wait for the start of a block to be written.  During a multiple
+        // block write, the stop token ends the transfer.
+        //
+        case CARD_WRITE_SINGLE:
+        case CARD_WRITE_MULTI:
+        {
+            if(ulTx == ((g_ulState == CARD_WRITE_SINGLE) ? 0xfe : 0xfc))
+            {
+                g_ulState++;
+                g_ulBlockLen = 0;
+            }
+            else if((g_ulState == CARD_WRITE_MULTI) && (ulTx == 0xfd))
+            {
+                g_ulState = CARD_IDLE;
+                CardPut(0xff, 1);
+                CardPut(0x00, CARD_BUSY_BYTES);
+            }
+            return(ucRx);
+        }
+
+        //
+        // Receive a block and its CRC, then accept it and go busy while it is
+        // programmed.
+        //
+        case CARD_WRITE_SINGLE_DATA:
+        case CARD_WRITE_MULTI_DATA:
+        {
+            g_pucBlock[g_ulBlockLen++] = ulTx;
+            if(g_ulBlockLen == sizeof(g_pucBlock))
+            {
+                memcpy(g_pucCard + ((g_ulSector++ % CARD_SECTORS) * 512),
+                       g_pucBlock, 512);
+                CardPut(0xe5, 1);
+                CardPut(0x00, CARD_BUSY_BYTES);
+                g_ulState = ((g_ulState == CARD_WRITE_MULTI_DATA) ?
+                             CARD_WRITE_MULTI : CARD_IDLE);
+            }
+            return(ucRx);
+        }
+    }
+
+    //
+    // Collect a command, which starts with a byte of the form 01xxxxxx.
+    //
+    if(g_ulCmdLen || ((ulTx & 0xc0) == 0x40))
+    {
+        g_pucCmd[g_ulCmdLen++] = ulTx;
+        if(g_ulCmdLen == sizeof(g_pucCmd))
+        {
+            g_ulCmdLen = 0;
+            CardCommand();
+        }
+    }
+
+    //
+    // During a multiple block read, queue the next block once the host has
+    // read the last one.
+    //
+    if((g_ulState == CARD_READ_MULTI) && (g_ulOutRead == g_ulOutWrite) &&
+       !g_ulCmdLen)
+    {
+        CardPutBlock(g_ulSector++);
+    }
+
+    return(ucRx);
+}
+
+//*****************************************************************************
+//
+// Checks a condition, reporting it if it has failed.
+//
+//*****************************************************************************
+static void
+Check(tBoolean bPass, const char *pcWhat)
+{
+    if(!bPass)
+    {
+        printf("mmc_test: FAIL: %s\n", pcWhat);
+        g_ulFailures++;
+    }
+}
+
+//*****************************************************************************
+//
+// Checks the commands received by the card, and the port's transfer counters,
+// since the counters were last reset.
+//
+//*****************************************************************************
+static void
+CheckCommands(unsigned long ulCmds, unsigned long ulRdCmds,
+              unsigned long ulWrCmds, const char *pcWhat)
+{
+    DISK_STATS sStats;
+    char pcBuf[96];
+
+    disk_ioctl(0, MMC_GET_STATS, &sStats);
+    sprintf(pcBuf, "%s: %lu card commands, expected %lu", pcWhat, g_ulCmds,
+            ulCmds);
+    Check(g_ulCmds == ulCmds, pcBuf);
+    sprintf(pcBuf, "%s: %lu read commands counted, expected %lu", pcWhat,
+            (unsigned long)sStats.rd_cmds, ulRdCmds);
+    Check(sStats.rd_cmds == ulRdCmds, pcBuf);
+    sprintf(pcBuf, "%s: %lu write commands counted, expected %lu", pcWhat,
+            (unsigned long)sStats.wr_cmds, ulWrCmds);
+    Check(sStats.wr_cmds == ulWrCmds, pcBuf);
+}
+
+//*****************************************************************************
+//
+// Resets the command count of the card and the port's transfer counters.
+//
+//*****************************************************************************
+static void
+ResetCommands(void)
+{
+    disk_ioctl(0, MMC_RESET_STATS, 0);
+    g_ulCmds = 0;
+}
+
+//*****************************************************************************
+//
+// Runs the tests, returning zero if they all pass.
+//
+//*****************************************************************************
+int
+main(void)
+{
+    static unsigned char pucData[4 * 512], pucRead[4 * 512];
+    unsigned long ulIdx;
+    BYTE ucExclusive;
+
+    //
+    // Start the simulator and attach the card to the SSI port.
+    //
+    HWSimInit();
+    SysCtlClockSet(SYSCTL_SYSDIV_4 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN |
+                   SYSCTL_XTAL_8MHZ);
+    HWSimSSIDeviceSet(SSI0_BASE, CardXfer);
+    Check(disk_initialize(0) == 0, "disk_initialize");
+    for(ulIdx = 0; ulIdx < sizeof(pucData); ulIdx++)
+    {
+        pucData[ulIdx] = (ulIdx * 7) + (ulIdx >> 9);
+    }
+
+    //
+    // A single sector is written with one WRITE_BLOCK and read with one
+    // READ_SINGLE_BLOCK.
+    //
+    ResetCommands();
+    Check(disk_write(0, pucData, 5, 1) == RES_OK, "single sector write");
+    Check(g_ulLastCmd == 24, "single sector write uses CMD24");
+    CheckCommands(1, 0, 1, "single sector write");
+    Check(!memcmp(g_pucCard + (5 * 512), pucData, 512),
+          "single sector write data");
+    ResetCommands();
+    Check(disk_read(0, pucRead, 5, 1) == RES_OK, "single sector read");
+    Check(g_ulLastCmd == 17, "single sector read uses CMD17");
+    CheckCommands(1, 1, 0, "single sector read");
+    Check(!memcmp(pucRead, pucData, 512), "single sector read data");
+
+    //
+    // Several sectors are written with ACMD23 and WRITE_MULTIPLE_BLOCK, and
+    // read with READ_MULTIPLE_BLOCK and STOP_TRANSMISSION.
+    //
+    ResetCommands();
+    Check(disk_write(0, pucData, 8, 4) == RES_OK, "multiple sector write");
+    CheckCommands(3, 0, 1, "multiple sector write");
+    Check(!memcmp(g_pucCard + (8 * 512), pucData, sizeof(pucData)),
+          "multiple sector write data");
+    ResetCommands();
+    memset(pucRead, 0, sizeof(pucRead));
+    Check(disk_read(0, pucRead, 8, 4) == RES_OK, "multiple sector read");
+    CheckCommands(2, 1, 0, "multiple sector read");
+    Check(!memcmp(pucRead, pucData, sizeof(pucRead)),
+          "multiple sector read data");
+
+    //
+    // With the port held exclusively, consecutive single sector reads stream
+    // through one READ_MULTIPLE_BLOCK, which is stopped by CTRL_SYNC.
+    //
+    ucExclusive = 1;
+    disk_ioctl(0, MMC_SET_EXCLUSIVE, &ucExclusive);
+    ResetCommands();
+    memset(pucRead, 0, sizeof(pucRead));
+    for(ulIdx = 0; ulIdx < 4; ulIdx++)
+    {
+        Check(disk_read(0, pucRead + (ulIdx * 512), 8 + ulIdx, 1) == RES_OK,
+              "exclusive read");
+    }
+    CheckCommands(1, 1, 0, "exclusive reads");
+    Check(disk_ioctl(0, CTRL_SYNC, 0) == RES_OK, "CTRL_SYNC");
+    Check(g_ulLastCmd == 12, "CTRL_SYNC stops the read");
+    Check(!memcmp(pucRead, pucData, sizeof(pucRead)), "exclusive read data");
+    ucExclusive = 0;
+    disk_ioctl(0, MMC_SET_EXCLUSIVE, &ucExclusive);
+
+    //
+    // Report the result.
+    //
+    printf("mmc_test: %s\n", g_ulFailures ? "FAILED" : "passed");
+    return(g_ulFailures ? 1 : 0);
+}
@@ -37,6 +37,7 @@
 #include "../hw_types.h"
 #include "../hw_nvic.h"
 #include "../hw_can.h"
+#include "../hw_sysctl.h"
 #include "debug.h"
 #include "interrupt.h"
 #include "sysctl.h"
@@ -57,6 +58,59 @@
 //*****************************************************************************
 #define CAN_RW_DELAY            (5)
 
+//*****************************************************************************
+//
+// Determines whether the CAN controller registers must be accessed with the
+// delays (and the double read) provided by CANReadReg() and CANWriteReg().
+// This is only required on the first (revision A) silicon of the devices
+// that have a CAN controller.  Like the DEVICE_IS_* macros in hw_types.h,
+// this can be hard-coded for a specific silicon revision to remove the run-
+// time check.
+//
+//*****************************************************************************
+#ifndef CAN_NEEDS_RW_DELAY
+#define CAN_NEEDS_RW_DELAY                                                    \
+    (DEVICE_IS_FURY &&                                                        \
+     ((HWREG(SYSCTL_DID0) & SYSCTL_DID0_MAJ_M) == SYSCTL_DID0_MAJ_REVA))
+#endif
+
+//*****************************************************************************
+//
+// Indicates whether the CAN controller registers need the access delays, or
+// is -1 if this has not yet been determined.
+//
+//*****************************************************************************
+static long g_lCANNeedsDelay = -1;
+
+//*****************************************************************************
+//
+//! \internal
+//! Determines whether the CAN register accesses need delays.
+//!
+//! This function checks the silicon revision the first time that it is
+//! called, and returns the saved result after that.
+//!
+//! \return Returns \b true if the register accesses need delays and \b false
+//! otherwise.
+//
+//*****************************************************************************
+static tBoolean
+CANNeedsDelay(void)
+{
+    //
+    // Check the silicon revision if it has not been checked before.
+    //
+    if(g_lCANNeedsDelay < 0)
+    {
+        g_lCANNeedsDelay = CAN_NEEDS_RW_DELAY ? 1 : 0;
+    }
+
+    //
+    // Return the saved result.
+    //
+    return(g_lCANNeedsDelay ? true : false);
+}
+
 //*****************************************************************************
 //
 //! Reads a CAN controller register.
@@ -67,7 +121,8 @@
 //! controller register.
 //!
 //! \note This function provides the delay required to access CAN registers.
-//! This delay is required when accessing CAN registers directly.
+//! This delay is required when accessing CAN registers directly on revision A
+//! silicon; on later silicon the register is simply read.
 //!
 //! \return Returns the value read from the register.
 //
@@ -80,6 +135,14 @@ CANReadReg(unsigned long ulRegAddress)
     unsigned long ulIntNumber;
     unsigned long ulReenableInts;
 
+    //
+    // A single read returns the valid value if no delay is required.
+    //
+    if(!CANNeedsDelay())
+    {
+        return(HWREG(ulRegAddress));
+    }
+
     //
     // Get the CAN interrupt number from the register base address.
     //
@@ -145,7 +208,8 @@ CANReadReg(unsigned long ulRegAddress)
 //! CAN controller register.
 //!
 //! \note The delays in this function are required when accessing CAN registers
-//! directly.
+//! directly on revision A silicon; on later silicon the register is simply
+//! written.
 //!
 //! \return None.
 //
@@ -164,8 +228,168 @@ CANWriteReg(unsigned long ulRegAddress, unsigned long ulRegValue)
     //
     // Delay to allow the CAN controller to receive the new data.
     //
-    for(iDelay = 0; iDelay < CAN_RW_DELAY; iDelay++)
+    if(CANNeedsDelay())
+    {
+        for(iDelay = 0; iDelay < CAN_RW_DELAY; iDelay++)
+        {
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! Starts a batch of CAN controller register accesses.
+//!
+//! \param ulBase is the base address of the CAN controller.
+//! \param psBatch is a pointer to the structure that holds the state of the
+//! batch.
+//!
+//! This function prepares for a sequence of register accesses made with
+//! CANRegBatchRead() and CANRegBatchWrite(), which must be ended by calling
+//! CANRegBatchEnd().  The interrupt of the CAN controller is disabled (if it
+//! was enabled) for the whole batch, rather than around each access as is
+//! done by CANReadReg(), and the silicon revision is only checked once.  This
+//! also keeps the CAN interrupt handler from using the IF registers part way
+//! through a sequence that programs or reads a message object.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+CANRegBatchBegin(unsigned long ulBase, tCANRegBatch *psBatch)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT((ulBase == CAN0_BASE) ||
+           (ulBase == CAN1_BASE) ||
+           (ulBase == CAN2_BASE));
+    ASSERT(psBatch);
+
+    //
+    // Get the CAN interrupt number from the base address.
+    //
+    psBatch->ulIntNumber = CANGetIntNumber(ulBase);
+
+    //
+    // Disable the CAN interrupt if it is enabled, remembering to re-enable it
+    // at the end of the batch.
+    //
+    psBatch->bReenableInt = ((HWREG(NVIC_EN1) &
+                              (1 << (psBatch->ulIntNumber - 48))) ?
+                             true : false);
+    if(psBatch->bReenableInt)
+    {
+        IntDisable(psBatch->ulIntNumber);
+    }
+
+    //
+    // Determine whether the accesses need delays.
+    //
+    psBatch->bDelay = CANNeedsDelay();
+}
+
+//*****************************************************************************
+//
+//! Ends a batch of CAN controller register accesses.
+//!
+//! \param psBatch is a pointer to the structure that holds the state of the
+//! batch.
+//!
+//! This function ends a batch of register accesses started with
+//! CANRegBatchBegin(), re-enabling the interrupt of the CAN controller if it
+//! was enabled when the batch was started.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+CANRegBatchEnd(tCANRegBatch *psBatch)
+{
+    //
+    // Re-enable the CAN interrupt if it was enabled before the batch.
+    //
+    if(psBatch->bReenableInt)
     {
+        IntEnable(psBatch->ulIntNumber);
+    }
+}
+
+//*****************************************************************************
+//
+//! Reads a CAN controller register as part of a batch.
+//!
+//! \param psBatch is a pointer to the structure that holds the state of the
+//! batch.
+//! \param ulRegAddress is the full address of the CAN register to be read.
+//!
+//! This function reads a CAN controller register in the same way as
+//! CANReadReg(), but without changing the interrupt state.  It may only be
+//! used between CANRegBatchBegin() and CANRegBatchEnd().
+//!
+//! \return Returns the value read from the register.
+//
+//*****************************************************************************
+unsigned long
+CANRegBatchRead(tCANRegBatch *psBatch, unsigned long ulRegAddress)
+{
+    volatile int iDelay;
+
+    //
+    // On silicon that needs it, trigger the initial read and then wait for
+    // the CAN controller to place the correct data on the bus.
+    //
+    if(psBatch->bDelay)
+    {
+        HWREG(ulRegAddress);
+        for(iDelay = 0; iDelay < CAN_RW_DELAY; iDelay++)
+        {
+        }
+    }
+
+    //
+    // Return the value of the register.
+    //
+    return(HWREG(ulRegAddress));
+}
+
+//*****************************************************************************
+//
+//! Writes a CAN controller register as part of a batch.
+//!
+//! \param psBatch is a pointer to the structure that holds the state of the
+//! batch.
+//! \param ulRegAddress is the full address of the CAN register to be written.
+//! \param ulRegValue is the value to write into the register specified by
+//! \e ulRegAddress.
+//!
+//! This function writes a CAN controller register in the same way as
+//! CANWriteReg().  It may only be used between CANRegBatchBegin() and
+//! CANRegBatchEnd().
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+CANRegBatchWrite(tCANRegBatch *psBatch, unsigned long ulRegAddress,
+                 unsigned long ulRegValue)
+{
+    volatile int iDelay;
+
+    //
+    // Write the register.
+    //
+    HWREG(ulRegAddress) = ulRegValue;
+
+    //
+    // On silicon that needs it, delay to allow the CAN controller to receive
+    // the new data.
+    //
+    if(psBatch->bDelay)
+    {
+        for(iDelay = 0; iDelay < CAN_RW_DELAY; iDelay++)
+        {
+        }
     }
 }
 
@@ -270,6 +494,106 @@ CANReadDataReg(unsigned char *pucData, unsigned long *pulRegister, int iSize)
     }
 }
 
+//*****************************************************************************
+//
+//! \internal
+//! Copies data from a buffer to the CAN Data registers as part of a batch.
+//!
+//! \param psBatch is a pointer to the structure that holds the state of the
+//! batch of register accesses.
+//! \param pucData is a pointer to the data to be written out to the CAN
+//! controller's data registers.
+//! \param pulRegister is an unsigned long pointer to the first register of the
+//! CAN controller's data registers.
+//! \param iSize is the number of bytes to copy into the CAN controller.
+//!
+//! This function is the same as CANWriteDataReg(), but uses
+//! CANRegBatchWrite() to access the registers.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+CANBatchWriteDataReg(tCANRegBatch *psBatch, unsigned char *pucData,
+                     unsigned long *pulRegister, int iSize)
+{
+    int iIdx;
+    unsigned long ulValue;
+
+    //
+    // Loop always copies 1 or 2 bytes per iteration.
+    //
+    for(iIdx = 0; iIdx < iSize; )
+    {
+        //
+        // Write out the data 16 bits at a time since this is how the registers
+        // are aligned in memory.
+        //
+        ulValue = pucData[iIdx++];
+
+        //
+        // Only write the second byte if needed otherwise it will be zero.
+        //
+        if(iIdx < iSize)
+        {
+            ulValue |= (pucData[iIdx++] << 8);
+        }
+        CANRegBatchWrite(psBatch, (unsigned long)(pulRegister++), ulValue);
+    }
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! Copies data from the CAN Data registers to a buffer as part of a batch.
+//!
+//! \param psBatch is a pointer to the structure that holds the state of the
+//! batch of register accesses.
+//! \param pucData is a pointer to the location to store the data read from the
+//! CAN controller's data registers.
+//! \param pulRegister is an unsigned long pointer to the first register of the
+//! CAN controller's data registers.
+//! \param iSize is the number of bytes to copy from the CAN controller.
+//!
+//! This function is the same as CANReadDataReg(), but uses CANRegBatchRead()
+//! to access the registers.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+CANBatchReadDataReg(tCANRegBatch *psBatch, unsigned char *pucData,
+                    unsigned long *pulRegister, int iSize)
+{
+    int iIdx;
+    unsigned long ulValue;
+
+    //
+    // Loop always copies 1 or 2 bytes per iteration.
+    //
+    for(iIdx = 0; iIdx < iSize; )
+    {
+        //
+        // Read out the data 16 bits at a time since this is how the registers
+        // are aligned in memory.
+        //
+        ulValue = CANRegBatchRead(psBatch, (unsigned long)(pulRegister++));
+
+        //
+        // Store the first byte.
+        //
+        pucData[iIdx++] = (unsigned char)ulValue;
+
+        //
+        // Only read the second byte if needed.
+        //
+        if(iIdx < iSize)
+        {
+            pucData[iIdx++] = (unsigned char)(ulValue >> 8);
+        }
+    }
+}
+
 //*****************************************************************************
 //
 //! Initializes the CAN controller after reset.
@@ -882,6 +1206,7 @@ unsigned long
 CANIntStatus(unsigned long ulBase, tCANIntStsReg eIntStsReg)
 {
     unsigned long ulStatus;
+    tCANRegBatch sBatch;
 
     //
     // Check the arguments.
@@ -890,6 +1215,12 @@ CANIntStatus(unsigned long ulBase, tCANIntStsReg eIntStsReg)
            (ulBase == CAN1_BASE) ||
            (ulBase == CAN2_BASE));
 
+    //
+    // Start a batch of register accesses, masking the CAN interrupt once for
+    // the whole sequence.
+    //
+    CANRegBatchBegin(ulBase, &sBatch);
+
     //
     // See which status the caller is looking for.
     //
@@ -901,7 +1232,7 @@ CANIntStatus(unsigned long ulBase, tCANIntStsReg eIntStsReg)
         //
         case CAN_INT_STS_CAUSE:
         {
-            ulStatus = CANReadReg(ulBase + CAN_O_INT);
+            ulStatus = CANRegBatchRead(&sBatch, ulBase + CAN_O_INT);
             break;
         }
 
@@ -914,9 +1245,10 @@ CANIntStatus(unsigned long ulBase, tCANIntStsReg eIntStsReg)
             //
             // Read and combine both 16 bit values into one 32bit status.
             //
-            ulStatus = (CANReadReg(ulBase + CAN_O_MSG1INT) &
+            ulStatus = (CANRegBatchRead(&sBatch, ulBase + CAN_O_MSG1INT) &
                         CAN_MSG1INT_INTPND_M);
-            ulStatus |= (CANReadReg(ulBase + CAN_O_MSG2INT) << 16);
+            ulStatus |= (CANRegBatchRead(&sBatch, ulBase + CAN_O_MSG2INT) <<
+                         16);
             break;
         }
 
@@ -929,6 +1261,12 @@ CANIntStatus(unsigned long ulBase, tCANIntStsReg eIntStsReg)
             break;
         }
     }
+
+    //
+    // End the batch of register accesses.
+    //
+    CANRegBatchEnd(&sBatch);
+
     //
     // Return the interrupt status value
     //
@@ -962,6 +1300,8 @@ CANIntStatus(unsigned long ulBase, tCANIntStsReg eIntStsReg)
 void
 CANIntClear(unsigned long ulBase, unsigned long ulIntClr)
 {
+    tCANRegBatch sBatch;
+
     //
     // Check the arguments.
     //
@@ -971,19 +1311,26 @@ CANIntClear(unsigned long ulBase, unsigned long ulIntClr)
     ASSERT((ulIntClr == CAN_INT_INTID_STATUS) ||
            ((ulIntClr>=1) && (ulIntClr <=32)));
 
+    //
+    // Start a batch of register accesses, masking the CAN interrupt once for
+    // the whole sequence.
+    //
+    CANRegBatchBegin(ulBase, &sBatch);
+
     if(ulIntClr == CAN_INT_INTID_STATUS)
     {
         //
         // Simply read and discard the status to clear the interrupt.
         //
-        CANReadReg(ulBase + CAN_O_STS);
+        CANRegBatchRead(&sBatch, ulBase + CAN_O_STS);
     }
     else
     {
         //
         // Wait to be sure that this interface is not busy.
         //
-        while(CANReadReg(ulBase + CAN_O_IF1CRQ) & CAN_IF1CRQ_BUSY)
+        while(CANRegBatchRead(&sBatch, ulBase + CAN_O_IF1CRQ) &
+              CAN_IF1CRQ_BUSY)
         {
         }
 
@@ -991,20 +1338,28 @@ CANIntClear(unsigned long ulBase, unsigned long ulIntClr)
         // Only change the interrupt pending state by setting only the
         // CAN_IF1CMSK_CLRINTPND bit.
         //
-        CANWriteReg(ulBase + CAN_O_IF1CMSK, CAN_IF1CMSK_CLRINTPND);
+        CANRegBatchWrite(&sBatch, ulBase + CAN_O_IF1CMSK,
+                         CAN_IF1CMSK_CLRINTPND);
 
         //
         // Send the clear pending interrupt command to the CAN controller.
         //
-        CANWriteReg(ulBase + CAN_O_IF1CRQ, ulIntClr & CAN_IF1CRQ_MNUM_M);
+        CANRegBatchWrite(&sBatch, ulBase + CAN_O_IF1CRQ,
+                         ulIntClr & CAN_IF1CRQ_MNUM_M);
 
         //
         // Wait to be sure that this interface is not busy.
         //
-        while(CANReadReg(ulBase + CAN_O_IF1CRQ) & CAN_IF1CRQ_BUSY)
+        while(CANRegBatchRead(&sBatch, ulBase + CAN_O_IF1CRQ) &
+              CAN_IF1CRQ_BUSY)
         {
         }
     }
+
+    //
+    // End the batch of register accesses.
+    //
+    CANRegBatchEnd(&sBatch);
 }
 
 //*****************************************************************************
@@ -1159,6 +1514,7 @@ unsigned long
 CANStatusGet(unsigned long ulBase, tCANStsReg eStatusReg)
 {
     unsigned long ulStatus;
+    tCANRegBatch sBatch;
 
     //
     // Check the arguments.
@@ -1167,6 +1523,12 @@ CANStatusGet(unsigned long ulBase, tCANStsReg eStatusReg)
            (ulBase == CAN1_BASE) ||
            (ulBase == CAN2_BASE));
 
+    //
+    // Start a batch of register accesses, masking the CAN interrupt once for
+    // the whole sequence.
+    //
+    CANRegBatchBegin(ulBase, &sBatch);
+
     switch (eStatusReg)
     {
         //
@@ -1175,9 +1537,9 @@ CANStatusGet(unsigned long ulBase, tCANStsReg eStatusReg)
         //
         case CAN_STS_CONTROL:
         {
-            ulStatus = CANReadReg(ulBase + CAN_O_STS);
-            CANWriteReg(ulBase + CAN_O_STS,
-                        ~(CAN_STS_RXOK | CAN_STS_TXOK | CAN_STS_LEC_M));
+            ulStatus = CANRegBatchRead(&sBatch, ulBase + CAN_O_STS);
+            CANRegBatchWrite(&sBatch, ulBase + CAN_O_STS,
+                             ~(CAN_STS_RXOK | CAN_STS_TXOK | CAN_STS_LEC_M));
             break;
         }
 
@@ -1186,8 +1548,8 @@ CANStatusGet(unsigned long ulBase, tCANStsReg eStatusReg)
         //
         case CAN_STS_TXREQUEST:
         {
-            ulStatus = CANReadReg(ulBase + CAN_O_TXRQ1);
-            ulStatus |= CANReadReg(ulBase + CAN_O_TXRQ2) << 16;
+            ulStatus = CANRegBatchRead(&sBatch, ulBase + CAN_O_TXRQ1);
+            ulStatus |= CANRegBatchRead(&sBatch, ulBase + CAN_O_TXRQ2) << 16;
             break;
         }
 
@@ -1196,8 +1558,8 @@ CANStatusGet(unsigned long ulBase, tCANStsReg eStatusReg)
         //
         case CAN_STS_NEWDAT:
         {
-            ulStatus = CANReadReg(ulBase + CAN_O_NWDA1);
-            ulStatus |= CANReadReg(ulBase + CAN_O_NWDA2) << 16;
+            ulStatus = CANRegBatchRead(&sBatch, ulBase + CAN_O_NWDA1);
+            ulStatus |= CANRegBatchRead(&sBatch, ulBase + CAN_O_NWDA2) << 16;
             break;
         }
 
@@ -1206,8 +1568,8 @@ CANStatusGet(unsigned long ulBase, tCANStsReg eStatusReg)
         //
         case CAN_STS_MSGVAL:
         {
-            ulStatus = CANReadReg(ulBase + CAN_O_MSG1VAL);
-            ulStatus |= CANReadReg(ulBase + CAN_O_MSG2VAL) << 16;
+            ulStatus = CANRegBatchRead(&sBatch, ulBase + CAN_O_MSG1VAL);
+            ulStatus |= CANRegBatchRead(&sBatch, ulBase + CAN_O_MSG2VAL) << 16;
             break;
         }
 
@@ -1220,6 +1582,12 @@ CANStatusGet(unsigned long ulBase, tCANStsReg eStatusReg)
             break;
         }
     }
+
+    //
+    // End the batch of register accesses.
+    //
+    CANRegBatchEnd(&sBatch);
+
     return(ulStatus);
 }
 
@@ -1315,6 +1683,8 @@ CANErrCntrGet(unsigned long ulBase, unsigned long *pulRxCount,
 //!   - Set \b MSG_OBJ_RX_INT_ENABLE flag to enable interrupt on receipt.
 //!   - Set \b MSG_OBJ_USE_ID_FILTER flag to enable filtering based on the
 //!   identifier mask specified by \e ulMsgIDMask.
+//!   - Set \b MSG_OBJ_FIFO flag to make a receive object part of a FIFO
+//!   buffer with the following message object (see below).
 //! - \e ulMsgLen - the number of bytes in the message data.  This should be
 //! non-zero even for a remote frame; it should match the expected bytes of the
 //! data responding data frame.
@@ -1349,6 +1719,13 @@ CANErrCntrGet(unsigned long ulBase, unsigned long *pulRxCount,
 //! -# The buffer pointed to by \e pucMsgData is not used for this call.
 //! -# Call this function with \e ulObjID set to one of the 32 object buffers.
 //!
+//! To receive a burst of data frames into a FIFO buffer, configure a run of
+//! consecutive message objects as receive objects with the same identifier
+//! and mask, setting the \b MSG_OBJ_FIFO flag on all of them but the last.
+//! A received frame is stored in the lowest numbered object of the buffer
+//! that does not already hold new data, and is only lost once every object of
+//! the buffer is full.
+//!
 //! If you specify a message object buffer that already contains a message
 //! definition, it will be overwritten.
 //!
@@ -1365,6 +1742,7 @@ CANMessageSet(unsigned long ulBase, unsigned long ulObjID,
     unsigned short usMsgCtrl;
     tBoolean bTransferData;
     tBoolean bUseExtendedID;
+    tCANRegBatch sBatch;
 
     bTransferData = 0;
 
@@ -1382,10 +1760,16 @@ CANMessageSet(unsigned long ulBase, unsigned long ulObjID,
            (eMsgType == MSG_OBJ_TYPE_TX_REMOTE) ||
            (eMsgType == MSG_OBJ_TYPE_RXTX_REMOTE));
 
+    //
+    // Start a batch of register accesses, masking the CAN interrupt once for
+    // the whole sequence.
+    //
+    CANRegBatchBegin(ulBase, &sBatch);
+
     //
     // Wait for busy bit to clear
     //
-    while(CANReadReg(ulBase + CAN_O_IF1CRQ) & CAN_IF1CRQ_BUSY)
+    while(CANRegBatchRead(&sBatch, ulBase + CAN_O_IF1CRQ) & CAN_IF1CRQ_BUSY)
     {
     }
 
@@ -1623,10 +2007,18 @@ CANMessageSet(unsigned long ulBase, unsigned long ulObjID,
     }
 
     //
-    // Set the data length since this is set for all transfers.  This is also a
-    // single transfer and not a FIFO transfer so set EOB bit.
+    // Set the data length since this is set for all transfers.
     //
-    usMsgCtrl |= (pMsgObject->ulMsgLen & CAN_IF1MCTL_DLC_M) | CAN_IF1MCTL_EOB;
+    usMsgCtrl |= pMsgObject->ulMsgLen & CAN_IF1MCTL_DLC_M;
+
+    //
+    // Set the EOB bit unless this object is followed by the next object of a
+    // FIFO buffer.
+    //
+    if(!(pMsgObject->ulFlags & MSG_OBJ_FIFO))
+    {
+        usMsgCtrl |= CAN_IF1MCTL_EOB;
+    }
 
     //
     // Enable transmit interrupts if they should be enabled.
@@ -1649,25 +2041,31 @@ CANMessageSet(unsigned long ulBase, unsigned long ulObjID,
     //
     if(bTransferData)
     {
-        CANWriteDataReg(pMsgObject->pucMsgData,
-                        (unsigned long *)(ulBase + CAN_O_IF1DA1),
-                        pMsgObject->ulMsgLen);
+        CANBatchWriteDataReg(&sBatch, pMsgObject->pucMsgData,
+                             (unsigned long *)(ulBase + CAN_O_IF1DA1),
+                             pMsgObject->ulMsgLen);
     }
 
     //
     // Write out the registers to program the message object.
     //
-    CANWriteReg(ulBase + CAN_O_IF1CMSK, usCmdMaskReg);
-    CANWriteReg(ulBase + CAN_O_IF1MSK1, usMaskReg[0]);
-    CANWriteReg(ulBase + CAN_O_IF1MSK2, usMaskReg[1]);
-    CANWriteReg(ulBase + CAN_O_IF1ARB1, usArbReg[0]);
-    CANWriteReg(ulBase + CAN_O_IF1ARB2, usArbReg[1]);
-    CANWriteReg(ulBase + CAN_O_IF1MCTL, usMsgCtrl);
+    CANRegBatchWrite(&sBatch, ulBase + CAN_O_IF1CMSK, usCmdMaskReg);
+    CANRegBatchWrite(&sBatch, ulBase + CAN_O_IF1MSK1, usMaskReg[0]);
+    CANRegBatchWrite(&sBatch, ulBase + CAN_O_IF1MSK2, usMaskReg[1]);
+    CANRegBatchWrite(&sBatch, ulBase + CAN_O_IF1ARB1, usArbReg[0]);
+    CANRegBatchWrite(&sBatch, ulBase + CAN_O_IF1ARB2, usArbReg[1]);
+    CANRegBatchWrite(&sBatch, ulBase + CAN_O_IF1MCTL, usMsgCtrl);
 
     //
     // Transfer the message object to the message object specifiec by ulObjID.
     //
-    CANWriteReg(ulBase + CAN_O_IF1CRQ, ulObjID & CAN_IF1CRQ_MNUM_M);
+    CANRegBatchWrite(&sBatch, ulBase + CAN_O_IF1CRQ,
+                     ulObjID & CAN_IF1CRQ_MNUM_M);
+
+    //
+    // End the batch of register accesses.
+    //
+    CANRegBatchEnd(&sBatch);
 
     return;
 }
@@ -1716,6 +2114,7 @@ CANMessageGet(unsigned long ulBase, unsigned long ulObjID,
     unsigned short usMaskReg[2];
     unsigned short usArbReg[2];
     unsigned short usMsgCtrl;
+    tCANRegBatch sBatch;
 
     //
     // Check the arguments.
@@ -1740,31 +2139,38 @@ CANMessageGet(unsigned long ulBase, unsigned long ulObjID,
         usCmdMaskReg |= CAN_IF1CMSK_CLRINTPND;
     }
 
+    //
+    // Start a batch of register accesses, masking the CAN interrupt once for
+    // the whole sequence.
+    //
+    CANRegBatchBegin(ulBase, &sBatch);
+
     //
     // Set up the request for data from the message object.
     //
-    CANWriteReg(ulBase + CAN_O_IF2CMSK, usCmdMaskReg);
+    CANRegBatchWrite(&sBatch, ulBase + CAN_O_IF2CMSK, usCmdMaskReg);
 
     //
     // Transfer the message object to the message object specifiec by ulObjID.
     //
-    CANWriteReg(ulBase + CAN_O_IF2CRQ, ulObjID & CAN_IF1CRQ_MNUM_M);
+    CANRegBatchWrite(&sBatch, ulBase + CAN_O_IF2CRQ,
+                     ulObjID & CAN_IF1CRQ_MNUM_M);
 
     //
     // Wait for busy bit to clear
     //
-    while(CANReadReg(ulBase + CAN_O_IF2CRQ) & CAN_IF1CRQ_BUSY)
+    while(CANRegBatchRead(&sBatch, ulBase + CAN_O_IF2CRQ) & CAN_IF1CRQ_BUSY)
     {
     }
 
     //
     // Read out the IF Registers.
     //
-    usMaskReg[0] = CANReadReg(ulBase + CAN_O_IF2MSK1);
-    usMaskReg[1] = CANReadReg(ulBase + CAN_O_IF2MSK2);
-    usArbReg[0] = CANReadReg(ulBase + CAN_O_IF2ARB1);
-    usArbReg[1] = CANReadReg(ulBase + CAN_O_IF2ARB2);
-    usMsgCtrl = CANReadReg(ulBase + CAN_O_IF2MCTL);
+    usMaskReg[0] = CANRegBatchRead(&sBatch, ulBase + CAN_O_IF2MSK1);
+    usMaskReg[1] = CANRegBatchRead(&sBatch, ulBase + CAN_O_IF2MSK2);
+    usArbReg[0] = CANRegBatchRead(&sBatch, ulBase + CAN_O_IF2ARB1);
+    usArbReg[1] = CANRegBatchRead(&sBatch, ulBase + CAN_O_IF2ARB2);
+    usMsgCtrl = CANRegBatchRead(&sBatch, ulBase + CAN_O_IF2MCTL);
 
     pMsgObject->ulFlags = MSG_OBJ_NO_FLAGS;
 
@@ -1881,6 +2287,15 @@ CANMessageGet(unsigned long ulBase, unsigned long ulObjID,
         pMsgObject->ulFlags |= MSG_OBJ_RX_INT_ENABLE;
     }
 
+    //
+    // Indicate if this object is followed by the next object of a FIFO
+    // buffer.
+    //
+    if(!(usMsgCtrl & CAN_IF1MCTL_EOB))
+    {
+        pMsgObject->ulFlags |= MSG_OBJ_FIFO;
+    }
+
     //
     // See if there is new data available.
     //
@@ -1900,26 +2315,28 @@ CANMessageGet(unsigned long ulBase, unsigned long ulObjID,
             //
             // Read out the data from the CAN registers.
             //
-            CANReadDataReg(pMsgObject->pucMsgData,
-                           (unsigned long *)(ulBase + CAN_O_IF2DA1),
-                           pMsgObject->ulMsgLen);
+            CANBatchReadDataReg(&sBatch, pMsgObject->pucMsgData,
+                                (unsigned long *)(ulBase + CAN_O_IF2DA1),
+                                pMsgObject->ulMsgLen);
         }
 
         //
         // Now clear out the new data flag.
         //
-        CANWriteReg(ulBase + CAN_O_IF2CMSK, CAN_IF1CMSK_NEWDAT);
+        CANRegBatchWrite(&sBatch, ulBase + CAN_O_IF2CMSK, CAN_IF1CMSK_NEWDAT);
 
         //
         // Transfer the message object to the message object specifiec by
         // ulObjID.
         //
-        CANWriteReg(ulBase + CAN_O_IF2CRQ, ulObjID & CAN_IF1CRQ_MNUM_M);
+        CANRegBatchWrite(&sBatch, ulBase + CAN_O_IF2CRQ,
+                         ulObjID & CAN_IF1CRQ_MNUM_M);
 
         //
         // Wait for busy bit to clear
         //
-        while(CANReadReg(ulBase + CAN_O_IF2CRQ) & CAN_IF1CRQ_BUSY)
+        while(CANRegBatchRead(&sBatch, ulBase + CAN_O_IF2CRQ) &
+              CAN_IF1CRQ_BUSY)
         {
         }
 
@@ -1936,6 +2353,11 @@ CANMessageGet(unsigned long ulBase, unsigned long ulObjID,
         //
         pMsgObject->ulMsgLen = 0;
     }
+
+    //
+    // End the batch of register accesses.
+    //
+    CANRegBatchEnd(&sBatch);
 }
 
 //*****************************************************************************
@@ -1955,6 +2377,8 @@ CANMessageGet(unsigned long ulBase, unsigned long ulObjID,
 void
 CANMessageClear(unsigned long ulBase, unsigned long ulObjID)
 {
+    tCANRegBatch sBatch;
+
     //
     // Check the arguments.
     //
@@ -1963,10 +2387,16 @@ CANMessageClear(unsigned long ulBase, unsigned long ulObjID)
            (ulBase == CAN2_BASE));
     ASSERT((ulObjID >= 1) && (ulObjID <= 32));
 
+    //
+    // Start a batch of register accesses, masking the CAN interrupt once for
+    // the whole sequence.
+    //
+    CANRegBatchBegin(ulBase, &sBatch);
+
     //
     // Wait for busy bit to clear
     //
-    while(CANReadReg(ulBase + CAN_O_IF1CRQ) & CAN_IF1CRQ_BUSY)
+    while(CANRegBatchRead(&sBatch, ulBase + CAN_O_IF1CRQ) & CAN_IF1CRQ_BUSY)
     {
     }
 
@@ -1974,14 +2404,21 @@ CANMessageClear(unsigned long ulBase, unsigned long ulObjID)
     // Clear the message value bit in the arbitration register.  This indicates
     // the message is not valid.
     //
-    CANWriteReg(ulBase + CAN_O_IF1CMSK, CAN_IF1CMSK_WRNRD | CAN_IF1CMSK_ARB);
-    CANWriteReg(ulBase + CAN_O_IF1ARB1, 0);
-    CANWriteReg(ulBase + CAN_O_IF1ARB2, 0);
+    CANRegBatchWrite(&sBatch, ulBase + CAN_O_IF1CMSK,
+                     CAN_IF1CMSK_WRNRD | CAN_IF1CMSK_ARB);
+    CANRegBatchWrite(&sBatch, ulBase + CAN_O_IF1ARB1, 0);
+    CANRegBatchWrite(&sBatch, ulBase + CAN_O_IF1ARB2, 0);
 
     //
     // Initiate programming the message object
     //
-    CANWriteReg(ulBase + CAN_O_IF1CRQ, ulObjID & CAN_IF1CRQ_MNUM_M);
+    CANRegBatchWrite(&sBatch, ulBase + CAN_O_IF1CRQ,
+                     ulObjID & CAN_IF1CRQ_MNUM_M);
+
+    //
+    // End the batch of register accesses.
+    //
+    CANRegBatchEnd(&sBatch);
 }
 
 //*****************************************************************************
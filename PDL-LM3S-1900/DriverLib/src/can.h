@@ -109,6 +109,13 @@ typedef enum
     //
     MSG_OBJ_REMOTE_FRAME =      0x00000040,
 
+    //
+    //! This indicates that a receive message object is part of a FIFO buffer
+    //! and is followed by the next message object of the buffer.  The last
+    //! message object of a FIFO buffer must not have this flag set.
+    //
+    MSG_OBJ_FIFO =              0x00000200,
+
     //
     //! This indicates that a message object has no flags set.
     //
@@ -197,6 +204,34 @@ typedef struct
 }
 tCANBitClkParms;
 
+//*****************************************************************************
+//
+//! This structure holds the state of a batch of CAN controller register
+//! accesses made with CANRegBatchRead() and CANRegBatchWrite().  It is filled
+//! in by CANRegBatchBegin() and should not be modified by the caller.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The interrupt number of the CAN controller.
+    //
+    unsigned long ulIntNumber;
+
+    //
+    //! Indicates that the CAN interrupt was enabled when the batch was started
+    //! and must be re-enabled when it is ended.
+    //
+    tBoolean bReenableInt;
+
+    //
+    //! Indicates that the register accesses need the delays required by
+    //! revision A silicon.
+    //
+    tBoolean bDelay;
+}
+tCANRegBatch;
+
 //*****************************************************************************
 //
 //! This data type is used to identify the interrupt status register.  This is
@@ -405,6 +440,12 @@ extern void CANSetBitTiming(unsigned long ulBase, tCANBitClkParms *pClkParms);
 extern void CANGetBitTiming(unsigned long ulBase, tCANBitClkParms *pClkParms);
 extern unsigned long CANReadReg(unsigned long ulRegAddress);
 extern void CANWriteReg(unsigned long ulRegAddress, unsigned long ulRegValue);
+extern void CANRegBatchBegin(unsigned long ulBase, tCANRegBatch *psBatch);
+extern void CANRegBatchEnd(tCANRegBatch *psBatch);
+extern unsigned long CANRegBatchRead(tCANRegBatch *psBatch,
+                                     unsigned long ulRegAddress);
+extern void CANRegBatchWrite(tCANRegBatch *psBatch, unsigned long ulRegAddress,
+                             unsigned long ulRegValue);
 extern void CANMessageSet(unsigned long ulBase, unsigned long ulObjID,
                           tCANMsgObject *pMsgObject, tMsgObjType eMsgType);
 extern void CANMessageGet(unsigned long ulBase, unsigned long ulObjID,
@@ -42,6 +42,16 @@
 #include "sysctl.h"
 #include "ethernet.h"
 
+//*****************************************************************************
+//
+// The first word of the packet at the head of the receive FIFO, which holds
+// the first two bytes of the destination address.  It is saved here by
+// EthernetPacketLenGet() until the rest of the packet is read by
+// EthernetPacketDataGetV().
+//
+//*****************************************************************************
+static unsigned long g_ulEthRxWord0;
+
 //*****************************************************************************
 //
 //! Initializes the Ethernet controller for operation.
@@ -481,12 +491,16 @@ EthernetSpaceAvail(unsigned long ulBase)
 //! Internal function for reading a packet from the Ethernet controller.
 //!
 //! \param ulBase is the base address of the controller.
-//! \param pucBuf is the pointer to the packet buffer.
-//! \param lBufLen is the maximum number of bytes to be read into the buffer.
+//! \param ulWord0 is the first word of the packet, already read from the
+//! FIFO.
+//! \param psSegs is a pointer to the list of segments to receive the packet.
+//! \param ulNumSegs is the number of segments in \e psSegs.
 //!
 //! Based on the following table of how the receive frame is stored in the
 //! receive FIFO, this function will extract a packet from the FIFO and store
-//! it in the packet buffer that was passed in.
+//! it in the segments that were passed in, filling each segment in turn.
+//! Any part of the packet that does not fit into the segments is read from
+//! the FIFO and discarded.
 //!
 //! Format of the data in the RX FIFO is as follows:
 //!
@@ -524,77 +538,107 @@ EthernetSpaceAvail(unsigned long ulBase)
 //! Where FCS is the Frame Check Sequence.
 //!
 //! \return Returns the negated packet length \b -n if the packet is too large
-//! for \e pucBuf, and returns the packet length \b n otherwise.
+//! for \e psSegs, and returns the packet length \b n otherwise.
 //
 //*****************************************************************************
 static long
-EthernetPacketGetInternal(unsigned long ulBase, unsigned char *pucBuf,
-                          long lBufLen)
+EthernetPacketGetInternal(unsigned long ulBase, unsigned long ulWord0,
+                          const tEthSeg *psSegs, unsigned long ulNumSegs)
 {
-    unsigned long ulTemp;
-    long lFrameLen, lTempLen;
-    long i = 0;
+    unsigned long ulTemp, ulBytes, ulWords, ulLen, ulSeg;
+    unsigned char *pucBuf;
+    long lFrameLen, lLeft;
 
     //
-    // Read WORD 0 (see format above) from the FIFO, set the receive
-    // Frame Length and store the first two bytes of the destination
-    // address in the receive buffer.
+    // Get the receive Frame Length from WORD 0 (see format above).  The first
+    // two bytes of the destination address are held over to be stored into
+    // the first segment.
     //
-    ulTemp = HWREG(ulBase + MAC_O_DATA);
+    ulTemp = ulWord0;
     lFrameLen = (long)(ulTemp & 0xFFFF);
-    pucBuf[i++] = (unsigned char) ((ulTemp >> 16) & 0xff);
-    pucBuf[i++] = (unsigned char) ((ulTemp >> 24) & 0xff);
+    ulTemp >>= 16;
+    ulBytes = 2;
 
     //
-    // Read all but the last WORD into the receive buffer.
+    // Compute the number of WORDs of the frame that remain in the FIFO, and
+    // the number of bytes of the packet (excluding the frame length and frame
+    // check sequence) that are to be stored.
     //
-    lTempLen = (lBufLen < (lFrameLen - 6)) ? lBufLen : (lFrameLen - 6);
-    while(i <= (lTempLen - 4))
-    {
-        *(unsigned long *)&pucBuf[i] = HWREG(ulBase + MAC_O_DATA);
-        i += 4;
-    }
+    ulWords = ((lFrameLen + 3) / 4) - 1;
+    lFrameLen -= 6;
+    lLeft = lFrameLen;
 
     //
-    // Read the last 1, 2, or 3 BYTES into the buffer
+    // Loop through the segments until the packet has been stored or there are
+    // no more segments.
     //
-    if(i < lTempLen)
+    for(ulSeg = 0; (ulSeg < ulNumSegs) && lLeft; ulSeg++)
     {
-        ulTemp = HWREG(ulBase + MAC_O_DATA);
-        if(i == lTempLen - 3)
+        pucBuf = psSegs[ulSeg].pucBuf;
+        ulLen = psSegs[ulSeg].ulLen;
+        if(ulLen > (unsigned long)lLeft)
         {
-            pucBuf[i++] = ((ulTemp >>  0) & 0xff);
-            pucBuf[i++] = ((ulTemp >>  8) & 0xff);
-            pucBuf[i++] = ((ulTemp >> 16) & 0xff);
-            i += 1;
+            ulLen = lLeft;
         }
-        else if(i == lTempLen - 2)
+        lLeft -= ulLen;
+
+        //
+        // Store the bytes held over from the last WORD read.
+        //
+        while(ulBytes && ulLen)
         {
-            pucBuf[i++] = ((ulTemp >>  0) & 0xff);
-            pucBuf[i++] = ((ulTemp >>  8) & 0xff);
-            i += 2;
+            *pucBuf++ = (unsigned char)ulTemp;
+            ulTemp >>= 8;
+            ulBytes--;
+            ulLen--;
         }
-        else if(i == lTempLen - 1)
+
+        //
+        // Read whole WORDs directly into the segment.  Since the held over
+        // bytes have been used up, the FIFO is at a WORD boundary of the
+        // packet; if the segment starts at a WORD boundary in the packet
+        // (such as the payload following the 14-byte Ethernet header) and in
+        // memory, each WORD is stored with a single aligned write.
+        //
+        while(ulLen >= 4)
+        {
+            *(unsigned long *)pucBuf = HWREG(ulBase + MAC_O_DATA);
+            pucBuf += 4;
+            ulLen -= 4;
+            ulWords--;
+        }
+
+        //
+        // Read one more WORD to get the last 1, 2, or 3 bytes of the segment,
+        // holding the rest of the WORD over for the next segment.
+        //
+        if(ulLen)
         {
-            pucBuf[i++] = ((ulTemp >>  0) & 0xff);
-            i += 3;
+            ulTemp = HWREG(ulBase + MAC_O_DATA);
+            ulWords--;
+            ulBytes = 4 - ulLen;
+            while(ulLen--)
+            {
+                *pucBuf++ = (unsigned char)ulTemp;
+                ulTemp >>= 8;
+            }
         }
     }
 
     //
-    // Read any remaining WORDS (that did not fit into the buffer).
+    // Read any remaining WORDS (that did not fit into the segments).
     //
-    while(i < (lFrameLen - 2))
+    while(ulWords)
     {
         ulTemp = HWREG(ulBase + MAC_O_DATA);
-        i += 4;
+        ulWords--;
     }
 
     //
-    // If frame was larger than the buffer, return the "negative" frame length
+    // If frame was larger than the segments, return the "negative" frame
+    // length.
     //
-    lFrameLen -= 6;
-    if(lFrameLen > lBufLen)
+    if(lLeft)
     {
         return(-lFrameLen);
     }
@@ -638,6 +682,8 @@ long
 EthernetPacketGetNonBlocking(unsigned long ulBase, unsigned char *pucBuf,
                              long lBufLen)
 {
+    tEthSeg sSeg;
+
     //
     // Check the arguments.
     //
@@ -656,7 +702,10 @@ EthernetPacketGetNonBlocking(unsigned long ulBase, unsigned char *pucBuf,
     //
     // Read the packet, and return.
     //
-    return(EthernetPacketGetInternal(ulBase, pucBuf, lBufLen));
+    sSeg.pucBuf = pucBuf;
+    sSeg.ulLen = lBufLen;
+    return(EthernetPacketGetInternal(ulBase, HWREG(ulBase + MAC_O_DATA),
+                                     &sSeg, 1));
 }
 
 //*****************************************************************************
@@ -687,6 +736,8 @@ long
 EthernetPacketGet(unsigned long ulBase, unsigned char *pucBuf,
                   long lBufLen)
 {
+    tEthSeg sSeg;
+
     //
     // Check the arguments.
     //
@@ -704,7 +755,143 @@ EthernetPacketGet(unsigned long ulBase, unsigned char *pucBuf,
     //
     // Read the packet
     //
-    return(EthernetPacketGetInternal(ulBase, pucBuf, lBufLen));
+    sSeg.pucBuf = pucBuf;
+    sSeg.ulLen = lBufLen;
+    return(EthernetPacketGetInternal(ulBase, HWREG(ulBase + MAC_O_DATA),
+                                     &sSeg, 1));
+}
+
+//*****************************************************************************
+//
+//! Waits for a packet from the Ethernet controller, scattering it into a list
+//! of buffers.
+//!
+//! \param ulBase is the base address of the controller.
+//! \param psSegs is a pointer to the list of segments to receive the packet.
+//! \param ulNumSegs is the number of segments in \e psSegs.
+//!
+//! This function reads a packet from the receive FIFO of the controller and
+//! places it into the \e ulNumSegs segments in \e psSegs, filling each
+//! segment in turn before moving on to the next.  The function will wait
+//! until a packet is available in the FIFO.  Then the function will read the
+//! entire packet from the receive FIFO; any part of the packet that does not
+//! fit into the segments is discarded.  If \e ulNumSegs is zero, the packet
+//! is discarded entirely.
+//!
+//! This allows the headers and the payload of a packet to be placed in
+//! separate buffers.  For example, if the first segment is the 14 bytes of
+//! the Ethernet header, the second segment starts at a word boundary of the
+//! packet, so the IP header and payload can be read into a word-aligned buffer
+//! with one aligned store per word instead of being copied a byte at a time.
+//!
+//! \note This function is blocking and will not return until a packet arrives.
+//!
+//! \return Returns the negated packet length \b -n if the packet is too large
+//! for the segments, and returns the packet length \b n otherwise.
+//
+//*****************************************************************************
+long
+EthernetPacketGetV(unsigned long ulBase, const tEthSeg *psSegs,
+                   unsigned long ulNumSegs)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(ulBase == ETH_BASE);
+    ASSERT((psSegs != 0) || (ulNumSegs == 0));
+
+    //
+    // Wait for a packet to become available
+    //
+    while((HWREG(ulBase + MAC_O_NP) & MAC_NP_NPR_M) == 0)
+    {
+    }
+
+    //
+    // Read the packet
+    //
+    return(EthernetPacketGetInternal(ulBase, HWREG(ulBase + MAC_O_DATA),
+                                     psSegs, ulNumSegs));
+}
+
+//*****************************************************************************
+//
+//! Gets the length of the next packet in the receive FIFO.
+//!
+//! \param ulBase is the base address of the controller.
+//!
+//! This function starts reading the packet at the head of the receive FIFO of
+//! the controller and returns its length, so that a buffer of the right size
+//! can be allocated for it.  The function will wait until a packet is
+//! available in the FIFO.  It must be followed by a call to
+//! EthernetPacketDataGetV() to read the rest of the packet (or to discard it)
+//! before any other function is used to receive a packet.
+//!
+//! \note This function is blocking and will not return until a packet arrives.
+//!
+//! \return Returns the number of bytes of the packet (excluding the frame
+//! check sequence bytes) that EthernetPacketDataGetV() will store.
+//
+//*****************************************************************************
+long
+EthernetPacketLenGet(unsigned long ulBase)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(ulBase == ETH_BASE);
+
+    //
+    // Wait for a packet to become available
+    //
+    while((HWREG(ulBase + MAC_O_NP) & MAC_NP_NPR_M) == 0)
+    {
+    }
+
+    //
+    // Read WORD 0 of the packet, which holds the Frame Length, and save it
+    // for EthernetPacketDataGetV().  The Frame Length includes itself and the
+    // frame check sequence, neither of which is stored.
+    //
+    g_ulEthRxWord0 = HWREG(ulBase + MAC_O_DATA);
+    return((long)(g_ulEthRxWord0 & 0xFFFF) - 6);
+}
+
+//*****************************************************************************
+//
+//! Reads the rest of a packet from the Ethernet controller, scattering it into
+//! a list of buffers.
+//!
+//! \param ulBase is the base address of the controller.
+//! \param psSegs is a pointer to the list of segments to receive the packet.
+//! \param ulNumSegs is the number of segments in \e psSegs.
+//!
+//! This function reads the packet whose length was returned by
+//! EthernetPacketLenGet() from the receive FIFO of the controller and places
+//! it into the \e ulNumSegs segments in \e psSegs, in the same way as
+//! EthernetPacketGetV().  Any part of the packet that does not fit into the
+//! segments is discarded; if \e ulNumSegs is zero, the packet is discarded
+//! entirely.
+//!
+//! \return Returns the negated packet length \b -n if the packet is too large
+//! for the segments, and returns the packet length \b n otherwise.
+//
+//*****************************************************************************
+long
+EthernetPacketDataGetV(unsigned long ulBase, const tEthSeg *psSegs,
+                       unsigned long ulNumSegs)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(ulBase == ETH_BASE);
+    ASSERT((psSegs != 0) || (ulNumSegs == 0));
+
+    //
+    // Read the rest of the packet.
+    //
+    return(EthernetPacketGetInternal(ulBase, g_ulEthRxWord0, psSegs,
+                                     ulNumSegs));
 }
 
 //*****************************************************************************
@@ -929,6 +1116,152 @@ EthernetPacketPut(unsigned long ulBase, unsigned char *pucBuf,
     return(EthernetPacketPutInternal(ulBase, pucBuf, lBufLen));
 }
 
+//*****************************************************************************
+//
+//! Waits to send a packet, gathered from a list of buffers, from the Ethernet
+//! controller.
+//!
+//! \param ulBase is the base address of the controller.
+//! \param psSegs is a pointer to the list of segments that make up the
+//! packet.
+//! \param ulNumSegs is the number of segments in \e psSegs.
+//!
+//! This function writes the packet formed by concatenating the \e ulNumSegs
+//! segments in \e psSegs into the transmit FIFO of the controller and then
+//! activates the transmitter for this packet.  The first segment starts with
+//! the destination address of the packet, exactly as the buffer passed to
+//! EthernetPacketPut() does; the segments may be of any length and alignment.
+//! Bytes that do not fill a whole FIFO word at the end of one segment are
+//! carried over and combined with the start of the next segment, so a packet
+//! whose headers and payload are held in separate buffers can be transmitted
+//! without first copying it into a single buffer.
+//!
+//! This function will wait until the transmit FIFO is empty before writing the
+//! packet, and will not wait for the transmission to complete.
+//!
+//! \return Returns the negated packet length \b -n if the packet is too large
+//! for the FIFO, and the packet length \b n otherwise.
+//
+//*****************************************************************************
+long
+EthernetPacketPutV(unsigned long ulBase, const tEthSeg *psSegs,
+                   unsigned long ulNumSegs)
+{
+    unsigned long ulTemp, ulWord, ulBytes, ulLen, ulSeg;
+    unsigned char *pucBuf;
+    long lFrameLen;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(ulBase == ETH_BASE);
+    ASSERT(psSegs != 0);
+    ASSERT(ulNumSegs > 0);
+
+    //
+    // Compute the length of the packet.
+    //
+    for(ulSeg = 0, lFrameLen = 0; ulSeg < ulNumSegs; ulSeg++)
+    {
+        lFrameLen += psSegs[ulSeg].ulLen;
+    }
+    ASSERT(lFrameLen >= 14);
+
+    //
+    // If the packet is too large, return the negative packet length as
+    // an error code.
+    //
+    if(lFrameLen > (2048 - 2))
+    {
+        return(-lFrameLen);
+    }
+
+    //
+    // Wait for current packet (if any) to complete.
+    //
+    while(HWREG(ulBase + MAC_O_TR) & MAC_TR_NEWTX)
+    {
+    }
+
+    //
+    // WORD 0 (see the format given for EthernetPacketPutInternal()) starts
+    // with the two byte payload length, so begin with it as a partially
+    // filled word awaiting the first two bytes of the packet.
+    //
+    ulTemp = (unsigned long)(lFrameLen - 14);
+    ulBytes = 2;
+
+    //
+    // Loop through the segments of the packet.
+    //
+    for(ulSeg = 0; ulSeg < ulNumSegs; ulSeg++)
+    {
+        pucBuf = psSegs[ulSeg].pucBuf;
+        ulLen = psSegs[ulSeg].ulLen;
+
+        //
+        // Write as many whole WORDs as possible from this segment.  If bytes
+        // have been carried over from the previous segment, each WORD read
+        // from this segment supplies the top of the WORD being written and
+        // the bottom of the next one.
+        //
+        if(ulBytes == 0)
+        {
+            while(ulLen >= 4)
+            {
+                HWREG(ulBase + MAC_O_DATA) = *(unsigned long *)pucBuf;
+                pucBuf += 4;
+                ulLen -= 4;
+            }
+        }
+        else
+        {
+            while(ulLen >= 4)
+            {
+                ulWord = *(unsigned long *)pucBuf;
+                HWREG(ulBase + MAC_O_DATA) = (ulTemp |
+                                              (ulWord << (ulBytes * 8)));
+                ulTemp = ulWord >> (32 - (ulBytes * 8));
+                pucBuf += 4;
+                ulLen -= 4;
+            }
+        }
+
+        //
+        // Add the remaining 1, 2, or 3 bytes of this segment to the WORD
+        // being built, writing it to the transmit FIFO if it becomes full.
+        //
+        while(ulLen--)
+        {
+            ulTemp |= *pucBuf++ << (ulBytes * 8);
+            if(++ulBytes == 4)
+            {
+                HWREG(ulBase + MAC_O_DATA) = ulTemp;
+                ulTemp = 0;
+                ulBytes = 0;
+            }
+        }
+    }
+
+    //
+    // Write the final partial WORD, if any, to the transmit FIFO.
+    //
+    if(ulBytes)
+    {
+        HWREG(ulBase + MAC_O_DATA) = ulTemp;
+    }
+
+    //
+    // Activate the transmitter
+    //
+    HWREG(ulBase + MAC_O_TR) = MAC_TR_NEWTX;
+
+    //
+    // Return the packet length transmitted.
+    //
+    return(lFrameLen);
+}
+
 //*****************************************************************************
 //
 //! Registers an interrupt handler for an Ethernet interrupt.
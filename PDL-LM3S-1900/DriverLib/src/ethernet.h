@@ -63,6 +63,26 @@ extern "C"
 #define ETH_INT_TXER            0x002       // TX Error
 #define ETH_INT_RX              0x001       // RX Complete
 
+//*****************************************************************************
+//
+//! The structure used to describe one segment of a packet that is gathered
+//! from, or scattered to, several separate buffers.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! A pointer to the data of this segment.
+    //
+    unsigned char *pucBuf;
+
+    //
+    //! The number of bytes in this segment.
+    //
+    unsigned long ulLen;
+}
+tEthSeg;
+
 //*****************************************************************************
 //
 // Helper Macros for Ethernet Processing
@@ -122,11 +142,18 @@ extern long EthernetPacketGetNonBlocking(unsigned long ulBase,
                                          long lBufLen);
 extern long EthernetPacketGet(unsigned long ulBase, unsigned char *pucBuf,
                               long lBufLen);
+extern long EthernetPacketGetV(unsigned long ulBase, const tEthSeg *psSegs,
+                               unsigned long ulNumSegs);
+extern long EthernetPacketLenGet(unsigned long ulBase);
+extern long EthernetPacketDataGetV(unsigned long ulBase, const tEthSeg *psSegs,
+                                   unsigned long ulNumSegs);
 extern long EthernetPacketPutNonBlocking(unsigned long ulBase,
                                          unsigned char *pucBuf,
                                          long lBufLen);
 extern long EthernetPacketPut(unsigned long ulBase, unsigned char *pucBuf,
                               long lBufLen);
+extern long EthernetPacketPutV(unsigned long ulBase, const tEthSeg *psSegs,
+                               unsigned long ulNumSegs);
 extern void EthernetIntRegister(unsigned long ulBase,
                                 void (*pfnHandler)(void));
 extern void EthernetIntUnregister(unsigned long ulBase);
@@ -41,6 +41,9 @@
 #include "interrupt.h"
 #include "hibernate.h"
 #include "debug.h"
+#if defined(host)
+#include "../hwsim/hwsim.h"
+#endif
 
 //*****************************************************************************
 //
@@ -108,6 +111,13 @@ HibernateWriteDelay(unsigned long ulCount)
     bx      lr;
 }
 #endif
+#if defined(host)
+static void
+HibernateWriteDelay(unsigned long ulCount)
+{
+    HWSimCyclesAdd(ulCount * 3);
+}
+#endif
 
 //*****************************************************************************
 //
@@ -215,11 +215,16 @@ IntRegister(unsigned long ulInterrupt, void (*pfnHandler)(void))
     {
         //
         // Copy the vector table from the beginning of FLASH to the RAM vector
-        // table.
+        // table.  On the host, the flash does not contain a vector table, so
+        // the default handler is used for every interrupt instead.
         //
         for(ulIdx = 0; ulIdx < NUM_INTERRUPTS; ulIdx++)
         {
+#if defined(host)
+            g_pfnRAMVectors[ulIdx] = IntDefaultHandler;
+#else
             g_pfnRAMVectors[ulIdx] = (void (*)(void))HWREG(ulIdx * 4);
+#endif
         }
 
         //
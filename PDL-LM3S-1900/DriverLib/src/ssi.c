@@ -42,6 +42,13 @@
 #include "ssi.h"
 #include "sysctl.h"
 
+//*****************************************************************************
+//
+// The depth of the SSI transmit and receive FIFOs.
+//
+//*****************************************************************************
+#define SSI_FIFO_DEPTH          8
+
 //*****************************************************************************
 //
 //! Configures the synchronous serial interface.
@@ -599,6 +606,174 @@ SSIDataGetNonBlocking(unsigned long ulBase, unsigned long *pulData)
     }
 }
 
+//*****************************************************************************
+//
+// Transfers a block of 8-bit (or narrower) frames, keeping as many frames in
+// flight as the FIFOs can hold.  Each frame transmitted is taken from pucTx
+// or, if pucTx is NULL, is ulFill.  Each frame received is stored to pucRx
+// or, if pucRx is NULL, is discarded.  The function returns once the frame
+// received for the last frame transmitted has been read.
+//
+//*****************************************************************************
+static void
+SSIDataBlock(unsigned long ulBase, const unsigned char *pucTx,
+             unsigned long ulFill, unsigned char *pucRx, unsigned long ulCount)
+{
+    unsigned long ulTx, ulRx, ulData;
+
+    //
+    // ulTx is the number of frames still to be written to the transmit FIFO
+    // and ulRx is the number of frames still to be read from the receive
+    // FIFO; the difference is the number of frames in flight.
+    //
+    ulTx = ulCount;
+    ulRx = ulCount;
+
+    //
+    // Loop until every frame has been received.
+    //
+    while(ulRx)
+    {
+        //
+        // Top up the transmit FIFO.  Never allow more frames in flight than
+        // the receive FIFO can hold, or the receive FIFO could overrun while
+        // this loop is still writing.
+        //
+        while(ulTx && ((ulRx - ulTx) < SSI_FIFO_DEPTH) &&
+              (HWREG(ulBase + SSI_O_SR) & SSI_SR_TNF))
+        {
+            HWREG(ulBase + SSI_O_DR) = pucTx ? *pucTx++ : ulFill;
+            ulTx--;
+        }
+
+        //
+        // Drain whatever has been received so far.
+        //
+        while(ulRx && (HWREG(ulBase + SSI_O_SR) & SSI_SR_RNE))
+        {
+            ulData = HWREG(ulBase + SSI_O_DR);
+            if(pucRx)
+            {
+                *pucRx++ = (unsigned char)ulData;
+            }
+            ulRx--;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! Transmits a block of data over the SSI interface.
+//!
+//! \param ulBase specifies the SSI module base address.
+//! \param pucData is a pointer to the data to be transmitted.
+//! \param ulCount is the number of data elements to transmit.
+//!
+//! This function transmits \e ulCount data elements, keeping the transmit
+//! FIFO full so that the elements are sent back-to-back at the configured
+//! bit rate.  The data received while the block is transmitted is read from
+//! the receive FIFO and discarded, so the receive FIFO is empty when this
+//! function returns.
+//!
+//! \note The SSI must be configured for a data width of 8 bits or less, and
+//! the receive FIFO must be empty when this function is called.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SSIDataPutBlock(unsigned long ulBase, const unsigned char *pucData,
+                unsigned long ulCount)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT((ulBase == SSI0_BASE) || (ulBase == SSI1_BASE));
+    ASSERT((HWREG(ulBase + SSI_O_CR0) & SSI_CR0_DSS_M) <= SSI_CR0_DSS_8);
+    ASSERT(pucData);
+
+    //
+    // Transmit the block, discarding the received data.
+    //
+    SSIDataBlock(ulBase, pucData, 0, 0, ulCount);
+}
+
+//*****************************************************************************
+//
+//! Receives a block of data over the SSI interface.
+//!
+//! \param ulBase specifies the SSI module base address.
+//! \param pucData is a pointer to the buffer that receives the data.
+//! \param ulCount is the number of data elements to receive.
+//! \param ulFill is the value transmitted for each data element received.
+//!
+//! This function receives \e ulCount data elements, transmitting \e ulFill
+//! for each one.  The transmit FIFO is kept full so that the elements are
+//! received back-to-back at the configured bit rate.  Typically \e ulFill is
+//! 0xFF, which holds the data line high while reading from devices such as
+//! SD cards.
+//!
+//! \note The SSI must be configured for a data width of 8 bits or less, and
+//! the receive FIFO must be empty when this function is called.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SSIDataGetBlock(unsigned long ulBase, unsigned char *pucData,
+                unsigned long ulCount, unsigned long ulFill)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT((ulBase == SSI0_BASE) || (ulBase == SSI1_BASE));
+    ASSERT((HWREG(ulBase + SSI_O_CR0) & SSI_CR0_DSS_M) <= SSI_CR0_DSS_8);
+    ASSERT(pucData);
+
+    //
+    // Receive the block, transmitting the fill value.
+    //
+    SSIDataBlock(ulBase, 0, ulFill, pucData, ulCount);
+}
+
+//*****************************************************************************
+//
+//! Transmits and receives a block of data over the SSI interface.
+//!
+//! \param ulBase specifies the SSI module base address.
+//! \param pucTx is a pointer to the data to be transmitted.
+//! \param pucRx is a pointer to the buffer that receives the data.
+//! \param ulCount is the number of data elements to transfer.
+//!
+//! This function transmits \e ulCount data elements from \e pucTx and stores
+//! the \e ulCount data elements received at the same time into \e pucRx.
+//! The transmit FIFO is kept full so that the elements are transferred
+//! back-to-back at the configured bit rate.  \e pucTx and \e pucRx may point
+//! to the same buffer.
+//!
+//! \note The SSI must be configured for a data width of 8 bits or less, and
+//! the receive FIFO must be empty when this function is called.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SSIDataExchangeBlock(unsigned long ulBase, const unsigned char *pucTx,
+                     unsigned char *pucRx, unsigned long ulCount)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT((ulBase == SSI0_BASE) || (ulBase == SSI1_BASE));
+    ASSERT((HWREG(ulBase + SSI_O_CR0) & SSI_CR0_DSS_M) <= SSI_CR0_DSS_8);
+    ASSERT(pucTx && pucRx);
+
+    //
+    // Transfer the block.
+    //
+    SSIDataBlock(ulBase, pucTx, 0, pucRx, ulCount);
+}
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
@@ -70,10 +70,17 @@ extern void SSIConfigSetExpClk(unsigned long ulBase, unsigned long ulSSIClk,
                                unsigned long ulProtocol, unsigned long ulMode,
                                unsigned long ulBitRate,
                                unsigned long ulDataWidth);
+extern void SSIDataExchangeBlock(unsigned long ulBase,
+                                 const unsigned char *pucTx,
+                                 unsigned char *pucRx, unsigned long ulCount);
 extern void SSIDataGet(unsigned long ulBase, unsigned long *pulData);
+extern void SSIDataGetBlock(unsigned long ulBase, unsigned char *pucData,
+                            unsigned long ulCount, unsigned long ulFill);
 extern long SSIDataGetNonBlocking(unsigned long ulBase,
                                   unsigned long *pulData);
 extern void SSIDataPut(unsigned long ulBase, unsigned long ulData);
+extern void SSIDataPutBlock(unsigned long ulBase, const unsigned char *pucData,
+                            unsigned long ulCount);
 extern long SSIDataPutNonBlocking(unsigned long ulBase, unsigned long ulData);
 extern void SSIDisable(unsigned long ulBase);
 extern void SSIEnable(unsigned long ulBase);
@@ -42,6 +42,9 @@
 #include "debug.h"
 #include "interrupt.h"
 #include "sysctl.h"
+#if defined(host)
+#include "../hwsim/hwsim.h"
+#endif
 
 //*****************************************************************************
 //
@@ -1419,6 +1422,13 @@ SysCtlDelay(unsigned long ulCount)
     bx      lr;
 }
 #endif
+#if defined(host)
+static void
+SysCtlDelay(unsigned long ulCount)
+{
+    HWSimCyclesAdd(ulCount * 3);
+}
+#endif
 
 //*****************************************************************************
 //
@@ -11,8 +11,13 @@
  * EK-LM3S6965 evaluation board.
  *
  * Note that the SSI port is shared with the osram display.  The code
- * in this file does not attempt to share the SSI port with the osram,
- * it assumes the osram is not being used.
+ * in this file does not reconfigure the SSI port for the display, but
+ * it does deselect the card and finish any multiple block transfer
+ * before disk_read() and disk_write() return, so the display can be
+ * used between calls (once the SSI port is set up for it again).  An
+ * application that does not use the display can keep transfers open
+ * between calls with the MMC_SET_EXCLUSIVE ioctl, and must then issue
+ * CTRL_SYNC before anything else drives the SSI port.
  */
 
 #include "diskio.h"
@@ -92,6 +97,31 @@ BYTE CardType;            /* b0:MMC, b1:SDC, b2:Block addressing */
 static
 BYTE PowerFlag = 0;     /* indicates if "power" is on */
 
+/* A multiple block transfer is used for each call.  With MMC_SET_EXCLUSIVE */
+/* it is left open between calls, so that accesses to consecutive sectors  */
+/* are streamed without a command per call.                                */
+#define STREAM_NONE     0
+#define STREAM_READ     1    /* CMD18 in progress */
+#define STREAM_WRITE    2    /* CMD25 in progress */
+
+static
+BYTE StreamMode = STREAM_NONE;    /* Type of the open transfer */
+
+static
+DWORD StreamSector;     /* Sector the open transfer will access next */
+
+static
+DWORD PreErase;         /* ACMD23 count for the next write transfer */
+
+static
+BYTE Exclusive = 0;     /* Transfers are left open between calls */
+
+static
+DISK_STATS Stats;       /* Transfer counters */
+
+static volatile
+DWORD Ticks, TicksBase; /* 100Hz tick count, and its value at counter reset */
+
 /*-----------------------------------------------------------------------*/
 /* Transmit a byte to MMC via SPI  (Platform dependent)                  */
 /*-----------------------------------------------------------------------*/
@@ -124,12 +154,6 @@ BYTE rcvr_spi (void)
 }
 
 
-static
-void rcvr_spi_m (BYTE *dst)
-{
-    *dst = rcvr_spi();
-}
-
 /*-----------------------------------------------------------------------*/
 /* Wait for card ready                                                   */
 /*-----------------------------------------------------------------------*/
@@ -142,9 +166,8 @@ BYTE wait_ready (void)
 
     Timer2 = 50;    /* Wait for ready in timeout of 500ms */
     rcvr_spi();
-    do
-        res = rcvr_spi();
-    while ((res != 0xFF) && Timer2);
+    while (((res = rcvr_spi()) != 0xFF) && Timer2)
+        Stats.busy_polls++;
 
     return res;
 }
@@ -247,15 +270,12 @@ BOOL rcvr_datablock (
 
 
     Timer1 = 10;
-    do {                            /* Wait for data packet in timeout of 100ms */
-        token = rcvr_spi();
-    } while ((token == 0xFF) && Timer1);
+    while (((token = rcvr_spi()) == 0xFF) && Timer1)    /* Wait for data packet in timeout of 100ms */
+        Stats.busy_polls++;
     if(token != 0xFE) return FALSE;    /* If not valid data token, retutn with error */
 
-    do {                            /* Receive the data block into buffer */
-        rcvr_spi_m(buff++);
-        rcvr_spi_m(buff++);
-    } while (btr -= 2);
+    /* Receive the data block into buffer, keeping the SSI FIFO full */
+    SSIDataGetBlock(SDC_SSI_BASE, buff, btr, 0xFF);
     rcvr_spi();                        /* Discard CRC */
     rcvr_spi();
 
@@ -275,18 +295,15 @@ BOOL xmit_datablock (
     BYTE token            /* Data/Stop token */
 )
 {
-    BYTE resp, wc;
+    BYTE resp;
 
 
     if (wait_ready() != 0xFF) return FALSE;
 
     xmit_spi(token);                    /* Xmit data token */
     if (token != 0xFD) {    /* Is data token */
-        wc = 0;
-        do {                            /* Xmit the 512 byte data block to MMC */
-            xmit_spi(*buff++);
-            xmit_spi(*buff++);
-        } while (--wc);
+        /* Xmit the 512 byte data block to MMC, keeping the SSI FIFO full */
+        SSIDataPutBlock(SDC_SSI_BASE, buff, 512);
         xmit_spi(0xFF);                    /* CRC (Dummy) */
         xmit_spi(0xFF);
         resp = rcvr_spi();                /* Reveive data response */
@@ -338,6 +355,37 @@ BYTE send_cmd (
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Close the open multiple block transfer                                */
+/*-----------------------------------------------------------------------*/
+
+static
+BOOL stream_close (void)
+{
+    BOOL res = TRUE;
+
+
+    if (StreamMode == STREAM_NONE) return TRUE;
+
+    if (StreamMode == STREAM_READ) {
+        send_cmd(CMD12, 0);                /* STOP_TRANSMISSION */
+    }
+#if _READONLY == 0
+    else {
+        if (!xmit_datablock(0, 0xFD))    /* STOP_TRAN token */
+            res = FALSE;
+    }
+#endif
+    StreamMode = STREAM_NONE;
+
+    DESELECT();            /* CS = H */
+    rcvr_spi();            /* Idle (Release DO) */
+
+    return res;
+}
+
+
+
 /*--------------------------------------------------------------------------
 
    Public Functions
@@ -359,6 +407,8 @@ DSTATUS disk_initialize (
     if (drv) return STA_NOINIT;            /* Supports only single drive */
     if (Stat & STA_NODISK) return Stat;    /* No card in the socket */
 
+    StreamMode = STREAM_NONE;            /* The card is reset below */
+
     power_on();                            /* Force socket power on */
     for (n = 10; n; n--) rcvr_spi();    /* 80 dummy clocks */
 
@@ -434,29 +484,58 @@ DRESULT disk_read (
     if (drv || !count) return RES_PARERR;
     if (Stat & STA_NOINIT) return RES_NOTRDY;
 
-    if (!(CardType & 4)) sector *= 512;    /* Convert to byte address if needed */
+    /* A single sector on a shared port is a single block read, since there
+       is no transfer to continue and nothing to gain from streaming it */
+    if (count == 1 && !Exclusive) {
+        if (!stream_close()) return RES_ERROR;
 
-    SELECT();            /* CS = L */
+        SELECT();            /* CS = L */
 
-    if (count == 1) {    /* Single block read */
-        if ((send_cmd(CMD17, sector) == 0)    /* READ_SINGLE_BLOCK */
-            && rcvr_datablock(buff, 512))
+        if ((send_cmd(CMD17, (CardType & 4) ? sector : sector * 512) == 0)    /* READ_SINGLE_BLOCK */
+            && rcvr_datablock(buff, 512)) {
             count = 0;
+            Stats.rd_sects++;
+        }
+        Stats.rd_cmds++;
+
+        DESELECT();            /* CS = H */
+        rcvr_spi();            /* Idle (Release DO) */
+
+        return count ? RES_ERROR : RES_OK;
     }
-    else {                /* Multiple block read */
-        if (send_cmd(CMD18, sector) == 0) {    /* READ_MULTIPLE_BLOCK */
-            do {
-                if (!rcvr_datablock(buff, 512)) break;
-                buff += 512;
-            } while (--count);
-            send_cmd(CMD12, 0);                /* STOP_TRANSMISSION */
+
+    /* Start a new transfer unless this continues the open read transfer */
+    if (StreamMode != STREAM_READ || sector != StreamSector) {
+        if (!stream_close()) return RES_ERROR;
+
+        SELECT();            /* CS = L */
+
+        if (send_cmd(CMD18, (CardType & 4) ? sector : sector * 512) != 0) {    /* READ_MULTIPLE_BLOCK */
+            DESELECT();        /* CS = H */
+            rcvr_spi();        /* Idle (Release DO) */
+            return RES_ERROR;
         }
+        StreamMode = STREAM_READ;
+        Stats.rd_cmds++;
     }
 
-    DESELECT();            /* CS = H */
-    rcvr_spi();            /* Idle (Release DO) */
+    do {
+        if (!rcvr_datablock(buff, 512)) break;
+        buff += 512;
+        sector++;
+        Stats.rd_sects++;
+    } while (--count);
+    StreamSector = sector;
+
+    if (count) {
+        stream_close();        /* Abandon the transfer on error */
+        return RES_ERROR;
+    }
 
-    return count ? RES_ERROR : RES_OK;
+    /* Release the shared SSI port unless it is ours alone */
+    if (!Exclusive && !stream_close()) return RES_ERROR;
+
+    return RES_OK;
 }
 
 
@@ -477,33 +556,62 @@ DRESULT disk_write (
     if (Stat & STA_NOINIT) return RES_NOTRDY;
     if (Stat & STA_PROTECT) return RES_WRPRT;
 
-    if (!(CardType & 4)) sector *= 512;    /* Convert to byte address if needed */
+    /* A single sector on a shared port is a single block write.  Any
+       MMC_SET_PREERASE count is kept for the next multiple block write. */
+    if (count == 1 && !Exclusive) {
+        if (!stream_close()) return RES_ERROR;
 
-    SELECT();            /* CS = L */
+        SELECT();            /* CS = L */
 
-    if (count == 1) {    /* Single block write */
-        if ((send_cmd(CMD24, sector) == 0)    /* WRITE_BLOCK */
-            && xmit_datablock(buff, 0xFE))
+        if ((send_cmd(CMD24, (CardType & 4) ? sector : sector * 512) == 0)    /* WRITE_BLOCK */
+            && xmit_datablock(buff, 0xFE)) {
             count = 0;
+            Stats.wr_sects++;
+        }
+        Stats.wr_cmds++;
+
+        DESELECT();            /* CS = H */
+        rcvr_spi();            /* Idle (Release DO) */
+
+        return count ? RES_ERROR : RES_OK;
     }
-    else {                /* Multiple block write */
-        if (CardType & 2) {
-            send_cmd(CMD55, 0); send_cmd(CMD23, count);    /* ACMD23 */
+
+    /* Start a new transfer unless this continues the open write transfer */
+    if (StreamMode != STREAM_WRITE || sector != StreamSector) {
+        if (!stream_close()) return RES_ERROR;
+
+        SELECT();            /* CS = L */
+
+        if (CardType & 2) {    /* Pre-erase hint, MMC_SET_PREERASE or this call */
+            send_cmd(CMD55, 0); send_cmd(CMD23, PreErase ? PreErase : count);    /* ACMD23 */
         }
-        if (send_cmd(CMD25, sector) == 0) {    /* WRITE_MULTIPLE_BLOCK */
-            do {
-                if (!xmit_datablock(buff, 0xFC)) break;
-                buff += 512;
-            } while (--count);
-            if (!xmit_datablock(0, 0xFD))    /* STOP_TRAN token */
-                count = 1;
+        PreErase = 0;
+        if (send_cmd(CMD25, (CardType & 4) ? sector : sector * 512) != 0) {    /* WRITE_MULTIPLE_BLOCK */
+            DESELECT();        /* CS = H */
+            rcvr_spi();        /* Idle (Release DO) */
+            return RES_ERROR;
         }
+        StreamMode = STREAM_WRITE;
+        Stats.wr_cmds++;
     }
 
-    DESELECT();            /* CS = H */
-    rcvr_spi();            /* Idle (Release DO) */
+    do {
+        if (!xmit_datablock(buff, 0xFC)) break;
+        buff += 512;
+        sector++;
+        Stats.wr_sects++;
+    } while (--count);
+    StreamSector = sector;
+
+    if (count) {
+        stream_close();        /* Abandon the transfer on error */
+        return RES_ERROR;
+    }
+
+    /* Release the shared SSI port unless it is ours alone */
+    if (!Exclusive && !stream_close()) return RES_ERROR;
 
-    return count ? RES_ERROR : RES_OK;
+    return RES_OK;
 }
 #endif /* _READONLY */
 
@@ -531,6 +639,7 @@ DRESULT disk_ioctl (
     if (ctrl == CTRL_POWER) {
         switch (*ptr) {
         case 0:        /* Sub control code == 0 (POWER_OFF) */
+            stream_close();
             if (chk_power())
                 power_off();        /* Power off */
             res = RES_OK;
@@ -547,9 +656,34 @@ DRESULT disk_ioctl (
             res = RES_PARERR;
         }
     }
+    else if (ctrl == MMC_SET_PREERASE) {    /* Set ACMD23 count for the next write (DWORD) */
+        PreErase = *(DWORD*)buff;
+        if (PreErase > 0x7FFFFF) PreErase = 0x7FFFFF;
+        res = RES_OK;
+    }
+    else if (ctrl == MMC_SET_EXCLUSIVE) {    /* Keep transfers open between calls (BYTE) */
+        Exclusive = *ptr;
+        res = RES_OK;
+        if (!Exclusive && !stream_close())    /* Release the SSI port now */
+            res = RES_ERROR;
+    }
+    else if (ctrl == MMC_GET_STATS) {    /* Get transfer counters (DISK_STATS) */
+        *(DISK_STATS*)buff = Stats;
+        ((DISK_STATS*)buff)->busy_ms = Stats.busy_polls / (SysCtlClockGet() / 16000);
+        ((DISK_STATS*)buff)->ticks = Ticks - TicksBase;
+        res = RES_OK;
+    }
+    else if (ctrl == MMC_RESET_STATS) {    /* Clear transfer counters */
+        for (n = 0; n < sizeof(Stats); n++) ((BYTE*)&Stats)[n] = 0;
+        TicksBase = Ticks;
+        res = RES_OK;
+    }
     else {
         if (Stat & STA_NOINIT) return RES_NOTRDY;
 
+        /* Finish the open transfer, reporting any error it left pending */
+        if (!stream_close()) return RES_ERROR;
+
         SELECT();        /* CS = L */
 
         switch (ctrl) {
@@ -630,6 +764,8 @@ void disk_timerproc (void)
     n = Timer2;
     if (n) Timer2 = --n;
 
+    Ticks++;
+
 }
 
 /*---------------------------------------------------------*/
@@ -55,10 +55,27 @@ void	disk_timerproc (void);
 #define MMC_GET_CSD			10
 #define MMC_GET_CID			11
 #define MMC_GET_OCR			12
+#define MMC_SET_PREERASE	13
+#define MMC_GET_STATS		14
+#define MMC_RESET_STATS		15
+#define MMC_SET_EXCLUSIVE	16
 #define ATA_GET_REV			20
 #define ATA_GET_MODEL		21
 #define ATA_GET_SN			22
 
 
+/* Transfer counters (MMC_GET_STATS) */
+
+typedef struct _DISK_STATS {
+	DWORD	rd_sects;	/* Sectors read */
+	DWORD	wr_sects;	/* Sectors written */
+	DWORD	rd_cmds;	/* Read commands issued */
+	DWORD	wr_cmds;	/* Write commands issued */
+	DWORD	busy_polls;	/* Bytes clocked while waiting for the card */
+	DWORD	busy_ms;	/* busy_polls converted to milliseconds */
+	DWORD	ticks;		/* 10ms ticks since the counters were reset */
+} DISK_STATS;
+
+
 #define _DISKIO
 #endif
@@ -55,6 +55,92 @@ WORD fsid;                /* File system mount ID */
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Write back a dirty sector buffer                                      */
+/*-----------------------------------------------------------------------*/
+
+#if !_FS_READONLY
+static
+BOOL write_back (        /* TRUE: successful, FALSE: failed */
+    FATFS *fs,            /* File system object */
+    const BYTE *buf,    /* Sector buffer */
+    DWORD sect,            /* Sector number the buffer holds (0:none) */
+    BYTE *flag            /* Pointer to the dirty flag of the buffer */
+)
+{
+    BYTE n;
+
+
+    if (*flag && sect) {    /* Write back the buffer if dirty */
+        if (disk_write(fs->drive, buf, sect, 1) != RES_OK)
+            return FALSE;
+        *flag = 0;
+        if (sect < (fs->fatbase + fs->sects_fat)) {    /* In FAT area */
+            for (n = fs->n_fats; n >= 2; n--) {    /* Refrect the change to FAT copy */
+                sect += fs->sects_fat;
+                disk_write(fs->drive, buf, sect, 1);
+            }
+        }
+    }
+    return TRUE;
+}
+#endif
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Window cache control                                                  */
+/*-----------------------------------------------------------------------*/
+
+#if _WIN_CACHE
+static
+void swap_window (
+    BYTE *a,            /* Sector buffers to exchange */
+    BYTE *b
+)
+{
+    UINT n;
+#if _MCU_ENDIAN == 1
+    DWORD t, *pa = (DWORD*)a, *pb = (DWORD*)b;
+
+    for (n = S_SIZ / 4; n; n--) {
+        t = *pa; *pa++ = *pb; *pb++ = t;
+    }
+#else
+    BYTE t;
+
+    for (n = S_SIZ; n; n--) {
+        t = *a; *a++ = *b; *b++ = t;
+    }
+#endif
+}
+
+
+#if !_FS_READONLY
+static
+void drop_cache (
+    FATFS *fs,            /* File system object */
+    DWORD sect,            /* First sector to discard from the cache */
+    BYTE n                /* Number of sectors */
+)
+{
+    BYTE i;
+
+
+    for (i = 0; i < _WIN_CACHE; i++) {
+        if (fs->csect[i] >= sect && fs->csect[i] < sect + n) {
+            fs->csect[i] = 0;
+            fs->cflag[i] = 0;
+        }
+    }
+}
+#endif
+#endif /* _WIN_CACHE */
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Change window offset                                                  */
 /*-----------------------------------------------------------------------*/
@@ -63,26 +149,58 @@ static
 BOOL move_window (        /* TRUE: successful, FALSE: failed */
     FATFS *fs,            /* File system object */
     DWORD sector        /* Sector number to make apperance in the fs->win[] */
-)                        /* Move to zero only writes back dirty window */
+)                        /* Move to zero only writes back dirty window (and cache) */
 {
     DWORD wsect;
+#if _WIN_CACHE
+    BYTE i, v;
+#endif
 
 
     wsect = fs->winsect;
+#if _WIN_CACHE
+    if (!sector) {            /* Write back the window and all dirty cached sectors */
+#if !_FS_READONLY
+        if (!write_back(fs, fs->win, wsect, &fs->winflag))
+            return FALSE;
+        for (i = 0; i < _WIN_CACHE; i++) {
+            if (!write_back(fs, fs->cbuf[i], fs->csect[i], &fs->cflag[i]))
+                return FALSE;
+        }
+#endif
+        return TRUE;
+    }
     if (wsect != sector) {    /* Changed current window */
+        for (i = v = 0; i < _WIN_CACHE && fs->csect[i] != sector; i++) {
+            if (!fs->csect[v]) continue;            /* Choose an empty slot or */
+            if (!fs->csect[i] || fs->cuse[i] < fs->cuse[v]) v = i;    /* the least recently used one */
+        }
+        if (i < _WIN_CACHE) {    /* Cache hit, exchange the window with the cached sector */
+            fs->cache_hit++;
+            swap_window(fs->win, fs->cbuf[i]);
+            fs->csect[i] = wsect; fs->winsect = sector;
+            v = fs->cflag[i]; fs->cflag[i] = fs->winflag; fs->winflag = v;
+        } else {                /* Cache miss, keep the window in the victim slot and load */
+            fs->cache_miss++;
+            i = v;
 #if !_FS_READONLY
-        BYTE n;
-        if (fs->winflag) {    /* Write back dirty window if needed */
-            if (disk_write(fs->drive, fs->win, wsect, 1) != RES_OK)
+            if (!write_back(fs, fs->cbuf[i], fs->csect[i], &fs->cflag[i]))
                 return FALSE;
-            fs->winflag = 0;
-            if (wsect < (fs->fatbase + fs->sects_fat)) {    /* In FAT area */
-                for (n = fs->n_fats; n >= 2; n--) {    /* Refrect the change to FAT copy */
-                    wsect += fs->sects_fat;
-                    disk_write(fs->drive, fs->win, wsect, 1);
-                }
-            }
+#endif
+            memcpy(fs->cbuf[i], fs->win, S_SIZ);
+            fs->csect[i] = wsect; fs->cflag[i] = fs->winflag;
+            fs->winsect = 0; fs->winflag = 0;
+            if (disk_read(fs->drive, fs->win, sector, 1) != RES_OK)
+                return FALSE;
+            fs->winsect = sector;
         }
+        fs->cuse[i] = fs->cache_hit + fs->cache_miss;
+    }
+#else
+    if (wsect != sector) {    /* Changed current window */
+#if !_FS_READONLY
+        if (!write_back(fs, fs->win, wsect, &fs->winflag))
+            return FALSE;
 #endif
         if (sector) {
             if (disk_read(fs->drive, fs->win, sector, 1) != RES_OK)
@@ -90,6 +208,7 @@ BOOL move_window (        /* TRUE: successful, FALSE: failed */
             fs->winsect = sector;
         }
     }
+#endif
     return TRUE;
 }
 
@@ -117,7 +236,7 @@ FRESULT sync (            /* FR_OK: successful, FR_RW_ERROR: failed */
         ST_DWORD(&fs->win[FSI_StrucSig], 0x61417272);
         ST_DWORD(&fs->win[FSI_Free_Count], fs->free_clust);
         ST_DWORD(&fs->win[FSI_Nxt_Free], fs->last_clust);
-        disk_write(0, fs->win, fs->fsi_sector, 1);
+        disk_write(fs->drive, fs->win, fs->fsi_sector, 1);
         fs->fsi_flag = 0;
     }
 #endif
@@ -222,6 +341,151 @@ BOOL put_cluster (        /* TRUE: successful, FALSE: failed */
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Free extent summary control                                           */
+/*-----------------------------------------------------------------------*/
+
+#if !_FS_READONLY && _FREE_EXTENTS
+static
+void ext_put (
+    FATFS *fs,            /* File system object */
+    DWORD clust,        /* Start cluster# of the free run */
+    DWORD n                /* Number of clusters in the run */
+)
+{
+    DWORD *e, *m;
+    UINT i;
+
+
+    for (e = m = fs->fext, i = 0; i < _FREE_EXTENTS; i++, e += 2) {    /* Find the smallest (or an empty) slot */
+        if (e[1] < m[1]) m = e;
+    }
+    if (m[1] < n) {        /* Replace it if the new run is larger */
+        m[0] = clust; m[1] = n;
+    }
+}
+
+
+static
+void ext_take (
+    FATFS *fs,            /* File system object */
+    DWORD clust,        /* First cluster# allocated */
+    DWORD n                /* Number of clusters allocated */
+)
+{
+    DWORD *e, end = clust + n, top;
+    UINT i;
+
+
+    if (clust < fs->fscan)                        /* Allocated below the scan point */
+        fs->fscan_free -= ((end < fs->fscan) ? end : fs->fscan) - clust;
+    if (fs->frun && clust < fs->fscan && end > fs->frun) {    /* Cut the run being scanned */
+        if (clust > fs->frun) ext_put(fs, fs->frun, clust - fs->frun);
+        fs->frun = (end < fs->fscan) ? end : 0;
+    }
+    for (e = fs->fext, i = 0; i < _FREE_EXTENTS; i++, e += 2) {    /* Cut the extents */
+        top = e[0] + e[1];
+        if (!e[1] || clust >= top || end <= e[0]) continue;
+        e[1] = (clust > e[0]) ? clust - e[0] : 0;    /* Leave the head in the slot */
+        if (end < top) {                            /* Put the tail */
+            if (!e[1]) {
+                e[0] = end; e[1] = top - end;
+            } else {
+                ext_put(fs, end, top - end);
+            }
+        }
+    }
+}
+
+
+static
+void ext_free (
+    FATFS *fs,            /* File system object */
+    DWORD clust,        /* First cluster# released */
+    DWORD n                /* Number of clusters released */
+)
+{
+    DWORD *e, *p, *q;
+    UINT i;
+
+
+    if (clust >= fs->fscan) return;                /* The scan will find it */
+    if (clust + n > fs->fscan) n = fs->fscan - clust;
+    fs->fscan_free += n;
+    if (fs->frun && clust + n == fs->frun) {    /* Stretch the run being scanned */
+        fs->frun = clust;
+        return;
+    }
+    for (p = 0, e = fs->fext, i = 0; i < _FREE_EXTENTS; i++, e += 2) {    /* Stretch an adjacent extent */
+        if (!e[1]) continue;
+        if (e[0] + e[1] == clust) {
+            e[1] += n; p = e; break;
+        }
+        if (e[0] == clust + n) {
+            e[0] = clust; e[1] += n; p = e; break;
+        }
+    }
+    if (!p) {
+        ext_put(fs, clust, n);
+        return;
+    }
+    for (q = fs->fext, i = 0; i < _FREE_EXTENTS; i++, q += 2) {    /* Merge the extents joined by the run */
+        if (q == p || !q[1]) continue;
+        if (q[0] == p[0] + p[1]) {
+            p[1] += q[1]; q[1] = 0;
+        } else if (q[0] + q[1] == p[0]) {
+            p[0] = q[0]; p[1] += q[1]; q[1] = 0;
+        }
+    }
+}
+
+
+#if _FS_MINIMIZE == 0
+static
+BOOL scan_free (        /* TRUE: successful, FALSE: failed */
+    FATFS *fs,            /* File system object */
+    DWORD n                /* Number of clusters to scan */
+)
+{
+    DWORD clust, cstat, mcl = fs->max_clust;
+    UINT i;
+
+
+    clust = fs->fscan;
+    if (clust >= mcl) return TRUE;                /* The scan has been completed */
+    if (clust < 2) {                            /* Start the scan */
+        for (i = 0; i < _FREE_EXTENTS * 2; i++) fs->fext[i] = 0;
+        fs->fscan_free = 0; fs->frun = 0;
+        fs->fscan = clust = 2;
+    }
+    for ( ; n && clust < mcl; n--, clust++) {
+        cstat = get_cluster(fs, clust);
+        if (cstat == 1) return FALSE;
+        if (cstat == 0) {                        /* A free cluster, start or stretch the run */
+            fs->fscan_free++;
+            if (!fs->frun) fs->frun = clust;
+        } else if (fs->frun) {                    /* End of a free run */
+            ext_put(fs, fs->frun, clust - fs->frun);
+            fs->frun = 0;
+        }
+        fs->fscan = clust + 1;
+    }
+    if (clust >= mcl) {                            /* The scan has been completed */
+        if (fs->frun) ext_put(fs, fs->frun, mcl - fs->frun);
+        fs->frun = 0;
+        fs->free_clust = fs->fscan_free;        /* Correct the number of free clusters */
+#if _USE_FSINFO
+        if (fs->fs_type == FS_FAT32) fs->fsi_flag = 1;
+#endif
+    }
+    return TRUE;
+}
+#endif /* _FS_MINIMIZE == 0 */
+#endif /* !_FS_READONLY && _FREE_EXTENTS */
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Remove a cluster chain                                                */
 /*-----------------------------------------------------------------------*/
@@ -234,12 +498,25 @@ BOOL remove_chain (        /* TRUE: successful, FALSE: failed */
 )
 {
     DWORD nxt;
+#if _FREE_EXTENTS
+    DWORD scl = 0, ecl = 0;
+#endif
 
 
     while (clust >= 2 && clust < fs->max_clust) {
         nxt = get_cluster(fs, clust);
         if (nxt == 1) return FALSE;
         if (!put_cluster(fs, clust, 0)) return FALSE;
+#if _WIN_CACHE
+        drop_cache(fs, (clust - 2) * fs->sects_clust + fs->database, fs->sects_clust);    /* Discard stale directory sectors */
+#endif
+#if _FREE_EXTENTS
+        if (clust != ecl) {                /* Return each contiguous run to the summary */
+            if (scl) ext_free(fs, scl, ecl - scl);
+            scl = clust;
+        }
+        ecl = clust + 1;
+#endif
         if (fs->free_clust != 0xFFFFFFFF) {
             fs->free_clust++;
 #if _USE_FSINFO
@@ -248,6 +525,9 @@ BOOL remove_chain (        /* TRUE: successful, FALSE: failed */
         }
         clust = nxt;
     }
+#if _FREE_EXTENTS
+    if (scl) ext_free(fs, scl, ecl - scl);
+#endif
     return TRUE;
 }
 #endif
@@ -267,6 +547,10 @@ DWORD create_chain (    /* 0: no free cluster, 1: error, >=2: new cluster number
 )
 {
     DWORD cstat, ncl, scl, mcl = fs->max_clust;
+#if _FREE_EXTENTS
+    DWORD *e, *m;
+    UINT i;
+#endif
 
 
     if (clust == 0) {        /* Create new chain */
@@ -280,6 +564,15 @@ DWORD create_chain (    /* 0: no free cluster, 1: error, >=2: new cluster number
         scl = clust;
     }
 
+#if _FREE_EXTENTS
+    ncl = scl + 1;            /* Start a new chain, or a chain that cannot be stretched contiguously, at the largest free extent, */
+    if ((!clust && ncl != fs->fexp) || ncl >= mcl || get_cluster(fs, ncl) != 0) {    /* unless it is the area reserved by f_expand() */
+        for (e = m = fs->fext, i = 0; i < _FREE_EXTENTS; i++, e += 2) {
+            if (e[1] > m[1]) m = e;
+        }
+        if (m[1] && get_cluster(fs, m[0]) == 0) scl = m[0] - 1;
+    }
+#endif
     ncl = scl;                /* Start cluster */
     for (;;) {
         ncl++;                            /* Next cluster */
@@ -295,6 +588,10 @@ DWORD create_chain (    /* 0: no free cluster, 1: error, >=2: new cluster number
 
     if (!put_cluster(fs, ncl, 0x0FFFFFFF)) return 1;        /* Mark the new cluster "in use" */
     if (clust && !put_cluster(fs, clust, ncl)) return 1;    /* Link it to previous one if needed */
+#if _FREE_EXTENTS
+    ext_take(fs, ncl, 1);
+    fs->fexp = 0;                        /* The reserved area has been used (or given up) */
+#endif
 
     fs->last_clust = ncl;                /* Update fsinfo */
     if (fs->free_clust != 0xFFFFFFFF) {
@@ -329,6 +626,105 @@ DWORD clust2sect (    /* !=0: sector number, 0: failed - invalid cluster# */
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Build the link map of a file                                          */
+/*-----------------------------------------------------------------------*/
+
+#if _USE_LINKMAP && _FS_MINIMIZE <= 2
+static
+BOOL map_build (    /* TRUE: the map is available, FALSE: no map */
+    FIL *fp            /* Pointer to the file object */
+)
+{
+    DWORD clust, nxt, *tbl = fp->map;
+    FATFS *fs = fp->fs;
+    BYTE n;
+
+
+    if (fp->map_clust) return TRUE;                /* Already built */
+    clust = fp->org_clust;
+    if (clust < 2 || clust >= fs->max_clust) return FALSE;    /* No cluster chain */
+
+    n = 1; tbl[0] = clust; tbl[1] = 1;
+    for (;;) {                                    /* Follow the chain and record each fragment */
+        nxt = get_cluster(fs, clust);
+        if (nxt == 1) return FALSE;                /* Any error occured */
+        if (nxt < 2 || nxt >= fs->max_clust) break;    /* End of the chain */
+        if (nxt == clust + 1) {                    /* Contiguous, stretch the fragment */
+            tbl[1]++;
+        } else {                                /* Start a new fragment */
+            if (n >= _LINKMAP_SIZE) break;        /* Map full, the rest is followed on the FAT */
+            tbl += 2; n++;
+            tbl[0] = nxt; tbl[1] = 1;
+        }
+        clust = nxt;
+    }
+
+    fp->map_frags = n;
+    for (tbl = fp->map, clust = 0; n; n--, tbl += 2)
+        clust += tbl[1];
+    fp->map_clust = clust;
+    return TRUE;
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Get the cluster# at an index in the link map                          */
+/*-----------------------------------------------------------------------*/
+
+static
+DWORD map_cluster (    /* Cluster# (the index must be in the map) */
+    FIL *fp,            /* Pointer to the file object */
+    DWORD idx            /* Index of the cluster in the chain */
+)
+{
+    DWORD *tbl = fp->map;
+
+
+    while (idx >= tbl[1]) {        /* Skip fragments before the index */
+        idx -= tbl[1];
+        tbl += 2;
+    }
+    return tbl[0] + idx;
+}
+#endif /* _USE_LINKMAP && _FS_MINIMIZE <= 2 */
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Get the next cluster of a file                                        */
+/*-----------------------------------------------------------------------*/
+
+static
+DWORD next_cluster (    /* 0,>=2: successful, 1: failed */
+    FIL *fp,            /* Pointer to the file object */
+    DWORD clust            /* Cluster# in the chain of the file */
+)
+{
+#if _USE_LINKMAP
+    DWORD *tbl = fp->map;
+    BYTE n;
+
+
+    if (fp->map_clust) {            /* Look up the link map first */
+        for (n = fp->map_frags; n; n--, tbl += 2) {
+            if (clust >= tbl[0] && clust < tbl[0] + tbl[1]) {
+                if (clust + 1 < tbl[0] + tbl[1]) return clust + 1;
+                if (n > 1) return tbl[2];
+                break;
+            }
+        }
+    }
+#endif
+    return get_cluster(fp->fs, clust);
+}
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Move directory pointer to next                                        */
 /*-----------------------------------------------------------------------*/
@@ -720,12 +1116,13 @@ FRESULT auto_mount (        /* FR_OK(0): successful, !=0: any error occured */
     /* Load fsinfo sector if needed */
     if (fmt == FS_FAT32) {
         fs->fsi_sector = bootsect + LD_WORD(&fs->win[BPB_FSInfo]);
-        if (disk_read(0, fs->win, fs->fsi_sector, 1) == RES_OK &&
+        if (disk_read(fs->drive, fs->win, fs->fsi_sector, 1) == RES_OK &&
             LD_WORD(&fs->win[BS_55AA]) == 0xAA55 &&
             LD_DWORD(&fs->win[FSI_LeadSig]) == 0x41615252 &&
             LD_DWORD(&fs->win[FSI_StrucSig]) == 0x61417272) {
             fs->last_clust = LD_DWORD(&fs->win[FSI_Nxt_Free]);
             fs->free_clust = LD_DWORD(&fs->win[FSI_Free_Count]);
+            if (fs->free_clust > maxclust - 2) fs->free_clust = 0xFFFFFFFF;    /* Invalid count */
         }
     }
 #endif
@@ -878,6 +1275,9 @@ FRESULT f_open (
     fp->fsize = LD_DWORD(&dir[DIR_FileSize]);    /* File size */
     fp->fptr = 0;                        /* File ptr */
     fp->sect_clust = 1;                    /* Sector counter */
+#if _USE_LINKMAP
+    fp->map_clust = 0;                    /* Link map is built on demand */
+#endif
     fp->fs = fs; fp->id = fs->id;        /* Owner file system object of the file */
 
     return FR_OK;
@@ -919,7 +1319,7 @@ FRESULT f_read (
                 sect = fp->curr_sect + 1;            /* Get current sector */
             } else {                                /* On the cluster boundary, get next cluster */
                 clust = (fp->fptr == 0) ?
-                    fp->org_clust : get_cluster(fs, fp->curr_clust);
+                    fp->org_clust : next_cluster(fp, fp->curr_clust);
                 if (clust < 2 || clust >= fs->max_clust)
                     goto fr_error;
                 fp->curr_clust = clust;                /* Current cluster */
@@ -936,6 +1336,15 @@ FRESULT f_read (
             fp->curr_sect = sect;                    /* Update current sector */
             cc = btr / S_SIZ;                        /* When left bytes >= S_SIZ, */
             if (cc) {                                /* Read maximum contiguous sectors directly */
+                if (cc > fp->sect_clust) {            /* Take in following clusters while contiguous */
+                    clust = fp->curr_clust;
+                    while (cc >= fp->sect_clust + fs->sects_clust &&
+                        next_cluster(fp, clust) == clust + 1) {
+                        clust++;
+                        fp->sect_clust += fs->sects_clust;
+                    }
+                    fp->curr_clust = clust;
+                }
                 if (cc > fp->sect_clust) cc = fp->sect_clust;
                 if (disk_read(fs->drive, rbuff, sect, cc) != RES_OK)
                     goto fr_error;
@@ -1124,6 +1533,9 @@ FRESULT f_lseek (
 )
 {
     DWORD clust, csize;
+#if _USE_LINKMAP
+    DWORD n;
+#endif
     BYTE csect;
     FRESULT res;
     FATFS *fs = fp->fs;
@@ -1157,6 +1569,15 @@ FRESULT f_lseek (
 #endif
         if (clust) {            /* If the file has a cluster chain, it can be followed */
             csize = (DWORD)fs->sects_clust * S_SIZ;        /* Cluster size in unit of byte */
+#if _USE_LINKMAP
+            if (ofs > csize && map_build(fp)) {        /* Skip leading clusters in the link map */
+                n = (ofs - 1) / csize;
+                if (n >= fp->map_clust) n = fp->map_clust - 1;
+                clust = map_cluster(fp, n);
+                fp->fptr += n * csize;
+                ofs -= n * csize;
+            }
+#endif
             for (;;) {                                    /* Loop to skip leading clusters */
                 fp->curr_clust = clust;                    /* Update current cluster */
                 if (ofs <= csize) break;
@@ -1318,8 +1739,10 @@ FRESULT f_getfree (
     FATFS **fatfs        /* Pointer to pointer to the file system object to return */
 )
 {
+#if !_FREE_EXTENTS
     DWORD n, clust, sect;
     BYTE fat, f, *p;
+#endif
     FRESULT res;
     FATFS *fs;
 
@@ -1329,6 +1752,13 @@ FRESULT f_getfree (
     if (res != FR_OK) return res;
     *fatfs = fs;
 
+#if _FREE_EXTENTS
+    /* Finish building the free extent summary (this also counts number of free clusters).
+       It is built even when the count is already valid, and does nothing once the FAT has been scanned. */
+    if (!scan_free(fs, fs->max_clust)) return FR_RW_ERROR;
+    *nclust = fs->free_clust;
+    return FR_OK;
+#else
     /* If number of free cluster is valid, return it without cluster scan. */
     if (fs->free_clust <= fs->max_clust - 2) {
         *nclust = fs->free_clust;
@@ -1367,6 +1797,117 @@ FRESULT f_getfree (
 #endif
 
     *nclust = n;
+    return FR_OK;
+#endif
+}
+
+
+
+
+#if _FREE_EXTENTS
+/*-----------------------------------------------------------------------*/
+/* Build the Free Extent Summary                                         */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_scanfree (
+    const char *drv,    /* Logical drive number */
+    DWORD count,        /* Number of clusters to scan in this call */
+    DWORD *left            /* Pointer to the double word to return number of clusters left to scan */
+)
+{
+    FRESULT res;
+    FATFS *fs;
+
+
+    res = auto_mount(&drv, &fs, 0);
+    if (res != FR_OK) return res;
+
+    if (!scan_free(fs, count)) return FR_RW_ERROR;
+    *left = (fs->fscan < 2) ? fs->max_clust - 2 : fs->max_clust - fs->fscan;
+    return FR_OK;
+}
+#endif
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Allocate a Contiguous Area to a File                                  */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_expand (
+    FIL *fp,        /* Pointer to the file object */
+    DWORD fsz,        /* Size of the area in bytes */
+    BYTE opt        /* 0: Make the area the next allocation point, 1: Allocate the area to the file */
+)
+{
+    DWORD n, clust, cstat, scl, ncl;
+    FRESULT res;
+    FATFS *fs = fp->fs;
+#if _FREE_EXTENTS
+    DWORD *e;
+    UINT i;
+#endif
+
+
+    res = validate(fs, fp->id);                        /* Check validity of the object */
+    if (res != FR_OK) return res;
+    if (fp->flag & FA__ERROR) return FR_RW_ERROR;    /* Check error flag */
+    if (!(fp->flag & FA_WRITE) || fp->org_clust || !fsz)    /* Check access mode and that the file is empty */
+        return FR_DENIED;
+    n = (fsz - 1) / ((DWORD)fs->sects_clust * S_SIZ) + 1;    /* Number of clusters required */
+
+    /* Find a contiguous free area */
+    scl = ncl = 0;
+#if _FREE_EXTENTS
+    for (e = fs->fext, i = 0; i < _FREE_EXTENTS; i++, e += 2) {    /* Take the smallest known extent that fits */
+        if (e[1] >= n && (!scl || e[1] < ncl)) {
+            scl = e[0]; ncl = e[1];
+        }
+    }
+    if (scl && get_cluster(fs, scl) != 0) scl = 0;
+#endif
+    if (!scl) {                                        /* Search the FAT */
+        for (clust = 2, ncl = 0; clust < fs->max_clust; clust++) {
+            cstat = get_cluster(fs, clust);
+            if (cstat == 1) return FR_RW_ERROR;
+            if (cstat) {
+                ncl = 0;
+            } else {
+                if (!ncl++) scl = clust;
+                if (ncl == n) break;
+            }
+        }
+        if (ncl < n) return FR_DENIED;                /* No contiguous area large enough */
+    }
+
+    if (opt) {                                        /* Allocate the area as the cluster chain of the file */
+        for (clust = scl, ncl = scl + n - 1; clust <= ncl; clust++) {
+            if (!put_cluster(fs, clust, (clust < ncl) ? clust + 1 : 0x0FFFFFFF)) {
+                fp->flag |= FA__ERROR;
+                return FR_RW_ERROR;
+            }
+        }
+#if _FREE_EXTENTS
+        ext_take(fs, scl, n);
+#endif
+        fs->last_clust = ncl;
+        if (fs->free_clust != 0xFFFFFFFF) {
+            fs->free_clust -= n;
+#if _USE_FSINFO
+            fs->fsi_flag = 1;
+#endif
+        }
+        fp->org_clust = scl;
+        fp->fsize = fsz;
+        fp->flag |= FA__WRITTEN;
+    } else {                                        /* Make following allocations start at the area */
+        fs->last_clust = scl - 1;
+#if _FREE_EXTENTS
+        fs->fexp = scl;                                /* Keep create_chain() from moving the start to the largest extent */
+#endif
+    }
+
     return FR_OK;
 }
 
@@ -32,7 +32,8 @@
 #define _FS_MINIMIZE    0
 /* The _FS_MINIMIZE option defines minimization level to remove some functions.
 /  0: Full function.
-/  1: f_stat, f_getfree, f_unlink, f_mkdir, f_chmod and f_rename are removed.
+/  1: f_stat, f_getfree, f_scanfree, f_expand, f_unlink, f_mkdir, f_chmod and
+/     f_rename are removed.
 /  2: f_opendir and f_readdir are removed in addition to level 1.
 /  3: f_lseek is removed in addition to level 2. */
 
@@ -51,6 +52,35 @@
 #define _USE_FSINFO    0
 /* To enable FSInfo support on FAT32 volume, set _USE_FSINFO to 1. */
 
+#define _WIN_CACHE      0
+/* Number of FAT/directory sectors cached in addition to the win[] window.
+/  When the window moves to another sector, the sector it leaves is kept in
+/  the cache and the least recently used cached sector is evicted, so access
+/  that alternates between a few sectors (e.g. a FAT sector and a directory
+/  entry while appending to a file) does not reload them each time. Dirty
+/  cached sectors are written back when evicted and on f_sync(). Each cached
+/  sector takes S_MAX_SIZ bytes of the file system object. */
+
+#define _FREE_EXTENTS   0
+/* When _FREE_EXTENTS is set to a non-zero value, the file system object holds
+/  a summary of the largest _FREE_EXTENTS runs of free clusters. The summary
+/  is built by a scan of the FAT that can be done at once by f_getfree() or
+/  a piece at a time by f_scanfree(), and is kept up to date as clusters are
+/  allocated and released. New cluster chains are started at the largest
+/  known run instead of searching the FAT (except for the next chain after
+/  f_expand() with option 0, which starts at the area it found), and the
+/  scan result corrects the free cluster count held in FSInfo. f_expand()
+/  does not depend on this option, but finds a contiguous area without a FAT
+/  search when the summary has one. */
+
+#define _USE_LINKMAP    0
+#define _LINKMAP_SIZE   8
+/* When _USE_LINKMAP is set to 1, each file object holds a map of the
+/  contiguous fragments of its cluster chain. The map is built on the first
+/  seek after the file is opened, and lets f_lseek() and f_read() move across
+/  clusters without following the FAT. _LINKMAP_SIZE is the number of
+/  fragments the map can hold; clusters beyond them are followed on the FAT. */
+
 #define    _USE_SJIS    1
 /* When _USE_SJIS is set to 1, Shift-JIS code transparency is enabled, otherwise
 /  only US-ASCII(7bit) code can be accepted as file/directory name. */
@@ -91,6 +121,13 @@ typedef struct _FATFS {
     BYTE    fsi_flag;        /* fsinfo dirty flag (1:must be written back) */
     BYTE    pad2;
 #endif
+#if _FREE_EXTENTS
+    DWORD    fscan;            /* Next cluster# to be scanned (0:scan not started) */
+    DWORD    fscan_free;        /* Number of free clusters found below fscan */
+    DWORD    frun;            /* Start of the free run being scanned (0:none) */
+    DWORD    fext[_FREE_EXTENTS * 2];    /* Free extents (start cluster and length of each run) */
+    DWORD    fexp;            /* Start of the area reserved by f_expand() for the next chain (0:none) */
+#endif
 #endif
     BYTE    fs_type;        /* FAT sub type */
     BYTE    sects_clust;    /* Sectors per cluster */
@@ -102,6 +139,14 @@ typedef struct _FATFS {
     BYTE    winflag;        /* win[] dirty flag (1:must be written back) */
     BYTE    pad1;
     BYTE    win[S_MAX_SIZ];    /* Disk access window for Directory/FAT */
+#if _WIN_CACHE
+    DWORD    cache_hit;        /* Number of window moves found in the cache */
+    DWORD    cache_miss;        /* Number of window moves read from the disk */
+    DWORD    csect[_WIN_CACHE];    /* Sector held in each cache slot (0:empty) */
+    DWORD    cuse[_WIN_CACHE];    /* Last use of each cache slot (for LRU) */
+    BYTE    cflag[_WIN_CACHE];    /* Dirty flag of each cache slot */
+    BYTE    cbuf[_WIN_CACHE][S_MAX_SIZ];    /* Cached sectors */
+#endif
 } FATFS;
 
 
@@ -130,6 +175,11 @@ typedef struct _FIL {
 #if _FS_READONLY == 0
     DWORD    dir_sect;        /* Sector containing the directory entry */
     BYTE*    dir_ptr;        /* Ponter to the directory entry in the window */
+#endif
+#if _USE_LINKMAP
+    DWORD    map_clust;        /* Number of clusters in the link map (0:not built) */
+    DWORD    map[_LINKMAP_SIZE * 2];    /* Link map (start cluster and length of each fragment) */
+    BYTE    map_frags;        /* Number of fragments in the link map */
 #endif
     BYTE    buffer[S_MAX_SIZ];    /* File R/W buffer */
 } FIL;
@@ -201,6 +251,8 @@ FRESULT f_opendir (DIR*, const char*);                /* Open an existing direct
 FRESULT f_readdir (DIR*, FILINFO*);                    /* Read a directory item */
 FRESULT f_stat (const char*, FILINFO*);                /* Get file status */
 FRESULT f_getfree (const char*, DWORD*, FATFS**);    /* Get number of free clusters on the drive */
+FRESULT f_scanfree (const char*, DWORD, DWORD*);    /* Build the free extent summary of the drive */
+FRESULT f_expand (FIL*, DWORD, BYTE);                /* Allocate a contiguous area to a file */
 FRESULT f_sync (FIL*);                                /* Flush cached data of a writing file */
 FRESULT f_unlink (const char*);                        /* Delete an existing file or directory */
 FRESULT    f_mkdir (const char*);                        /* Create a new directory */
@@ -32,6 +32,7 @@
 #include "lwip/opt.h"
 #include "lwip/def.h"
 #include "lwip/mem.h"
+#include <string.h>
 #include "fs.h"
 #include "fsdata.h"
 #include "fsdata.c"
@@ -51,17 +52,31 @@ fs_open(char *name)
     return NULL;
   }
 
+#ifdef FS_HASH_SIZE
+  /* Images from the current makefsdata carry a hash of the file names. */
+  f = (struct fsdata_file_noconst *)fsdata_find(name);
+  if(f != NULL) {
+    file->data = (char *)f->data;
+    file->len = f->len;
+    file->flags = f->flags;
+    file->index = f->len;
+    file->pextension = NULL;
+    return file;
+  }
+#else /* FS_HASH_SIZE */
   for(f = (struct fsdata_file_noconst *)FS_ROOT;
       f != NULL;
       f = (struct fsdata_file_noconst *)f->next) {
     if (!strcmp(name, (char *)f->name)) {
       file->data = (char *)f->data;
       file->len = f->len;
+      file->flags = f->flags;
       file->index = f->len;
       file->pextension = NULL;
       return file;
     }
   }
+#endif /* FS_HASH_SIZE */
   mem_free(file);
   return NULL;
 }
@@ -32,13 +32,26 @@
 #ifndef __FS_H__
 #define __FS_H__
 
+/* If data is not NULL, the file is the len bytes at data.  The server
+   sends them by reference, so they must stay unchanged until TCP has
+   finished with them (as they do in flash).  Otherwise the contents of
+   the file are produced by fs_read(). */
 struct fs_file {
   char *data;
   int len;
   int index;
   void *pextension;
+  int flags;
 };
 
+/* Flags for fs_file and fsdata_file.  A gzip compressed file already
+   carries a Content-Encoding header, and may only be sent to a client
+   that accepts gzip.  makefsdata stores it under the name of the file
+   with ".gz" added, next to the uncompressed copy.  A file whose headers carry a Content-Length can be
+   followed by another response on the same connection. */
+#define FS_FILE_FLAGS_GZIP   0x01
+#define FS_FILE_FLAGS_LENGTH 0x02
+
 /* file must be allocated by caller and will be filled in
    by the function. */
 struct fs_file *fs_open(char *name);
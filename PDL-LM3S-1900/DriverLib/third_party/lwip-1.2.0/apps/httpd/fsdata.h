@@ -37,6 +37,7 @@ struct fsdata_file {
   const unsigned char *name;
   const unsigned char *data;
   const int len;
+  const int flags;
 };
 
 struct fsdata_file_noconst {
@@ -44,6 +45,7 @@ struct fsdata_file_noconst {
   unsigned char *name;
   unsigned char *data;
   int len;
+  int flags;
 };
 
 #endif /* __FSDATA_H__ */
@@ -44,13 +44,103 @@
 
 #include <string.h>
 
+/* The size of the buffer that generated file data is read into before
+   being copied into the TCP send queue.  A file that is generated in one
+   piece (such as a server side include) must fit in this buffer. */
+#ifndef HTTPD_BUF_SIZE
+#define HTTPD_BUF_SIZE TCP_MSS
+#endif
+
+/* The longest request that is waited for.  A connection that has sent
+   this much without completing its request headers is closed. */
+#ifndef HTTPD_MAX_REQ_LEN
+#define HTTPD_MAX_REQ_LEN 2048
+#endif
+
+/* The number of polls (two seconds apart) that a persistent connection
+   may spend waiting for its next request before it is closed, so that
+   its pcb is free for another client. */
+#ifndef HTTPD_IDLE_POLLS
+#define HTTPD_IDLE_POLLS 3
+#endif
+
 struct http_state {
   struct fs_file *handle;
   char *file;
   u32_t left;
   u8_t retries;
+  u8_t keepalive;
+  u8_t copy_wait;
+  struct pbuf *req;
+  struct tcp_pcb *pcb;
+  struct http_state *copy_next;
 };
 
+/* Files whose contents are in memory (the fsdata image in flash) are
+   handed to TCP by reference and never copied.  Files without a data
+   pointer are generated by fs_read() into this buffer and copied into
+   the send queue.  The buffer is shared by all connections; a connection
+   that could not queue all of the data it read keeps ownership until
+   it has, and other connections wait for it in a queue.  They are served
+   in turn as soon as the buffer is released. */
+static char copy_buf[HTTPD_BUF_SIZE];
+static struct http_state *copy_owner;
+static struct http_state *copy_waiters;
+static u8_t copy_kicking;
+
+static void serve(struct tcp_pcb *pcb, struct http_state *hs);
+/*-----------------------------------------------------------------------------------*/
+/* Adds a connection to the end of the queue waiting for the copy
+   buffer, unless it is already in it. */
+static void
+copy_wait(struct http_state *hs)
+{
+  struct http_state **link;
+
+  if(hs->copy_wait) {
+    return;
+  }
+  for(link = &copy_waiters; *link != NULL; link = &(*link)->copy_next);
+  hs->copy_next = NULL;
+  hs->copy_wait = 1;
+  *link = hs;
+}
+/*-----------------------------------------------------------------------------------*/
+/* Removes a connection from the queue waiting for the copy buffer, if
+   it is in it. */
+static void
+copy_unwait(struct http_state *hs)
+{
+  struct http_state **link;
+
+  if(hs->copy_wait) {
+    for(link = &copy_waiters; *link != hs; link = &(*link)->copy_next);
+    *link = hs->copy_next;
+    hs->copy_wait = 0;
+  }
+}
+/*-----------------------------------------------------------------------------------*/
+/* Releases the copy buffer and serves the waiting connections in turn
+   until one of them takes it.  A connection that releases the buffer
+   while being served here leaves the next one to this loop. */
+static void
+copy_release(void)
+{
+  struct http_state *hs;
+
+  copy_owner = NULL;
+  if(copy_kicking) {
+    return;
+  }
+  copy_kicking = 1;
+  while(copy_owner == NULL && copy_waiters != NULL) {
+    hs = copy_waiters;
+    copy_waiters = hs->copy_next;
+    hs->copy_wait = 0;
+    serve(hs->pcb, hs);
+  }
+  copy_kicking = 0;
+}
 /*-----------------------------------------------------------------------------------*/
 static void
 conn_err(void *arg, err_t err)
@@ -60,10 +150,20 @@ conn_err(void *arg, err_t err)
   if(arg)
   {
       hs = arg;
+      /* The waiting connections are not served from here, since TCP
+         is part way through dropping this one; they take the buffer at
+         their next poll instead. */
+      if(copy_owner == hs) {
+        copy_owner = NULL;
+      }
+      copy_unwait(hs);
       if(hs->handle) {
         fs_close(hs->handle);
         hs->handle = NULL;
       }
+      if(hs->req) {
+        pbuf_free(hs->req);
+      }
       mem_free(hs);
   }
 }
@@ -71,47 +171,83 @@ conn_err(void *arg, err_t err)
 static void
 close_conn(struct tcp_pcb *pcb, struct http_state *hs)
 {
+  u8_t owner;
+
   tcp_arg(pcb, NULL);
   tcp_sent(pcb, NULL);
   tcp_recv(pcb, NULL);
+  owner = copy_owner == hs;
+  copy_unwait(hs);
   if(hs->handle) {
     fs_close(hs->handle);
     hs->handle = NULL;
   }
+  if(hs->req) {
+    pbuf_free(hs->req);
+  }
   mem_free(hs);
   tcp_close(pcb);
+  if(owner) {
+    copy_release();
+  }
 }
 /*-----------------------------------------------------------------------------------*/
-static void
+/* Finishes the current response.  The connection is closed unless it is
+   persistent, in which case it is left waiting for the next request.
+   Returns ERR_CLSD if the connection was closed, which frees hs. */
+static err_t
+end_response(struct tcp_pcb *pcb, struct http_state *hs)
+{
+  if(!hs->keepalive) {
+    close_conn(pcb, hs);
+    return ERR_CLSD;
+  }
+  fs_close(hs->handle);
+  hs->handle = NULL;
+  hs->retries = 0;
+  return ERR_OK;
+}
+/*-----------------------------------------------------------------------------------*/
+/* Queues as much of the current response as TCP will take.  Returns
+   ERR_CLSD if the connection was closed, which frees hs. */
+static err_t
 send_data(struct tcp_pcb *pcb, struct http_state *hs)
 {
   err_t err;
   u16_t len;
 
+  if(hs->handle == NULL) {
+    return ERR_OK;
+  }
+
   if(hs->left == 0)
   {
     int count;
-    static char buf[3][2*TCP_MSS];
-    static int index = 0;
-
-    count = 2*TCP_MSS;
-    hs->file = buf[index];
-    index++;
-    if(index > 2) {
-      index = 0;
+
+    /* A file in memory was queued in full from its data pointer, so
+       reaching the end of it is the end of the file. */
+    if(hs->handle->data != NULL) {
+      return end_response(pcb, hs);
     }
-    if(count > (2*pcb->mss)) {
-      count = 2*pcb->mss;
+
+    /* Wait for another connection to finish with the copy buffer. */
+    if(copy_owner != NULL) {
+      copy_wait(hs);
+      return ERR_OK;
     }
-    count = fs_read(hs->handle, hs->file, count);
+
+    count = fs_read(hs->handle, copy_buf, HTTPD_BUF_SIZE);
     if(count < 0)
     {
-      fs_close(hs->handle);
-      hs->handle = NULL;
-      close_conn(pcb, hs);
-      return;
+      return end_response(pcb, hs);
+    }
+    if(count == 0) {
+      return ERR_OK;
     }
+    hs->file = copy_buf;
     hs->left = count;
+    copy_unwait(hs);
+    copy_owner = hs;
   }
 
   /* We cannot send more data than space available in the send
@@ -126,8 +262,10 @@ send_data(struct tcp_pcb *pcb, struct http_state *hs)
     len = 2*pcb->mss;
   }
 
+  /* Data in the copy buffer has to be copied into the send queue, while
+     file data in memory is referenced by PBUF_ROM segments. */
   do {
-    err = tcp_write(pcb, hs->file, len, 0);
+    err = tcp_write(pcb, hs->file, len, copy_owner == hs);
     if (err == ERR_MEM) {
       len /= 2;
     }
@@ -137,9 +275,189 @@ send_data(struct tcp_pcb *pcb, struct http_state *hs)
     tcp_output(pcb);
     hs->file += len;
     hs->left -= len;
+    if(hs->left == 0 && copy_owner == hs) {
+      copy_release();
+    }
+
+    /* On a persistent connection the next response can be queued
+       behind this one as soon as all of it is in the send queue. */
+    if(hs->left == 0 && hs->keepalive && hs->handle->data != NULL) {
+      return end_response(pcb, hs);
+    }
   /*  } else {
     printf("send_data: error %s len %d %d\n", lwip_strerr(err), len, tcp_sndbuf(pcb));*/
   }
+  return ERR_OK;
+}
+/*-----------------------------------------------------------------------------------*/
+/* Frees the first len bytes of the received data, which have been
+   parsed, and opens the receive window by the same amount. */
+static void
+consume_request(struct tcp_pcb *pcb, struct http_state *hs, u16_t len)
+{
+  struct pbuf *q;
+
+  tcp_recved(pcb, len);
+  while(hs->req != NULL && hs->req->len <= len) {
+    len -= hs->req->len;
+    q = hs->req->next;
+    if(q != NULL) {
+      pbuf_ref(q);
+    }
+    pbuf_free(hs->req);
+    hs->req = q;
+  }
+  if(len > 0) {
+    pbuf_header(hs->req, -(s16_t)len);
+  }
+}
+/*-----------------------------------------------------------------------------------*/
+/* Opens the named file.  A client that accepts gzip is given the
+   compressed copy of the file that makefsdata stores under the name with
+   ".gz" added, if there is one.  A compressed file is never given to a
+   client that does not accept gzip. */
+static struct fs_file *
+open_file(char *name, u8_t gzip)
+{
+  struct fs_file *file;
+  char gzname[48];
+
+  if(gzip && strlen(name) + sizeof(".gz") <= sizeof(gzname)) {
+    strcpy(gzname, name);
+    strcat(gzname, ".gz");
+    file = fs_open(gzname);
+    if(file != NULL) {
+      if(file->flags & FS_FILE_FLAGS_GZIP) {
+        return file;
+      }
+      fs_close(file);
+    }
+  }
+
+  file = fs_open(name);
+  if(file != NULL && (file->flags & FS_FILE_FLAGS_GZIP) && !gzip) {
+    fs_close(file);
+    file = NULL;
+  }
+  return file;
+}
+/*-----------------------------------------------------------------------------------*/
+/* Answers the requests that have been received, in order, for as long as
+   there is no response in progress.  Returns ERR_CLSD if the connection
+   was closed, which frees hs. */
+static err_t
+parse_requests(struct tcp_pcb *pcb, struct http_state *hs)
+{
+  struct pbuf *q;
+  struct fs_file *file;
+  char line[64], name[41];
+  u16_t i, j, len, used, lines;
+  u8_t done, gzip, persistent;
+  char c;
+
+  while(hs->handle == NULL && hs->req != NULL) {
+    /* Look for the blank line that ends the next request, noting the
+       headers that matter on the way.  Header lines are lower cased, as
+       header names are not case sensitive; lines too long for the
+       buffer are cut short. */
+    name[0] = 0;
+    len = used = lines = 0;
+    done = gzip = persistent = 0;
+    for(q = hs->req; q != NULL && !done; q = q->next) {
+      for(i = 0; i < q->len && !done; i++) {
+        c = ((char *)q->payload)[i];
+        used++;
+        if(c != '\n') {
+          if(c != '\r' && len < sizeof(line) - 1) {
+            if(lines != 0 && c >= 'A' && c <= 'Z') {
+              c += 'a' - 'A';
+            }
+            line[len++] = c;
+          }
+          continue;
+        }
+        line[len] = 0;
+
+        if(lines == 0) {
+          /* Blank lines in front of a request are ignored. */
+          if(len == 0) {
+            continue;
+          }
+          if(strncmp(line, "GET ", 4) != 0) {
+            close_conn(pcb, hs);
+            return ERR_CLSD;
+          }
+          for(j = 0; j < sizeof(name) - 1 && line[4 + j] != ' ' &&
+                line[4 + j] != 0; j++) {
+            name[j] = line[4 + j];
+          }
+          name[j] = 0;
+
+          /* HTTP/1.1 connections are persistent unless the client asks
+             for the connection to be closed. */
+          persistent = strstr(line + 4, " HTTP/1.1") != NULL;
+        } else if(len == 0) {
+          done = 1;
+        } else if(strncmp(line, "connection:", 11) == 0) {
+          if(strstr(line + 11, "close") != NULL) {
+            persistent = 0;
+          }
+        } else if(strncmp(line, "accept-encoding:", 16) == 0) {
+          gzip = strstr(line + 16, "gzip") != NULL;
+        }
+        lines++;
+        len = 0;
+      }
+    }
+
+    if(!done) {
+      /* Wait for the rest of the request. */
+      if(hs->req->tot_len >= HTTPD_MAX_REQ_LEN) {
+        close_conn(pcb, hs);
+        return ERR_CLSD;
+      }
+      return ERR_OK;
+    }
+    consume_request(pcb, hs, used);
+
+    if (name[0] == '/' && name[1] == 0) {
+      file = open_file("/index.html", gzip);
+    } else {
+      file = open_file(name, gzip);
+      if(file == NULL) {
+        file = fs_open("/404.html");
+      }
+    }
+    if(file == NULL) {
+      close_conn(pcb, hs);
+      return ERR_CLSD;
+    }
+
+    hs->handle = file;
+    hs->file = file->data;
+    hs->left = file->len;
+    hs->retries = 0;
+
+    /* The client can only find the end of a response that is followed
+       by another if the response gives its length. */
+    hs->keepalive = persistent && (file->flags & FS_FILE_FLAGS_LENGTH);
+    /*    printf("data %p len %ld\n", hs->file, hs->left);*/
+
+    if(send_data(pcb, hs) != ERR_OK) {
+      return ERR_CLSD;
+    }
+  }
+  return ERR_OK;
+}
+/*-----------------------------------------------------------------------------------*/
+/* Continues the current response, and then answers any requests that
+   have been received behind it. */
+static void
+serve(struct tcp_pcb *pcb, struct http_state *hs)
+{
+  if(send_data(pcb, hs) == ERR_OK) {
+    parse_requests(pcb, hs);
+  }
 }
 /*-----------------------------------------------------------------------------------*/
 static err_t
@@ -155,12 +473,21 @@ http_poll(void *arg, struct tcp_pcb *pcb)
     tcp_abort(pcb);
     return ERR_ABRT;
   } else {
-    ++hs->retries;
-    if (hs->retries == 4) {
+    /* Time spent waiting for the copy buffer is not a stalled
+       connection. */
+    if (!hs->copy_wait) {
+      ++hs->retries;
+    }
+    if (hs->handle == NULL) {
+      if (hs->retries >= HTTPD_IDLE_POLLS) {
+        close_conn(pcb, hs);
+        return ERR_OK;
+      }
+    } else if (hs->retries == 4) {
       tcp_abort(pcb);
       return ERR_ABRT;
     }
-    send_data(pcb, hs);
+    serve(pcb, hs);
   }
 
   return ERR_OK;
@@ -175,7 +502,7 @@ http_sent(void *arg, struct tcp_pcb *pcb, u16_t len)
 
   hs->retries = 0;
 
-  send_data(pcb, hs);
+  serve(pcb, hs);
 
   return ERR_OK;
 }
@@ -183,57 +510,25 @@ http_sent(void *arg, struct tcp_pcb *pcb, u16_t len)
 static err_t
 http_recv(void *arg, struct tcp_pcb *pcb, struct pbuf *p, err_t err)
 {
-  int i;
-  char *data;
-  struct fs_file *file;
   struct http_state *hs;
 
   hs = arg;
 
   if (err == ERR_OK && p != NULL) {
 
-    /* Inform TCP that we have taken the data. */
-    tcp_recved(pcb, p->tot_len);
-
-    if (hs->handle == NULL) {
-      data = p->payload;
-
-      if (strncmp(data, "GET ", 4) == 0) {
-    for(i = 0; i < 40; i++) {
-      if (((char *)data + 4)[i] == ' ' ||
-         ((char *)data + 4)[i] == '\r' ||
-         ((char *)data + 4)[i] == '\n') {
-        ((char *)data + 4)[i] = 0;
-      }
-    }
-
-    if (*(char *)(data + 4) == '/' &&
-       *(char *)(data + 5) == 0) {
-      file = fs_open("/index.html");
+    /* Queue the data behind any requests that have not been answered
+       yet.  TCP is told that the data has been taken as each request is
+       parsed, so a client that sends requests faster than they are
+       answered is held back by the receive window. */
+    if (hs->req == NULL) {
+      hs->req = p;
     } else {
-        file = fs_open((char *)data + 4);
-        if(file == NULL) {
-          file = fs_open("/404.html");
-        }
+      pbuf_cat(hs->req, p);
     }
-    hs->handle = file;
-    hs->file = file->data;
-    hs->left = file->len;
-    hs->retries = 0;
-    /*    printf("data %p len %ld\n", hs->file, hs->left);*/
-
-    pbuf_free(p);
-    send_data(pcb, hs);
 
-    /* Tell TCP that we wish be to informed of data that has been
-       successfully sent by a call to the http_sent() function. */
-    tcp_sent(pcb, http_sent);
-      } else {
-    pbuf_free(p);
-    close_conn(pcb, hs);
-      }
-    } else {
-      pbuf_free(p);
+    if (hs->handle == NULL) {
+      hs->retries = 0;
+      parse_requests(pcb, hs);
     }
   }
 
@@ -264,6 +559,11 @@ http_accept(void *arg, struct tcp_pcb *pcb, err_t err)
   hs->file = NULL;
   hs->left = 0;
   hs->retries = 0;
+  hs->keepalive = 0;
+  hs->copy_wait = 0;
+  hs->req = NULL;
+  hs->pcb = pcb;
+  hs->copy_next = NULL;
 
   /* Tell TCP that this is the structure we wish to be passed for our
      callbacks. */
@@ -273,6 +573,10 @@ http_accept(void *arg, struct tcp_pcb *pcb, err_t err)
      to the http_recv() function. */
   tcp_recv(pcb, http_recv);
 
+  /* Tell TCP that we wish be to informed of data that has been
+     successfully sent by a call to the http_sent() function. */
+  tcp_sent(pcb, http_sent);
+
   tcp_err(pcb, conn_err);
 
   tcp_poll(pcb, http_poll, 4);
@@ -83,4 +83,11 @@ extern void __error__(char *pcFilename, unsigned long ulLine);
 #define LWIP_PLATFORM_ASSERT(expr)
 #endif
 
+//
+// Provide the prototype of the word at a time checksum, which is used in place
+// of the C version in inet.c when LWIP_CHKSUM is defined to InetChksum in
+// lwipopts.h.  utils/inetchksum.c must then be added to the application.
+//
+#include "../../../../utils/inetchksum.h"
+
 #endif /* __CC_H__ */
@@ -41,6 +41,36 @@ extern void getRxTime(TimeInternal *t);
 #error "PBUF_POOL_BUFSIZE must be modulo 4!"
 #endif
 
+//*****************************************************************************
+//
+// The largest frame that will be received, excluding the frame check sequence
+// (a full-sized Ethernet frame with an 802.1Q tag).
+//
+//*****************************************************************************
+#define ETH_MAX_FRAME_LEN       1518
+
+//*****************************************************************************
+//
+// The maximum number of pbufs in a chain that can be handed to the Ethernet
+// transmitter in one go.  Frames built from longer chains are dropped.  This
+// can be overridden in lwipopts.h.
+//
+//*****************************************************************************
+#ifndef ETHERNET_TX_SEGMENTS
+#define ETHERNET_TX_SEGMENTS    16
+#endif
+
+//*****************************************************************************
+//
+// The maximum number of pbufs in a chain that can be filled by the Ethernet
+// receiver in one go.  This must be enough to hold the largest frame in
+// PBUF_POOL_BUFSIZE sized pbufs, and can be overridden in lwipopts.h.
+//
+//*****************************************************************************
+#ifndef ETHERNET_RX_SEGMENTS
+#define ETHERNET_RX_SEGMENTS    16
+#endif
+
 //*****************************************************************************
 //
 // Ethernet Configuration Structure for this interface.
@@ -172,56 +202,49 @@ low_level_init(struct netif *netif)
 err_t
 low_level_output(struct netif *netif, struct pbuf *p)
 {
+    tEthSeg psSegs[ETHERNET_TX_SEGMENTS];
+    unsigned long ulNumSegs;
     struct pbuf *q;
-    int i;
-    unsigned char *pucBuf;
-    unsigned long ulTemp;
-    unsigned char *pucTemp = (unsigned char *)&ulTemp;
-
-    //
-    // Wait for space available in the TX FIFO.
-    //
-    while(!EthernetSpaceAvail(ETH_BASE))
-    {
-    }
-
-    //
-    // Fill in the first two bytes of the payload data (configured as padding
-    // with ETH_PAD_SIZE = 2) with the total length of the payload data
-    // (minus the Ethernet MAC layer header).
-    //
-    pucBuf = p->payload;
-    ulTemp = p->tot_len - 16;
-    *pucBuf++ = pucTemp[0];
-    *pucBuf++ = pucTemp[1];
 
     //
-    // Copy data from the pbuf(s) into the TX Fifo.
-    // For now, assume every pbuf is full, except possibly the last one.
+    // Build the list of segments that make up the frame, one per pbuf in the
+    // chain.  The first pbuf starts with ETH_PAD_SIZE bytes of padding that
+    // are not part of the frame.
     //
-    for(q = p; q != NULL; q = q->next)
+    psSegs[0].pucBuf = (unsigned char *)p->payload + ETH_PAD_SIZE;
+    psSegs[0].ulLen = p->len - ETH_PAD_SIZE;
+    ulNumSegs = 1;
+    for(q = p->next; q != NULL; q = q->next)
     {
-        pucBuf = q->payload;
+        //
+        // Skip any empty pbufs in the chain.
+        //
+        if(q->len == 0)
+        {
+            continue;
+        }
 
         //
-        // Send the data from the pbuf to the interface, one pbuf at a
-        // time. The size of the data in each pbuf is kept in the ->len
-        // variable.
+        // Drop the frame if the chain is too long to be described.
         //
-        for(i = 0; i < q->len; i += 4)
+        if(ulNumSegs == ETHERNET_TX_SEGMENTS)
         {
-            pucTemp[0] = *pucBuf++;
-            pucTemp[1] = *pucBuf++;
-            pucTemp[2] = *pucBuf++;
-            pucTemp[3] = *pucBuf++;
-            HWREG(ETH_BASE + MAC_O_DATA) = ulTemp;
+#if LINK_STATS
+            lwip_stats.link.drop++;
+#endif
+            return ERR_BUF;
         }
+
+        psSegs[ulNumSegs].pucBuf = q->payload;
+        psSegs[ulNumSegs].ulLen = q->len;
+        ulNumSegs++;
     }
 
     //
-    // Wakeup the transmitter.
+    // Send the frame straight from the pbufs.  This waits for the TX FIFO to
+    // be available and wakes up the transmitter.
     //
-    HWREG(ETH_BASE + MAC_O_TR) = MAC_TR_NEWTX;
+    EthernetPacketPutV(ETH_BASE, psSegs, ulNumSegs);
 
 #if LINK_STATS
     lwip_stats.link.xmit++;
@@ -239,12 +262,10 @@ low_level_output(struct netif *netif, struct pbuf *p)
 struct pbuf *
 low_level_input(struct netif *netif)
 {
+    tEthSeg psSegs[ETHERNET_RX_SEGMENTS];
+    unsigned long ulNumSegs;
     struct pbuf *p, *q;
-    u16_t len;
-    unsigned long ulTemp;
-    int i;
-    unsigned char *ptr;
-    unsigned char *pucTemp = (unsigned char *)&ulTemp;
+    long lLen;
 #if LWIP_PTPD
     TimeInternal tTimestamp;
 
@@ -255,95 +276,58 @@ low_level_input(struct netif *netif)
 #endif
 
     //
-    // Obtain the size of the packet and put it into the "len" variable.
-    // Note:  The length returned in the FIFO length position includes the
-    // two bytes for the length + the 4 bytes for the FCS.
+    // Get the length of the frame at the head of the FIFO.
     //
-    ulTemp = HWREG(ETH_BASE + MAC_O_DATA);
-    len = ulTemp & 0xFFFF;
+    lLen = EthernetPacketLenGet(ETH_BASE);
 
     //
-    // We allocate a pbuf chain of pbufs from the pool.
+    // Allocate a pbuf chain from the pool that is just large enough for the
+    // frame.  Frames that are empty or longer than the largest valid frame
+    // are dropped.
     //
-    p = pbuf_alloc(PBUF_RAW, len, PBUF_POOL);
+    p = NULL;
+    if((lLen > 0) && (lLen <= ETH_MAX_FRAME_LEN))
+    {
+        p = pbuf_alloc(PBUF_RAW, ETH_PAD_SIZE + lLen, PBUF_POOL);
+    }
 
     if(p != NULL)
     {
         //
-        // Place the first word into the first pbuf location.
+        // Build the list of segments to receive the frame, one per pbuf in
+        // the chain.  The first pbuf starts with ETH_PAD_SIZE bytes of
+        // padding, which places the IP header that follows the Ethernet
+        // header at a word boundary.
         //
-        *(unsigned long *)p->payload = ulTemp;
-        p->payload = (char *)(p->payload) + 4;
-        p->len -= 4;
-
-        //
-        // Process all but the last buffer in the pbuf chain.
-        //
-        q = p;
-        while(q->next != NULL)
+        psSegs[0].pucBuf = (unsigned char *)p->payload + ETH_PAD_SIZE;
+        psSegs[0].ulLen = p->len - ETH_PAD_SIZE;
+        ulNumSegs = 1;
+        for(q = p->next; (q != NULL) && (ulNumSegs < ETHERNET_RX_SEGMENTS);
+            q = q->next)
         {
-            //
-            // Setup a byte pointer into the payload section of the pbuf.
-            //
-            ptr = q->payload;
-
-            //
-            // Read data from FIFO into the current pbuf
-            // (assume pbuf length is modulo 4)
-            //
-            for(i = 0; i < q->len; i += 4)
-            {
-                ulTemp = HWREG(ETH_BASE + MAC_O_DATA);
-                *ptr++ = pucTemp[0];
-                *ptr++ = pucTemp[1];
-                *ptr++ = pucTemp[2];
-                *ptr++ = pucTemp[3];
-            }
-
-            //
-            // Link in the next pbuf in the chain.
-            //
-            q = q->next;
+            psSegs[ulNumSegs].pucBuf = q->payload;
+            psSegs[ulNumSegs].ulLen = q->len;
+            ulNumSegs++;
         }
 
         //
-        // Process the last pbuf in the list.
-        //
-        ptr = q->payload;
-
-        //
-        // Read data from FIFO into the current pbuf, omitting the
-        // last 1-3 bytes.
+        // Read the rest of the frame from the FIFO straight into the pbufs.
         //
-        for(i = 0; i < (q->len - 3); i += 4)
-        {
-            ulTemp = HWREG(ETH_BASE + MAC_O_DATA);
-            *ptr++ = pucTemp[0];
-            *ptr++ = pucTemp[1];
-            *ptr++ = pucTemp[2];
-            *ptr++ = pucTemp[3];
-        }
+        lLen = EthernetPacketDataGetV(ETH_BASE, psSegs, ulNumSegs);
 
         //
-        // If needed, get the last 1-3 bytes of data into the pbuf.
+        // Drop the frame if it did not fit into the pbuf chain.
         //
-        if(i < q->len)
+        if(lLen <= 0)
         {
-            ulTemp = HWREG(ETH_BASE + MAC_O_DATA);
-            while(i < q->len)
-            {
-                *ptr++ = ulTemp & 0xFF;
-                i++;
-                ulTemp = ulTemp >> 8;
-            }
+            pbuf_free(p);
+#if LINK_STATS
+            lwip_stats.link.lenerr++;
+            lwip_stats.link.drop++;
+#endif
+            return NULL;
         }
 
-        //
-        // Restore the first pbuf parameters to their original values.
-        //
-        p->payload = (char *)(p->payload) - 4;
-        p->len += 4;
-
 #if LINK_STATS
         lwip_stats.link.recv++;
 #endif
@@ -359,15 +343,19 @@ low_level_input(struct netif *netif)
     else
     {
         //
-        // Just read all of the remaining data from the FIFO and dump it.
+        // Just read the frame from the FIFO and dump it.
         //
-        for(i = 4; i < len; i+=4)
-        {
-            ulTemp = HWREG(ETH_BASE + MAC_O_DATA);
-        }
+        EthernetPacketDataGetV(ETH_BASE, 0, 0);
 
 #if LINK_STATS
-        lwip_stats.link.memerr++;
+        if((lLen <= 0) || (lLen > ETH_MAX_FRAME_LEN))
+        {
+            lwip_stats.link.lenerr++;
+        }
+        else
+        {
+            lwip_stats.link.memerr++;
+        }
         lwip_stats.link.drop++;
 #endif
     }
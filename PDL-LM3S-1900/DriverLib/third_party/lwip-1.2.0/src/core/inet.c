@@ -321,7 +321,7 @@ inet_chksum_pbuf(struct pbuf *p)
     }
     if (q->len % 2 != 0) {
       swapped = 1 - swapped;
-      acc = (acc & 0x00ffUL << 8) | (acc & 0xff00UL >> 8);
+      acc = ((acc & 0x00ffUL) << 8) | ((acc & 0xff00UL) >> 8);
     }
   }
 
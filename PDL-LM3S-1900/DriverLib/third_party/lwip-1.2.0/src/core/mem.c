@@ -84,10 +84,485 @@ static struct mem ram_heap[1 + ( (MEM_SIZE + sizeof(struct mem) - 1) / sizeof(st
                           (4 - (sizeof(struct mem) % MEM_ALIGNMENT))))
 #endif
 
-static struct mem *lfree;   /* pointer to the lowest free block */
-
 static sys_sem_t mem_sem;
 
+#if MEM_USE_TLSF
+/*
+ * Two level segregated fit heap.
+ *
+ * Each free block is kept on one of a number of lists chosen by its size.
+ * The first level splits the sizes into powers of two, and the second level
+ * splits each power of two into MEM_TLSF_SL_COUNT equal ranges.  A bitmap of
+ * the lists that are not empty is kept for each level, so mem_malloc() finds
+ * a list holding a large enough block with two bit scans.  Both mem_malloc()
+ * and mem_free() therefore take a bounded time however full or fragmented the
+ * heap is, and since mem_malloc() takes the smallest class that fits rather
+ * than the lowest block, the large free blocks are not carved up by small
+ * allocations.
+ *
+ * Blocks have the same header as the first fit heap.  The links of the list
+ * of a free block are kept in the block itself, and free blocks are always
+ * merged with their neighbours, so no two free blocks are adjacent.
+ */
+
+#define MEM_TLSF_SL_SHIFT 3
+#define MEM_TLSF_SL_COUNT (1 << MEM_TLSF_SL_SHIFT)
+
+#if MEM_ALIGNMENT == 1
+#define MEM_TLSF_ALIGN_SHIFT 0
+#elif MEM_ALIGNMENT == 2
+#define MEM_TLSF_ALIGN_SHIFT 1
+#elif MEM_ALIGNMENT == 4
+#define MEM_TLSF_ALIGN_SHIFT 2
+#elif MEM_ALIGNMENT == 8
+#define MEM_TLSF_ALIGN_SHIFT 3
+#endif /* MEM_ALIGNMENT */
+
+/* Blocks smaller than (1 << MEM_TLSF_FL_SHIFT) are all on the first of the
+   first level lists, in steps of MEM_ALIGNMENT. */
+#define MEM_TLSF_FL_SHIFT (MEM_TLSF_SL_SHIFT + MEM_TLSF_ALIGN_SHIFT)
+#define MEM_TLSF_FL_COUNT (sizeof(mem_size_t) * 8 - MEM_TLSF_FL_SHIFT + 1)
+
+/* A free block must be large enough to hold its list links. */
+#define MEM_TLSF_MIN_SIZE MEM_ALIGN_SIZE(MIN_SIZE)
+
+/* The list links of a free block, stored after its header. */
+struct mem_link {
+  mem_size_t next, prev;
+};
+
+#define MEM_LINK(mem) ((struct mem_link *)((u8_t *)(mem) + SIZEOF_STRUCT_MEM))
+
+/* The offset of the first block on each list, or MEM_SIZE if it is empty. */
+static mem_size_t mem_lists[MEM_TLSF_FL_COUNT][MEM_TLSF_SL_COUNT];
+static u32_t mem_fl_bitmap;
+static u8_t mem_sl_bitmap[MEM_TLSF_FL_COUNT];
+
+/**
+ * Return the index of the most significant bit set in x, which must not be
+ * zero.
+ */
+static u8_t
+mem_fls(u32_t x)
+{
+  u8_t bit = 0;
+
+  if (x & 0xffff0000) {
+    x >>= 16;
+    bit += 16;
+  }
+  if (x & 0xff00) {
+    x >>= 8;
+    bit += 8;
+  }
+  if (x & 0xf0) {
+    x >>= 4;
+    bit += 4;
+  }
+  if (x & 0xc) {
+    x >>= 2;
+    bit += 2;
+  }
+  if (x & 0x2) {
+    bit += 1;
+  }
+  return bit;
+}
+
+/**
+ * Return the index of the least significant bit set in x, which must not be
+ * zero.
+ */
+static u8_t
+mem_ffs(u32_t x)
+{
+  return mem_fls(x & (~x + 1));
+}
+
+/**
+ * Find the list that holds free blocks of the given size.
+ */
+static void
+mem_mapping(u32_t size, u8_t *fl, u8_t *sl)
+{
+  u8_t bit;
+
+  if (size < (1 << MEM_TLSF_FL_SHIFT)) {
+    *fl = 0;
+    *sl = (u8_t)(size >> MEM_TLSF_ALIGN_SHIFT);
+  } else {
+    bit = mem_fls(size);
+    *fl = bit - MEM_TLSF_FL_SHIFT + 1;
+    *sl = (u8_t)((size >> (bit - MEM_TLSF_SL_SHIFT)) - MEM_TLSF_SL_COUNT);
+  }
+}
+
+/**
+ * Put a free block on the list for its size.
+ */
+static void
+mem_insert(struct mem *mem)
+{
+  struct mem_link *link;
+  mem_size_t ptr;
+  u8_t fl, sl;
+
+  ptr = (u8_t *)mem - ram;
+  mem_mapping(mem->next - ptr - SIZEOF_STRUCT_MEM, &fl, &sl);
+
+  link = MEM_LINK(mem);
+  link->next = mem_lists[fl][sl];
+  link->prev = MEM_SIZE;
+  if (link->next != MEM_SIZE) {
+    MEM_LINK(&ram[link->next])->prev = ptr;
+  }
+  mem_lists[fl][sl] = ptr;
+  mem_fl_bitmap |= (u32_t)1 << fl;
+  mem_sl_bitmap[fl] |= 1 << sl;
+
+#if MEM_STATS
+  ++lwip_stats.mem.free_blocks;
+#endif /* MEM_STATS */
+}
+
+/**
+ * Take a free block off the list for its size.
+ */
+static void
+mem_remove(struct mem *mem)
+{
+  struct mem_link *link;
+  mem_size_t ptr;
+  u8_t fl, sl;
+
+  ptr = (u8_t *)mem - ram;
+  mem_mapping(mem->next - ptr - SIZEOF_STRUCT_MEM, &fl, &sl);
+
+  link = MEM_LINK(mem);
+  if (link->prev != MEM_SIZE) {
+    MEM_LINK(&ram[link->prev])->next = link->next;
+  } else {
+    mem_lists[fl][sl] = link->next;
+  }
+  if (link->next != MEM_SIZE) {
+    MEM_LINK(&ram[link->next])->prev = link->prev;
+  }
+  if (mem_lists[fl][sl] == MEM_SIZE) {
+    mem_sl_bitmap[fl] &= ~(1 << sl);
+    if (mem_sl_bitmap[fl] == 0) {
+      mem_fl_bitmap &= ~((u32_t)1 << fl);
+    }
+  }
+
+#if MEM_STATS
+  --lwip_stats.mem.free_blocks;
+#endif /* MEM_STATS */
+}
+
+/**
+ * Find a free block of at least size bytes, or return NULL if there is none.
+ * The size is rounded up to the next list boundary, so that any block on the
+ * list that is found is large enough.
+ */
+static struct mem *
+mem_find(mem_size_t size)
+{
+  struct mem *mem;
+  u32_t map;
+  u8_t fl, sl;
+
+  if (size < (1 << MEM_TLSF_FL_SHIFT)) {
+    mem_mapping(size, &fl, &sl);
+  } else {
+    mem_mapping(size + ((u32_t)1 << (mem_fls(size) - MEM_TLSF_SL_SHIFT)) - 1,
+                &fl, &sl);
+  }
+
+  map = 0;
+  if (fl < MEM_TLSF_FL_COUNT) {
+    map = mem_sl_bitmap[fl] & (~(u32_t)0 << sl);
+    if (map == 0) {
+      map = mem_fl_bitmap & (~(u32_t)0 << (fl + 1));
+      if (map != 0) {
+        fl = mem_ffs(map);
+        map = mem_sl_bitmap[fl];
+      }
+    }
+  }
+  if (map != 0) {
+    return (struct mem *)&ram[mem_lists[fl][mem_ffs(map)]];
+  }
+
+  /* Rounding up may have skipped a list that holds a large enough block.
+     Only the first block on it is tried, to keep the time bounded. */
+  mem_mapping(size, &fl, &sl);
+  if (mem_lists[fl][sl] != MEM_SIZE) {
+    mem = (struct mem *)&ram[mem_lists[fl][sl]];
+    if (mem->next - ((u8_t *)mem - ram) - SIZEOF_STRUCT_MEM >= size) {
+      return mem;
+    }
+  }
+  return NULL;
+}
+
+/**
+ * Merge a block that is no longer used with any free neighbours and put the
+ * result on its free list.
+ */
+static void
+mem_release(struct mem *mem)
+{
+  struct mem *nmem;
+  struct mem *pmem;
+
+  mem->used = 0;
+
+  /* merge with the next block */
+  nmem = (struct mem *)&ram[mem->next];
+  if (nmem != ram_end && nmem->used == 0) {
+    mem_remove(nmem);
+    mem->next = nmem->next;
+    if (mem->next != MEM_SIZE) {
+      ((struct mem *)&ram[mem->next])->prev = (u8_t *)mem - ram;
+    }
+  }
+
+  /* merge with the previous block */
+  pmem = (struct mem *)&ram[mem->prev];
+  if (pmem != mem && pmem->used == 0) {
+    mem_remove(pmem);
+    pmem->next = mem->next;
+    if (pmem->next != MEM_SIZE) {
+      ((struct mem *)&ram[pmem->next])->prev = (u8_t *)pmem - ram;
+    }
+    mem = pmem;
+  }
+
+  mem_insert(mem);
+}
+
+#if MEM_STATS
+/**
+ * Update the size of the largest free block.  This is the first block on the
+ * highest list that is not empty, which is the largest to within the range of
+ * sizes of one list.
+ */
+static void
+mem_stats_largest(void)
+{
+  struct mem *mem;
+  u8_t fl;
+
+  if (mem_fl_bitmap == 0) {
+    lwip_stats.mem.largest_free = 0;
+  } else {
+    fl = mem_fls(mem_fl_bitmap);
+    mem = (struct mem *)&ram[mem_lists[fl][mem_fls(mem_sl_bitmap[fl])]];
+    lwip_stats.mem.largest_free = mem->next - ((u8_t *)mem - ram) -
+      SIZEOF_STRUCT_MEM;
+  }
+}
+#endif /* MEM_STATS */
+
+void
+mem_init(void)
+{
+  struct mem *mem;
+  u8_t fl, sl;
+
+  ram = (u8_t*)ram_heap;
+  memset(ram, 0, MEM_SIZE);
+  mem = (struct mem *)ram;
+  mem->next = MEM_SIZE;
+  mem->prev = 0;
+  mem->used = 0;
+  ram_end = (struct mem *)&ram[MEM_SIZE];
+  ram_end->used = 1;
+  ram_end->next = MEM_SIZE;
+  ram_end->prev = MEM_SIZE;
+
+  mem_sem = sys_sem_new(1);
+
+  for (fl = 0; fl < MEM_TLSF_FL_COUNT; fl++) {
+    for (sl = 0; sl < MEM_TLSF_SL_COUNT; sl++) {
+      mem_lists[fl][sl] = MEM_SIZE;
+    }
+    mem_sl_bitmap[fl] = 0;
+  }
+  mem_fl_bitmap = 0;
+  mem_insert(mem);
+
+#if MEM_STATS
+  lwip_stats.mem.avail = MEM_SIZE;
+  mem_stats_largest();
+#endif /* MEM_STATS */
+}
+
+void
+mem_free(void *rmem)
+{
+  struct mem *mem;
+
+  if (rmem == NULL) {
+    LWIP_DEBUGF(MEM_DEBUG | DBG_TRACE | 2, ("mem_free(p == NULL) was called.\n"));
+    return;
+  }
+
+  sys_sem_wait(mem_sem);
+
+  LWIP_ASSERT("mem_free: legal memory", (u8_t *)rmem >= (u8_t *)ram &&
+    (u8_t *)rmem < (u8_t *)ram_end);
+
+  if ((u8_t *)rmem < (u8_t *)ram || (u8_t *)rmem >= (u8_t *)ram_end) {
+    LWIP_DEBUGF(MEM_DEBUG | 3, ("mem_free: illegal memory\n"));
+#if MEM_STATS
+    ++lwip_stats.mem.err;
+#endif /* MEM_STATS */
+    sys_sem_signal(mem_sem);
+    return;
+  }
+  mem = (struct mem *)((u8_t *)rmem - SIZEOF_STRUCT_MEM);
+
+  LWIP_ASSERT("mem_free: mem->used", mem->used);
+
+#if MEM_STATS
+  lwip_stats.mem.used -= mem->next - ((u8_t *)mem - ram);
+#endif /* MEM_STATS */
+  mem_release(mem);
+#if MEM_STATS
+  mem_stats_largest();
+#endif /* MEM_STATS */
+  sys_sem_signal(mem_sem);
+}
+
+void *
+mem_realloc(void *rmem, mem_size_t newsize)
+{
+  mem_size_t size;
+  mem_size_t ptr, ptr2;
+  struct mem *mem, *mem2;
+
+  if (newsize > MEM_SIZE) {
+    return NULL;
+  }
+
+  /* Only shrinking is supported, so a block that cannot be split is left as
+     it is. */
+  newsize = MEM_ALIGN_SIZE(newsize);
+  if (newsize < MEM_TLSF_MIN_SIZE) {
+    newsize = MEM_TLSF_MIN_SIZE;
+  }
+
+  sys_sem_wait(mem_sem);
+
+  LWIP_ASSERT("mem_realloc: legal memory", (u8_t *)rmem >= (u8_t *)ram &&
+   (u8_t *)rmem < (u8_t *)ram_end);
+
+  if ((u8_t *)rmem < (u8_t *)ram || (u8_t *)rmem >= (u8_t *)ram_end) {
+    LWIP_DEBUGF(MEM_DEBUG | 3, ("mem_realloc: illegal memory\n"));
+    sys_sem_signal(mem_sem);
+    return rmem;
+  }
+  mem = (struct mem *)((u8_t *)rmem - SIZEOF_STRUCT_MEM);
+
+  ptr = (u8_t *)mem - ram;
+
+  size = mem->next - ptr - SIZEOF_STRUCT_MEM;
+
+  if (newsize + SIZEOF_STRUCT_MEM + MEM_TLSF_MIN_SIZE <= size) {
+    ptr2 = ptr + SIZEOF_STRUCT_MEM + newsize;
+    mem2 = (struct mem *)&ram[ptr2];
+    mem2->next = mem->next;
+    mem2->prev = ptr;
+    mem->next = ptr2;
+    if (mem2->next != MEM_SIZE) {
+      ((struct mem *)&ram[mem2->next])->prev = ptr2;
+    }
+#if MEM_STATS
+    lwip_stats.mem.used -= (size - newsize);
+#endif /* MEM_STATS */
+
+    mem_release(mem2);
+#if MEM_STATS
+    mem_stats_largest();
+#endif /* MEM_STATS */
+  }
+  sys_sem_signal(mem_sem);
+  return rmem;
+}
+
+void *
+mem_malloc(mem_size_t size)
+{
+  mem_size_t ptr, ptr2;
+  struct mem *mem, *mem2;
+
+  if (size == 0) {
+    return NULL;
+  }
+
+  if (size > MEM_SIZE) {
+    return NULL;
+  }
+
+  /* Expand the size of the allocated memory region so that we can
+     adjust for alignment, and so that the block can be put on a free list
+     once it is freed. */
+  size = MEM_ALIGN_SIZE(size);
+  if (size < MEM_TLSF_MIN_SIZE) {
+    size = MEM_TLSF_MIN_SIZE;
+  }
+
+  sys_sem_wait(mem_sem);
+
+  mem = mem_find(size);
+  if (mem == NULL) {
+    LWIP_DEBUGF(MEM_DEBUG | 2, ("mem_malloc: could not allocate %"S16_F" bytes\n", (s16_t)size));
+#if MEM_STATS
+    ++lwip_stats.mem.err;
+#endif /* MEM_STATS */
+    sys_sem_signal(mem_sem);
+    return NULL;
+  }
+  mem_remove(mem);
+
+  /* Split off the remainder of the block if it is large enough to be a free
+     block of its own. */
+  ptr = (u8_t *)mem - ram;
+  if (mem->next - ptr - SIZEOF_STRUCT_MEM >=
+      size + SIZEOF_STRUCT_MEM + MEM_TLSF_MIN_SIZE) {
+    ptr2 = ptr + SIZEOF_STRUCT_MEM + size;
+    mem2 = (struct mem *)&ram[ptr2];
+    mem2->used = 0;
+    mem2->next = mem->next;
+    mem2->prev = ptr;
+    mem->next = ptr2;
+    if (mem2->next != MEM_SIZE) {
+      ((struct mem *)&ram[mem2->next])->prev = ptr2;
+    }
+    mem_insert(mem2);
+  }
+  mem->used = 1;
+
+#if MEM_STATS
+  lwip_stats.mem.used += mem->next - ptr;
+  if (lwip_stats.mem.max < lwip_stats.mem.used) {
+    lwip_stats.mem.max = lwip_stats.mem.used;
+  }
+  mem_stats_largest();
+#endif /* MEM_STATS */
+  sys_sem_signal(mem_sem);
+  LWIP_ASSERT("mem_malloc: allocated memory not above ram_end.",
+   (mem_ptr_t)mem + SIZEOF_STRUCT_MEM + size <= (mem_ptr_t)ram_end);
+  LWIP_ASSERT("mem_malloc: allocated memory properly aligned.",
+   (unsigned long)((u8_t *)mem + SIZEOF_STRUCT_MEM) % MEM_ALIGNMENT == 0);
+  return (u8_t *)mem + SIZEOF_STRUCT_MEM;
+}
+
+#else /* MEM_USE_TLSF */
+
+static struct mem *lfree;   /* pointer to the lowest free block */
+
 static void
 plug_holes(struct mem *mem)
 {
@@ -410,5 +885,7 @@ mem_malloc(mem_size_t size)
 }
 #endif
 
+#endif /* MEM_USE_TLSF */
+
 #endif /* MEM_LIBC_MALLOC == 0 */
 
@@ -87,7 +87,9 @@ stats_display_mem(struct stats_mem *mem, char *name)
   LWIP_PLATFORM_DIAG(("avail: %"MEM_SIZE_F"\n\t", mem->avail)); 
   LWIP_PLATFORM_DIAG(("used: %"MEM_SIZE_F"\n\t", mem->used)); 
   LWIP_PLATFORM_DIAG(("max: %"MEM_SIZE_F"\n\t", mem->max)); 
-  LWIP_PLATFORM_DIAG(("err: %"MEM_SIZE_F"\n", mem->err));
+  LWIP_PLATFORM_DIAG(("err: %"MEM_SIZE_F"\n\t", mem->err));
+  LWIP_PLATFORM_DIAG(("free_blocks: %"MEM_SIZE_F"\n\t", mem->free_blocks));
+  LWIP_PLATFORM_DIAG(("largest_free: %"MEM_SIZE_F"\n", mem->largest_free));
   
 }
 
@@ -93,6 +93,14 @@ a lot of data that needs to be copied, this should be set high. */
 #define MEM_SIZE                        1600
 #endif
 
+/* MEM_USE_TLSF: use a two level segregated fit heap in place of the first
+   fit one.  mem_malloc() and mem_free() then take a bounded time however
+   full the heap is, and the number of free blocks and the size of the
+   largest one are kept in the heap statistics. */
+#ifndef MEM_USE_TLSF
+#define MEM_USE_TLSF                    0
+#endif
+
 #ifndef MEMP_SANITY_CHECK
 #define MEMP_SANITY_CHECK       0
 #endif
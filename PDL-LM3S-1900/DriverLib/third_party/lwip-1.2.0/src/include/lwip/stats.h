@@ -61,6 +61,10 @@ struct stats_mem {
   mem_size_t used;
   mem_size_t max;  
   mem_size_t err;
+
+  /* Fragmentation of the heap, only kept when MEM_USE_TLSF is set. */
+  mem_size_t free_blocks;
+  mem_size_t largest_free;
 };
 
 struct stats_pbuf {
@@ -32,3 +32,8 @@ extern const char http_gif[5];
 extern const char http_jpg[5];
 extern const char http_text[5];
 extern const char http_txt[5];
+extern const char http_accept_encoding[17];
+extern const char http_gzip[5];
+extern const char http_gz[4];
+extern const char http_content_encoding_gzip[25];
+extern const char http_vary[24];
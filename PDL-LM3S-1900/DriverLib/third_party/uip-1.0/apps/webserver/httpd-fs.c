@@ -44,7 +44,8 @@
 #include "httpd-fsdata.c"
 
 #if HTTPD_FS_STATISTICS
-static u16_t count[HTTPD_FS_NUMFILES];
+/* The access counts are indexed by the hash table slot of each file. */
+static u16_t count[HTTPD_FS_HASH_SIZE];
 #endif /* HTTPD_FS_STATISTICS */
 
 /*-----------------------------------------------------------------------------------*/
@@ -55,10 +56,11 @@ httpd_fs_strcmp(const char *str1, const char *str2)
   i = 0;
  loop:
 
-  if(str2[i] == 0 ||
-     str1[i] == '\r' ||
-     str1[i] == '\n') {
-    return 0;
+  if(str2[i] == 0) {
+    return !(str1[i] == 0 ||
+             str1[i] == '\r' ||
+             str1[i] == '\n' ||
+             str1[i] == '?');
   }
 
   if(str1[i] != str2[i]) {
@@ -70,30 +72,39 @@ httpd_fs_strcmp(const char *str1, const char *str2)
   goto loop;
 }
 /*-----------------------------------------------------------------------------------*/
+/* Returns the slot of the hash table in which the named file would be
+   found.  The name ends at the end of the string or line, or at the start
+   of a query string, and the hash must match the one in makefsdata, which
+   is kept to 32 bits whatever the size of a long. */
+static u16_t
+httpd_fs_slot(const char *name)
+{
+  unsigned long h;
+
+  h = HTTPD_FS_HASH_SEED;
+  while(*name != 0 && *name != '\r' && *name != '\n' && *name != '?') {
+    h = (((h << 5) + h) ^ (unsigned char)*name++) & 0xffffffffUL;
+  }
+  h ^= h >> 16;
+  return h & (HTTPD_FS_HASH_SIZE - 1);
+}
+/*-----------------------------------------------------------------------------------*/
 int
 httpd_fs_open(const char *name, struct httpd_fs_file *file)
 {
-#if HTTPD_FS_STATISTICS
-  u16_t i = 0;
-#endif /* HTTPD_FS_STATISTICS */
+  u16_t i;
   struct httpd_fsdata_file_noconst *f;
 
-  for(f = (struct httpd_fsdata_file_noconst *)HTTPD_FS_ROOT;
-      f != NULL;
-      f = (struct httpd_fsdata_file_noconst *)f->next) {
-
-    if(httpd_fs_strcmp(name, f->name) == 0) {
-      file->data = f->data;
-      file->len = f->len;
-#if HTTPD_FS_STATISTICS
-      ++count[i];
-#endif /* HTTPD_FS_STATISTICS */
-      return 1;
-    }
+  i = httpd_fs_slot(name);
+  f = (struct httpd_fsdata_file_noconst *)httpd_fs_hash[i];
+  if(f != NULL && httpd_fs_strcmp(name, f->name) == 0) {
+    file->data = f->data;
+    file->len = f->len;
+    file->flags = f->flags;
 #if HTTPD_FS_STATISTICS
-    ++i;
+    ++count[i];
 #endif /* HTTPD_FS_STATISTICS */
-
+    return 1;
   }
   return 0;
 }
@@ -103,7 +114,7 @@ httpd_fs_init(void)
 {
 #if HTTPD_FS_STATISTICS
   u16_t i;
-  for(i = 0; i < HTTPD_FS_NUMFILES; i++) {
+  for(i = 0; i < HTTPD_FS_HASH_SIZE; i++) {
     count[i] = 0;
   }
 #endif /* HTTPD_FS_STATISTICS */
@@ -116,15 +127,10 @@ u16_t httpd_fs_count
   struct httpd_fsdata_file_noconst *f;
   u16_t i;
 
-  i = 0;
-  for(f = (struct httpd_fsdata_file_noconst *)HTTPD_FS_ROOT;
-      f != NULL;
-      f = (struct httpd_fsdata_file_noconst *)f->next) {
-
-    if(httpd_fs_strcmp(name, f->name) == 0) {
-      return count[i];
-    }
-    ++i;
+  i = httpd_fs_slot(name);
+  f = (struct httpd_fsdata_file_noconst *)httpd_fs_hash[i];
+  if(f != NULL && httpd_fs_strcmp(name, f->name) == 0) {
+    return count[i];
   }
   return 0;
 }
@@ -40,8 +40,17 @@
 struct httpd_fs_file {
   char *data;
   int len;
+  int flags;
 };
 
+/* The file is stored gzip compressed, and may only be sent to a client
+   that accepts gzip.  makefsdata stores it under the name of the file
+   with ".gz" added. */
+#define HTTPD_FS_FLAGS_GZIP 0x01
+/* The file also has a compressed copy, so the response depends on the
+   encodings that the client accepts. */
+#define HTTPD_FS_FLAGS_VARY 0x02
+
 /* file must be allocated by caller and will be filled in
    by the function. */
 int httpd_fs_open(const char *name, struct httpd_fs_file *file);
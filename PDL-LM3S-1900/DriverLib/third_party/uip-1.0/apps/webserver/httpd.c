@@ -67,6 +67,7 @@
 #define STATE_OUTPUT  1
 
 #define ISO_nl      0x0a
+#define ISO_cr      0x0d
 #define ISO_space   0x20
 #define ISO_bang    0x21
 #define ISO_percent 0x25
@@ -193,6 +194,13 @@ PT_THREAD(send_headers(struct httpd_state *s, const char *statushdr))
 
   PSOCK_SEND_STR(&s->sout, statushdr);
 
+  if(s->file.flags & HTTPD_FS_FLAGS_GZIP) {
+    PSOCK_SEND_STR(&s->sout, http_content_encoding_gzip);
+  }
+  if(s->file.flags & (HTTPD_FS_FLAGS_GZIP | HTTPD_FS_FLAGS_VARY)) {
+    PSOCK_SEND_STR(&s->sout, http_vary);
+  }
+
   ptr = strrchr(s->filename, ISO_period);
   if(ptr == NULL) {
     PSOCK_SEND_STR(&s->sout, http_content_type_binary);
@@ -213,6 +221,27 @@ PT_THREAD(send_headers(struct httpd_state *s, const char *statushdr))
   PSOCK_END(&s->sout);
 }
 /*---------------------------------------------------------------------------*/
+/* Opens the requested file.  A client that accepts gzip is given the
+   compressed copy of the file that makefsdata stores under the name with
+   ".gz" added, if there is one.  A compressed file is never given to a
+   client that does not accept gzip. */
+static int
+open_file(struct httpd_state *s)
+{
+  char name[sizeof(s->filename) + sizeof(http_gz)];
+
+  if(s->gzip) {
+    strncpy(name, s->filename, sizeof(s->filename));
+    name[sizeof(s->filename)] = 0;
+    strcat(name, http_gz);
+    if(httpd_fs_open(name, &s->file)) {
+      return 1;
+    }
+  }
+  return httpd_fs_open(s->filename, &s->file) &&
+    (s->gzip || !(s->file.flags & HTTPD_FS_FLAGS_GZIP));
+}
+/*---------------------------------------------------------------------------*/
 static
 PT_THREAD(handle_output(struct httpd_state *s))
 {
@@ -220,7 +249,7 @@ PT_THREAD(handle_output(struct httpd_state *s))
   
   PT_BEGIN(&s->outputpt);
  
-  if(!httpd_fs_open(s->filename, &s->file)) {
+  if(!open_file(s)) {
     httpd_fs_open(http_404_html, &s->file);
     strcpy(s->filename, http_404_html);
     PT_WAIT_THREAD(&s->outputpt,
@@ -271,14 +300,21 @@ PT_THREAD(handle_input(struct httpd_state *s))
 
   /*  httpd_log_file(uip_conn->ripaddr, s->filename);*/
   
-  s->state = STATE_OUTPUT;
-
   while(1) {
     PSOCK_READTO(&s->sin, ISO_nl);
 
     if(strncmp(s->inputbuf, http_referer, 8) == 0) {
       s->inputbuf[PSOCK_DATALEN(&s->sin) - 2] = 0;
       /*      httpd_log(&s->inputbuf[9]);*/
+    } else if(strncmp(s->inputbuf, http_accept_encoding, 16) == 0) {
+      s->inputbuf[PSOCK_DATALEN(&s->sin) - 1] = 0;
+      if(strstr(&s->inputbuf[16], http_gzip) != NULL) {
+	s->gzip = 1;
+      }
+    } else if(s->inputbuf[0] == ISO_cr || s->inputbuf[0] == ISO_nl) {
+      /* The response depends on the headers, so it is not started
+	 until all of them have been read. */
+      s->state = STATE_OUTPUT;
     }
   }
   
@@ -305,6 +341,7 @@ httpd_appcall(void)
     PSOCK_INIT(&s->sout, s->inputbuf, sizeof(s->inputbuf) - 1);
     PT_INIT(&s->outputpt);
     s->state = STATE_WAITING;
+    s->gzip = 0;
     /*    timer_set(&s->timer, CLOCK_SECOND * 100);*/
     s->timer = 0;
     handle_connection(s);
@@ -188,6 +188,28 @@ static u16_t lastport;       /* Keeps track of the last port used for
 				a new connection. */
 #endif /* UIP_ACTIVE_OPEN */
 
+#if UIP_CONN_HASH
+/* The hash chains and the free list hold connection indices plus one
+   in a u8_t, with zero marking the end. */
+#if UIP_CONNS > 255
+#error "UIP_CONN_HASH supports at most 255 connections (UIP_CONNS)"
+#endif /* UIP_CONNS > 255 */
+static u8_t uip_conn_hash[UIP_CONN_HASH_SIZE];
+                             /* The first connection (plus one) of
+				each hash chain, or zero if the chain
+				is empty. */
+static u8_t uip_conn_free;   /* The first unused connection (plus
+				one), or zero if there are none. */
+
+/* The ports and address are summed rather than XORed, since clients
+   tend to step their address and port together and the steps would
+   cancel, and the high byte is folded in since the fields are in
+   network byte order and the low byte of each changes least on a
+   little endian CPU. */
+#define UIP_CONN_HASH_SLOT(lport, rport, ripaddr) \
+  uip_conn_hash_slot((lport) + (rport) + (ripaddr)[0] + (ripaddr)[1])
+#endif /* UIP_CONN_HASH */
+
 /* Temporary variables. */
 u8_t uip_acc32[4];
 static u8_t c, opt;
@@ -375,6 +397,104 @@ uip_udpchksum(void)
 #endif /* UIP_UDP_CHECKSUMS */
 #endif /* UIP_ARCH_CHKSUM */
 /*---------------------------------------------------------------------------*/
+#if UIP_CONN_HASH
+/* Reduce the sum of the ports and remote IP address of a connection to
+   its hash chain. */
+static u16_t
+uip_conn_hash_slot(u16_t sum)
+{
+  return (u16_t)(sum + (sum >> 8)) % UIP_CONN_HASH_SIZE;
+}
+/*---------------------------------------------------------------------------*/
+/* Add a connection to the hash chain for its ports and remote IP
+   address. */
+static void
+uip_conn_hash_add(struct uip_conn *conn)
+{
+  u16_t slot = UIP_CONN_HASH_SLOT(conn->lport, conn->rport, conn->ripaddr);
+
+  conn->hnext = uip_conn_hash[slot];
+  uip_conn_hash[slot] = (conn - uip_conns) + 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Remove a connection from its hash chain. */
+static void
+uip_conn_hash_remove(struct uip_conn *conn)
+{
+  u8_t *link;
+
+  for(link = &uip_conn_hash[UIP_CONN_HASH_SLOT(conn->lport, conn->rport,
+					       conn->ripaddr)];
+      *link != 0 && *link != (conn - uip_conns) + 1;
+      link = &uip_conns[*link - 1].hnext) {
+  }
+  if(*link != 0) {
+    *link = conn->hnext;
+  }
+}
+#endif /* UIP_CONN_HASH */
+/*---------------------------------------------------------------------------*/
+/* Find an unused connection, or the oldest connection in TIME_WAIT if
+   there are none. */
+static struct uip_conn *
+uip_conn_alloc(void)
+{
+  register struct uip_conn *conn;
+
+#if UIP_CONN_HASH
+  if(uip_conn_free != 0) {
+    conn = &uip_conns[uip_conn_free - 1];
+    uip_conn_free = conn->hnext;
+    return conn;
+  }
+#endif /* UIP_CONN_HASH */
+
+  /* Unused connections are kept in the same table as used
+     connections, but unused ones have the tcpstate set to
+     CLOSED. Also, connections in TIME_WAIT are kept track of and
+     we'll use the oldest one if no CLOSED connections are
+     found. Thanks to Eddie C. Dost for a very nice algorithm for the
+     TIME_WAIT search. */
+  conn = 0;
+  for(c = 0; c < UIP_CONNS; ++c) {
+    if(uip_conns[c].tcpstateflags == UIP_CLOSED) {
+      conn = &uip_conns[c];
+      break;
+    }
+    if(uip_conns[c].tcpstateflags == UIP_TIME_WAIT) {
+      if(conn == 0 ||
+	 uip_conns[c].timer > conn->timer) {
+	conn = &uip_conns[c];
+      }
+    }
+  }
+
+#if UIP_CONN_HASH
+  /* With the free list empty, the connection is still in a hash
+     chain (a CLOSED connection found here was closed by the
+     application rather than by uIP). */
+  if(conn != 0) {
+    uip_conn_hash_remove(conn);
+  }
+#endif /* UIP_CONN_HASH */
+
+  return conn;
+}
+/*---------------------------------------------------------------------------*/
+/* Close a connection, putting it on the free list. */
+static void
+uip_conn_release(struct uip_conn *conn)
+{
+#if UIP_CONN_HASH
+  if(conn->tcpstateflags != UIP_CLOSED) {
+    uip_conn_hash_remove(conn);
+    conn->hnext = uip_conn_free;
+    uip_conn_free = (conn - uip_conns) + 1;
+  }
+#endif /* UIP_CONN_HASH */
+  conn->tcpstateflags = UIP_CLOSED;
+}
+/*---------------------------------------------------------------------------*/
 void
 uip_init(void)
 {
@@ -383,7 +503,15 @@ uip_init(void)
   }
   for(c = 0; c < UIP_CONNS; ++c) {
     uip_conns[c].tcpstateflags = UIP_CLOSED;
+#if UIP_CONN_HASH
+    uip_conns[c].hnext = c + 2;
+#endif /* UIP_CONN_HASH */
   }
+#if UIP_CONN_HASH
+  uip_conns[UIP_CONNS - 1].hnext = 0;
+  uip_conn_free = 1;
+  memset(uip_conn_hash, 0, sizeof(uip_conn_hash));
+#endif /* UIP_CONN_HASH */
 #if UIP_ACTIVE_OPEN
   lastport = 1024;
 #endif /* UIP_ACTIVE_OPEN */
@@ -406,7 +534,7 @@ uip_init(void)
 struct uip_conn *
 uip_connect(uip_ipaddr_t *ripaddr, u16_t rport)
 {
-  register struct uip_conn *conn, *cconn;
+  register struct uip_conn *conn;
   
   /* Find an unused local port. */
  again:
@@ -426,20 +554,7 @@ uip_connect(uip_ipaddr_t *ripaddr, u16_t rport)
     }
   }
 
-  conn = 0;
-  for(c = 0; c < UIP_CONNS; ++c) {
-    cconn = &uip_conns[c];
-    if(cconn->tcpstateflags == UIP_CLOSED) {
-      conn = cconn;
-      break;
-    }
-    if(cconn->tcpstateflags == UIP_TIME_WAIT) {
-      if(conn == 0 ||
-	 cconn->timer > conn->timer) {
-	conn = cconn;
-      }
-    }
-  }
+  conn = uip_conn_alloc();
 
   if(conn == 0) {
     return 0;
@@ -463,6 +578,9 @@ uip_connect(uip_ipaddr_t *ripaddr, u16_t rport)
   conn->lport = htons(lastport);
   conn->rport = rport;
   uip_ipaddr_copy(&conn->ripaddr, ripaddr);
+#if UIP_CONN_HASH
+  uip_conn_hash_add(conn);
+#endif /* UIP_CONN_HASH */
   
   return conn;
 }
@@ -730,7 +848,7 @@ uip_process(u8_t flag)
        uip_connr->tcpstateflags == UIP_FIN_WAIT_2) {
       ++(uip_connr->timer);
       if(uip_connr->timer == UIP_TIME_WAIT_TIMEOUT) {
-	uip_connr->tcpstateflags = UIP_CLOSED;
+	uip_conn_release(uip_connr);
       }
     } else if(uip_connr->tcpstateflags != UIP_CLOSED) {
       /* If the connection has outstanding data, we increase the
@@ -742,7 +860,7 @@ uip_process(u8_t flag)
 	     ((uip_connr->tcpstateflags == UIP_SYN_SENT ||
 	       uip_connr->tcpstateflags == UIP_SYN_RCVD) &&
 	      uip_connr->nrtx == UIP_MAXSYNRTX)) {
-	    uip_connr->tcpstateflags = UIP_CLOSED;
+	    uip_conn_release(uip_connr);
 
 	    /* We call UIP_APPCALL() with uip_flags set to
 	       UIP_TIMEDOUT to inform the application that the
@@ -1186,8 +1304,15 @@ uip_process(u8_t flag)
   
   /* Demultiplex this segment. */
   /* First check any active connections. */
+#if UIP_CONN_HASH
+  for(c = uip_conn_hash[UIP_CONN_HASH_SLOT(BUF->destport, BUF->srcport,
+					   BUF->srcipaddr)];
+      c != 0; c = uip_connr->hnext) {
+    uip_connr = &uip_conns[c - 1];
+#else /* UIP_CONN_HASH */
   for(uip_connr = &uip_conns[0]; uip_connr <= &uip_conns[UIP_CONNS - 1];
       ++uip_connr) {
+#endif /* UIP_CONN_HASH */
     if(uip_connr->tcpstateflags != UIP_CLOSED &&
        BUF->destport == uip_connr->lport &&
        BUF->srcport == uip_connr->rport &&
@@ -1270,25 +1395,8 @@ uip_process(u8_t flag)
      with a connection in LISTEN. In that case, we should create a new
      connection and send a SYNACK in return. */
  found_listen:
-  /* First we check if there are any connections avaliable. Unused
-     connections are kept in the same table as used connections, but
-     unused ones have the tcpstate set to CLOSED. Also, connections in
-     TIME_WAIT are kept track of and we'll use the oldest one if no
-     CLOSED connections are found. Thanks to Eddie C. Dost for a very
-     nice algorithm for the TIME_WAIT search. */
-  uip_connr = 0;
-  for(c = 0; c < UIP_CONNS; ++c) {
-    if(uip_conns[c].tcpstateflags == UIP_CLOSED) {
-      uip_connr = &uip_conns[c];
-      break;
-    }
-    if(uip_conns[c].tcpstateflags == UIP_TIME_WAIT) {
-      if(uip_connr == 0 ||
-	 uip_conns[c].timer > uip_connr->timer) {
-	uip_connr = &uip_conns[c];
-      }
-    }
-  }
+  /* First we check if there are any connections avaliable. */
+  uip_connr = uip_conn_alloc();
 
   if(uip_connr == 0) {
     /* All connections are used already, we drop packet and hope that
@@ -1309,6 +1417,9 @@ uip_process(u8_t flag)
   uip_connr->rport = BUF->srcport;
   uip_ipaddr_copy(uip_connr->ripaddr, BUF->srcipaddr);
   uip_connr->tcpstateflags = UIP_SYN_RCVD;
+#if UIP_CONN_HASH
+  uip_conn_hash_add(uip_connr);
+#endif /* UIP_CONN_HASH */
 
   uip_connr->snd_nxt[0] = iss[0];
   uip_connr->snd_nxt[1] = iss[1];
@@ -1387,7 +1498,7 @@ uip_process(u8_t flag)
      sequence number of this reset is wihtin our advertised window
      before we accept the reset. */
   if(BUF->flags & TCP_RST) {
-    uip_connr->tcpstateflags = UIP_CLOSED;
+    uip_conn_release(uip_connr);
     UIP_LOG("tcp: got reset, aborting connection.");
     uip_flags = UIP_ABORT;
     UIP_APPCALL();
@@ -1541,7 +1652,7 @@ uip_process(u8_t flag)
     uip_flags = UIP_ABORT;
     UIP_APPCALL();
     /* The connection is closed after we send the RST */
-    uip_conn->tcpstateflags = UIP_CLOSED;
+    uip_conn_release(uip_conn);
     goto reset;
 #endif /* UIP_ACTIVE_OPEN */
     
@@ -1649,7 +1760,7 @@ uip_process(u8_t flag)
       
       if(uip_flags & UIP_ABORT) {
 	uip_slen = 0;
-	uip_connr->tcpstateflags = UIP_CLOSED;
+	uip_conn_release(uip_connr);
 	BUF->flags = TCP_RST | TCP_ACK;
 	goto tcp_send_nodata;
       }
@@ -1722,7 +1833,7 @@ uip_process(u8_t flag)
     /* We can close this connection if the peer has acknowledged our
        FIN. This is indicated by the UIP_ACKDATA flag. */
     if(uip_flags & UIP_ACKDATA) {
-      uip_connr->tcpstateflags = UIP_CLOSED;
+      uip_conn_release(uip_connr);
       uip_flags = UIP_CLOSE;
       UIP_APPCALL();
     }
@@ -1175,6 +1175,11 @@ struct uip_conn {
   u8_t timer;         /**< The retransmission timer. */
   u8_t nrtx;          /**< The number of retransmissions for the last
 			 segment sent. */
+#if UIP_CONN_HASH
+  u8_t hnext;         /**< One more than the index of the next
+			 connection in the same hash chain, or on the
+			 free list, or zero for the last one. */
+#endif /* UIP_CONN_HASH */
 
   /** The application state. */
   uip_tcp_appstate_t appstate;
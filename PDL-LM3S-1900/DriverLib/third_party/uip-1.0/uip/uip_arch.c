@@ -0,0 +1,126 @@
+//*****************************************************************************
+//
+// uip_arch.c - Architecture specific checksum routines for uIP.
+//
+//*****************************************************************************
+
+//
+// These routines replace the portable checksum routines in uip.c when
+// UIP_ARCH_CHKSUM is set to 1 in uip-conf.h.  They use the word at a time
+// checksum in utils/inetchksum.c, which must also be added to the
+// application.
+//
+#include "uip.h"
+#include "uip_arch.h"
+#include "../../../utils/inetchksum.h"
+
+#if UIP_ARCH_CHKSUM
+
+//*****************************************************************************
+//
+// A pointer to the IP and TCP headers in the uIP buffer.
+//
+//*****************************************************************************
+#define BUF                     ((struct uip_tcpip_hdr *)&uip_buf[UIP_LLH_LEN])
+
+//*****************************************************************************
+//
+// Computes the Internet checksum of a buffer.
+//
+//*****************************************************************************
+u16_t
+uip_chksum(u16_t *data, u16_t len)
+{
+    return(InetChksum(data, len));
+}
+
+//*****************************************************************************
+//
+// Computes the checksum of the IP header in the uIP buffer.
+//
+//*****************************************************************************
+u16_t
+uip_ipchksum(void)
+{
+    u16_t usSum;
+
+    usSum = InetChksum(&uip_buf[UIP_LLH_LEN], UIP_IPH_LEN);
+    return((usSum == 0) ? 0xffff : usSum);
+}
+
+//*****************************************************************************
+//
+// Computes the checksum of the upper layer protocol header and data in the
+// uIP buffer, including the pseudo-header formed from the IP header.
+//
+//*****************************************************************************
+static u16_t
+UpperLayerChksum(u8_t ucProto)
+{
+    u16_t usLen, usSum;
+
+    //
+    // Get the length of the upper layer protocol header and data.
+    //
+#if UIP_CONF_IPV6
+    usLen = ((u16_t)(BUF->len[0]) << 8) + BUF->len[1];
+#else
+    usLen = (((u16_t)(BUF->len[0]) << 8) + BUF->len[1]) - UIP_IPH_LEN;
+#endif
+
+    //
+    // Sum the pseudo-header.  The protocol and length are summed as a single
+    // word, since their addition cannot carry.
+    //
+    usSum = InetChksumAdd(htons(usLen + ucProto), &BUF->srcipaddr[0],
+                          2 * sizeof(uip_ipaddr_t));
+
+    //
+    // Sum the upper layer protocol header and data.
+    //
+    usSum = InetChksumAdd(usSum, &uip_buf[UIP_IPH_LEN + UIP_LLH_LEN], usLen);
+
+    //
+    // Return the sum.
+    //
+    return((usSum == 0) ? 0xffff : usSum);
+}
+
+//*****************************************************************************
+//
+// Computes the ICMPv6 checksum of the packet in the uIP buffer.
+//
+//*****************************************************************************
+#if UIP_CONF_IPV6
+u16_t
+uip_icmp6chksum(void)
+{
+    return(UpperLayerChksum(UIP_PROTO_ICMP6));
+}
+#endif
+
+//*****************************************************************************
+//
+// Computes the TCP checksum of the packet in the uIP buffer.
+//
+//*****************************************************************************
+u16_t
+uip_tcpchksum(void)
+{
+    return(UpperLayerChksum(UIP_PROTO_TCP));
+}
+
+//*****************************************************************************
+//
+// Computes the UDP checksum of the packet in the uIP buffer.
+//
+//*****************************************************************************
+#if UIP_UDP_CHECKSUMS
+u16_t
+uip_udpchksum(void)
+{
+    return(UpperLayerChksum(UIP_PROTO_UDP));
+}
+#endif
+
+#endif // UIP_ARCH_CHKSUM
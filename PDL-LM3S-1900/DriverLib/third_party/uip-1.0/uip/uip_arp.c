@@ -100,6 +100,11 @@ struct arp_entry {
   u16_t ipaddr[2];
   struct uip_eth_addr ethaddr;
   u8_t time;
+#if UIP_ARP_HASH
+  /* The previous and next entries on the age list, or on the free
+     list (which only uses next). */
+  u16_t prev, next;
+#endif /* UIP_ARP_HASH */
 };
 
 static const struct uip_eth_addr broadcast_ethaddr =
@@ -108,13 +113,126 @@ static const u16_t broadcast_ipaddr[2] = {0xffff,0xffff};
 
 static struct arp_entry arp_table[UIP_ARPTAB_SIZE];
 static u16_t ipaddr[2];
+#if !UIP_ARP_HASH
 static u8_t i, c;
+#endif /* !UIP_ARP_HASH */
 
 static u8_t arptime;
+#if !UIP_ARP_HASH
 static u8_t tmpage;
+#endif /* !UIP_ARP_HASH */
+
+#if UIP_ARP_HASH
+/* The marker for the end of a list. */
+#define ARP_NONE 0xffff
+
+/* The hash table, in which each slot holds one more than the index of
+   an entry in arp_table[], or zero if the slot is empty. Collisions
+   are resolved by linear probing. */
+static u16_t arp_hash[UIP_ARP_HASH_SIZE];
+
+/* The entries in use, from the oldest to the most recently updated
+   (which is the order of their time stamps), and the unused entries. */
+static u16_t arp_oldest, arp_newest, arp_free;
+#endif /* UIP_ARP_HASH */
 
 #define BUF   ((struct arp_hdr *)&uip_buf[0])
 #define IPBUF ((struct ethip_hdr *)&uip_buf[0])
+
+#if UIP_ARP_HASH
+/*-----------------------------------------------------------------------------------*/
+/* Return the home slot of an IP address in the hash table. The last
+   two bytes of the address differ the most between hosts on the
+   local network, so they are folded into the low bits. */
+static u16_t
+arp_hash_slot(u16_t *ipaddr)
+{
+  u16_t h;
+
+  h = ipaddr[0] ^ ipaddr[1];
+  h ^= (h >> 8) | (h << 8);
+  return h % UIP_ARP_HASH_SIZE;
+}
+/*-----------------------------------------------------------------------------------*/
+/* Return the slot that holds the entry for an IP address, or the
+   empty slot where the entry would be inserted if there is none. */
+static u16_t
+arp_hash_find(u16_t *ipaddr)
+{
+  u16_t slot;
+
+  for(slot = arp_hash_slot(ipaddr);
+      arp_hash[slot] != 0 &&
+	!uip_ipaddr_cmp(ipaddr, arp_table[arp_hash[slot] - 1].ipaddr);
+      slot = (slot + 1) % UIP_ARP_HASH_SIZE) {
+  }
+  return slot;
+}
+/*-----------------------------------------------------------------------------------*/
+/* Unlink an entry from the age list. */
+static void
+arp_unlink(u16_t idx)
+{
+  struct arp_entry *tabptr = &arp_table[idx];
+
+  if(tabptr->prev == ARP_NONE) {
+    arp_oldest = tabptr->next;
+  } else {
+    arp_table[tabptr->prev].next = tabptr->next;
+  }
+  if(tabptr->next == ARP_NONE) {
+    arp_newest = tabptr->prev;
+  } else {
+    arp_table[tabptr->next].prev = tabptr->prev;
+  }
+}
+/*-----------------------------------------------------------------------------------*/
+/* Remove an entry from the hash table and the age list, and put it on
+   the free list. */
+static void
+arp_remove(u16_t idx)
+{
+  struct arp_entry *tabptr = &arp_table[idx];
+  u16_t slot, next, home;
+
+  /* Empty the slot of the entry, and move any later entries of the
+     probe sequence back into it if that does not take them before
+     their home slot, so that no entry is cut off from its home slot
+     by an empty slot. */
+  slot = arp_hash_find(tabptr->ipaddr);
+  for(next = (slot + 1) % UIP_ARP_HASH_SIZE; arp_hash[next] != 0;
+      next = (next + 1) % UIP_ARP_HASH_SIZE) {
+    home = arp_hash_slot(arp_table[arp_hash[next] - 1].ipaddr);
+    if(slot <= next ? (home <= slot || home > next) :
+       (home <= slot && home > next)) {
+      arp_hash[slot] = arp_hash[next];
+      slot = next;
+    }
+  }
+  arp_hash[slot] = 0;
+
+  /* Unlink the entry from the age list, and put it on the free
+     list. */
+  arp_unlink(idx);
+  memset(tabptr->ipaddr, 0, 4);
+  tabptr->next = arp_free;
+  arp_free = idx;
+}
+/*-----------------------------------------------------------------------------------*/
+/* Add an entry to the end of the age list. */
+static void
+arp_append(u16_t idx)
+{
+  arp_table[idx].prev = arp_newest;
+  arp_table[idx].next = ARP_NONE;
+  if(arp_newest == ARP_NONE) {
+    arp_oldest = idx;
+  } else {
+    arp_table[arp_newest].next = idx;
+  }
+  arp_newest = idx;
+}
+#endif /* UIP_ARP_HASH */
 /*-----------------------------------------------------------------------------------*/
 /**
  * Initialize the ARP module.
@@ -124,9 +242,22 @@ static u8_t tmpage;
 void
 uip_arp_init(void)
 {
+#if UIP_ARP_HASH
+  u16_t idx;
+
+  for(idx = 0; idx < UIP_ARPTAB_SIZE; ++idx) {
+    memset(arp_table[idx].ipaddr, 0, 4);
+    arp_table[idx].next = idx + 1;
+  }
+  arp_table[UIP_ARPTAB_SIZE - 1].next = ARP_NONE;
+  arp_free = 0;
+  arp_oldest = arp_newest = ARP_NONE;
+  memset(arp_hash, 0, sizeof(arp_hash));
+#else /* UIP_ARP_HASH */
   for(i = 0; i < UIP_ARPTAB_SIZE; ++i) {
     memset(arp_table[i].ipaddr, 0, 4);
   }
+#endif /* UIP_ARP_HASH */
 }
 /*-----------------------------------------------------------------------------------*/
 /**
@@ -144,6 +275,17 @@ uip_arp_timer(void)
   struct arp_entry *tabptr;
   
   ++arptime;
+#if UIP_ARP_HASH
+  /* The age list is in time stamp order, so the expired entries are
+     all at its start. */
+  while(arp_oldest != ARP_NONE) {
+    tabptr = &arp_table[arp_oldest];
+    if((u8_t)(arptime - tabptr->time) < UIP_ARP_MAXAGE) {
+      break;
+    }
+    arp_remove(arp_oldest);
+  }
+#else /* UIP_ARP_HASH */
   for(i = 0; i < UIP_ARPTAB_SIZE; ++i) {
     tabptr = &arp_table[i];
     if((tabptr->ipaddr[0] | tabptr->ipaddr[1]) != 0 &&
@@ -151,6 +293,7 @@ uip_arp_timer(void)
       memset(tabptr->ipaddr, 0, 4);
     }
   }
+#endif /* UIP_ARP_HASH */
 
 }
 /*-----------------------------------------------------------------------------------*/
@@ -158,6 +301,41 @@ static void
 uip_arp_update(u16_t *ipaddr, struct uip_eth_addr *ethaddr)
 {
   register struct arp_entry *tabptr;
+#if UIP_ARP_HASH
+  u16_t slot, idx;
+
+  /* If there is an entry for the IP address, update it and move it to
+     the end of the age list. */
+  slot = arp_hash_find(ipaddr);
+  if(arp_hash[slot] != 0) {
+    idx = arp_hash[slot] - 1;
+    tabptr = &arp_table[idx];
+    memcpy(tabptr->ethaddr.addr, ethaddr->addr, 6);
+    tabptr->time = arptime;
+    if(idx != arp_newest) {
+      arp_unlink(idx);
+      arp_append(idx);
+    }
+    return;
+  }
+
+  /* Otherwise, take an unused entry, or throw away the oldest entry if
+     there are none, and insert it in the hash table. Removing the
+     oldest entry may move other entries in the hash table, so the
+     slot is found again. */
+  if(arp_free == ARP_NONE) {
+    arp_remove(arp_oldest);
+    slot = arp_hash_find(ipaddr);
+  }
+  idx = arp_free;
+  tabptr = &arp_table[idx];
+  arp_free = tabptr->next;
+  arp_hash[slot] = idx + 1;
+  memcpy(tabptr->ipaddr, ipaddr, 4);
+  memcpy(tabptr->ethaddr.addr, ethaddr->addr, 6);
+  tabptr->time = arptime;
+  arp_append(idx);
+#else /* UIP_ARP_HASH */
   /* Walk through the ARP mapping table and try to find an entry to
      update. If none is found, the IP -> MAC address mapping is
      inserted in the ARP table. */
@@ -215,6 +393,7 @@ uip_arp_update(u16_t *ipaddr, struct uip_eth_addr *ethaddr)
   memcpy(tabptr->ipaddr, ipaddr, 4);
   memcpy(tabptr->ethaddr.addr, ethaddr->addr, 6);
   tabptr->time = arptime;
+#endif /* UIP_ARP_HASH */
 }
 /*-----------------------------------------------------------------------------------*/
 /**
@@ -354,6 +533,9 @@ void
 uip_arp_out(void)
 {
   struct arp_entry *tabptr;
+#if UIP_ARP_HASH
+  u16_t slot;
+#endif /* UIP_ARP_HASH */
   
   /* Find the destination IP address in the ARP table and construct
      the Ethernet header. If the destination IP addres isn't on the
@@ -377,6 +559,11 @@ uip_arp_out(void)
       uip_ipaddr_copy(ipaddr, IPBUF->destipaddr);
     }
       
+#if UIP_ARP_HASH
+    slot = arp_hash[arp_hash_find(ipaddr)];
+
+    if(slot == 0) {
+#else /* UIP_ARP_HASH */
     for(i = 0; i < UIP_ARPTAB_SIZE; ++i) {
       tabptr = &arp_table[i];
       if(uip_ipaddr_cmp(ipaddr, tabptr->ipaddr)) {
@@ -385,6 +572,7 @@ uip_arp_out(void)
     }
 
     if(i == UIP_ARPTAB_SIZE) {
+#endif /* UIP_ARP_HASH */
       /* The destination address was not in our ARP table, so we
 	 overwrite the IP packet with an ARP request. */
 
@@ -408,6 +596,10 @@ uip_arp_out(void)
       return;
     }
 
+#if UIP_ARP_HASH
+    tabptr = &arp_table[slot - 1];
+#endif /* UIP_ARP_HASH */
+
     /* Build an ethernet header. */
     memcpy(IPBUF->ethhdr.dest.addr, tabptr->ethaddr.addr, 6);
   }
@@ -247,6 +247,36 @@
 #define UIP_CONNS UIP_CONF_MAX_CONNECTIONS
 #endif /* UIP_CONF_MAX_CONNECTIONS */
 
+/**
+ * Use a hash table to find the connection of incoming TCP segments.
+ *
+ * If this option is set, the connections in use are kept in a hash
+ * table keyed on the port numbers and the remote IP address, and the
+ * unused connections are kept on a free list. Finding the connection
+ * of an incoming segment and allocating a connection then take the
+ * same time however large UIP_CONNS is, instead of requiring a scan
+ * of all connections. This uses one byte of RAM per connection and
+ * per hash table slot, and limits UIP_CONNS to 255.
+ *
+ * \hideinitializer
+ */
+#ifdef UIP_CONF_CONN_HASH
+#define UIP_CONN_HASH UIP_CONF_CONN_HASH
+#else /* UIP_CONF_CONN_HASH */
+#define UIP_CONN_HASH 0
+#endif /* UIP_CONF_CONN_HASH */
+
+/**
+ * The number of slots in the TCP connection hash table.
+ *
+ * \hideinitializer
+ */
+#ifdef UIP_CONF_CONN_HASH_SIZE
+#define UIP_CONN_HASH_SIZE UIP_CONF_CONN_HASH_SIZE
+#else /* UIP_CONF_CONN_HASH_SIZE */
+#define UIP_CONN_HASH_SIZE UIP_CONNS
+#endif /* UIP_CONF_CONN_HASH_SIZE */
+
 
 /**
  * The maximum number of simultaneously listening TCP ports.
@@ -357,6 +387,40 @@
  */
 #define UIP_ARP_MAXAGE 120
 
+/**
+ * Use a hash table to find ARP table entries.
+ *
+ * If this option is set, the ARP table entries are found through an
+ * open-addressed hash table keyed on the IP address, and are kept on
+ * a list ordered by the time that they were last updated. The oldest
+ * entry is evicted from the head of the list when the table is full,
+ * and uip_arp_timer() only looks at the entries that have expired, so
+ * the time taken by the ARP functions does not grow with
+ * UIP_ARPTAB_SIZE. This uses 4 bytes of RAM per ARP table entry and
+ * 2 bytes per hash table slot in addition to the ARP table.
+ *
+ * \hideinitializer
+ */
+#ifdef UIP_CONF_ARP_HASH
+#define UIP_ARP_HASH UIP_CONF_ARP_HASH
+#else
+#define UIP_ARP_HASH 0
+#endif
+
+/**
+ * The number of slots in the ARP hash table.
+ *
+ * This must be larger than UIP_ARPTAB_SIZE; the default of twice the
+ * size of the ARP table keeps the probe sequences short.
+ *
+ * \hideinitializer
+ */
+#ifdef UIP_CONF_ARP_HASH_SIZE
+#define UIP_ARP_HASH_SIZE UIP_CONF_ARP_HASH_SIZE
+#else
+#define UIP_ARP_HASH_SIZE (2 * UIP_ARPTAB_SIZE)
+#endif
+
 /** @} */
 
 /*------------------------------------------------------------------------------*/
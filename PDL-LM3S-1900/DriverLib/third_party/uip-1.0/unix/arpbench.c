@@ -0,0 +1,211 @@
+/*
+ * arpbench.c - Benchmark of the ARP table lookups.
+ *
+ * The benchmark fills the ARP table with replies from as many hosts
+ * as it holds, checks that every host resolves to its own Ethernet
+ * address, and then times uip_arp_out() for outgoing packets spread
+ * evenly over the hosts, the ARP replies that refresh their entries,
+ * and uip_arp_timer() on a full table in which nothing expires.
+ *
+ * Build with "make arpbench", which builds arpbench with the linear
+ * search of the ARP table and arpbench-hash with UIP_ARP_HASH set.
+ * The size of the table is set with ARPBENCH_SIZE, for example "make
+ * arpbench ARPBENCH_SIZE=200".
+ */
+
+/* uip.h comes first, as in main.c: uip-conf.h sets the byte order
+   to LITTLE_ENDIAN, which the C library headers would otherwise
+   define to the value of UIP_BIG_ENDIAN. */
+#include "uip.h"
+#include "uip_arp.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if !UIP_ARP_HASH && UIP_ARPTAB_SIZE > 255
+#error "the linear ARP table search supports at most 255 entries"
+#endif
+
+/* The ARP packet and the Ethernet and IP headers, as in uip_arp.c. */
+struct arp_hdr {
+  struct uip_eth_hdr ethhdr;
+  u16_t hwtype;
+  u16_t protocol;
+  u8_t hwlen;
+  u8_t protolen;
+  u16_t opcode;
+  struct uip_eth_addr shwaddr;
+  u16_t sipaddr[2];
+  struct uip_eth_addr dhwaddr;
+  u16_t dipaddr[2];
+};
+
+struct ethip_hdr {
+  struct uip_eth_hdr ethhdr;
+  u8_t vhl, tos, len[2], ipid[2], ipoffset[2], ttl, proto;
+  u16_t ipchksum;
+  u16_t srcipaddr[2], destipaddr[2];
+};
+
+#define BUF   ((struct arp_hdr *)&uip_buf[0])
+#define IPBUF ((struct ethip_hdr *)&uip_buf[0])
+
+/* The number of times that each host is looked up or refreshed, and
+   the number of times that uip_arp_timer() is run for half of the
+   maximum age of an entry. */
+#define OUT_ROUNDS    (20000000 / UIP_ARPTAB_SIZE)
+#define UPDATE_ROUNDS (10000000 / UIP_ARPTAB_SIZE)
+#define TIMER_ROUNDS  20000
+#define TIMER_CALLS   (UIP_ARP_MAXAGE / 2)
+
+/*---------------------------------------------------------------------------*/
+static double
+now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+/*---------------------------------------------------------------------------*/
+/* Sets the IP address of host i, which is on the local network. */
+static void
+host_ipaddr(u16_t *addr, int i)
+{
+  uip_ipaddr(addr, 10, 0, (i + 2) >> 8, (i + 2) & 0xff);
+}
+/*---------------------------------------------------------------------------*/
+/* Hands uIP an ARP reply from host i, whose Ethernet address ends in
+   the host number. */
+static void
+input_reply(int i)
+{
+  memset(uip_buf, 0, sizeof(struct arp_hdr));
+  BUF->ethhdr.type = HTONS(UIP_ETHTYPE_ARP);
+  BUF->hwtype = HTONS(1);
+  BUF->protocol = HTONS(UIP_ETHTYPE_IP);
+  BUF->hwlen = 6;
+  BUF->protolen = 4;
+  BUF->opcode = HTONS(2);
+  BUF->shwaddr.addr[0] = 0x02;
+  BUF->shwaddr.addr[4] = i >> 8;
+  BUF->shwaddr.addr[5] = i & 0xff;
+  host_ipaddr(BUF->sipaddr, i);
+  uip_ipaddr_copy(BUF->dipaddr, uip_hostaddr);
+
+  uip_len = sizeof(struct arp_hdr);
+  uip_arp_arpin();
+}
+/*---------------------------------------------------------------------------*/
+/* Hands uip_arp_out() an IP packet for host i, returning 1 if the
+   Ethernet header was filled in with the host's address, 0 if an ARP
+   request was made instead, or -1 if the wrong address was used. */
+static int
+output_packet(int i)
+{
+  memset(uip_buf, 0, sizeof(struct ethip_hdr));
+  IPBUF->vhl = 0x45;
+  host_ipaddr(IPBUF->destipaddr, i);
+
+  uip_len = UIP_LLH_LEN + UIP_TCPIP_HLEN;
+  uip_arp_out();
+  if(IPBUF->ethhdr.type == HTONS(UIP_ETHTYPE_ARP)) {
+    return 0;
+  }
+  return (IPBUF->ethhdr.dest.addr[4] == (i >> 8) &&
+	  IPBUF->ethhdr.dest.addr[5] == (i & 0xff)) ? 1 : -1;
+}
+/*---------------------------------------------------------------------------*/
+int
+main(void)
+{
+  uip_ipaddr_t ipaddr;
+  double start, outs, updates, timers;
+  long round;
+  int i, j;
+
+  uip_init();
+  uip_arp_init();
+  uip_ipaddr(ipaddr, 10,0,0,1);
+  uip_sethostaddr(ipaddr);
+  uip_ipaddr(ipaddr, 255,255,0,0);
+  uip_setnetmask(ipaddr);
+
+  printf("ARP table: %s, %d entries\n",
+	 UIP_ARP_HASH ? "hash" : "linear search", UIP_ARPTAB_SIZE);
+
+  /* Fill the table, and check that every host resolves. */
+  for(i = 0; i < UIP_ARPTAB_SIZE; i++) {
+    input_reply(i);
+  }
+  for(i = 0; i < UIP_ARPTAB_SIZE; i++) {
+    if(output_packet(i) != 1) {
+      printf("arpbench: host %d was not resolved\n", i);
+      return 1;
+    }
+  }
+
+  /* A host that is not in the table needs an ARP request. */
+  if(output_packet(UIP_ARPTAB_SIZE) != 0) {
+    printf("arpbench: unknown host was resolved\n");
+    return 1;
+  }
+
+  /* Time the lookups of outgoing packets. */
+  start = now();
+  for(round = 0; round < OUT_ROUNDS; round++) {
+    for(i = 0; i < UIP_ARPTAB_SIZE; i++) {
+      if(output_packet(i) != 1) {
+	printf("arpbench: host %d was not resolved\n", i);
+	return 1;
+      }
+    }
+  }
+  outs = now() - start;
+
+  /* Time the replies that refresh the entries. */
+  start = now();
+  for(round = 0; round < UPDATE_ROUNDS; round++) {
+    for(i = 0; i < UIP_ARPTAB_SIZE; i++) {
+      input_reply(i);
+    }
+  }
+  updates = now() - start;
+
+  /* Time the timer. The entries are refreshed (untimed) before they
+     can expire, so the table stays full. */
+  timers = 0;
+  for(round = 0; round < TIMER_ROUNDS; round++) {
+    for(i = 0; i < UIP_ARPTAB_SIZE; i++) {
+      input_reply(i);
+    }
+    start = now();
+    for(j = 0; j < TIMER_CALLS; j++) {
+      uip_arp_timer();
+    }
+    timers += now() - start;
+  }
+
+  for(i = 0; i < UIP_ARPTAB_SIZE; i++) {
+    if(output_packet(i) != 1) {
+      printf("arpbench: host %d expired\n", i);
+      return 1;
+    }
+  }
+
+  printf("  uip_arp_out():   %.1f ns\n",
+	 outs * 1e9 / ((double)OUT_ROUNDS * UIP_ARPTAB_SIZE));
+  printf("  ARP reply:       %.1f ns\n",
+	 updates * 1e9 / ((double)UPDATE_ROUNDS * UIP_ARPTAB_SIZE));
+  printf("  uip_arp_timer(): %.1f ns\n",
+	 timers * 1e9 / ((double)TIMER_ROUNDS * TIMER_CALLS));
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+void
+uip_log(char *m)
+{
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,232 @@
+/*
+ * connbench.c - Packets per second benchmark for the demultiplexing
+ * of incoming TCP segments.
+ *
+ * The benchmark opens every connection slot to the web server from a
+ * different client, then feeds uip_input() a stream of pure ACKs
+ * spread evenly over the connections. Each ACK has to be matched to
+ * its connection but then needs no further work, so the rate at
+ * which they are processed shows the cost of finding the connection.
+ * The rate at which connections can be opened and reset is measured
+ * as well, which includes finding a free connection slot.
+ *
+ * Both are measured twice: with each client on its own host using
+ * its own port, and with every client on one host using sequential
+ * ports, as a browser opening several connections would.
+ *
+ * Build with "make bench", which builds connbench with the linear
+ * scan of uip_conns[] and connbench-hash with UIP_CONN_HASH set.
+ */
+
+/* uip.h comes first, as in main.c: uip-conf.h sets the byte order
+   to LITTLE_ENDIAN, which the C library headers would otherwise
+   define to the value of UIP_BIG_ENDIAN. */
+#include "uip.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BUF ((struct uip_tcpip_hdr *)&uip_buf[UIP_LLH_LEN])
+
+/* The TCP flags used by the benchmark. */
+#define TCP_SYN 0x02
+#define TCP_RST 0x04
+#define TCP_ACK 0x10
+
+/* The number of ACKs sent per connection, and the number of times
+   that every connection is reset and opened again. */
+#define ACK_ROUNDS  100000
+#define OPEN_ROUNDS 2000
+
+/* The sequence numbers of each client and of the server on each
+   connection. */
+static unsigned long client_seq[UIP_CONNS], server_seq[UIP_CONNS];
+
+/* The number of messages logged by uIP. */
+static unsigned long log_messages;
+
+/* Set when every client is on the same host. */
+static int one_host;
+
+/*---------------------------------------------------------------------------*/
+static void
+put32(u8_t *p, unsigned long n)
+{
+  p[0] = n >> 24;
+  p[1] = n >> 16;
+  p[2] = n >> 8;
+  p[3] = n;
+}
+/*---------------------------------------------------------------------------*/
+static unsigned long
+get32(const u8_t *p)
+{
+  return ((unsigned long)p[0] << 24) | ((unsigned long)p[1] << 16) |
+    ((unsigned long)p[2] << 8) | p[3];
+}
+/*---------------------------------------------------------------------------*/
+static double
+now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+/*---------------------------------------------------------------------------*/
+/* Builds a segment without data from client i to the web server in
+   uip_buf, and hands it to uIP. */
+static void
+input_segment(int i, u8_t flags)
+{
+  memset(uip_buf, 0, UIP_LLH_LEN + UIP_TCPIP_HLEN);
+  BUF->vhl = 0x45;
+  BUF->len[1] = UIP_TCPIP_HLEN;
+  BUF->ttl = UIP_TTL;
+  BUF->proto = UIP_PROTO_TCP;
+  if(one_host) {
+    uip_ipaddr(BUF->srcipaddr, 10, 0, 0, 1);
+    BUF->srcport = HTONS(49152 + i);
+  } else {
+    uip_ipaddr(BUF->srcipaddr, 10, 0, i >> 8, i & 0xff);
+    BUF->srcport = HTONS(1024 + i);
+  }
+  uip_ipaddr_copy(BUF->destipaddr, uip_hostaddr);
+  BUF->destport = HTONS(80);
+  put32(BUF->seqno, client_seq[i]);
+  if(flags & TCP_ACK) {
+    put32(BUF->ackno, server_seq[i]);
+  }
+  BUF->tcpoffset = 5 << 4;
+  BUF->flags = flags;
+  BUF->wnd[0] = UIP_RECEIVE_WINDOW >> 8;
+  BUF->wnd[1] = UIP_RECEIVE_WINDOW & 0xff;
+  BUF->ipchksum = ~(uip_ipchksum());
+  BUF->tcpchksum = ~(uip_tcpchksum());
+
+  uip_len = UIP_LLH_LEN + UIP_TCPIP_HLEN;
+  uip_input();
+}
+/*---------------------------------------------------------------------------*/
+/* Opens a connection from client i with a SYN and the ACK of the
+   server's SYN-ACK. */
+static void
+open_conn(int i)
+{
+  client_seq[i] = 1000 + i;
+  input_segment(i, TCP_SYN);
+  if(uip_len == 0 || BUF->flags != (TCP_SYN | TCP_ACK)) {
+    printf("connbench: client %d got no SYN-ACK\n", i);
+    exit(1);
+  }
+  client_seq[i]++;
+  server_seq[i] = get32(BUF->seqno) + 1;
+  input_segment(i, TCP_ACK);
+  if(uip_len != 0) {
+    printf("connbench: client %d was not connected\n", i);
+    exit(1);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Checks that every connection is established with its client. */
+static void
+check_conns(void)
+{
+  int i, n;
+
+  for(i = 0, n = 0; i < UIP_CONNS; i++) {
+    if((uip_conns[i].tcpstateflags & UIP_TS_MASK) == UIP_ESTABLISHED) {
+      n++;
+    }
+  }
+  if(n != UIP_CONNS) {
+    printf("connbench: %d of %d connections established\n", n, UIP_CONNS);
+    exit(1);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Runs the benchmark with the clients set up by one_host. */
+static void
+run(void)
+{
+  double start, acks, opens;
+  long round;
+  int i;
+
+  /* Open every connection slot. */
+  for(i = 0; i < UIP_CONNS; i++) {
+    open_conn(i);
+  }
+  check_conns();
+
+  /* Time the ACKs. A segment that does not match its connection is
+     answered with a RST, so the reply is checked as well. */
+  start = now();
+  for(round = 0; round < ACK_ROUNDS; round++) {
+    for(i = 0; i < UIP_CONNS; i++) {
+      input_segment(i, TCP_ACK);
+      if(uip_len != 0) {
+	printf("connbench: ACK for client %d was not matched\n", i);
+	exit(1);
+      }
+    }
+  }
+  acks = now() - start;
+  check_conns();
+
+  /* Time resetting and opening the connections again. */
+  start = now();
+  for(round = 0; round < OPEN_ROUNDS; round++) {
+    for(i = 0; i < UIP_CONNS; i++) {
+      input_segment(i, TCP_RST | TCP_ACK);
+    }
+    for(i = 0; i < UIP_CONNS; i++) {
+      open_conn(i);
+    }
+  }
+  opens = now() - start;
+  check_conns();
+
+  /* Leave the connection slots free for the next run. */
+  for(i = 0; i < UIP_CONNS; i++) {
+    input_segment(i, TCP_RST | TCP_ACK);
+  }
+
+  printf("%s:\n", one_host ? "one client host, sequential ports" :
+	 "one port per client host");
+  printf("  ACKs:  %.0f packets/s\n", (double)ACK_ROUNDS * UIP_CONNS / acks);
+  printf("  opens: %.0f connections/s (with a reset of each)\n",
+	 (double)OPEN_ROUNDS * UIP_CONNS / opens);
+}
+/*---------------------------------------------------------------------------*/
+int
+main(void)
+{
+  uip_ipaddr_t ipaddr;
+
+  uip_init();
+  uip_ipaddr(ipaddr, 192,168,0,2);
+  uip_sethostaddr(ipaddr);
+  uip_ipaddr(ipaddr, 255,255,255,0);
+  uip_setnetmask(ipaddr);
+  httpd_init();
+
+  printf("connection lookup: %s, %d connections\n",
+	 UIP_CONN_HASH ? "hash" : "linear scan", UIP_CONNS);
+  one_host = 0;
+  run();
+  one_host = 1;
+  run();
+  printf("log messages: %lu (one per reset expected)\n", log_messages);
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+/* Every reset is logged, so the messages are only counted. */
+void
+uip_log(char *m)
+{
+  log_messages++;
+}
+/*---------------------------------------------------------------------------*/
@@ -99,6 +99,15 @@ typedef unsigned short uip_stats_t;
  */
 #define UIP_CONF_MAX_LISTENPORTS 40
 
+/**
+ * TCP connection hashing on or off
+ *
+ * \hideinitializer
+ */
+#ifndef UIP_CONF_CONN_HASH
+#define UIP_CONF_CONN_HASH       0
+#endif /* UIP_CONF_CONN_HASH */
+
 /**
  * uIP buffer size.
  *
@@ -106,6 +115,24 @@ typedef unsigned short uip_stats_t;
  */
 #define UIP_CONF_BUFFER_SIZE     420
 
+/**
+ * Size of the ARP table.
+ *
+ * \hideinitializer
+ */
+#ifndef UIP_CONF_ARPTAB_SIZE
+#define UIP_CONF_ARPTAB_SIZE     8
+#endif /* UIP_CONF_ARPTAB_SIZE */
+
+/**
+ * ARP table hashing on or off
+ *
+ * \hideinitializer
+ */
+#ifndef UIP_CONF_ARP_HASH
+#define UIP_CONF_ARP_HASH        0
+#endif /* UIP_CONF_ARP_HASH */
+
 /**
  * CPU byte order.
  *
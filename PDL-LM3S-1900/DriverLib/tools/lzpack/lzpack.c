@@ -0,0 +1,327 @@
+//*****************************************************************************
+//
+// lzpack.c - Compresses a firmware image for COMMAND_DOWNLOAD_COMPRESSED.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//*****************************************************************************
+//
+// The shortest and longest matches that can be encoded, and the largest
+// window that can be encoded.
+//
+//*****************************************************************************
+#define MIN_MATCH               3
+#define MAX_MATCH               18
+#define MAX_WINDOW              4096
+
+//*****************************************************************************
+//
+// The number of entries in the hash table used to find matches, and the
+// number of earlier positions with the same hash that are tried for each
+// match.
+//
+//*****************************************************************************
+#define HASH_SIZE               4096
+#define MAX_CHAIN               256
+
+//*****************************************************************************
+//
+// Computes the hash of the three bytes at the given position.
+//
+//*****************************************************************************
+#define HASH(pucData)                                                         \
+        ((((pucData)[0] << 8) ^ ((pucData)[1] << 4) ^ (pucData)[2]) &         \
+         (HASH_SIZE - 1))
+
+//*****************************************************************************
+//
+// The most recent position with each hash, and for each position the previous
+// position with the same hash (or -1 if there is none).
+//
+//*****************************************************************************
+static long g_plHead[HASH_SIZE];
+static long *g_plPrev;
+
+//*****************************************************************************
+//
+// Prints the usage of the program.
+//
+//*****************************************************************************
+static void
+Usage(const char *pcName)
+{
+    fprintf(stderr, "Usage: %s [-w <window>] <input> <output>\n", pcName);
+    fprintf(stderr, "\n");
+    fprintf(stderr, "Compresses <input> for use with the boot loader "
+            "COMMAND_DOWNLOAD_COMPRESSED\n");
+    fprintf(stderr, "command, writing the compressed data to <output>.  "
+            "The window must be no\n");
+    fprintf(stderr, "larger than the LZ_WINDOW_SIZE of the boot loader "
+            "(default 1024).\n");
+}
+
+//*****************************************************************************
+//
+// Finds the longest match for the data at the given position, returning its
+// length (which is less than MIN_MATCH if there is no useful match) and
+// storing its offset.
+//
+//*****************************************************************************
+static long
+FindMatch(const unsigned char *pucData, long lPos, long lSize, long lWindow,
+          long *plOffset)
+{
+    long lCandidate, lLength, lBest, lMax, lChain;
+
+    //
+    // Limit the match to the end of the data.
+    //
+    lMax = lSize - lPos;
+    if(lMax > MAX_MATCH)
+    {
+        lMax = MAX_MATCH;
+    }
+    if(lMax < MIN_MATCH)
+    {
+        return(0);
+    }
+
+    //
+    // Try the earlier positions with the same hash, most recent first.
+    //
+    lBest = 0;
+    for(lCandidate = g_plHead[HASH(pucData + lPos)], lChain = 0;
+        (lCandidate >= 0) && ((lPos - lCandidate) <= lWindow) &&
+        (lChain < MAX_CHAIN);
+        lCandidate = g_plPrev[lCandidate], lChain++)
+    {
+        for(lLength = 0; lLength < lMax; lLength++)
+        {
+            if(pucData[lCandidate + lLength] != pucData[lPos + lLength])
+            {
+                break;
+            }
+        }
+        if(lLength > lBest)
+        {
+            lBest = lLength;
+            *plOffset = lPos - lCandidate;
+            if(lBest == lMax)
+            {
+                break;
+            }
+        }
+    }
+
+    //
+    // Return the length of the best match.
+    //
+    return(lBest);
+}
+
+//*****************************************************************************
+//
+// Adds the given position to the hash table.
+//
+//*****************************************************************************
+static void
+AddPosition(const unsigned char *pucData, long lPos, long lSize)
+{
+    long lHash;
+
+    if((lPos + MIN_MATCH) <= lSize)
+    {
+        lHash = HASH(pucData + lPos);
+        g_plPrev[lPos] = g_plHead[lHash];
+        g_plHead[lHash] = lPos;
+    }
+}
+
+//*****************************************************************************
+//
+// Compresses the data, returning the size of the compressed data.  The output
+// buffer must be large enough for the worst case, which is nine bytes for
+// every eight bytes of input (plus one).
+//
+//*****************************************************************************
+static long
+Compress(const unsigned char *pucData, long lSize, long lWindow,
+         unsigned char *pucOut)
+{
+    long lPos, lOut, lFlags, lItem, lLength, lOffset, lIdx;
+
+    //
+    // Empty the hash table.
+    //
+    for(lIdx = 0; lIdx < HASH_SIZE; lIdx++)
+    {
+        g_plHead[lIdx] = -1;
+    }
+
+    //
+    // Loop through the data, one group of eight items at a time.
+    //
+    for(lPos = 0, lOut = 0, lItem = 8, lFlags = 0; lPos < lSize; lItem++)
+    {
+        //
+        // Start a new group, leaving space for its flag byte.
+        //
+        if(lItem == 8)
+        {
+            lFlags = lOut++;
+            pucOut[lFlags] = 0;
+            lItem = 0;
+        }
+
+        //
+        // Find the longest match for the data at this position.
+        //
+        lLength = FindMatch(pucData, lPos, lSize, lWindow, &lOffset);
+
+        //
+        // Add a literal byte if there is no useful match.
+        //
+        if(lLength < MIN_MATCH)
+        {
+            pucOut[lFlags] |= 1 << lItem;
+            pucOut[lOut++] = pucData[lPos];
+            lLength = 1;
+        }
+
+        //
+        // Otherwise, add the match.
+        //
+        else
+        {
+            pucOut[lOut++] = (lOffset - 1) >> 4;
+            pucOut[lOut++] = (((lOffset - 1) & 15) << 4) |
+                             (lLength - MIN_MATCH);
+        }
+
+        //
+        // Add the positions that were just encoded to the hash table.
+        //
+        for(; lLength; lLength--)
+        {
+            AddPosition(pucData, lPos++, lSize);
+        }
+    }
+
+    //
+    // Return the size of the compressed data.
+    //
+    return(lOut);
+}
+
+//*****************************************************************************
+//
+// Compresses a firmware image.
+//
+//*****************************************************************************
+int
+main(int argc, char *argv[])
+{
+    unsigned char *pucData, *pucOut;
+    long lSize, lOut, lWindow;
+    FILE *pFile;
+    int iArg;
+
+    //
+    // Parse the options.
+    //
+    lWindow = 1024;
+    for(iArg = 1; (iArg < argc) && (argv[iArg][0] == '-'); iArg++)
+    {
+        if(!strcmp(argv[iArg], "-w") && ((iArg + 1) < argc))
+        {
+            lWindow = strtol(argv[++iArg], 0, 0);
+        }
+        else
+        {
+            Usage(argv[0]);
+            return(1);
+        }
+    }
+    if(((argc - iArg) != 2) || (lWindow < 4) || (lWindow > MAX_WINDOW) ||
+       (lWindow & (lWindow - 1)))
+    {
+        Usage(argv[0]);
+        return(1);
+    }
+
+    //
+    // Read the input file.
+    //
+    pFile = fopen(argv[iArg], "rb");
+    if(!pFile)
+    {
+        fprintf(stderr, "%s: Unable to open %s\n", argv[0], argv[iArg]);
+        return(1);
+    }
+    fseek(pFile, 0, SEEK_END);
+    lSize = ftell(pFile);
+    fseek(pFile, 0, SEEK_SET);
+    pucData = malloc(lSize + 1);
+    pucOut = malloc(((lSize * 9) / 8) + 2);
+    g_plPrev = malloc((lSize + 1) * sizeof(long));
+    if(!pucData || !pucOut || !g_plPrev ||
+       (fread(pucData, 1, lSize, pFile) != (size_t)lSize))
+    {
+        fprintf(stderr, "%s: Unable to read %s\n", argv[0], argv[iArg]);
+        return(1);
+    }
+    fclose(pFile);
+
+    //
+    // Compress the data.
+    //
+    lOut = Compress(pucData, lSize, lWindow, pucOut);
+
+    //
+    // Write the output file.
+    //
+    pFile = fopen(argv[iArg + 1], "wb");
+    if(!pFile || (fwrite(pucOut, 1, lOut, pFile) != (size_t)lOut) ||
+       fclose(pFile))
+    {
+        fprintf(stderr, "%s: Unable to write %s\n", argv[0], argv[iArg + 1]);
+        return(1);
+    }
+
+    //
+    // Report the sizes that must be given to COMMAND_DOWNLOAD_COMPRESSED.
+    //
+    printf("Program size %ld, compressed size %ld (%ld%%)\n", lSize, lOut,
+           lSize ? ((lOut * 100) / lSize) : 0);
+
+    //
+    // Success.
+    //
+    return(0);
+}
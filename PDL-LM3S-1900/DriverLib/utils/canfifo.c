@@ -0,0 +1,668 @@
+//*****************************************************************************
+//
+// canfifo.c - Buffered CAN receive and transmit queues.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \addtogroup utilities_api
+//! @{
+//
+//*****************************************************************************
+
+#include <string.h>
+#include "../hw_can.h"
+#include "../hw_ints.h"
+#include "../hw_memmap.h"
+#include "../hw_types.h"
+#include "../src/can.h"
+#include "../src/debug.h"
+#include "../src/interrupt.h"
+#include "canfifo.h"
+
+//*****************************************************************************
+//
+// The number of message objects in the CAN controller.
+//
+//*****************************************************************************
+#define CAN_NUM_OBJECTS         32
+
+//*****************************************************************************
+//
+// The base address and interrupt number of the CAN controller in use.
+//
+//*****************************************************************************
+static unsigned long g_ulCANFifoBase;
+static unsigned long g_ulCANFifoInt;
+
+//*****************************************************************************
+//
+// The message objects used by the hardware receive buffer, which are objects
+// 1 to g_ulCANFifoRxObjects, and the next object of the buffer that should be
+// read.
+//
+//*****************************************************************************
+static unsigned long g_ulCANFifoRxObjects;
+static unsigned long g_ulCANFifoRxNext;
+
+//*****************************************************************************
+//
+// The message objects used for transmission, which follow the receive
+// objects, and a bit mask of those that are not currently transmitting a
+// frame (bit 0 is message object 1).
+//
+//*****************************************************************************
+static unsigned long g_ulCANFifoTxMask;
+static volatile unsigned long g_ulCANFifoTxIdle;
+
+//*****************************************************************************
+//
+// Receive ring buffer.  The buffer is full if g_ulCANFifoRxRead is one ahead
+// of g_ulCANFifoRxWrite, and empty if the two indices are the same.  Only the
+// interrupt handler writes to the buffer.
+//
+//*****************************************************************************
+static tCANFifoFrame g_psCANFifoRx[CAN_FIFO_RX_SIZE];
+static volatile unsigned long g_ulCANFifoRxWrite;
+static volatile unsigned long g_ulCANFifoRxRead;
+
+//*****************************************************************************
+//
+// Transmit priority queue.  The frames are kept sorted by their arbitration
+// priority, with the frame that should be sent next at the end of the array;
+// frames of equal priority are sent in the order in which they were queued.
+// The queue is shared with the interrupt handler, so it is only changed with
+// the CAN interrupt disabled.
+//
+//*****************************************************************************
+typedef struct
+{
+    unsigned long ulPriority;
+    tCANFifoFrame sFrame;
+}
+tCANFifoTxEntry;
+static tCANFifoTxEntry g_psCANFifoTx[CAN_FIFO_TX_SIZE];
+static unsigned long g_ulCANFifoTxCount;
+
+//*****************************************************************************
+//
+// The traffic counted so far.
+//
+//*****************************************************************************
+static tCANFifoStats g_sCANFifoStats;
+
+//*****************************************************************************
+//
+// Computes the arbitration priority of a frame, where a lower value wins
+// arbitration on the bus.  A standard frame beats an extended frame whose
+// identifier starts with the same 11 bits, since the extended frame's IDE bit
+// is recessive.
+//
+//*****************************************************************************
+static unsigned long
+CANFifoPriority(const tCANFifoFrame *psFrame)
+{
+    if(psFrame->ulFlags & MSG_OBJ_EXTENDED_ID)
+    {
+        return(((psFrame->ulMsgID & 0x1ffc0000) << 1) | 0x00040000 |
+               (psFrame->ulMsgID & 0x0003ffff));
+    }
+    return((psFrame->ulMsgID & 0x7ff) << 19);
+}
+
+//*****************************************************************************
+//
+// Loads the highest priority queued frame into each idle transmit message
+// object.  This must be called with the CAN interrupt disabled, or from the
+// interrupt handler.
+//
+//*****************************************************************************
+static void
+CANFifoTxStart(void)
+{
+    tCANFifoFrame *psFrame;
+    tCANMsgObject sMsg;
+    unsigned long ulObj;
+
+    //
+    // Loop while there are frames queued and idle objects to send them.
+    //
+    for(ulObj = 0; g_ulCANFifoTxCount && g_ulCANFifoTxIdle; ulObj++)
+    {
+        //
+        // Skip this object if it is busy.
+        //
+        if(!(g_ulCANFifoTxIdle & (1 << ulObj)))
+        {
+            continue;
+        }
+
+        //
+        // Take the frame from the end of the queue.
+        //
+        g_ulCANFifoTxCount--;
+        psFrame = &g_psCANFifoTx[g_ulCANFifoTxCount].sFrame;
+
+        //
+        // Load the frame into the message object, which starts its
+        // transmission.
+        //
+        sMsg.ulMsgID = psFrame->ulMsgID;
+        sMsg.ulMsgIDMask = 0;
+        sMsg.ulFlags = ((psFrame->ulFlags & MSG_OBJ_EXTENDED_ID) |
+                        MSG_OBJ_TX_INT_ENABLE);
+        sMsg.ulMsgLen = psFrame->ulMsgLen;
+        sMsg.pucMsgData = psFrame->pucMsgData;
+        g_ulCANFifoTxIdle &= ~(1 << ulObj);
+        CANMessageSet(g_ulCANFifoBase, ulObj + 1, &sMsg,
+                      ((psFrame->ulFlags & MSG_OBJ_REMOTE_FRAME) ?
+                       MSG_OBJ_TYPE_TX_REMOTE : MSG_OBJ_TYPE_TX));
+    }
+}
+
+//*****************************************************************************
+//
+// Moves the frames held in the hardware receive buffer into the receive ring.
+// The hardware stores each frame in the lowest numbered free object of the
+// buffer, so once the buffer has been emptied the next frame is in the first
+// object.  Objects that are freed while the buffer is being read are refilled
+// with newer frames, so the objects are read in a circular order starting
+// from the object after the last one read, which returns the frames in the
+// order in which they were received.
+//
+//*****************************************************************************
+static void
+CANFifoRxDrain(void)
+{
+    tCANFifoFrame *psFrame, sDiscard;
+    tCANMsgObject sMsg;
+    unsigned long ulPending, ulWrite;
+
+    //
+    // Loop until the hardware buffer is empty.
+    //
+    while(1)
+    {
+        //
+        // Find the objects of the buffer that hold new frames.  Once there
+        // are none, the next frame will be stored in the first object.
+        //
+        ulPending = (CANStatusGet(g_ulCANFifoBase, CAN_STS_NEWDAT) &
+                     ((1 << g_ulCANFifoRxObjects) - 1));
+        if(!ulPending)
+        {
+            g_ulCANFifoRxNext = 0;
+            return;
+        }
+
+        //
+        // Loop through the objects that hold frames.
+        //
+        while(ulPending)
+        {
+            //
+            // If the next object in order is empty, then the frames start at
+            // the lowest numbered object that holds one.
+            //
+            if(!(ulPending & (1 << g_ulCANFifoRxNext)))
+            {
+                for(g_ulCANFifoRxNext = 0;
+                    !(ulPending & (1 << g_ulCANFifoRxNext));
+                    g_ulCANFifoRxNext++)
+                {
+                }
+            }
+
+            //
+            // Read the frame into the ring, or discard it if the ring is
+            // full.
+            //
+            ulWrite = (g_ulCANFifoRxWrite + 1) % CAN_FIFO_RX_SIZE;
+            if(ulWrite == g_ulCANFifoRxRead)
+            {
+                psFrame = &sDiscard;
+                g_sCANFifoStats.ulRxOverruns++;
+            }
+            else
+            {
+                psFrame = &g_psCANFifoRx[g_ulCANFifoRxWrite];
+            }
+            sMsg.pucMsgData = psFrame->pucMsgData;
+            CANMessageGet(g_ulCANFifoBase, g_ulCANFifoRxNext + 1, &sMsg,
+                          true);
+            psFrame->ulMsgID = sMsg.ulMsgID;
+            psFrame->ulFlags = sMsg.ulFlags & (MSG_OBJ_EXTENDED_ID |
+                                               MSG_OBJ_REMOTE_FRAME |
+                                               MSG_OBJ_DATA_LOST);
+            psFrame->ulMsgLen = sMsg.ulMsgLen;
+            if(sMsg.ulFlags & MSG_OBJ_DATA_LOST)
+            {
+                g_sCANFifoStats.ulRxLost++;
+            }
+
+            //
+            // Add the frame to the ring.
+            //
+            if(psFrame != &sDiscard)
+            {
+                g_ulCANFifoRxWrite = ulWrite;
+                g_sCANFifoStats.ulRxFrames++;
+            }
+
+            //
+            // Move on to the next object of the buffer.
+            //
+            ulPending &= ~(1 << g_ulCANFifoRxNext);
+            g_ulCANFifoRxNext = ((g_ulCANFifoRxNext + 1) %
+                                 g_ulCANFifoRxObjects);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! Initializes the buffered CAN queues.
+//!
+//! \param ulBase is the base address of the CAN controller.
+//! \param psRxFilter is a pointer to the identifier, mask, and flags of the
+//! frames to be received, or \b NULL to receive all frames.
+//! \param ulRxObjects is the number of message objects used to buffer
+//! received frames in hardware.
+//! \param ulTxObjects is the number of message objects used to transmit
+//! frames.
+//!
+//! This function sets up a receive ring and a transmit queue on top of the
+//! message objects of a CAN controller, so that frames can be received and
+//! sent by the application without waiting for (or accessing) the controller.
+//!
+//! Message objects 1 to \e ulRxObjects are chained into a single hardware
+//! FIFO buffer that receives the frames matching \e psRxFilter, which must
+//! have \b MSG_OBJ_USE_ID_FILTER set in its \e ulFlags (and optionally
+//! \b MSG_OBJ_EXTENDED_ID and \b MSG_OBJ_USE_EXT_FILTER).  The buffer absorbs
+//! bursts of frames that arrive faster than the interrupt handler can respond,
+//! and the interrupt handler moves the frames into a ring of
+//! \b CAN_FIFO_RX_SIZE entries from which they are read by CANFifoReceive().
+//!
+//! The following \e ulTxObjects message objects are used to transmit the
+//! frames passed to CANFifoSend(), which are queued (in a queue of
+//! \b CAN_FIFO_TX_SIZE entries) in order of their arbitration priority.  With
+//! a single transmit object, frames are sent in strict priority order; more
+//! objects allow frames to be sent back to back without waiting for the
+//! interrupt handler, but a frame that is queued while every object is busy
+//! may then have to wait for lower priority frames that were queued before
+//! it.  The remaining message objects are left for use by the application.
+//!
+//! The controller must have been initialized with CANInit() and its bit
+//! timing set before this function is called; CANEnable() can be called
+//! before or after.  CANFifoIntHandler() must be installed as the interrupt
+//! handler for the controller.
+//!
+//! This function is contained in <tt>utils/canfifo.c</tt>, with
+//! <tt>utils/canfifo.h</tt> containing the API definition for use by
+//! applications.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+CANFifoInit(unsigned long ulBase, tCANMsgObject *psRxFilter,
+            unsigned long ulRxObjects, unsigned long ulTxObjects)
+{
+    tCANMsgObject sMsg;
+    unsigned long ulObj;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT((ulBase == CAN0_BASE) || (ulBase == CAN1_BASE) ||
+           (ulBase == CAN2_BASE));
+    ASSERT(ulRxObjects && ulTxObjects &&
+           ((ulRxObjects + ulTxObjects) <= CAN_NUM_OBJECTS));
+
+    //
+    // Save the controller and the message objects in use.
+    //
+    g_ulCANFifoBase = ulBase;
+    g_ulCANFifoInt = CANGetIntNumber(ulBase);
+    g_ulCANFifoRxObjects = ulRxObjects;
+    g_ulCANFifoRxNext = 0;
+    g_ulCANFifoTxMask = (((1 << ulTxObjects) - 1) << ulRxObjects);
+
+    //
+    // Disable the interrupt while the queues are reset.
+    //
+    IntDisable(g_ulCANFifoInt);
+
+    //
+    // Empty the queues and clear the traffic counts.
+    //
+    g_ulCANFifoRxWrite = 0;
+    g_ulCANFifoRxRead = 0;
+    g_ulCANFifoTxCount = 0;
+    g_ulCANFifoTxIdle = g_ulCANFifoTxMask;
+    memset(&g_sCANFifoStats, 0, sizeof(g_sCANFifoStats));
+
+    //
+    // Set up the receive objects as a FIFO buffer, with the last object
+    // marking the end of the buffer.
+    //
+    if(psRxFilter)
+    {
+        sMsg = *psRxFilter;
+    }
+    else
+    {
+        sMsg.ulMsgID = 0;
+        sMsg.ulMsgIDMask = 0;
+        sMsg.ulFlags = MSG_OBJ_USE_ID_FILTER;
+    }
+    sMsg.ulFlags |= MSG_OBJ_RX_INT_ENABLE;
+    sMsg.ulMsgLen = 8;
+    sMsg.pucMsgData = 0;
+    for(ulObj = 1; ulObj <= ulRxObjects; ulObj++)
+    {
+        if(ulObj == ulRxObjects)
+        {
+            sMsg.ulFlags &= ~MSG_OBJ_FIFO;
+        }
+        else
+        {
+            sMsg.ulFlags |= MSG_OBJ_FIFO;
+        }
+        CANMessageSet(ulBase, ulObj, &sMsg, MSG_OBJ_TYPE_RX);
+    }
+
+    //
+    // Make sure that the transmit objects are not in use.
+    //
+    for(ulObj = ulRxObjects + 1; ulObj <= (ulRxObjects + ulTxObjects);
+        ulObj++)
+    {
+        CANMessageClear(ulBase, ulObj);
+    }
+
+    //
+    // Enable the message object and error interrupts.
+    //
+    CANIntEnable(ulBase, CAN_INT_MASTER | CAN_INT_ERROR);
+    IntEnable(g_ulCANFifoInt);
+}
+
+//*****************************************************************************
+//
+//! Reads a frame from the receive ring.
+//!
+//! \param psFrame is a pointer to the structure that is filled in with the
+//! frame.
+//!
+//! This function returns the oldest frame that has been received, without
+//! accessing the CAN controller.
+//!
+//! \return Returns \b true if a frame was returned, or \b false if no frames
+//! have been received.
+//
+//*****************************************************************************
+tBoolean
+CANFifoReceive(tCANFifoFrame *psFrame)
+{
+    unsigned long ulRead;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psFrame);
+
+    //
+    // Return false if the ring is empty.
+    //
+    ulRead = g_ulCANFifoRxRead;
+    if(ulRead == g_ulCANFifoRxWrite)
+    {
+        return(false);
+    }
+
+    //
+    // Copy out the frame and then release its entry to the interrupt handler.
+    //
+    *psFrame = g_psCANFifoRx[ulRead];
+    g_ulCANFifoRxRead = (ulRead + 1) % CAN_FIFO_RX_SIZE;
+
+    //
+    // A frame was returned.
+    //
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Returns the number of frames waiting in the receive ring.
+//!
+//! \return Returns the number of frames that can be read by CANFifoReceive()
+//! without it returning \b false.
+//
+//*****************************************************************************
+unsigned long
+CANFifoRxAvail(void)
+{
+    unsigned long ulRead, ulWrite;
+
+    ulRead = g_ulCANFifoRxRead;
+    ulWrite = g_ulCANFifoRxWrite;
+    return((ulWrite + CAN_FIFO_RX_SIZE - ulRead) % CAN_FIFO_RX_SIZE);
+}
+
+//*****************************************************************************
+//
+//! Queues a frame for transmission.
+//!
+//! \param psFrame is a pointer to the frame to be sent.
+//!
+//! This function adds a frame to the transmit queue, from which frames are
+//! sent in order of their arbitration priority (lowest identifier first).  If
+//! a transmit message object is idle, the frame is loaded into it at once.
+//!
+//! \return Returns \b true if the frame was queued, or \b false if the queue
+//! is full.
+//
+//*****************************************************************************
+tBoolean
+CANFifoSend(const tCANFifoFrame *psFrame)
+{
+    unsigned long ulPriority, ulPos;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psFrame && (psFrame->ulMsgLen <= 8));
+
+    //
+    // Compute the priority of the frame.
+    //
+    ulPriority = CANFifoPriority(psFrame);
+
+    //
+    // Keep the interrupt handler away from the queue while it is changed.
+    //
+    IntDisable(g_ulCANFifoInt);
+
+    //
+    // Fail if the queue is full.
+    //
+    if(g_ulCANFifoTxCount == CAN_FIFO_TX_SIZE)
+    {
+        IntEnable(g_ulCANFifoInt);
+        return(false);
+    }
+
+    //
+    // Find the place for the frame, which is after the frames that are sent
+    // after it and before the frames of the same or higher priority.
+    //
+    for(ulPos = 0; (ulPos < g_ulCANFifoTxCount) &&
+        (g_psCANFifoTx[ulPos].ulPriority > ulPriority); ulPos++)
+    {
+    }
+
+    //
+    // Insert the frame into the queue.
+    //
+    memmove(&g_psCANFifoTx[ulPos + 1], &g_psCANFifoTx[ulPos],
+            (g_ulCANFifoTxCount - ulPos) * sizeof(tCANFifoTxEntry));
+    g_psCANFifoTx[ulPos].ulPriority = ulPriority;
+    g_psCANFifoTx[ulPos].sFrame = *psFrame;
+    g_ulCANFifoTxCount++;
+
+    //
+    // Start sending the frame if a transmit object is idle.
+    //
+    CANFifoTxStart();
+
+    //
+    // Allow the interrupt handler to run again.
+    //
+    IntEnable(g_ulCANFifoInt);
+
+    //
+    // The frame was queued.
+    //
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Returns the number of free entries in the transmit queue.
+//!
+//! \return Returns the number of frames that can be passed to CANFifoSend()
+//! without it returning \b false.
+//
+//*****************************************************************************
+unsigned long
+CANFifoTxFree(void)
+{
+    return(CAN_FIFO_TX_SIZE - g_ulCANFifoTxCount);
+}
+
+//*****************************************************************************
+//
+//! Handles interrupts from the CAN controller used by the queues.
+//!
+//! This function must be installed as the interrupt handler of the CAN
+//! controller passed to CANFifoInit().  It moves received frames from the
+//! hardware buffer into the receive ring, loads queued frames into the
+//! transmit objects as they become idle, and counts bus-off events.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+CANFifoIntHandler(void)
+{
+    unsigned long ulCause;
+
+    //
+    // Loop while the controller has interrupts pending.
+    //
+    while((ulCause = CANIntStatus(g_ulCANFifoBase, CAN_INT_STS_CAUSE)) != 0)
+    {
+        //
+        // A status interrupt is cleared by reading the status.
+        //
+        if(ulCause == CAN_INT_INTID_STATUS)
+        {
+            if(CANStatusGet(g_ulCANFifoBase, CAN_STS_CONTROL) &
+               CAN_STATUS_BUS_OFF)
+            {
+                g_sCANFifoStats.ulBusOff++;
+            }
+        }
+
+        //
+        // A receive object interrupt means that frames are waiting in the
+        // hardware buffer; reading them clears their interrupts.
+        //
+        else if(ulCause <= g_ulCANFifoRxObjects)
+        {
+            CANFifoRxDrain();
+        }
+
+        //
+        // A transmit object interrupt means that its frame has been sent, so
+        // it can be loaded with the next frame.
+        //
+        else if(g_ulCANFifoTxMask & (1 << (ulCause - 1)))
+        {
+            CANIntClear(g_ulCANFifoBase, ulCause);
+            g_ulCANFifoTxIdle |= 1 << (ulCause - 1);
+            g_sCANFifoStats.ulTxFrames++;
+            CANFifoTxStart();
+        }
+
+        //
+        // Clear an interrupt from an object that is not used by the queues.
+        //
+        else
+        {
+            CANIntClear(g_ulCANFifoBase, ulCause);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! Gets the traffic counted by the CAN queues.
+//!
+//! \param psStats is a pointer to the structure that is filled in with the
+//! number of frames received, discarded, lost, and transmitted, and the number
+//! of bus-off events.
+//!
+//! The counts cover the traffic since CANFifoInit() was called.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+CANFifoStatsGet(tCANFifoStats *psStats)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psStats);
+
+    //
+    // Return a copy of the counts, with the interrupt disabled so that they
+    // are consistent.
+    //
+    IntDisable(g_ulCANFifoInt);
+    *psStats = g_sCANFifoStats;
+    IntEnable(g_ulCANFifoInt);
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
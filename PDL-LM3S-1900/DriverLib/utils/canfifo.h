@@ -0,0 +1,137 @@
+//*****************************************************************************
+//
+// canfifo.h - Prototypes for the buffered CAN receive and transmit queues.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+#ifndef __CANFIFO_H__
+#define __CANFIFO_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The number of frames held by the software receive ring and the software
+// transmit queue respectively.  One entry of the receive ring is always left
+// empty, so it holds one frame less than its size.
+//
+//*****************************************************************************
+#ifndef CAN_FIFO_RX_SIZE
+#define CAN_FIFO_RX_SIZE        32
+#endif
+#ifndef CAN_FIFO_TX_SIZE
+#define CAN_FIFO_TX_SIZE        16
+#endif
+
+//*****************************************************************************
+//
+//! A CAN frame held in the receive ring or the transmit queue.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The 11 or 29 bit identifier of the frame.
+    //
+    unsigned long ulMsgID;
+
+    //
+    //! The flags of the frame; \b MSG_OBJ_EXTENDED_ID for a 29 bit
+    //! identifier, and \b MSG_OBJ_REMOTE_FRAME for a remote frame.  Received
+    //! frames also have \b MSG_OBJ_DATA_LOST set if the hardware buffer
+    //! overflowed before the frame was read.
+    //
+    unsigned long ulFlags;
+
+    //
+    //! The number of bytes of data in the frame.
+    //
+    unsigned long ulMsgLen;
+
+    //
+    //! The data of the frame.
+    //
+    unsigned char pucMsgData[8];
+}
+tCANFifoFrame;
+
+//*****************************************************************************
+//
+//! Structure that holds the traffic counted by the CAN queues.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The number of frames placed in the receive ring.
+    //
+    unsigned long ulRxFrames;
+
+    //
+    //! The number of received frames that were discarded because the receive
+    //! ring was full.
+    //
+    unsigned long ulRxOverruns;
+
+    //
+    //! The number of times that the hardware receive buffer overflowed before
+    //! it could be emptied by the interrupt handler.
+    //
+    unsigned long ulRxLost;
+
+    //
+    //! The number of frames transmitted.
+    //
+    unsigned long ulTxFrames;
+
+    //
+    //! The number of times that the controller entered the bus-off state.
+    //
+    unsigned long ulBusOff;
+}
+tCANFifoStats;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern void CANFifoInit(unsigned long ulBase, tCANMsgObject *psRxFilter,
+                        unsigned long ulRxObjects, unsigned long ulTxObjects);
+extern tBoolean CANFifoReceive(tCANFifoFrame *psFrame);
+extern unsigned long CANFifoRxAvail(void);
+extern tBoolean CANFifoSend(const tCANFifoFrame *psFrame);
+extern unsigned long CANFifoTxFree(void);
+extern void CANFifoIntHandler(void);
+extern void CANFifoStatsGet(tCANFifoStats *psStats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __CANFIFO_H__
@@ -0,0 +1,583 @@
+//*****************************************************************************
+//
+// canfilter.c - Assigns CAN message objects to lists of identifiers.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \addtogroup utilities_api
+//! @{
+//
+//*****************************************************************************
+
+#include "../hw_can.h"
+#include "../hw_ints.h"
+#include "../hw_memmap.h"
+#include "../hw_types.h"
+#include "../src/can.h"
+#include "../src/debug.h"
+#include "../src/interrupt.h"
+#include "canfilter.h"
+
+//*****************************************************************************
+//
+// The number of message objects in the CAN controller.
+//
+//*****************************************************************************
+#define CAN_NUM_OBJECTS         32
+
+//*****************************************************************************
+//
+// The identifier bits of standard and extended frames.
+//
+//*****************************************************************************
+#define CAN_FILTER_STD_MASK     0x000007ff
+#define CAN_FILTER_EXT_MASK     0x1fffffff
+
+//*****************************************************************************
+//
+// A masked filter, which accepts the identifiers that match ulValue in the
+// bits that are set in ulMask.  Filters can only be merged if they are for
+// the same type of identifier and the same handler.
+//
+//*****************************************************************************
+typedef struct
+{
+    unsigned long ulValue;
+    unsigned long ulMask;
+    unsigned long ulFlags;
+    tCANFilterHandler pfnHandler;
+}
+tCANFilterBlock;
+
+//*****************************************************************************
+//
+// Flag in the ulFlags of a filter that indicates that the filter accepts
+// identifiers that are not in any of the ranges for its handler.
+//
+//*****************************************************************************
+#define CAN_FILTER_INEXACT      0x80000000
+
+//*****************************************************************************
+//
+// The dispatch table, which gives the handler (or zero if the object is not
+// in use) and the filter flags of each message object.
+//
+//*****************************************************************************
+static tCANFilterHandler g_ppfnCANFilterHandler[CAN_NUM_OBJECTS];
+static unsigned long g_pulCANFilterFlags[CAN_NUM_OBJECTS];
+
+//*****************************************************************************
+//
+// The CAN controller in use, and the identifier ranges that were passed to
+// CANFilterInit().
+//
+//*****************************************************************************
+static unsigned long g_ulCANFilterBase;
+static const tCANFilterEntry *g_psCANFilterEntries;
+static unsigned long g_ulCANFilterNumEntries;
+
+//*****************************************************************************
+//
+// The number of frames that were received by a merged filter but did not
+// match any of the identifier ranges of its handler.
+//
+//*****************************************************************************
+static unsigned long g_ulCANFilterRejected;
+
+//*****************************************************************************
+//
+// Returns the number of identifiers accepted by a filter with the given mask.
+//
+//*****************************************************************************
+static unsigned long
+CANFilterSize(unsigned long ulMask, unsigned long ulFlags)
+{
+    unsigned long ulFree;
+
+    //
+    // Count the identifier bits that are not compared by the filter.
+    //
+    ulFree = (((ulFlags & MSG_OBJ_EXTENDED_ID) ? CAN_FILTER_EXT_MASK :
+               CAN_FILTER_STD_MASK) & ~ulMask);
+    ulFree = ulFree - ((ulFree >> 1) & 0x55555555);
+    ulFree = (ulFree & 0x33333333) + ((ulFree >> 2) & 0x33333333);
+    ulFree = (((ulFree + (ulFree >> 4)) & 0x0f0f0f0f) * 0x01010101) >> 24;
+
+    //
+    // Return the number of identifiers that match.
+    //
+    return(1 << ulFree);
+}
+
+//*****************************************************************************
+//
+// Computes the number of unwanted identifiers that are accepted if two
+// filters are merged, which is the number of identifiers accepted by the
+// merged filter that are not accepted by either of the two filters.
+//
+//*****************************************************************************
+static unsigned long
+CANFilterMergeCost(const tCANFilterBlock *psA, const tCANFilterBlock *psB)
+{
+    unsigned long ulMask, ulCovered;
+
+    //
+    // The merged filter only compares the bits that are compared by both
+    // filters and that have the same value in both.
+    //
+    ulMask = psA->ulMask & psB->ulMask & ~(psA->ulValue ^ psB->ulValue);
+
+    //
+    // Count the identifiers accepted by either filter.  The two filters
+    // overlap unless they differ in a bit that is compared by both.
+    //
+    ulCovered = (CANFilterSize(psA->ulMask, psA->ulFlags) +
+                 CANFilterSize(psB->ulMask, psB->ulFlags));
+    if(((psA->ulValue ^ psB->ulValue) & psA->ulMask & psB->ulMask) == 0)
+    {
+        ulCovered -= CANFilterSize(psA->ulMask | psB->ulMask, psA->ulFlags);
+    }
+
+    //
+    // Return the number of additional identifiers accepted.
+    //
+    return(CANFilterSize(ulMask, psA->ulFlags) - ulCovered);
+}
+
+//*****************************************************************************
+//
+// Merges the two filters that accept the fewest unwanted identifiers when
+// merged, returning the new number of filters, or zero if no two filters can
+// be merged.
+//
+//*****************************************************************************
+static unsigned long
+CANFilterMergeBest(tCANFilterBlock *psBlocks, unsigned long ulCount)
+{
+    unsigned long ulI, ulJ, ulBestI, ulBestJ, ulCost, ulBestCost, ulMask;
+
+    //
+    // Find the pair of compatible filters with the lowest merge cost.
+    //
+    ulBestI = ulBestJ = 0;
+    ulBestCost = 0xffffffff;
+    for(ulI = 0; ulI < ulCount; ulI++)
+    {
+        for(ulJ = ulI + 1; ulJ < ulCount; ulJ++)
+        {
+            if((psBlocks[ulI].pfnHandler != psBlocks[ulJ].pfnHandler) ||
+               ((psBlocks[ulI].ulFlags ^ psBlocks[ulJ].ulFlags) &
+                MSG_OBJ_EXTENDED_ID))
+            {
+                continue;
+            }
+            ulCost = CANFilterMergeCost(&psBlocks[ulI], &psBlocks[ulJ]);
+            if(ulCost < ulBestCost)
+            {
+                ulBestCost = ulCost;
+                ulBestI = ulI;
+                ulBestJ = ulJ;
+            }
+        }
+    }
+
+    //
+    // Fail if there are no two filters that can be merged.
+    //
+    if(ulBestCost == 0xffffffff)
+    {
+        return(0);
+    }
+
+    //
+    // Replace the first filter with the merged filter.  The merged filter is
+    // inexact if either filter was, or if the merge accepts more identifiers.
+    //
+    ulMask = (psBlocks[ulBestI].ulMask & psBlocks[ulBestJ].ulMask &
+              ~(psBlocks[ulBestI].ulValue ^ psBlocks[ulBestJ].ulValue));
+    psBlocks[ulBestI].ulMask = ulMask;
+    psBlocks[ulBestI].ulValue &= ulMask;
+    psBlocks[ulBestI].ulFlags |= psBlocks[ulBestJ].ulFlags;
+    if(ulBestCost)
+    {
+        psBlocks[ulBestI].ulFlags |= CAN_FILTER_INEXACT;
+    }
+
+    //
+    // Remove the second filter by moving the last filter into its place.
+    //
+    psBlocks[ulBestJ] = psBlocks[ulCount - 1];
+
+    //
+    // Return the new number of filters.
+    //
+    return(ulCount - 1);
+}
+
+//*****************************************************************************
+//
+//! Sets up CAN message objects to receive lists of identifiers.
+//!
+//! \param ulBase is the base address of the CAN controller.
+//! \param psEntries is an array of the identifier ranges to be received.
+//! \param ulNumEntries is the number of entries in \e psEntries.
+//! \param ulFirstObj is the first message object to be used (1-32).
+//! \param ulNumObjs is the number of message objects to be used.
+//!
+//! This function computes a set of masked acceptance filters that receive all
+//! of the identifiers in the ranges of \e psEntries, and programs one message
+//! object (starting with \e ulFirstObj) for each filter.  Each range is first
+//! split into the smallest number of masked filters that accept exactly the
+//! identifiers in the range, so a range such as 0x100-0x17f needs a single
+//! message object.  If there are more filters than \e ulNumObjs, the pair of
+//! filters that accepts the fewest unwanted identifiers when merged is
+//! repeatedly merged into one, so adjacent identifiers are merged first and
+//! widely separated identifiers last.  Only filters for the same type of
+//! identifier and the same handler are merged, so each message object can be
+//! mapped directly to its handler.
+//!
+//! Frames that are not accepted by any of the filters are discarded by the
+//! CAN controller without interrupting the processor.  A frame accepted by a
+//! merged filter that is not in any of the ranges of the handler is discarded
+//! by CANFilterDispatch(), and counted by CANFilterRejectCount().
+//!
+//! The array \e psEntries must remain valid after this function returns.  The
+//! message objects that are not needed are cleared, and the message objects
+//! outside the given range are left for use by the application.
+//!
+//! The controller must have been initialized with CANInit() and its bit
+//! timing set before this function is called.  Either CANFilterIntHandler()
+//! must be installed as the interrupt handler for the controller, or the
+//! application's handler must call CANFilterDispatch() for each message
+//! object interrupt.
+//!
+//! This function is contained in <tt>utils/canfilter.c</tt>, with
+//! <tt>utils/canfilter.h</tt> containing the API definition for use by
+//! applications.
+//!
+//! \return Returns the number of message objects used, or zero if the ranges
+//! have more combinations of handler and identifier type than there are
+//! message objects.
+//
+//*****************************************************************************
+unsigned long
+CANFilterInit(unsigned long ulBase, const tCANFilterEntry *psEntries,
+              unsigned long ulNumEntries, unsigned long ulFirstObj,
+              unsigned long ulNumObjs)
+{
+    tCANFilterBlock psBlocks[CAN_FILTER_MAX_BLOCKS];
+    unsigned long ulIdx, ulCount, ulID, ulLast, ulStep, ulIDMask;
+    tCANMsgObject sMsg;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT((ulBase == CAN0_BASE) || (ulBase == CAN1_BASE) ||
+           (ulBase == CAN2_BASE));
+    ASSERT(psEntries || !ulNumEntries);
+    ASSERT(ulFirstObj && ulNumObjs &&
+           ((ulFirstObj + ulNumObjs - 1) <= CAN_NUM_OBJECTS));
+
+    //
+    // Save the controller and the identifier ranges.
+    //
+    g_ulCANFilterBase = ulBase;
+    g_psCANFilterEntries = psEntries;
+    g_ulCANFilterNumEntries = ulNumEntries;
+    g_ulCANFilterRejected = 0;
+
+    //
+    // Split each range into filters.
+    //
+    for(ulIdx = 0, ulCount = 0; ulIdx < ulNumEntries; ulIdx++)
+    {
+        ulIDMask = ((psEntries[ulIdx].ulFlags & MSG_OBJ_EXTENDED_ID) ?
+                    CAN_FILTER_EXT_MASK : CAN_FILTER_STD_MASK);
+        ulID = psEntries[ulIdx].ulIDFirst;
+        ulLast = psEntries[ulIdx].ulIDLast;
+        ASSERT((ulID <= ulLast) && (ulLast <= ulIDMask));
+
+        //
+        // Loop until the entire range has been covered.
+        //
+        while(ulID <= ulLast)
+        {
+            //
+            // Find the largest aligned power of two block of identifiers that
+            // starts at this identifier and is within the range.
+            //
+            for(ulStep = 1;
+                (ulStep <= ulIDMask) && !(ulID & ulStep) &&
+                ((ulID + (ulStep * 2) - 1) <= ulLast);
+                ulStep *= 2)
+            {
+            }
+
+            //
+            // Make room for the filter, if necessary, by merging two of the
+            // filters found so far.
+            //
+            if(ulCount == CAN_FILTER_MAX_BLOCKS)
+            {
+                ulCount = CANFilterMergeBest(psBlocks, ulCount);
+                if(ulCount == 0)
+                {
+                    return(0);
+                }
+            }
+
+            //
+            // Add the filter for this block of identifiers.
+            //
+            psBlocks[ulCount].ulValue = ulID;
+            psBlocks[ulCount].ulMask = ulIDMask & ~(ulStep - 1);
+            psBlocks[ulCount].ulFlags = (psEntries[ulIdx].ulFlags &
+                                         MSG_OBJ_EXTENDED_ID);
+            psBlocks[ulCount].pfnHandler = psEntries[ulIdx].pfnHandler;
+            ulCount++;
+
+            //
+            // Move past this block, stopping at the largest identifier.
+            //
+            if((ulID + ulStep - 1) == ulIDMask)
+            {
+                break;
+            }
+            ulID += ulStep;
+        }
+    }
+
+    //
+    // Merge filters until there is a message object for each one.
+    //
+    while(ulCount > ulNumObjs)
+    {
+        ulCount = CANFilterMergeBest(psBlocks, ulCount);
+        if(ulCount == 0)
+        {
+            return(0);
+        }
+    }
+
+    //
+    // Program a message object for each filter, and clear the rest of the
+    // message objects.  The filters always compare the IDE bit so that
+    // standard and extended frames are not confused.
+    //
+    sMsg.ulMsgLen = 8;
+    sMsg.pucMsgData = 0;
+    for(ulIdx = 0; ulIdx < ulNumObjs; ulIdx++)
+    {
+        if(ulIdx < ulCount)
+        {
+            sMsg.ulMsgID = psBlocks[ulIdx].ulValue;
+            sMsg.ulMsgIDMask = psBlocks[ulIdx].ulMask;
+            sMsg.ulFlags = ((psBlocks[ulIdx].ulFlags & MSG_OBJ_EXTENDED_ID) |
+                            MSG_OBJ_USE_EXT_FILTER | MSG_OBJ_RX_INT_ENABLE);
+            CANMessageSet(ulBase, ulFirstObj + ulIdx, &sMsg, MSG_OBJ_TYPE_RX);
+            g_ppfnCANFilterHandler[ulFirstObj + ulIdx - 1] =
+                psBlocks[ulIdx].pfnHandler;
+            g_pulCANFilterFlags[ulFirstObj + ulIdx - 1] =
+                psBlocks[ulIdx].ulFlags;
+        }
+        else
+        {
+            CANMessageClear(ulBase, ulFirstObj + ulIdx);
+            g_ppfnCANFilterHandler[ulFirstObj + ulIdx - 1] = 0;
+        }
+    }
+
+    //
+    // Enable the message object and error interrupts.
+    //
+    CANIntEnable(ulBase, CAN_INT_MASTER | CAN_INT_ERROR);
+    IntEnable(CANGetIntNumber(ulBase));
+
+    //
+    // Return the number of message objects used.
+    //
+    return(ulCount);
+}
+
+//*****************************************************************************
+//
+//! Passes a frame received by a message object to its handler.
+//!
+//! \param ulObj is the number of the message object (1-32) that caused the
+//! interrupt.
+//!
+//! This function looks up the handler of a message object that was set up by
+//! CANFilterInit(), reads the received frame (clearing the interrupt), and
+//! calls the handler with the frame.  The handler is found in a table indexed
+//! by the message object number, so the time taken does not depend on the
+//! number of identifier ranges.  Only frames received by a merged filter,
+//! which may accept unwanted identifiers, are checked against the ranges of
+//! the handler.
+//!
+//! This function is called by CANFilterIntHandler(), and can be called by
+//! the interrupt handler of an application that also uses message objects
+//! that are not managed by CANFilterInit().
+//!
+//! \return Returns \b true if the message object was set up by
+//! CANFilterInit(), or \b false if it is not in use by the filters.
+//
+//*****************************************************************************
+tBoolean
+CANFilterDispatch(unsigned long ulObj)
+{
+    const tCANFilterEntry *psEntry;
+    tCANFilterHandler pfnHandler;
+    unsigned char pucData[8];
+    tCANMsgObject sMsg;
+    unsigned long ulIdx;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT((ulObj >= 1) && (ulObj <= CAN_NUM_OBJECTS));
+
+    //
+    // Return false if this message object is not in use by the filters.
+    //
+    pfnHandler = g_ppfnCANFilterHandler[ulObj - 1];
+    if(!pfnHandler)
+    {
+        return(false);
+    }
+
+    //
+    // Read the frame from the message object, clearing its interrupt.
+    //
+    sMsg.pucMsgData = pucData;
+    CANMessageGet(g_ulCANFilterBase, ulObj, &sMsg, true);
+
+    //
+    // A merged filter may have accepted a frame that is not in any of the
+    // ranges of the handler, so search the ranges.
+    //
+    if(g_pulCANFilterFlags[ulObj - 1] & CAN_FILTER_INEXACT)
+    {
+        for(ulIdx = 0, psEntry = g_psCANFilterEntries;
+            ulIdx < g_ulCANFilterNumEntries; ulIdx++, psEntry++)
+        {
+            if((psEntry->pfnHandler == pfnHandler) &&
+               !((psEntry->ulFlags ^ sMsg.ulFlags) & MSG_OBJ_EXTENDED_ID) &&
+               (sMsg.ulMsgID >= psEntry->ulIDFirst) &&
+               (sMsg.ulMsgID <= psEntry->ulIDLast))
+            {
+                break;
+            }
+        }
+
+        //
+        // Discard the frame if it is not in any of the ranges.
+        //
+        if(ulIdx == g_ulCANFilterNumEntries)
+        {
+            g_ulCANFilterRejected++;
+            return(true);
+        }
+    }
+
+    //
+    // Pass the frame to the handler.
+    //
+    pfnHandler(g_ulCANFilterBase, &sMsg);
+
+    //
+    // This message object is in use by the filters.
+    //
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Handles interrupts from the CAN controller used by the filters.
+//!
+//! This function can be installed as the interrupt handler of the CAN
+//! controller passed to CANFilterInit().  It passes each received frame to
+//! its handler with CANFilterDispatch(), and clears the status interrupt and
+//! the interrupts of message objects that are not in use by the filters.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+CANFilterIntHandler(void)
+{
+    unsigned long ulCause;
+
+    //
+    // Loop while the controller has interrupts pending.
+    //
+    while((ulCause = CANIntStatus(g_ulCANFilterBase, CAN_INT_STS_CAUSE)) != 0)
+    {
+        //
+        // A status interrupt is cleared by reading the status.
+        //
+        if(ulCause == CAN_INT_INTID_STATUS)
+        {
+            CANStatusGet(g_ulCANFilterBase, CAN_STS_CONTROL);
+        }
+
+        //
+        // Pass a received frame to its handler, or clear the interrupt of an
+        // object that is not in use by the filters.
+        //
+        else if(!CANFilterDispatch(ulCause))
+        {
+            CANIntClear(g_ulCANFilterBase, ulCause);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! Gets the number of unwanted frames discarded by the filters.
+//!
+//! When the identifier ranges passed to CANFilterInit() need more message
+//! objects than are available, some of the filters are merged and accept
+//! identifiers that are not in any range.  This function returns the number
+//! of such frames that have been discarded by CANFilterDispatch() since
+//! CANFilterInit() was called, which indicates the cost of the merged
+//! filters.
+//!
+//! \return Returns the number of frames discarded.
+//
+//*****************************************************************************
+unsigned long
+CANFilterRejectCount(void)
+{
+    return(g_ulCANFilterRejected);
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
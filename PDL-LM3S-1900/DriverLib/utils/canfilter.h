@@ -0,0 +1,110 @@
+//*****************************************************************************
+//
+// canfilter.h - Prototypes for the CAN acceptance filter manager.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+#ifndef __CANFILTER_H__
+#define __CANFILTER_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The number of masked filters that are kept while the acceptance filters are
+// being computed.  When the identifier ranges break down into more filters
+// than this, the closest filters are merged early, which may accept more
+// unwanted identifiers than necessary.  Each filter uses 16 bytes of stack.
+//
+//*****************************************************************************
+#ifndef CAN_FILTER_MAX_BLOCKS
+#define CAN_FILTER_MAX_BLOCKS   64
+#endif
+
+//*****************************************************************************
+//
+//! The prototype of the function called when a frame is received that matches
+//! one of the identifier ranges given to CANFilterInit().  The first argument
+//! is the base address of the CAN controller, and the second argument is the
+//! received frame, which is only valid for the duration of the call.
+//
+//*****************************************************************************
+typedef void (*tCANFilterHandler)(unsigned long ulBase,
+                                  tCANMsgObject *psMsgObject);
+
+//*****************************************************************************
+//
+//! A range of identifiers to be received, and the function that handles the
+//! frames with those identifiers.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The first identifier of the range.
+    //
+    unsigned long ulIDFirst;
+
+    //
+    //! The last identifier of the range, which is the same as \e ulIDFirst for
+    //! a single identifier.
+    //
+    unsigned long ulIDLast;
+
+    //
+    //! The flags of the range; \b MSG_OBJ_EXTENDED_ID for a range of 29 bit
+    //! identifiers, or zero for a range of 11 bit identifiers.
+    //
+    unsigned long ulFlags;
+
+    //
+    //! The function that is called with each received frame in the range.
+    //
+    tCANFilterHandler pfnHandler;
+}
+tCANFilterEntry;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern unsigned long CANFilterInit(unsigned long ulBase,
+                                   const tCANFilterEntry *psEntries,
+                                   unsigned long ulNumEntries,
+                                   unsigned long ulFirstObj,
+                                   unsigned long ulNumObjs);
+extern tBoolean CANFilterDispatch(unsigned long ulObj);
+extern void CANFilterIntHandler(void);
+extern unsigned long CANFilterRejectCount(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __CANFILTER_H__
@@ -0,0 +1,390 @@
+//*****************************************************************************
+//
+// flashbuf.c - Write-combining buffer for programming the on-chip flash.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \addtogroup utilities_api
+//! @{
+//
+//*****************************************************************************
+
+#include <string.h>
+#include "../hw_flash.h"
+#include "../hw_types.h"
+#include "../src/debug.h"
+#include "../src/flash.h"
+#include "flashbuf.h"
+#if defined(host)
+#include "../hwsim/hwsim.h"
+#endif
+
+//*****************************************************************************
+//
+// The number of words in a flash page.
+//
+//*****************************************************************************
+#define FLASH_PAGE_WORDS        (FLASH_ERASE_SIZE / 4)
+
+//*****************************************************************************
+//
+// Gets a pointer through which the flash contents at the given address can be
+// read.  The host simulator can not map the flash at address zero, so its
+// contents are read from the simulator's copy instead.
+//
+//*****************************************************************************
+#if defined(host)
+#define FLASH_READ_PTR(ulAddr)  (HWSimFlashGet() + (ulAddr))
+#else
+#define FLASH_READ_PTR(ulAddr)  ((unsigned char *)(ulAddr))
+#endif
+
+//*****************************************************************************
+//
+// The flash page held in the buffer, the address of that page (or 0xFFFFFFFF
+// if no page is held), and a flag that is set when the buffer holds data that
+// has not been written to the flash.
+//
+//*****************************************************************************
+static unsigned long g_pulFlashBufPage[FLASH_PAGE_WORDS];
+static unsigned long g_ulFlashBufAddr = 0xFFFFFFFF;
+static tBoolean g_bFlashBufDirty;
+
+//*****************************************************************************
+//
+// The function used to time flash operations, and the activity counted so
+// far.
+//
+//*****************************************************************************
+static unsigned long (*g_pfnFlashBufTimeGet)(void);
+static tFlashBufStats g_sFlashBufStats;
+
+//*****************************************************************************
+//
+// Erases a flash page (if pulData is NULL) or programs a run of words,
+// charging the time taken to the busy time.
+//
+//*****************************************************************************
+static long
+FlashBufOperation(unsigned long *pulData, unsigned long ulAddress,
+                  unsigned long ulCount)
+{
+    unsigned long ulStart;
+    long lRet;
+
+    //
+    // Get the time at which the operation starts.
+    //
+    ulStart = g_pfnFlashBufTimeGet ? g_pfnFlashBufTimeGet() : 0;
+
+    //
+    // Perform the operation.
+    //
+    if(pulData)
+    {
+        lRet = FlashProgram(pulData, ulAddress, ulCount);
+        g_sFlashBufStats.ulBytesProgrammed += ulCount;
+    }
+    else
+    {
+        lRet = FlashErase(ulAddress);
+        g_sFlashBufStats.ulPagesErased++;
+    }
+
+    //
+    // Add the time taken to the busy time.
+    //
+    if(g_pfnFlashBufTimeGet)
+    {
+        g_sFlashBufStats.ulBusyTime += g_pfnFlashBufTimeGet() - ulStart;
+    }
+
+    //
+    // Return the result of the operation.
+    //
+    return(lRet);
+}
+
+//*****************************************************************************
+//
+//! Initializes the flash write-combining buffer.
+//!
+//! \param pfnTimeGet is a pointer to a function that returns a free-running
+//! time count, which is used to measure the time for which the flash is busy;
+//! it may be \b NULL if the busy time is not needed.
+//!
+//! This function empties the write-combining buffer, discarding any data that
+//! has not been flushed to the flash, and clears the activity counts returned
+//! by FlashBufStatsGet().  The time count returned by \e pfnTimeGet may be in
+//! any units (for example, SysTick interrupts or timer ticks), as long as it
+//! counts upward and wraps from 0xFFFFFFFF to zero.
+//!
+//! This function is contained in <tt>utils/flashbuf.c</tt>, with
+//! <tt>utils/flashbuf.h</tt> containing the API definition for use by
+//! applications.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+FlashBufInit(unsigned long (*pfnTimeGet)(void))
+{
+    //
+    // Empty the buffer.
+    //
+    g_ulFlashBufAddr = 0xFFFFFFFF;
+    g_bFlashBufDirty = false;
+
+    //
+    // Save the time function and clear the activity counts.
+    //
+    g_pfnFlashBufTimeGet = pfnTimeGet;
+    memset(&g_sFlashBufStats, 0, sizeof(g_sFlashBufStats));
+}
+
+//*****************************************************************************
+//
+//! Writes data to the flash through the write-combining buffer.
+//!
+//! \param ulAddress is the flash address at which to write the data.
+//! \param pucData is a pointer to the data to be written.
+//! \param ulCount is the number of bytes to be written.
+//!
+//! This function writes data of any length to any address in the flash,
+//! preserving the rest of each flash page that it touches.  The data is
+//! gathered in a RAM copy of one flash page; the page is only written to the
+//! flash when a write moves on to a different page or when FlashBufFlush() is
+//! called, so a sequence of small writes to the same page results in a single
+//! update of that page.
+//!
+//! When a page is written, only the words that differ from the flash are
+//! programmed, and the page is only erased if some bit needs to be changed
+//! from zero to one.  A page whose new contents match the flash is not
+//! written at all.
+//!
+//! Since the data may be held in the buffer, the flash must not be read back
+//! until FlashBufFlush() has been called.
+//!
+//! \return Returns 0 on success, or -1 if a page had to be written to the
+//! flash and the flash could not be erased or programmed.
+//
+//*****************************************************************************
+long
+FlashBufWrite(unsigned long ulAddress, const unsigned char *pucData,
+              unsigned long ulCount)
+{
+    unsigned char *pucPage = (unsigned char *)g_pulFlashBufPage;
+    unsigned long ulPage, ulOffset;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pucData || !ulCount);
+
+    //
+    // Loop over the pages that are touched by the data.
+    //
+    while(ulCount)
+    {
+        //
+        // If the page is not in the buffer, write back the page that is and
+        // load this one from the flash.
+        //
+        ulPage = ulAddress & ~(FLASH_ERASE_SIZE - 1);
+        if(ulPage != g_ulFlashBufAddr)
+        {
+            if(FlashBufFlush())
+            {
+                return(-1);
+            }
+            memcpy(g_pulFlashBufPage, FLASH_READ_PTR(ulPage),
+                   FLASH_ERASE_SIZE);
+            g_ulFlashBufAddr = ulPage;
+        }
+
+        //
+        // Copy the data into this page, noting whether anything changed.
+        //
+        for(ulOffset = ulAddress - ulPage;
+            ulCount && (ulOffset < FLASH_ERASE_SIZE);
+            ulOffset++, ulAddress++, ulCount--)
+        {
+            if(pucPage[ulOffset] != *pucData)
+            {
+                pucPage[ulOffset] = *pucData;
+                g_bFlashBufDirty = true;
+            }
+            pucData++;
+        }
+    }
+
+    //
+    // Success.
+    //
+    return(0);
+}
+
+//*****************************************************************************
+//
+//! Writes the buffered page to the flash.
+//!
+//! This function writes any data held in the write-combining buffer to the
+//! flash.  It must be called after the last FlashBufWrite() of a sequence,
+//! and before the flash written by FlashBufWrite() is read back.
+//!
+//! \return Returns 0 on success, or -1 if the flash could not be erased or
+//! programmed.  On failure the page is kept in the buffer, so the flush can be
+//! retried.
+//
+//*****************************************************************************
+long
+FlashBufFlush(void)
+{
+    unsigned long *pulFlash, ulIdx, ulStart;
+    tBoolean bChanged, bErase;
+
+    //
+    // There is nothing to do if the buffer holds no new data.
+    //
+    if(!g_bFlashBufDirty)
+    {
+        return(0);
+    }
+    pulFlash = (unsigned long *)FLASH_READ_PTR(g_ulFlashBufAddr);
+
+    //
+    // Find out whether the page has changed, and whether any bit needs to be
+    // changed from zero to one (which requires the page to be erased).
+    //
+    bChanged = false;
+    bErase = false;
+    for(ulIdx = 0; ulIdx < FLASH_PAGE_WORDS; ulIdx++)
+    {
+        if(g_pulFlashBufPage[ulIdx] != pulFlash[ulIdx])
+        {
+            bChanged = true;
+            if((g_pulFlashBufPage[ulIdx] & pulFlash[ulIdx]) !=
+               g_pulFlashBufPage[ulIdx])
+            {
+                bErase = true;
+                break;
+            }
+        }
+    }
+
+    //
+    // Skip the page if the flash already holds the new contents.
+    //
+    if(!bChanged)
+    {
+        g_sFlashBufStats.ulPagesSkipped++;
+        g_bFlashBufDirty = false;
+        return(0);
+    }
+
+    //
+    // Erase the page if needed.
+    //
+    if(bErase)
+    {
+        if(FlashBufOperation(0, g_ulFlashBufAddr, 0))
+        {
+            return(-1);
+        }
+    }
+    else
+    {
+        g_sFlashBufStats.ulPagesPatched++;
+    }
+
+    //
+    // Program each run of words that differs from the flash (after an erase,
+    // this is every word that is not 0xFFFFFFFF).
+    //
+    for(ulIdx = 0; ulIdx < FLASH_PAGE_WORDS; )
+    {
+        if(g_pulFlashBufPage[ulIdx] == pulFlash[ulIdx])
+        {
+            ulIdx++;
+            continue;
+        }
+        for(ulStart = ulIdx;
+            (ulIdx < FLASH_PAGE_WORDS) &&
+            (g_pulFlashBufPage[ulIdx] != pulFlash[ulIdx]);
+            ulIdx++)
+        {
+        }
+        if(FlashBufOperation(&g_pulFlashBufPage[ulStart],
+                             g_ulFlashBufAddr + (ulStart * 4),
+                             (ulIdx - ulStart) * 4))
+        {
+            return(-1);
+        }
+    }
+
+    //
+    // Success.  The buffer is only marked clean now, so that a failed write
+    // is retried by the next call rather than being lost.
+    //
+    g_bFlashBufDirty = false;
+    return(0);
+}
+
+//*****************************************************************************
+//
+//! Gets the flash activity counted by the write-combining buffer.
+//!
+//! \param psStats is a pointer to the structure that is filled in with the
+//! number of bytes programmed, the number of pages erased, written without
+//! an erase, or skipped, and the total busy time.
+//!
+//! The counts cover the flash operations performed since FlashBufInit() was
+//! called.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+FlashBufStatsGet(tFlashBufStats *psStats)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psStats);
+
+    //
+    // Return a copy of the counts.
+    //
+    *psStats = g_sFlashBufStats;
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
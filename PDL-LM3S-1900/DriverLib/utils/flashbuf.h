@@ -0,0 +1,91 @@
+//*****************************************************************************
+//
+// flashbuf.h - Prototypes for the flash write-combining buffer.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+#ifndef __FLASHBUF_H__
+#define __FLASHBUF_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+//! Structure that holds the flash activity counted by the write-combining
+//! buffer.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The number of bytes programmed into the flash.
+    //
+    unsigned long ulBytesProgrammed;
+
+    //
+    //! The number of pages erased.
+    //
+    unsigned long ulPagesErased;
+
+    //
+    //! The number of modified pages that were written without being erased,
+    //! because the new contents only cleared bits of the old contents.
+    //
+    unsigned long ulPagesPatched;
+
+    //
+    //! The number of modified pages that did not need to be written, because
+    //! the new contents matched the contents already in the flash.
+    //
+    unsigned long ulPagesSkipped;
+
+    //
+    //! The total time for which the flash was busy being erased or
+    //! programmed, in the units of the time function passed to FlashBufInit().
+    //
+    unsigned long ulBusyTime;
+}
+tFlashBufStats;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern void FlashBufInit(unsigned long (*pfnTimeGet)(void));
+extern long FlashBufWrite(unsigned long ulAddress,
+                          const unsigned char *pucData,
+                          unsigned long ulCount);
+extern long FlashBufFlush(void);
+extern void FlashBufStatsGet(tFlashBufStats *psStats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __FLASHBUF_H__
@@ -0,0 +1,202 @@
+//*****************************************************************************
+//
+// inetchksum.c - Word at a time Internet checksum.
+//
+// Copyright (c) 2007 Luminary Micro, Inc.  All rights reserved.
+// 
+// Software License Agreement
+// 
+// Luminary Micro, Inc. (LMI) is supplying this software for use solely and
+// exclusively on LMI's microcontroller products.
+// 
+// The software is owned by LMI and/or its suppliers, and is protected under
+// applicable copyright laws.  All rights are reserved.  You may not combine
+// this software with "viral" open-source software in order to form a larger
+// program.  Any use in violation of the foregoing restrictions may subject
+// the user to criminal sanctions under applicable laws, as well as to civil
+// liability for the breach of the terms and conditions of this license.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+// OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+// LMI SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+// CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 1900 of the Stellaris Peripheral Driver Library.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \addtogroup utilities_api
+//! @{
+//
+//*****************************************************************************
+
+#include "inetchksum.h"
+
+//*****************************************************************************
+//
+//! Adds a buffer to an Internet checksum.
+//!
+//! \param usSum is the checksum of the preceding data, or zero if there is no
+//! preceding data.
+//! \param pvData is a pointer to the data to be summed.
+//! \param ulLen is the number of bytes of data to be summed.
+//!
+//! This function computes the one's complement sum of the 16-bit words in a
+//! buffer, as described in RFC 1071, and adds it to the sum of the preceding
+//! data.  The buffer may start at any address; the bulk of the data is read
+//! using aligned 32-bit loads, eight words at a time, into a 64-bit
+//! accumulator so that carries are only folded back in once at the end.
+//!
+//! The words are summed in the order in which they are stored in memory, so
+//! the sum can be stored directly into a packet header (after being inverted)
+//! without any byte swapping.  If \e ulLen is odd, the final byte is treated
+//! as though it were followed by a zero byte; the preceding data must
+//! therefore have an even length for \e usSum to be combined correctly.
+//!
+//! This function is contained in <tt>utils/inetchksum.c</tt>, with
+//! <tt>utils/inetchksum.h</tt> containing the API definition for use by
+//! applications.
+//!
+//! \return Returns the one's complement sum, which has not been inverted.
+//
+//*****************************************************************************
+unsigned short
+InetChksumAdd(unsigned short usSum, const void *pvData, unsigned long ulLen)
+{
+    const unsigned char *pucData;
+    const unsigned long *pulData;
+    unsigned long long ullSum;
+    unsigned long ulSum, ulOdd;
+
+    //
+    // Start with an empty sum.
+    //
+    pucData = (const unsigned char *)pvData;
+    ullSum = 0;
+
+    //
+    // If the buffer starts at an odd address, then every halfword read from
+    // here on straddles two words of the checksum.  Sum the first byte in the
+    // upper half of a word, and swap the bytes of the result at the end.
+    //
+    ulOdd = (unsigned long)pucData & 1;
+    if(ulOdd && ulLen)
+    {
+        ullSum = (unsigned long)*pucData++ << 8;
+        ulLen--;
+    }
+
+    //
+    // Sum a halfword if needed to reach a word boundary.
+    //
+    if(((unsigned long)pucData & 2) && (ulLen >= 2))
+    {
+        ullSum += *(const unsigned short *)pucData;
+        pucData += 2;
+        ulLen -= 2;
+    }
+
+    //
+    // Sum the bulk of the buffer eight words at a time.
+    //
+    pulData = (const unsigned long *)pucData;
+    while(ulLen >= 32)
+    {
+        ullSum += pulData[0];
+        ullSum += pulData[1];
+        ullSum += pulData[2];
+        ullSum += pulData[3];
+        ullSum += pulData[4];
+        ullSum += pulData[5];
+        ullSum += pulData[6];
+        ullSum += pulData[7];
+        pulData += 8;
+        ulLen -= 32;
+    }
+
+    //
+    // Sum the remaining whole words.
+    //
+    while(ulLen >= 4)
+    {
+        ullSum += *pulData++;
+        ulLen -= 4;
+    }
+
+    //
+    // Sum the trailing halfword and byte, if there are any.  A trailing byte
+    // is in the lower half of its word since the processor is little endian.
+    //
+    pucData = (const unsigned char *)pulData;
+    if(ulLen >= 2)
+    {
+        ullSum += *(const unsigned short *)pucData;
+        pucData += 2;
+    }
+    if(ulLen & 1)
+    {
+        ullSum += *pucData;
+    }
+
+    //
+    // Fold the 64-bit accumulator down to 16 bits.  The first fold leaves at
+    // most a single carry above 32 bits, which the second fold absorbs.
+    //
+    ullSum = (ullSum & 0xffffffff) + (ullSum >> 32);
+    ulSum = (unsigned long)ullSum + (unsigned long)(ullSum >> 32);
+    ulSum = (ulSum & 0xffff) + (ulSum >> 16);
+    ulSum = (ulSum & 0xffff) + (ulSum >> 16);
+
+    //
+    // Undo the byte offset caused by an odd starting address.
+    //
+    if(ulOdd)
+    {
+        ulSum = ((ulSum & 0xff) << 8) | (ulSum >> 8);
+    }
+
+    //
+    // Add in the sum of the preceding data.
+    //
+    ulSum += usSum;
+    ulSum = (ulSum & 0xffff) + (ulSum >> 16);
+
+    //
+    // Return the sum.
+    //
+    return((unsigned short)ulSum);
+}
+
+//*****************************************************************************
+//
+//! Computes the Internet checksum of a buffer.
+//!
+//! \param pvData is a pointer to the data to be summed.
+//! \param ulLen is the number of bytes of data to be summed.
+//!
+//! This function computes the one's complement sum of the 16-bit words in a
+//! buffer, in the same way as InetChksumAdd().  It returns the sum in the form
+//! expected by lwIP, so it can be used as the \b LWIP_CHKSUM option.
+//!
+//! This function is contained in <tt>utils/inetchksum.c</tt>, with
+//! <tt>utils/inetchksum.h</tt> containing the API definition for use by
+//! applications.
+//!
+//! \return Returns the one's complement sum, which has not been inverted.
+//
+//*****************************************************************************
+unsigned short
+InetChksum(const void *pvData, unsigned long ulLen)
+{
+    return(InetChksumAdd(0, pvData, ulLen));
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -27,12 +27,15 @@
 //*****************************************************************************
 
 #include <stdarg.h>
-#include "../hw_types.h"
+#include "../hw_ints.h"
 #include "../hw_memmap.h"
+#include "../hw_types.h"
 #include "../hw_uart.h"
-#include "../src/uart.h"
 #include "../src/debug.h"
+#include "../src/interrupt.h"
 #include "../src/sysctl.h"
+#include "../src/uart.h"
+#include "uartstdio.h"
 
 //*****************************************************************************
 //
@@ -41,6 +44,94 @@
 //
 //*****************************************************************************
 
+//*****************************************************************************
+//
+// If buffered mode is defined, set aside RX and TX buffers and read/write
+// pointers to control them.
+//
+//*****************************************************************************
+#ifdef UART_BUFFERED
+
+//*****************************************************************************
+//
+// Indicates that the last character received was a CR, so that an LF that
+// follows it can be discarded.
+//
+//*****************************************************************************
+static tBoolean g_bLastWasCR = false;
+
+//*****************************************************************************
+//
+// Output ring buffer.  Buffer is full if g_ulUARTTxReadIndex is one ahead of
+// g_ulUARTTxWriteIndex.  Buffer is empty if the two indices are the same.
+//
+//*****************************************************************************
+static unsigned char g_pcUARTTxBuffer[UART_TX_BUFFER_SIZE];
+static volatile unsigned long g_ulUARTTxWriteIndex = 0;
+static volatile unsigned long g_ulUARTTxReadIndex = 0;
+
+//*****************************************************************************
+//
+// Input ring buffer.  Buffer is full if g_ulUARTRxReadIndex is one ahead of
+// g_ulUARTRxWriteIndex.  Buffer is empty if the two indices are the same.
+//
+//*****************************************************************************
+static unsigned char g_pcUARTRxBuffer[UART_RX_BUFFER_SIZE];
+static volatile unsigned long g_ulUARTRxWriteIndex = 0;
+static volatile unsigned long g_ulUARTRxReadIndex = 0;
+
+//*****************************************************************************
+//
+// Macros to determine number of free and used bytes in the transmit buffer.
+//
+//*****************************************************************************
+#define TX_BUFFER_USED          (GetBufferCount(&g_ulUARTTxReadIndex,  \
+                                                &g_ulUARTTxWriteIndex, \
+                                                UART_TX_BUFFER_SIZE))
+#define TX_BUFFER_FREE          (UART_TX_BUFFER_SIZE - 1 - TX_BUFFER_USED)
+#define TX_BUFFER_EMPTY         (IsBufferEmpty(&g_ulUARTTxReadIndex,   \
+                                               &g_ulUARTTxWriteIndex))
+#define TX_BUFFER_FULL          (IsBufferFull(&g_ulUARTTxReadIndex,  \
+                                              &g_ulUARTTxWriteIndex, \
+                                              UART_TX_BUFFER_SIZE))
+#define ADVANCE_TX_BUFFER_INDEX(Index) \
+                                (Index) = ((Index) + 1) % UART_TX_BUFFER_SIZE
+
+//*****************************************************************************
+//
+// Macros to determine number of free and used bytes in the receive buffer.
+//
+//*****************************************************************************
+#define RX_BUFFER_USED          (GetBufferCount(&g_ulUARTRxReadIndex,  \
+                                                &g_ulUARTRxWriteIndex, \
+                                                UART_RX_BUFFER_SIZE))
+#define RX_BUFFER_FREE          (UART_RX_BUFFER_SIZE - 1 - RX_BUFFER_USED)
+#define RX_BUFFER_EMPTY         (IsBufferEmpty(&g_ulUARTRxReadIndex,   \
+                                               &g_ulUARTRxWriteIndex))
+#define RX_BUFFER_FULL          (IsBufferFull(&g_ulUARTRxReadIndex,  \
+                                              &g_ulUARTRxWriteIndex, \
+                                              UART_RX_BUFFER_SIZE))
+#define ADVANCE_RX_BUFFER_INDEX(Index) \
+                                (Index) = ((Index) + 1) % UART_RX_BUFFER_SIZE
+
+//*****************************************************************************
+//
+// The interrupt number of the chosen UART.
+//
+//*****************************************************************************
+static unsigned long g_ulPortInt = 0;
+
+//*****************************************************************************
+//
+// The list of interrupts for the console UART.
+//
+//*****************************************************************************
+static const unsigned long g_ulUartInt[3] =
+{
+    INT_UART0, INT_UART1, INT_UART2
+};
+#endif
+
 //*****************************************************************************
 //
 // The base address of the chosen UART.
@@ -76,6 +167,119 @@ static unsigned long g_ulUartPeriph[3] =
     SYSCTL_PERIPH_UART0, SYSCTL_PERIPH_UART1, SYSCTL_PERIPH_UART2
 };
 
+#ifdef UART_BUFFERED
+//*****************************************************************************
+//
+//! Determines whether the ring buffer whose pointers and size are provided
+//! is full or not.
+//!
+//! \param pulRead points to the read index for the buffer.
+//! \param pulWrite points to the write index for the buffer.
+//! \param ulSize is the size of the buffer in bytes.
+//!
+//! This function is used to determine whether or not a given ring buffer is
+//! full.  The structure of the code is specifically to ensure that we do not
+//! see warnings from the compiler related to the order of volatile accesses
+//! being undefined.
+//!
+//! \return Returns \b true if the buffer is full or \b false otherwise.
+//
+//*****************************************************************************
+static tBoolean
+IsBufferFull(volatile unsigned long *pulRead,
+             volatile unsigned long *pulWrite, unsigned long ulSize)
+{
+    unsigned long ulWrite;
+    unsigned long ulRead;
+
+    ulWrite = *pulWrite;
+    ulRead = *pulRead;
+
+    return((((ulWrite + 1) % ulSize) == ulRead) ? true : false);
+}
+
+//*****************************************************************************
+//
+//! Determines whether the ring buffer whose pointers and size are provided
+//! is empty or not.
+//!
+//! \param pulRead points to the read index for the buffer.
+//! \param pulWrite points to the write index for the buffer.
+//!
+//! This function is used to determine whether or not a given ring buffer is
+//! empty.  The structure of the code is specifically to ensure that we do not
+//! see warnings from the compiler related to the order of volatile accesses
+//! being undefined.
+//!
+//! \return Returns \b true if the buffer is empty or \b false otherwise.
+//
+//*****************************************************************************
+static tBoolean
+IsBufferEmpty(volatile unsigned long *pulRead,
+              volatile unsigned long *pulWrite)
+{
+    unsigned long ulWrite;
+    unsigned long ulRead;
+
+    ulWrite = *pulWrite;
+    ulRead = *pulRead;
+
+    return((ulWrite == ulRead) ? true : false);
+}
+
+//*****************************************************************************
+//
+//! Determines the number of bytes of data contained in a ring buffer.
+//!
+//! \param pulRead points to the read index for the buffer.
+//! \param pulWrite points to the write index for the buffer.
+//! \param ulSize is the size of the buffer in bytes.
+//!
+//! This function is used to determine how many bytes of data a given ring
+//! buffer currently contains.  The structure of the code is specifically to
+//! ensure that we do not see warnings from the compiler related to the order
+//! of volatile accesses being undefined.
+//!
+//! \return Returns the number of bytes of data currently in the buffer.
+//
+//*****************************************************************************
+static unsigned long
+GetBufferCount(volatile unsigned long *pulRead,
+               volatile unsigned long *pulWrite, unsigned long ulSize)
+{
+    unsigned long ulWrite;
+    unsigned long ulRead;
+
+    ulWrite = *pulWrite;
+    ulRead = *pulRead;
+
+    return((ulWrite >= ulRead) ? (ulWrite - ulRead) :
+                                 (ulSize - (ulRead - ulWrite)));
+}
+
+//*****************************************************************************
+//
+// Take as many bytes from the transmit buffer as we have space for and move
+// them into the UART transmit FIFO.  This must be called either from the
+// interrupt handler or with interrupts disabled, since otherwise there is a
+// race condition which can cause the read index to be corrupted.
+//
+//*****************************************************************************
+static void
+UARTPrimeTransmit(unsigned long ulBase)
+{
+    //
+    // Take some characters out of the transmit buffer and feed them to the
+    // UART transmit FIFO.
+    //
+    while(UARTSpaceAvail(ulBase) && !TX_BUFFER_EMPTY)
+    {
+        UARTCharPutNonBlocking(ulBase, g_pcUARTTxBuffer[g_ulUARTTxReadIndex]);
+        ADVANCE_TX_BUFFER_INDEX(g_ulUARTTxReadIndex);
+    }
+}
+#endif
+
 //*****************************************************************************
 //
 //! Initialize UART console.
@@ -90,6 +294,11 @@ static unsigned long g_ulUartPeriph[3] =
 //! functions: UARTprintf() or UARTgets().  In order for this function to work
 //! correctly, SysCtlClockSet() must be called prior to calling this function.
 //!
+//! If the module is built with \b UART_BUFFERED defined, this function also
+//! enables the receive interrupts of the UART; UARTStdioIntHandler() must be
+//! installed as the interrupt handler for the UART and the processor interrupt
+//! must be enabled for the console to operate.
+//!
 //! This function is contained in <tt>utils/uartstdio.c</tt>, with
 //! <tt>utils/uartstdio.h</tt> containing the API definition for use by
 //! applications.
@@ -135,6 +344,31 @@ UARTStdioInit(unsigned long ulPortNum)
     // Enable the UART operation.
     //
     UARTEnable(g_ulBase);
+
+#ifdef UART_BUFFERED
+    //
+    // Empty the receive and transmit buffers.
+    //
+    g_ulUARTRxReadIndex = g_ulUARTRxWriteIndex;
+    g_ulUARTTxReadIndex = g_ulUARTTxWriteIndex;
+    g_bLastWasCR = false;
+
+    //
+    // Interrupt when the transmit FIFO drains to 1/8 full, so that it is
+    // refilled from the transmit buffer before it runs dry, and when the
+    // receive FIFO fills to 1/2 full or a receive timeout occurs.
+    //
+    UARTFIFOLevelSet(g_ulBase, UART_FIFO_TX1_8, UART_FIFO_RX4_8);
+
+    //
+    // Enable the receive interrupts; the transmit interrupt is enabled only
+    // while there is data in the transmit buffer.
+    //
+    g_ulPortInt = g_ulUartInt[ulPortNum];
+    UARTIntDisable(g_ulBase, 0xFFFFFFFF);
+    UARTIntEnable(g_ulBase, UART_INT_RX | UART_INT_RT);
+    IntEnable(g_ulPortInt);
+#endif
 }
 
 //*****************************************************************************
@@ -154,8 +388,11 @@ UARTStdioInit(unsigned long ulPortNum)
 //! null character (0) is encountered, then no more characters will be
 //! transmitted and the function will return.
 //!
-//! This function is blocking and will not return until all the characters have
-//! been written to the output FIFO.
+//! In non-buffered mode, this function is blocking and will not return until
+//! all the characters have been written to the output FIFO.  In buffered mode,
+//! the characters are written to the UART transmit buffer and the call returns
+//! immediately.  If insufficient space remains in the transmit buffer,
+//! additional characters are discarded.
 //!
 //! This function is contained in <tt>utils/uartstdio.c</tt>, with
 //! <tt>utils/uartstdio.h</tt> containing the API definition for use by
@@ -167,6 +404,84 @@ UARTStdioInit(unsigned long ulPortNum)
 static int
 UARTwrite(const char *pcBuf, unsigned long ulLen)
 {
+#ifdef UART_BUFFERED
+    unsigned int uIdx;
+    tBoolean bMasked;
+
+    //
+    // Check for valid arguments.
+    //
+    ASSERT(pcBuf != 0);
+    ASSERT(g_ulBase != 0);
+
+    //
+    // Disable interrupts while adding to the transmit buffer, since the
+    // interrupt handler also adds to it when echoing received characters.
+    // They may already be disabled if this is the echo from the interrupt
+    // handler, in which case they are left that way.
+    //
+    bMasked = IntMasterDisable();
+
+    //
+    // Send the characters
+    //
+    for(uIdx = 0; uIdx < ulLen; uIdx++)
+    {
+        //
+        // If the character to the UART is \n, then add a \r before it so that
+        // \n is translated to \n\r in the output.  Both characters must fit
+        // in the buffer.
+        //
+        if(pcBuf[uIdx] == '\n')
+        {
+            if(TX_BUFFER_FREE < 2)
+            {
+                break;
+            }
+            g_pcUARTTxBuffer[g_ulUARTTxWriteIndex] = '\r';
+            ADVANCE_TX_BUFFER_INDEX(g_ulUARTTxWriteIndex);
+        }
+        else if(TX_BUFFER_FULL)
+        {
+            //
+            // Buffer is full - discard remaining characters and return.
+            //
+            break;
+        }
+
+        //
+        // Send the character to the UART output.
+        //
+        g_pcUARTTxBuffer[g_ulUARTTxWriteIndex] = pcBuf[uIdx];
+        ADVANCE_TX_BUFFER_INDEX(g_ulUARTTxWriteIndex);
+    }
+
+    //
+    // Start off the transmission by filling the FIFO from the buffer.  If any
+    // of the buffer is left, enable the transmit interrupt so that the
+    // interrupt handler refills the FIFO with the rest as it drains.  This is
+    // done before interrupts are reenabled, so that the handler can not empty
+    // the buffer and turn off the transmit interrupt in between.
+    //
+    UARTPrimeTransmit(g_ulBase);
+    if(!TX_BUFFER_EMPTY)
+    {
+        UARTIntEnable(g_ulBase, UART_INT_TX);
+    }
+
+    //
+    // Reenable interrupts.
+    //
+    if(!bMasked)
+    {
+        IntMasterEnable();
+    }
+
+    //
+    // Return the number of characters written.
+    //
+    return(uIdx);
+#else
     unsigned int uIdx;
 
     //
@@ -199,6 +514,7 @@ UARTwrite(const char *pcBuf, unsigned long ulLen)
     // Return the number of characters written.
     //
     return(uIdx);
+#endif
 }
 
 //*****************************************************************************
@@ -221,6 +537,11 @@ UARTwrite(const char *pcBuf, unsigned long ulLen)
 //! Since the string will be null terminated, the user must ensure that the
 //! buffer is sized to allow for the additional null character.
 //!
+//! In buffered mode, the echo and backspace processing is performed by
+//! UARTStdioIntHandler() as each character arrives, and this function only
+//! removes the line from the receive buffer.  UARTPeek() can be used to check
+//! that a complete line is available, so that this function does not block.
+//!
 //! This function is contained in <tt>utils/uartstdio.c</tt>, with
 //! <tt>utils/uartstdio.h</tt> containing the API definition for use by
 //! applications.
@@ -232,6 +553,77 @@ UARTwrite(const char *pcBuf, unsigned long ulLen)
 int
 UARTgets(char *pcBuf, unsigned long ulLen)
 {
+#ifdef UART_BUFFERED
+    unsigned long ulCount = 0;
+    char cChar;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pcBuf != 0);
+    ASSERT(ulLen != 0);
+    ASSERT(g_ulBase != 0);
+
+    //
+    // Adjust the length back by 1 to leave space for the trailing
+    // null terminator.
+    //
+    ulLen--;
+
+    //
+    // Process characters until a newline is received.
+    //
+    while(1)
+    {
+        //
+        // Wait for a character to be received.
+        //
+        while(RX_BUFFER_EMPTY)
+        {
+        }
+
+        //
+        // Read the next character from the receive buffer.  The UART
+        // interrupt is disabled while doing so, since the interrupt handler
+        // removes characters from the buffer when a backspace is received.
+        //
+        IntDisable(g_ulPortInt);
+        cChar = g_pcUARTRxBuffer[g_ulUARTRxReadIndex];
+        ADVANCE_RX_BUFFER_INDEX(g_ulUARTRxReadIndex);
+        IntEnable(g_ulPortInt);
+
+        //
+        // The interrupt handler stores every line termination as a CR, so
+        // stop processing the input when one is found.
+        //
+        if(cChar == '\r')
+        {
+            break;
+        }
+
+        //
+        // Store the character in the caller supplied buffer as long as we are
+        // not at the end of the buffer.  If the end of the buffer has been
+        // reached then all additional characters are ignored until a newline
+        // is received.
+        //
+        if(ulCount < ulLen)
+        {
+            pcBuf[ulCount] = cChar;
+            ulCount++;
+        }
+    }
+
+    //
+    // Add a null termination to the string.
+    //
+    pcBuf[ulCount] = 0;
+
+    //
+    // Return the count of chars in the buffer, not counting the trailing 0.
+    //
+    return(ulCount);
+#else
     unsigned long ulCount = 0;
     char cChar;
     static char bLastWasCR = 0;
@@ -356,6 +748,7 @@ UARTgets(char *pcBuf, unsigned long ulLen)
     // Return the count of chars in the buffer, not counting the trailing 0.
     //
     return(ulCount);
+#endif
 }
 
 //*****************************************************************************
@@ -735,6 +1128,318 @@ convert:
     va_end(vaArgP);
 }
 
+#ifdef UART_BUFFERED
+//*****************************************************************************
+//
+//! Returns the number of bytes available in the receive buffer.
+//!
+//! This function, available only when the module is built to operate in
+//! buffered mode using \b UART_BUFFERED, may be used to determine the number
+//! of bytes of data currently available in the receive buffer.
+//!
+//! This function is contained in <tt>utils/uartstdio.c</tt>, with
+//! <tt>utils/uartstdio.h</tt> containing the API definition for use by
+//! applications.
+//!
+//! \return Returns the number of available bytes.
+//
+//*****************************************************************************
+int
+UARTRxBytesAvail(void)
+{
+    return(RX_BUFFER_USED);
+}
+
+//*****************************************************************************
+//
+//! Returns the number of bytes free in the transmit buffer.
+//!
+//! This function, available only when the module is built to operate in
+//! buffered mode using \b UART_BUFFERED, may be used to determine the amount
+//! of space currently available in the transmit buffer.  Note that each LF
+//! written takes two bytes of the buffer, since it is expanded to a CRLF pair.
+//!
+//! This function is contained in <tt>utils/uartstdio.c</tt>, with
+//! <tt>utils/uartstdio.h</tt> containing the API definition for use by
+//! applications.
+//!
+//! \return Returns the number of free bytes.
+//
+//*****************************************************************************
+int
+UARTTxBytesFree(void)
+{
+    return(TX_BUFFER_FREE);
+}
+
+//*****************************************************************************
+//
+//! Looks ahead in the receive buffer for a particular character.
+//!
+//! \param ucChar is the character that is to be searched for.
+//!
+//! This function, available only when the module is built to operate in
+//! buffered mode using \b UART_BUFFERED, may be used to look ahead in the
+//! receive buffer for a particular character and report its position if found.
+//! It is typically used to determine whether a complete line of user input is
+//! available, in which case ucChar should be set to CR ('\\r') which is used
+//! as the line end marker in the receive buffer.
+//!
+//! This function is contained in <tt>utils/uartstdio.c</tt>, with
+//! <tt>utils/uartstdio.h</tt> containing the API definition for use by
+//! applications.
+//!
+//! \return Returns -1 to indicate that the requested character does not exist
+//! in the receive buffer.  Returns a non-negative number if the character was
+//! found in which case the value represents the position of the first instance
+//! of \e ucChar relative to the receive buffer read pointer.
+//
+//*****************************************************************************
+int
+UARTPeek(unsigned char ucChar)
+{
+    int iCount;
+    int iAvail;
+    unsigned long ulReadIndex;
+
+    //
+    // How many characters are there in the receive buffer?
+    //
+    iAvail = (int)RX_BUFFER_USED;
+    ulReadIndex = g_ulUARTRxReadIndex;
+
+    //
+    // Check all the unread characters looking for the one passed.
+    //
+    for(iCount = 0; iCount < iAvail; iCount++)
+    {
+        if(g_pcUARTRxBuffer[ulReadIndex] == ucChar)
+        {
+            //
+            // We found it so return the index
+            //
+            return(iCount);
+        }
+        else
+        {
+            //
+            // This one didn't match so move on to the next character.
+            //
+            ADVANCE_RX_BUFFER_INDEX(ulReadIndex);
+        }
+    }
+
+    //
+    // If we drop out of the loop, we didn't find the character in the receive
+    // buffer.
+    //
+    return(-1);
+}
+
+//*****************************************************************************
+//
+//! Flushes the transmit buffer.
+//!
+//! \param bDiscard indicates whether any remaining data in the buffer should
+//! be discarded (\b true) or transmitted (\b false).
+//!
+//! This function, available only when the module is built to operate in
+//! buffered mode using \b UART_BUFFERED, may be used to flush the transmit
+//! buffer, either discarding or transmitting any data received via calls to
+//! UARTprintf() that is waiting to be transmitted.  On return, the transmit
+//! buffer will be empty.  When transmitting, the function waits until the
+//! data has been moved into the UART transmit FIFO, which requires the UART
+//! interrupt to be enabled.
+//!
+//! This function is contained in <tt>utils/uartstdio.c</tt>, with
+//! <tt>utils/uartstdio.h</tt> containing the API definition for use by
+//! applications.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTFlushTx(tBoolean bDiscard)
+{
+    //
+    // Should the remaining data be discarded or transmitted?
+    //
+    if(bDiscard)
+    {
+        //
+        // The remaining data should be discarded, so temporarily turn off
+        // interrupts.
+        //
+        IntDisable(g_ulPortInt);
+
+        //
+        // Flush the transmit buffer.
+        //
+        g_ulUARTTxReadIndex = 0;
+        g_ulUARTTxWriteIndex = 0;
+
+        //
+        // Turn the interrupts back on.
+        //
+        IntEnable(g_ulPortInt);
+    }
+    else
+    {
+        //
+        // Wait for all remaining data to be transmitted before returning.
+        //
+        while(!TX_BUFFER_EMPTY)
+        {
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! Handles UART interrupts.
+//!
+//! This function handles interrupts from the UART.  It will copy data from the
+//! transmit buffer to the UART transmit FIFO if space is available, and it
+//! will copy data from the UART receive FIFO to the receive buffer if data is
+//! available.  Received characters are echoed back to the UART; a backspace
+//! removes the last character from the receive buffer (if it is not the end
+//! of a line), and CR, LF, CRLF, and ESC are all stored as a single CR.
+//!
+//! This function is available only when the module is built to operate in
+//! buffered mode using \b UART_BUFFERED, and must be placed in the vector
+//! table entry for the UART chosen by UARTStdioInit().
+//!
+//! This function is contained in <tt>utils/uartstdio.c</tt>, with
+//! <tt>utils/uartstdio.h</tt> containing the API definition for use by
+//! applications.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTStdioIntHandler(void)
+{
+    unsigned long ulInts;
+    unsigned long ulLast;
+    unsigned char ucChar;
+
+    //
+    // Get and clear the current interrupt source(s)
+    //
+    ulInts = UARTIntStatus(g_ulBase, true);
+    UARTIntClear(g_ulBase, ulInts);
+
+    //
+    // Are we being interrupted because the TX FIFO has space available?
+    //
+    if(ulInts & UART_INT_TX)
+    {
+        //
+        // Move as many bytes as we can into the transmit FIFO.
+        //
+        UARTPrimeTransmit(g_ulBase);
+
+        //
+        // If the output buffer is empty, turn off the transmit interrupt.
+        //
+        if(TX_BUFFER_EMPTY)
+        {
+            UARTIntDisable(g_ulBase, UART_INT_TX);
+        }
+    }
+
+    //
+    // Are we being interrupted due to a received character?
+    //
+    if(ulInts & (UART_INT_RX | UART_INT_RT))
+    {
+        //
+        // Get all the available characters from the UART.
+        //
+        while(UARTCharsAvail(g_ulBase))
+        {
+            //
+            // Read a character
+            //
+            ucChar = (unsigned char)(UARTCharGetNonBlocking(g_ulBase) & 0xFF);
+
+            //
+            // If this character is LF and last was CR, then just gobble up
+            // the character because the EOL processing was taken care of with
+            // the CR.
+            //
+            if((ucChar == '\n') && g_bLastWasCR)
+            {
+                g_bLastWasCR = false;
+                continue;
+            }
+            g_bLastWasCR = (ucChar == '\r') ? true : false;
+
+            //
+            // See if the backspace key was pressed.
+            //
+            if(ucChar == '\b')
+            {
+                //
+                // If there are any characters of the current line in the
+                // buffer, then delete the last and rub it out.
+                //
+                if(!RX_BUFFER_EMPTY)
+                {
+                    ulLast = ((g_ulUARTRxWriteIndex +
+                               (UART_RX_BUFFER_SIZE - 1)) %
+                              UART_RX_BUFFER_SIZE);
+                    if(g_pcUARTRxBuffer[ulLast] != '\r')
+                    {
+                        UARTwrite("\b \b", 3);
+                        g_ulUARTRxWriteIndex = ulLast;
+                    }
+                }
+
+                //
+                // Skip ahead to read the next character.
+                //
+                continue;
+            }
+
+            //
+            // Any line termination is stored in the buffer as a CR.
+            //
+            if((ucChar == '\n') || (ucChar == 0x1b))
+            {
+                ucChar = '\r';
+            }
+
+            //
+            // If there is space in the receive buffer, put the character
+            // there, otherwise throw it away.
+            //
+            if(!RX_BUFFER_FULL)
+            {
+                //
+                // Store the new character in the receive buffer
+                //
+                g_pcUARTRxBuffer[g_ulUARTRxWriteIndex] = ucChar;
+                ADVANCE_RX_BUFFER_INDEX(g_ulUARTRxWriteIndex);
+
+                //
+                // Reflect the character back to the user, ending the line
+                // with a newline (which UARTwrite expands to a CRLF pair).
+                //
+                if(ucChar == '\r')
+                {
+                    UARTwrite("\n", 1);
+                }
+                else
+                {
+                    UARTwrite((char *)&ucChar, 1);
+                }
+            }
+        }
+    }
+}
+#endif
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
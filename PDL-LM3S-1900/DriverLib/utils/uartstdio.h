@@ -34,6 +34,21 @@ extern "C"
 {
 #endif
 
+//*****************************************************************************
+//
+// If built for buffered operation, the following labels define the sizes of
+// the transmit and receive buffers respectively.
+//
+//*****************************************************************************
+#ifdef UART_BUFFERED
+#ifndef UART_RX_BUFFER_SIZE
+#define UART_RX_BUFFER_SIZE     128
+#endif
+#ifndef UART_TX_BUFFER_SIZE
+#define UART_TX_BUFFER_SIZE     1024
+#endif
+#endif
+
 //*****************************************************************************
 //
 // Prototypes for the APIs.
@@ -43,6 +58,19 @@ extern void UARTStdioInit(unsigned long ulPort);
 extern int  UARTgets(char *pcBuf, unsigned long ulLen);
 extern void UARTprintf(const char *pcString, ...);
 
+//*****************************************************************************
+//
+// Prototypes for the APIs available only when buffered operation is enabled.
+//
+//*****************************************************************************
+#ifdef UART_BUFFERED
+extern int  UARTRxBytesAvail(void);
+extern int  UARTTxBytesFree(void);
+extern int  UARTPeek(unsigned char ucChar);
+extern void UARTFlushTx(tBoolean bDiscard);
+extern void UARTStdioIntHandler(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif